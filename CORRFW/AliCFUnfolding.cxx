@@ -57,6 +57,11 @@
 // found in AliCFUnfolding::CalculateCorrelatedErrors()                //
 // Author: marta.verweij@cern.ch                                       //
 //                                                                     //
+// Without smoothing, the iterations run on a compressed sparse row    //
+// copy of the conditional matrix (see BuildCompactResponse()) and the //
+// randomized unfoldings of the error calculation can be distributed   //
+// over several threads with ::SetNumberOfThreads                      //
+//                                                                     //
 // An optional possibility is to smooth the unfolded spectrum at the   //
 // end of each iteration, either using a fit function                  //
 // (only if #dimensions <=3)                                           //
@@ -92,6 +97,10 @@
 #include "TH2D.h"
 #include "TH3D.h"
 #include "TRandom3.h"
+#if __cplusplus >= 201103L
+#include <atomic>
+#include <thread>
+#endif
 
 
 ClassImp(AliCFUnfolding)
@@ -130,7 +139,18 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fNThreads(1),
+  fCompactRowStart(),
+  fCompactColumn(),
+  fCompactCond(),
+  fCompactBin(),
+  fCellCoordM(),
+  fCellCoordT(),
+  fCellIndexM(),
+  fCellIndexT(),
+  fEfficiencyCell(),
+  fMeasuredCell()
 {
   //
   // default constructor
@@ -174,7 +194,18 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fNThreads(1),
+  fCompactRowStart(),
+  fCompactColumn(),
+  fCompactCond(),
+  fCompactBin(),
+  fCellCoordM(),
+  fCellCoordT(),
+  fCellIndexM(),
+  fCellIndexT(),
+  fEfficiencyCell(),
+  fMeasuredCell()
 {
   //
   // named constructor
@@ -353,6 +384,43 @@ void AliCFUnfolding::Unfold() {
   Int_t iIterBayes     = 0 ;
   Double_t convergence = 0.;
 
+  if (fUseSmoothing) {
+    // smoothing works on the THnSparse unfolded spectrum at each iteration
+    iIterBayes = IterateSparse(convergence);
+    if (iIterBayes<0) return;
+  }
+  else iIterBayes = IterateCompact(convergence);
+
+  if (fNCalcCorrErrors==0) fUnfoldedFinal = (THnSparse*) fUnfolded->Clone() ;
+
+  //
+  //for (Long_t iBin=0; iBin<fUnfoldedFinal->GetNbins(); iBin++) AliDebug(2,Form("%e\n",fUnfoldedFinal->GetBinError(iBin)));
+  //
+
+  if (fNCalcCorrErrors == 0) {
+    AliInfo("\n================================================\nFinished bayes iteration, now calculating errors...\n================================================\n");
+    fNCalcCorrErrors = 1;
+    CalculateCorrelatedErrors();
+  }
+
+  if (fNCalcCorrErrors >1 ) {
+    AliInfo(Form("\n\n=======================\nFinished at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
+  }
+  else if(fNCalcCorrErrors>0) {
+    AliInfo(Form("=======================\nUnfolding of randomized distribution finished at iteration %d with convergence %e \n",iIterBayes,convergence));
+  }
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfolding::IterateSparse(Double_t& convergence) {
+  //
+  // Bayes iterations on the THnSparse objects, needed when smoothing the unfolded spectrum
+  // returns the number of iterations performed, or -1 if the smoothing failed
+  //
+
+  Int_t iIterBayes = 0 ;
+
   for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
 
     CreateEstMeasured(); // create measured estimate from prior
@@ -377,7 +445,7 @@ void AliCFUnfolding::Unfold() {
 	else {
 	  AliInfo(Form("\n\n=======================\nFinish at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
 	}
-	return;
+	return -1;
       }
     }
 
@@ -388,24 +456,7 @@ void AliCFUnfolding::Unfold() {
 
   } // end bayes iteration
 
-  if (fNCalcCorrErrors==0) fUnfoldedFinal = (THnSparse*) fUnfolded->Clone() ;
-
-  //
-  //for (Long_t iBin=0; iBin<fUnfoldedFinal->GetNbins(); iBin++) AliDebug(2,Form("%e\n",fUnfoldedFinal->GetBinError(iBin)));
-  //
-
-  if (fNCalcCorrErrors == 0) {
-    AliInfo("\n================================================\nFinished bayes iteration, now calculating errors...\n================================================\n");
-    fNCalcCorrErrors = 1;
-    CalculateCorrelatedErrors();
-  }
-
-  if (fNCalcCorrErrors >1 ) {
-    AliInfo(Form("\n\n=======================\nFinished at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
-  }
-  else if(fNCalcCorrErrors>0) {
-    AliInfo(Form("=======================\nUnfolding of randomized distribution finished at iteration %d with convergence %e \n",iIterBayes,convergence));
-  }
+  return iIterBayes;
 }
 
 //______________________________________________________________
@@ -457,30 +508,35 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
 
 
   //Do fNRandomIterations = bayes iterations performed
-  for (int i=0; i<fNRandomIterations; i++) {
+  if (!fUseSmoothing) {
+    RunRandomizedUnfoldings(); // on the compact representation, possibly multi-threaded
+  }
+  else {
+    for (int i=0; i<fNRandomIterations; i++) {
     
-    // reset prior to original one
-    if (fPrior) delete fPrior ;
-    fPrior = (THnSparse*) fPriorOrig->Clone();
+      // reset prior to original one
+      if (fPrior) delete fPrior ;
+      fPrior = (THnSparse*) fPriorOrig->Clone();
 
-    // create randomized distribution and stick measured spectrum to it
-    CreateRandomizedDist();
+      // create randomized distribution and stick measured spectrum to it
+      CreateRandomizedDist();
 
-    if (fResponse) delete fResponse ;
-    fResponse = (THnSparse*) fRandomResponse->Clone();
-    fResponse->SetTitle("Response");
+      if (fResponse) delete fResponse ;
+      fResponse = (THnSparse*) fRandomResponse->Clone();
+      fResponse->SetTitle("Response");
 
-    if (fEfficiency) delete fEfficiency ;
-    fEfficiency = (THnSparse*) fRandomEfficiency->Clone();
-    fEfficiency->SetTitle("Efficiency");
+      if (fEfficiency) delete fEfficiency ;
+      fEfficiency = (THnSparse*) fRandomEfficiency->Clone();
+      fEfficiency->SetTitle("Efficiency");
 
-    if (fMeasured)   delete fMeasured   ;
-    fMeasured = (THnSparse*) fRandomMeasured->Clone();
-    fMeasured->SetTitle("Measured");
+      if (fMeasured)   delete fMeasured   ;
+      fMeasured = (THnSparse*) fRandomMeasured->Clone();
+      fMeasured->SetTitle("Measured");
 
-    //unfold with randomized distributions
-    Unfold();
-    FillDeltaUnfoldedProfile();
+      //unfold with randomized distributions
+      Unfold();
+      FillDeltaUnfoldedProfile();
+    }
   }
 
   // Get statistical errors for final unfolded spectrum
@@ -862,3 +918,392 @@ void AliCFUnfolding::CreateFlatPrior() {
   delete [] bin;
   delete [] bins;
 }
+
+//______________________________________________________________
+
+struct AliCFUnfolding::CompactState {
+  //
+  // spectra of one unfolding on the compact representation
+  // true-space quantities are indexed by true cell, measured-space ones by measured cell,
+  // the inverse response by CSR entry. The "filled" flags tell which cells are bins
+  // of the corresponding THnSparse
+  //
+  std::vector<Double_t> fPrior;          // prior
+  std::vector<Char_t>   fPriorFilled;    // cells filled in the prior
+  std::vector<Double_t> fEfficiency;     // efficiency
+  std::vector<Double_t> fMeasured;       // measured spectrum
+  std::vector<Double_t> fEstMeasured;    // measured estimate
+  std::vector<Char_t>   fEstFilled;      // cells filled in the measured estimate
+  std::vector<Double_t> fInverse;        // inverse response
+  std::vector<Double_t> fUnfolded;       // unfolded spectrum
+  std::vector<Char_t>   fUnfoldedFilled; // cells filled in the unfolded spectrum
+};
+
+//______________________________________________________________
+
+void AliCFUnfolding::BuildCompactResponse() {
+  //
+  // Converts the conditional matrix into a compressed sparse row (CSR) structure :
+  // rows are the measured cells, columns the true cells. The cells are the
+  // coordinates used by the response matrix and the prior, numbered once here,
+  // so that the bayes iterations run as sparse matrix-vector products on plain
+  // arrays instead of coordinate lookups in the THnSparse objects
+  //
+
+  fCellCoordM.clear();
+  fCellCoordT.clear();
+  fCellIndexM.clear();
+  fCellIndexT.clear();
+
+  const Long64_t nEntries = fConditional->GetNbins();
+  std::vector<Int_t> row(nEntries);
+  std::vector<Int_t> column(nEntries);
+  for (Long64_t iBin=0; iBin<nEntries; iBin++) {
+    fConditional->GetBinContent(iBin,fCoordinates2N);
+    GetCoordinates();
+    row[iBin]    = GetCell(fCoordinatesN_M,kFALSE,kTRUE);
+    column[iBin] = GetCell(fCoordinatesN_T,kTRUE ,kTRUE);
+  }
+  // the prior bins enter the convergence criterion, they must have a cell as well
+  for (Long64_t iBin=0; iBin<fPriorOrig->GetNbins(); iBin++) {
+    fPriorOrig->GetBinContent(iBin,fCoordinatesN_T);
+    GetCell(fCoordinatesN_T,kTRUE,kTRUE);
+  }
+  for (Long64_t iBin=0; iBin<fPrior->GetNbins(); iBin++) {
+    fPrior->GetBinContent(iBin,fCoordinatesN_T);
+    GetCell(fCoordinatesN_T,kTRUE,kTRUE);
+  }
+
+  // sort the entries by measured cell
+  const Int_t nRows = fCellIndexM.size();
+  fCompactRowStart.assign(nRows+1,0);
+  for (Long64_t iBin=0; iBin<nEntries; iBin++) fCompactRowStart[row[iBin]+1]++;
+  for (Int_t iRow=0; iRow<nRows; iRow++) fCompactRowStart[iRow+1] += fCompactRowStart[iRow];
+  std::vector<Int_t> next(fCompactRowStart.begin(),fCompactRowStart.end()-1);
+  fCompactColumn.resize(nEntries);
+  fCompactCond  .resize(nEntries);
+  fCompactBin   .resize(nEntries);
+  for (Long64_t iBin=0; iBin<nEntries; iBin++) {
+    Int_t iEntry = next[row[iBin]]++;
+    fCompactColumn[iEntry] = column[iBin];
+    fCompactCond  [iEntry] = fConditional->GetBinContent(iBin);
+    fCompactBin   [iEntry] = iBin;
+  }
+
+  // cells of the original spectra used in the error calculation
+  fEfficiencyCell.resize(fEfficiencyOrig->GetNbins());
+  for (Long64_t iBin=0; iBin<fEfficiencyOrig->GetNbins(); iBin++) {
+    fEfficiencyOrig->GetBinContent(iBin,fCoordinatesN_T);
+    fEfficiencyCell[iBin] = GetCell(fCoordinatesN_T,kTRUE,kFALSE);
+  }
+  fMeasuredCell.resize(fMeasuredOrig->GetNbins());
+  for (Long64_t iBin=0; iBin<fMeasuredOrig->GetNbins(); iBin++) {
+    fMeasuredOrig->GetBinContent(iBin,fCoordinatesN_M);
+    fMeasuredCell[iBin] = GetCell(fCoordinatesN_M,kFALSE,kFALSE);
+  }
+
+  AliInfo(Form("Compact response : %lld entries, %d measured cells, %d true cells",nEntries,nRows,(Int_t)fCellIndexT.size()));
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfolding::GetCell(const Int_t* coord, Bool_t trueSpace, Bool_t add) {
+  //
+  // returns the cell number of the given coordinates in measured or true space
+  // if add is kTRUE, unknown coordinates are given a new cell, otherwise -1 is returned
+  //
+
+  Int_t firstAxis = trueSpace ? fNVariables : 0 ;
+  Long64_t globalBin = 0;
+  for (Int_t iVar=fNVariables-1; iVar>=0; iVar--) {
+    globalBin *= fResponse->GetAxis(firstAxis+iVar)->GetNbins()+2 ;
+    globalBin += coord[iVar] ;
+  }
+
+  std::map<Long64_t,Int_t>& index = trueSpace ? fCellIndexT : fCellIndexM ;
+  std::map<Long64_t,Int_t>::const_iterator it = index.find(globalBin);
+  if (it != index.end()) return it->second;
+  if (!add) return -1;
+
+  Int_t cell = index.size();
+  index[globalBin] = cell;
+  std::vector<Int_t>& coordinates = trueSpace ? fCellCoordT : fCellCoordM ;
+  coordinates.insert(coordinates.end(),coord,coord+fNVariables);
+  return cell;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::LoadSpectrum(const THnSparse* hist, Bool_t trueSpace, std::vector<Double_t>& values, std::vector<Char_t>* filled) {
+  //
+  // copies the content of a N-dim spectrum into a vector indexed by cell
+  // bins without cell (not used by the response nor the prior) are ignored
+  //
+
+  Int_t nCells = (trueSpace ? fCellCoordT.size() : fCellCoordM.size()) / fNVariables ;
+  values.assign(nCells,0.);
+  if (filled) filled->assign(nCells,0);
+
+  Int_t* coord = trueSpace ? fCoordinatesN_T : fCoordinatesN_M ;
+  for (Long64_t iBin=0; iBin<hist->GetNbins(); iBin++) {
+    Double_t value = hist->GetBinContent(iBin,coord);
+    Int_t cell = GetCell(coord,trueSpace,kFALSE);
+    if (cell<0) continue;
+    values[cell] = value;
+    if (filled) (*filled)[cell] = 1;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::StoreSpectrum(THnSparse* hist, Bool_t trueSpace, const std::vector<Double_t>& values, const std::vector<Char_t>& filled) const {
+  //
+  // replaces the content of a N-dim spectrum by the filled cells of a vector
+  // errors are set to zero, as in the iterations on the THnSparse objects
+  //
+
+  hist->Reset();
+  const std::vector<Int_t>& coordinates = trueSpace ? fCellCoordT : fCellCoordM ;
+  for (UInt_t cell=0; cell<values.size(); cell++) {
+    if (!filled[cell]) continue;
+    const Int_t* coord = &coordinates[cell*fNVariables];
+    hist->SetBinContent(coord,values[cell]);
+    hist->SetBinError  (coord,0.);
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::LoadState(CompactState& state) {
+  //
+  // copies the current prior, efficiency, measured and inverse response into the compact representation
+  //
+
+  LoadSpectrum(fPrior     ,kTRUE ,state.fPrior     ,&state.fPriorFilled);
+  LoadSpectrum(fEfficiency,kTRUE ,state.fEfficiency,0x0);
+  LoadSpectrum(fMeasured  ,kFALSE,state.fMeasured  ,0x0);
+  state.fInverse.resize(fCompactBin.size());
+  for (UInt_t iEntry=0; iEntry<fCompactBin.size(); iEntry++) state.fInverse[iEntry] = fInverseResponse->GetBinContent(fCompactBin[iEntry]);
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::StoreState(const CompactState& state) {
+  //
+  // copies the result of the iterations back into the THnSparse objects
+  //
+
+  StoreSpectrum(fPrior           ,kTRUE ,state.fPrior      ,state.fPriorFilled);
+  StoreSpectrum(fMeasuredEstimate,kFALSE,state.fEstMeasured,state.fEstFilled);
+  StoreSpectrum(fUnfolded        ,kTRUE ,state.fUnfolded   ,state.fUnfoldedFilled);
+  for (UInt_t iEntry=0; iEntry<fCompactBin.size(); iEntry++) {
+    fInverseResponse->SetBinContent(fCompactBin[iEntry],state.fInverse[iEntry]);
+    fInverseResponse->SetBinError2 (fCompactBin[iEntry],0.);
+  }
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfolding::IterateCompact(Double_t& convergence) {
+  //
+  // Bayes iterations on the compact representation of the conditional matrix :
+  // the spectra are copied once into plain arrays, iterated as sparse matrix-vector
+  // products, and copied back into the THnSparse objects at the end
+  // returns the number of iterations performed
+  //
+
+  if (fCompactRowStart.empty()) BuildCompactResponse();
+
+  CompactState state;
+  LoadState(state);
+  Int_t iIterBayes = Iterate(state,convergence,fNCalcCorrErrors==0,kTRUE);
+  if (fNCalcCorrErrors==0 && iIterBayes<fMaxNumIterations) fNRandomIterations = iIterBayes; // convergence is met
+  StoreState(state);
+  return iIterBayes;
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfolding::Iterate(CompactState& state, Double_t& convergence, Bool_t stopAtConvergence, Bool_t verbose) const {
+  //
+  // Bayes iterations on the compact representation, same as
+  // CreateEstMeasured(), CreateInvResponse(), CreateUnfolded() and GetConvergence()
+  // on the THnSparse objects :
+  //
+  // --> M(i)     = SUM_k { COND(i,k) * T(k) * E(k) }
+  // --> INV(i,j) = COND(i,j) * T(j) * E(j) / M(i)
+  // --> U(j)     = SUM_i { INV(i,j) * M_meas(i) } / E(j)
+  //
+  // Only the given state is modified, so that randomized unfoldings can run concurrently
+  // (in that case verbose must be kFALSE)
+  // returns the number of iterations performed
+  //
+
+  const Int_t nRows  = fCompactRowStart.size()-1;
+  const Int_t nCells = state.fPrior.size();
+  std::vector<Double_t> priorTimesEff(nCells);
+
+  Int_t iIterBayes = 0 ;
+
+  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
+
+    for (Int_t iCell=0; iCell<nCells; iCell++) priorTimesEff[iCell] = state.fPrior[iCell] * state.fEfficiency[iCell];
+
+    // measured estimate from prior
+    state.fEstMeasured.assign(nRows,0.);
+    state.fEstFilled  .assign(nRows,0);
+    for (Int_t iRow=0; iRow<nRows; iRow++) {
+      Double_t estMeasured = 0.;
+      for (Int_t iEntry=fCompactRowStart[iRow]; iEntry<fCompactRowStart[iRow+1]; iEntry++) {
+	Double_t fill = fCompactCond[iEntry] * priorTimesEff[fCompactColumn[iEntry]] ;
+	if (fill>0.) {
+	  estMeasured += fill;
+	  state.fEstFilled[iRow] = 1;
+	}
+      }
+      state.fEstMeasured[iRow] = estMeasured;
+    }
+
+    // inverse response from prior, and unfolded spectrum from measured and inverse response
+    state.fUnfolded      .assign(nCells,0.);
+    state.fUnfoldedFilled.assign(nCells,0);
+    for (Int_t iRow=0; iRow<nRows; iRow++) {
+      Double_t estMeasuredValue = state.fEstMeasured[iRow];
+      Double_t measuredValue    = state.fMeasured[iRow];
+      for (Int_t iEntry=fCompactRowStart[iRow]; iEntry<fCompactRowStart[iRow+1]; iEntry++) {
+	Int_t iCell = fCompactColumn[iEntry];
+	Double_t inverse = (estMeasuredValue>0. ? fCompactCond[iEntry] * priorTimesEff[iCell] / estMeasuredValue : 0.) ;
+	if (inverse>0. || state.fInverse[iEntry]>0.) state.fInverse[iEntry] = inverse;
+	Double_t effValue = state.fEfficiency[iCell];
+	Double_t fill = (effValue>0. ? state.fInverse[iEntry] * measuredValue / effValue : 0.) ;
+	if (fill>0.) {
+	  state.fUnfolded[iCell] += fill;
+	  state.fUnfoldedFilled[iCell] = 1;
+	}
+      }
+    }
+
+    // convergence criterion over the bins of the prior
+    convergence = 0.;
+    for (Int_t iCell=0; iCell<nCells; iCell++) {
+      if (!state.fPriorFilled[iCell]) continue;
+      Double_t priorValue = state.fPrior[iCell];
+      if (priorValue > 0.)
+	convergence += ((priorValue-state.fUnfolded[iCell])/priorValue)*((priorValue-state.fUnfolded[iCell])/priorValue);
+      else if (verbose)
+	AliWarning(Form("priorValue = %f. Adding 0 to convergence criterion.",priorValue));
+    }
+    if (verbose) AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes,convergence));
+
+    if (stopAtConvergence && fMaxConvergence>0. && convergence<fMaxConvergence) {
+      if (verbose) AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
+      break;
+    }
+
+    // update the prior distribution
+    state.fPrior       = state.fUnfolded;
+    state.fPriorFilled = state.fUnfoldedFilled;
+
+  } // end bayes iteration
+
+  return iIterBayes;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::RandomizedUnfolding(const CompactState& start, TRandom3& random, std::vector<Double_t>& unfolded, Int_t& nIterations, Double_t& convergence) const {
+  //
+  // One randomized unfolding of the error calculation on the compact representation :
+  // the original efficiency and measured spectra are smeared with their errors
+  // (same as CreateRandomizedDist()) and unfolded starting from the given state
+  // Only local objects and the given generator are used, so this can run on a worker thread
+  //
+
+  CompactState state(start);
+
+  state.fEfficiency.assign(state.fEfficiency.size(),0.);
+  for (Long64_t iBin=0; iBin<fEfficiencyOrig->GetNbins(); iBin++) {
+    Double_t ran = random.Gaus(fEfficiencyOrig->GetBinContent(iBin),fEfficiencyOrig->GetBinError(iBin));
+    if (fEfficiencyCell[iBin]>=0) state.fEfficiency[fEfficiencyCell[iBin]] = ran;
+  }
+  state.fMeasured.assign(state.fMeasured.size(),0.);
+  for (Long64_t iBin=0; iBin<fMeasuredOrig->GetNbins(); iBin++) {
+    Double_t ran = random.Gaus(fMeasuredOrig->GetBinContent(iBin),fMeasuredOrig->GetBinError(iBin));
+    if (fMeasuredCell[iBin]>=0) state.fMeasured[fMeasuredCell[iBin]] = ran;
+  }
+
+  nIterations = Iterate(state,convergence,kFALSE,kFALSE);
+  unfolded.swap(state.fUnfolded);
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::RunRandomizedUnfoldings() {
+  //
+  // Steps 1-4 of CalculateCorrelatedErrors() on the compact representation.
+  // Each randomized unfolding starts from the original prior and the inverse response
+  // of the nominal unfolding, and has its own random generator seeded from fRandom3.
+  // They are distributed over fNThreads threads and merged into the delta profile in
+  // their original order, so the result does not depend on the number of threads.
+  // The response matrix is not randomized : the conditional matrix used in the
+  // iterations is built only once, from the original response.
+  //
+
+  if (fCompactRowStart.empty()) BuildCompactResponse();
+
+  CompactState start;
+  LoadState(start);
+  LoadSpectrum(fPriorOrig,kTRUE,start.fPrior,&start.fPriorFilled);
+
+  const Int_t nRandom = TMath::Max(fNRandomIterations,0);
+  std::vector<TRandom3*> random(nRandom);
+  for (Int_t iRandom=0; iRandom<nRandom; iRandom++) random[iRandom] = new TRandom3(fRandom3->Integer(kMaxInt)+1);
+  std::vector<std::vector<Double_t> > unfolded(nRandom);
+  std::vector<Int_t>    nIterations(nRandom,0);
+  std::vector<Double_t> convergence(nRandom,0.);
+
+  Int_t nThreads = TMath::Min(fNThreads,nRandom);
+#if __cplusplus >= 201103L
+  if (nThreads>1) {
+    AliInfo(Form("Running %d randomized unfoldings on %d threads",nRandom,nThreads));
+    std::atomic<Int_t> nextRandom(0);
+    std::vector<std::thread> workers;
+    for (Int_t iThread=0; iThread<nThreads; iThread++) {
+      workers.emplace_back([&]() {
+	for (Int_t iRandom=nextRandom++; iRandom<nRandom; iRandom=nextRandom++)
+	  RandomizedUnfolding(start,*random[iRandom],unfolded[iRandom],nIterations[iRandom],convergence[iRandom]);
+      });
+    }
+    for (auto& worker : workers) worker.join();
+  }
+  else
+#else
+  if (nThreads>1) AliWarning("Multi-threaded error calculation needs C++11, running on a single thread");
+#endif
+  for (Int_t iRandom=0; iRandom<nRandom; iRandom++) {
+    RandomizedUnfolding(start,*random[iRandom],unfolded[iRandom],nIterations[iRandom],convergence[iRandom]);
+  }
+
+  // fill the delta profile, see FillDeltaUnfoldedProfile()
+  for (Long64_t iBin=0; iBin<fUnfoldedFinal->GetNbins(); iBin++) {
+    Double_t finalValue   = fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_T);
+    Int_t    cell         = GetCell(fCoordinatesN_T,kTRUE,kFALSE);
+    Double_t mean         = fDeltaUnfoldedP->GetBinContent(fCoordinatesN_T);
+    Double_t meanx2       = fDeltaUnfoldedP->GetBinError  (fCoordinatesN_T);
+    Double_t entriesInBin = fDeltaUnfoldedN->GetBinContent(fCoordinatesN_T);
+    for (Int_t iRandom=0; iRandom<nRandom; iRandom++) {
+      Double_t deltaInBin = finalValue - (cell>=0 ? unfolded[iRandom][cell] : 0.);
+      mean   = (mean  *entriesInBin + deltaInBin           ) / (entriesInBin+1) ;
+      meanx2 = (meanx2*entriesInBin + deltaInBin*deltaInBin) / (entriesInBin+1) ;
+      entriesInBin++;
+    }
+    fDeltaUnfoldedP->SetBinError  (fCoordinatesN_T,meanx2) ;
+    fDeltaUnfoldedP->SetBinContent(fCoordinatesN_T,mean) ;
+    fDeltaUnfoldedN->SetBinContent(fCoordinatesN_T,entriesInBin);
+  }
+
+  for (Int_t iRandom=0; iRandom<nRandom; iRandom++) {
+    AliInfo(Form("=======================\nUnfolding of randomized distribution finished at iteration %d with convergence %e \n",nIterations[iRandom],convergence[iRandom]));
+    delete random[iRandom];
+  }
+}
@@ -10,6 +10,8 @@
 // Author : renaud.vernet@cern.ch                                     //
 //--------------------------------------------------------------------//
 
+#include <map>
+#include <vector>
 #include "TNamed.h"
 #include "THnSparse.h"
 #include "AliLog.h"
@@ -36,6 +38,7 @@ class AliCFUnfolding : public TNamed {
   }
 
   void SetNRandomIterations(Int_t n = 100) {fNRandomIterations = n;};
+  void SetNumberOfThreads(Int_t n = 1) {fNThreads = n;}  // threads used for the randomized unfoldings of the error calculation (C++11 builds only)
 
   void UseSmoothing(TF1* fcn=0x0, Option_t* opt="iremn") { // if fcn=0x0 then smooth using neighbouring bins 
     fUseSmoothing=kTRUE;                                   // this function must NOT be used if fNVariables > 3
@@ -111,6 +114,19 @@ class AliCFUnfolding : public TNamed {
   THnSparse     *fDeltaUnfoldedN;    // Entries of the delta-unfolded distribution (count for each bin)
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
+  Int_t          fNThreads;          // Number of threads for the randomized unfoldings
+
+  /* compressed sparse row (CSR) representation of the conditional matrix, see BuildCompactResponse() */
+  std::vector<Int_t>       fCompactRowStart; //! first entry of each measured cell (row), size = number of measured cells + 1
+  std::vector<Int_t>       fCompactColumn;   //! true cell (column) of each entry
+  std::vector<Double_t>    fCompactCond;     //! P(M|T) of each entry
+  std::vector<Long64_t>    fCompactBin;      //! bin of each entry in fConditional and fInverseResponse
+  std::vector<Int_t>       fCellCoordM;      //! coordinates of the measured cells (fNVariables per cell)
+  std::vector<Int_t>       fCellCoordT;      //! coordinates of the true cells (fNVariables per cell)
+  std::map<Long64_t,Int_t> fCellIndexM;      //! global bin number -> measured cell
+  std::map<Long64_t,Int_t> fCellIndexT;      //! global bin number -> true cell
+  std::vector<Int_t>       fEfficiencyCell;  //! true cell of each bin of fEfficiencyOrig (-1 if not used)
+  std::vector<Int_t>       fMeasuredCell;    //! measured cell of each bin of fMeasuredOrig (-1 if not used)
 
 
   // functions
@@ -132,7 +148,23 @@ class AliCFUnfolding : public TNamed {
   void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
   void     SetMaxConvergencePerDOF (Double_t val);
 
-  ClassDef(AliCFUnfolding,1);
+  /* unfolding on the compact representation (used when no smoothing is requested) */
+  Int_t    IterateSparse(Double_t& convergence);  // bayes iterations on the THnSparse objects, returns -1 if smoothing failed
+  Int_t    IterateCompact(Double_t& convergence); // bayes iterations on the compact representation
+  void     BuildCompactResponse();                // converts the conditional matrix into CSR format
+  Int_t    GetCell(const Int_t* coord, Bool_t trueSpace, Bool_t add); // cell index of given coordinates
+  void     LoadSpectrum(const THnSparse* hist, Bool_t trueSpace, std::vector<Double_t>& values, std::vector<Char_t>* filled);
+  void     StoreSpectrum(THnSparse* hist, Bool_t trueSpace, const std::vector<Double_t>& values, const std::vector<Char_t>& filled) const;
+  void     RunRandomizedUnfoldings();             // randomized unfoldings of the error calculation, possibly in parallel
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+  struct   CompactState;
+  void     LoadState(CompactState& state);
+  void     StoreState(const CompactState& state);
+  Int_t    Iterate(CompactState& state, Double_t& convergence, Bool_t stopAtConvergence, Bool_t verbose) const;
+  void     RandomizedUnfolding(const CompactState& start, TRandom3& random, std::vector<Double_t>& unfolded, Int_t& nIterations, Double_t& convergence) const;
+#endif
+
+  ClassDef(AliCFUnfolding,2);
 };
 
 #endif
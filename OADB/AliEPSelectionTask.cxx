@@ -104,7 +104,17 @@ AliAnalysisTaskSE(),
   fHOutNTEPRes(0),
   fHOutPTPsi(0),
   fHOutDiff(0),
-  fHOutleadPTPsi(0)
+  fHOutleadPTPsi(0),
+  fTrackList(0),
+  fTrackQx(),
+  fTrackQy(),
+  fTrackPhiWeight(),
+  fTrackPhi(),
+  fTrackPt(),
+  fTrackEta(),
+  fTrackCharge(),
+  fTrackID(),
+  fTrackSubevent()
 {
   // Default constructor
   AliInfo("Event Plane Selection enabled.");
@@ -113,6 +123,8 @@ AliAnalysisTaskSE(),
   }
   for(Int_t i = 0; i < 2; ++i) {
      fQDist[i] = 0;
+     fQMean[i] = 0;
+     fQRms[i] = 1;
   }
 }
 
@@ -155,7 +167,17 @@ AliEPSelectionTask::AliEPSelectionTask(const char *name):
   fHOutNTEPRes(0),
   fHOutPTPsi(0),
   fHOutDiff(0),
-  fHOutleadPTPsi(0)
+  fHOutleadPTPsi(0),
+  fTrackList(0),
+  fTrackQx(),
+  fTrackQy(),
+  fTrackPhiWeight(),
+  fTrackPhi(),
+  fTrackPt(),
+  fTrackEta(),
+  fTrackCharge(),
+  fTrackID(),
+  fTrackSubevent()
 {
   // Default constructor
   AliInfo("Event Plane Selection enabled.");
@@ -165,6 +187,8 @@ AliEPSelectionTask::AliEPSelectionTask(const char *name):
   }
   for(Int_t i = 0; i < 2; ++i) {
      fQDist[i] = 0;
+     fQMean[i] = 0;
+     fQRms[i] = 1;
   }
 }
 
@@ -199,6 +223,10 @@ AliEPSelectionTask::~AliEPSelectionTask()
       }
       if(fHruns) delete fHruns;
   }
+  if (fTrackList){
+      delete fTrackList;
+      fTrackList = 0;
+  }
   if(fQDist[0] && fQDist[1]) {
     for(Int_t i = 0; i < 2; i++) {
       if(fQDist[i]){
@@ -286,19 +314,27 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 	esdEP->GetQContributionYArraysub2()->Set(esd->GetNumberOfTracks());
       }
 
-      TObjArray* tracklist = new TObjArray;
+      TObjArray* tracklist = 0;
       if (fTrackType.CompareTo("GLOBAL")==0) tracklist = fESDtrackCuts->GetAcceptedTracks(esd,kFALSE);
       if (fTrackType.CompareTo("TPC")==0 && fPeriod.CompareTo("LHC10h")==0) tracklist = fESDtrackCuts->GetAcceptedTracks(esd,kTRUE);
       else if (fTrackType.CompareTo("TPC")==0 && fPeriod.CompareTo("LHC11h")==0) tracklist = GetTracksForLHC11h(esd);
+      // the lists of the track cuts are created per event, fTrackList is reused
+      if (!tracklist) {
+	if (!fTrackList) fTrackList = new TObjArray;
+	fTrackList->Clear();
+	tracklist = fTrackList;
+      }
       const int nt = tracklist->GetEntries();
 
       if (nt>4){
 
+	// weights and harmonics of all tracks, computed once
+	const Int_t ntracks = FillTrackHarmonics(tracklist);
 	// qvector full event
-	fQVector = new TVector2(GetQ(esdEP,tracklist));
+	fQVector = new TVector2(SumQ(esdEP));
 	fEventplaneQ = fQVector->Phi()/2;
 	// q vector subevents
-	GetQsub(qq1, qq2, tracklist, esdEP);
+	SumQsub(qq1, qq2, esdEP);
 	fQsub1 = new TVector2(qq1);
 	fQsub2 = new TVector2(qq2);
 	fQsubRes = (fQsub1->Phi()/2 - fQsub2->Phi()/2);
@@ -314,27 +350,25 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 
 	if (fUseMCRP) fHOutDiff->Fill(fEventplaneQ, fRP);
 
-	for (int iter = 0; iter<nt;iter++){
-	  AliESDtrack* track = dynamic_cast<AliESDtrack*> (tracklist->At(iter));
-	  if (track) {
-	    float delta = track->Phi()-fEventplaneQ;
-	    while (delta < 0) delta += TMath::Pi();
-	    while (delta > TMath::Pi()) delta -= TMath::Pi();
-	    fHOutPTPsi->Fill(track->Pt(),delta);
-	    fHOutPhi->Fill(track->Phi());
-	    fHOutPhiCorr->Fill(track->Phi(),GetPhiWeight(track));
-          }
-	}
-
 	AliESDtrack* trmax = esd->GetTrack(0);
-	for (int iter = 1; iter<nt;iter++){
-	  AliESDtrack* track = dynamic_cast<AliESDtrack*> (tracklist->At(iter));
-	  if (track && (track->Pt() > trmax->Pt())) trmax = track;
+	Double_t maxPt = trmax->Pt();
+	Double_t maxPhi = trmax->Phi();
+	for (int iter = 0; iter<ntracks;iter++){
+	  float delta = fTrackPhi[iter]-fEventplaneQ;
+	  while (delta < 0) delta += TMath::Pi();
+	  while (delta > TMath::Pi()) delta -= TMath::Pi();
+	  fHOutPTPsi->Fill(fTrackPt[iter],delta);
+	  fHOutPhi->Fill(fTrackPhi[iter]);
+	  fHOutPhiCorr->Fill(fTrackPhi[iter],fTrackPhiWeight[iter]);
+	  if (iter > 0 && fTrackPt[iter] > maxPt) {
+	    maxPt = fTrackPt[iter];
+	    maxPhi = fTrackPhi[iter];
+	  }
 	}
-	fHOutleadPTPsi->Fill(trmax->Phi(),fEventplaneQ);
+	fHOutleadPTPsi->Fill(maxPhi,fEventplaneQ);
       }
       tracklist->Clear();
-      delete tracklist;
+      if (tracklist != fTrackList) delete tracklist;
       tracklist = 0;
     }
   }
@@ -388,11 +422,13 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 
       if (NT>4){
 
+	// weights and harmonics of all tracks, computed once
+	const Int_t ntracks = FillTrackHarmonics(tracklist);
 	// qvector full event
-	fQVector = new TVector2(GetQ(esdEP,tracklist));
+	fQVector = new TVector2(SumQ(esdEP));
 	fEventplaneQ = fQVector->Phi()/2;
 	// q vector subevents
-	GetQsub(qq1, qq2, tracklist, esdEP);
+	SumQsub(qq1, qq2, esdEP);
 	fQsub1 = new TVector2(qq1);
 	fQsub2 = new TVector2(qq2);
 	fQsubRes = (fQsub1->Phi()/2 - fQsub2->Phi()/2);
@@ -408,27 +444,25 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 
 	if (fUseMCRP) fHOutDiff->Fill(fEventplaneQ, fRP);
 
-	for (int iter = 0; iter<NT;iter++){
-	  AliAODTrack* track = dynamic_cast<AliAODTrack*> (tracklist->At(iter));
-	  if (track) {
-	    float delta = track->Phi()-fEventplaneQ;
-	    while (delta < 0) delta += TMath::Pi();
-	    while (delta > TMath::Pi()) delta -= TMath::Pi();
-	    fHOutPTPsi->Fill(track->Pt(),delta);
-	    fHOutPhi->Fill(track->Phi());
-	    fHOutPhiCorr->Fill(track->Phi(),GetPhiWeight(track));
-	  }
-	}
-
 	AliAODTrack* trmax = dynamic_cast<AliAODTrack*>(aod->GetTrack(0));
 	if(!trmax) AliFatal("Not a standard AOD");
-	for (int iter = 1; iter<NT;iter++){
-	  AliAODTrack* track = dynamic_cast<AliAODTrack*> (tracklist->At(iter));
-	  if (track && (track->Pt() > trmax->Pt())) trmax = track;
+	Double_t maxPt = trmax->Pt();
+	Double_t maxPhi = trmax->Phi();
+	for (int iter = 0; iter<ntracks;iter++){
+	  float delta = fTrackPhi[iter]-fEventplaneQ;
+	  while (delta < 0) delta += TMath::Pi();
+	  while (delta > TMath::Pi()) delta -= TMath::Pi();
+	  fHOutPTPsi->Fill(fTrackPt[iter],delta);
+	  fHOutPhi->Fill(fTrackPhi[iter]);
+	  fHOutPhiCorr->Fill(fTrackPhi[iter],fTrackPhiWeight[iter]);
+	  if (iter > 0 && fTrackPt[iter] > maxPt) {
+	    maxPt = fTrackPt[iter];
+	    maxPhi = fTrackPhi[iter];
+	  }
 	}
-	fHOutleadPTPsi->Fill(trmax->Phi(),fEventplaneQ);
+	fHOutleadPTPsi->Fill(maxPhi,fEventplaneQ);
       }
-      delete tracklist;
+      tracklist->Clear();
       tracklist = 0;
     }
 
@@ -453,168 +487,169 @@ void AliEPSelectionTask::Terminate(Option_t */*option*/)
 TVector2 AliEPSelectionTask::GetQ(AliEventplane* EP, TObjArray* tracklist)
 {
   // Get the Q vector
-  TVector2 mQ;
-  float mQx=0, mQy=0;
-  AliVTrack* track;
-  Double_t weight;
-  Int_t idtemp = -1;
+  FillTrackHarmonics(tracklist);
+  return SumQ(EP);
+}
+
+  //________________________________________________________________________
+void AliEPSelectionTask::GetQsub(TVector2 &Q1, TVector2 &Q2, TObjArray* tracklist,AliEventplane* EP)
+{
+  // Get Qsub
+  FillTrackHarmonics(tracklist);
+  SumQsub(Q1, Q2, EP);
+}
+
+//__________________________________________________________________________
+Int_t AliEPSelectionTask::FillTrackHarmonics(TObjArray* tracklist)
+{
+  // Computes the weight and the second harmonic of each track once per event,
+  // the Q vectors, the subevents and the track contributions are summed from these arrays
   // get recentering values
-  Double_t mean[2], rms[2];
-  Recenter(0, mean);
-  Recenter(1, rms);
+  Recenter(0, fQMean);
+  Recenter(1, fQRms);
+
+  // the integrals of the phi distributions are the same for all tracks
+  Double_t nParticles[4];
+  for (Int_t i = 0; i < 4; i++) nParticles[i] = (fUsePhiWeight && fPhiDist[i]) ? fPhiDist[i]->Integral() : 0;
+
+  const Bool_t negativeID = (fAnalysisInput.CompareTo("AOD")==0) && (fAODfilterbit == 128);
+
+  fTrackQx.clear();
+  fTrackQy.clear();
+  fTrackPhiWeight.clear();
+  fTrackPhi.clear();
+  fTrackPt.clear();
+  fTrackEta.clear();
+  fTrackCharge.clear();
+  fTrackID.clear();
 
   int nt = tracklist->GetEntries();
+  for (int i=0; i<nt; i++){
+    AliVTrack* track = dynamic_cast<AliVTrack*> (tracklist->At(i));
+    if (!track) continue;
+
+    Double_t phi = track->Phi();
+    Double_t pt  = track->Pt();
+
+    Double_t phiweight = 1;
+    TH1F *phiDist = SelectPhiDist(track);
+    if (fUsePhiWeight && phiDist) {
+      Int_t idist = 0;
+      while (idist < 3 && fPhiDist[idist] != phiDist) idist++;
+      phiweight = GetPhiWeight(track, phiDist, nParticles[idist]);
+    }
+    Double_t ptweight = 1;
+    if (fUsePtWeight) ptweight = (pt < 2) ? pt : 2;
+    Double_t weight = ptweight*phiweight;
+
+    Int_t idtemp = track->GetID();
+    if (negativeID) idtemp = idtemp*(-1) - 1;
+
+    fTrackQx.push_back(weight*cos(2*phi)/fQRms[0]);
+    fTrackQy.push_back(weight*sin(2*phi)/fQRms[1]);
+    fTrackPhiWeight.push_back(phiweight);
+    fTrackPhi.push_back(phi);
+    fTrackPt.push_back(pt);
+    fTrackEta.push_back(track->Eta());
+    fTrackCharge.push_back(track->Charge());
+    fTrackID.push_back(idtemp);
+  }
+  return fTrackQx.size();
+}
 
+//__________________________________________________________________________
+TVector2 AliEPSelectionTask::SumQ(AliEventplane* EP)
+{
+  // Q vector of the full event from the arrays of FillTrackHarmonics
+  TVector2 mQ;
+  float mQx=0, mQy=0;
+
+  TArrayF* contributionX = fSaveTrackContribution ? EP->GetQContributionXArray() : 0;
+  TArrayF* contributionY = fSaveTrackContribution ? EP->GetQContributionYArray() : 0;
+
+  int nt = fTrackQx.size();
   for (int i=0; i<nt; i++){
-    weight = 1;
-    track = dynamic_cast<AliVTrack*> (tracklist->At(i));
-    if (track) {
-      weight = GetWeight(track);
     if (fSaveTrackContribution){
-      idtemp = track->GetID();
-      if ((fAnalysisInput.CompareTo("AOD")==0) && (fAODfilterbit == 128)) idtemp = idtemp*(-1) - 1;
-      EP->GetQContributionXArray()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-      EP->GetQContributionYArray()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-     }
-     mQx += (weight*cos(2*track->Phi())/rms[0]);
-     mQy += (weight*sin(2*track->Phi())/rms[1]);
+      contributionX->AddAt(fTrackQx[i],fTrackID[i]);
+      contributionY->AddAt(fTrackQy[i],fTrackID[i]);
     }
+    mQx += fTrackQx[i];
+    mQy += fTrackQy[i];
   }
-  mQ.Set(mQx-(mean[0]/rms[0]), mQy-(mean[1]/rms[1]));
+  mQ.Set(mQx-(fQMean[0]/fQRms[0]), mQy-(fQMean[1]/fQRms[1]));
   return mQ;
 }
 
-  //________________________________________________________________________
-void AliEPSelectionTask::GetQsub(TVector2 &Q1, TVector2 &Q2, TObjArray* tracklist,AliEventplane* EP)
+//__________________________________________________________________________
+void AliEPSelectionTask::SumQsub(TVector2 &Q1, TVector2 &Q2, AliEventplane* EP)
 {
-  // Get Qsub
+  // Q vectors of the subevents from the arrays of FillTrackHarmonics
   TVector2 mQ[2];
   float mQx1=0, mQy1=0, mQx2=0, mQy2=0;
-  Double_t weight;
-  // get recentering values
-  Double_t mean[2], rms[2];
-  Recenter(0, mean);
-  Recenter(1, rms);
 
-  AliVTrack* track;
-  TRandom2 rn = 0;
+  TArrayF* contributionX1 = fSaveTrackContribution ? EP->GetQContributionXArraysub1() : 0;
+  TArrayF* contributionY1 = fSaveTrackContribution ? EP->GetQContributionYArraysub1() : 0;
+  TArrayF* contributionX2 = fSaveTrackContribution ? EP->GetQContributionXArraysub2() : 0;
+  TArrayF* contributionY2 = fSaveTrackContribution ? EP->GetQContributionYArraysub2() : 0;
 
-  int nt = tracklist->GetEntries();
-  int trackcounter1=0, trackcounter2=0;
-  int idtemp = 0;
+  int nt = fTrackQx.size();
+
+  // subevent of each track: 1, 2 or 0 for none
+  std::vector<Char_t>& subevent = fTrackSubevent;
+  subevent.assign(nt, 0);
 
   if (fSplitMethod == AliEPSelectionTask::kRandom){
+    TRandom2 rn = 0;
+    int trackcounter1=0, trackcounter2=0;
 
     for (Int_t i = 0; i < nt; i++) {
-      weight = 1;
-      track = dynamic_cast<AliVTrack*> (tracklist->At(i));
-      if (!track) continue;
-      weight = GetWeight(track);
-      idtemp = track->GetID();
-      if ((fAnalysisInput.CompareTo("AOD")==0) && (fAODfilterbit == 128)) idtemp = idtemp*(-1) - 1;
-
       // This loop splits the track set into 2 random subsets
       if( trackcounter1 < int(nt/2.) && trackcounter2 < int(nt/2.)){
         float random = rn.Rndm();
-        if(random < .5){
-          mQx1 += (weight*cos(2*track->Phi())/rms[0]);
-          mQy1 += (weight*sin(2*track->Phi())/rms[1]);
-          if (fSaveTrackContribution){
-            EP->GetQContributionXArraysub1()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-            EP->GetQContributionYArraysub1()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-          }
-          trackcounter1++;
-        }
-        else {
-          mQx2 += (weight*cos(2*track->Phi())/rms[0]);
-          mQy2 += (weight*sin(2*track->Phi())/rms[1]);
-          if (fSaveTrackContribution){
-            EP->GetQContributionXArraysub2()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-            EP->GetQContributionYArraysub2()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-          }
-          trackcounter2++;
-        }
-      }
-      else if( trackcounter1 >= int(nt/2.)){
-        mQx2 += (weight*cos(2*track->Phi())/rms[0]);
-        mQy2 += (weight*sin(2*track->Phi())/rms[1]);
-        if (fSaveTrackContribution){
-          EP->GetQContributionXArraysub2()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-          EP->GetQContributionYArraysub2()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-        }
-        trackcounter2++;
-      }
-      else {
-        mQx1 += (weight*cos(2*track->Phi())/rms[0]);
-        mQy1 += (weight*sin(2*track->Phi())/rms[1]);
-        if (fSaveTrackContribution){
-          EP->GetQContributionXArraysub1()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-          EP->GetQContributionYArraysub1()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-        }
-        trackcounter1++;
+        if(random < .5) subevent[i] = 1;
+        else            subevent[i] = 2;
       }
+      else if( trackcounter1 >= int(nt/2.)) subevent[i] = 2;
+      else                                  subevent[i] = 1;
+
+      if (subevent[i] == 1) trackcounter1++;
+      else                  trackcounter2++;
     }
   } else if (fSplitMethod == AliEPSelectionTask::kEta) {
-
     for (Int_t i = 0; i < nt; i++) {
-      weight = 1;
-      track = dynamic_cast<AliVTrack*> (tracklist->At(i));
-      if (!track) continue;
-      weight = GetWeight(track);
-      Double_t eta = track->Eta();
-      idtemp = track->GetID();
-      if ((fAnalysisInput.CompareTo("AOD")==0) && (fAODfilterbit == 128)) idtemp = idtemp*(-1) - 1;
-
-      if (eta > fEtaGap/2.) {
-        mQx1 += (weight*cos(2*track->Phi())/rms[0]);
-        mQy1 += (weight*sin(2*track->Phi())/rms[1]);
-        if (fSaveTrackContribution){
-          EP->GetQContributionXArraysub1()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-          EP->GetQContributionYArraysub1()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-        }
-      } else if (eta < -1.*fEtaGap/2.) {
-        mQx2 += (weight*cos(2*track->Phi())/rms[0]);
-        mQy2 += (weight*sin(2*track->Phi())/rms[1]);
-        if (fSaveTrackContribution){
-          EP->GetQContributionXArraysub2()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-          EP->GetQContributionYArraysub2()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-        }
-      }
+      if (fTrackEta[i] > fEtaGap/2.)          subevent[i] = 1;
+      else if (fTrackEta[i] < -1.*fEtaGap/2.) subevent[i] = 2;
     }
   } else if (fSplitMethod == AliEPSelectionTask::kCharge) {
-
     for (Int_t i = 0; i < nt; i++) {
-      weight = 1;
-      track = dynamic_cast<AliVTrack*> (tracklist->At(i));
-      if (!track) continue;
-      weight = GetWeight(track);
-      Short_t cha = track->Charge();
-      idtemp = track->GetID();
-      if ((fAnalysisInput.CompareTo("AOD")==0) && (fAODfilterbit == 128)) idtemp = idtemp*(-1) - 1;
-
-      if (cha > 0) {
-        mQx1 += (weight*cos(2*track->Phi())/rms[0]);
-        mQy1 += (weight*sin(2*track->Phi())/rms[1]);
-        if (fSaveTrackContribution){
-          EP->GetQContributionXArraysub1()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-          EP->GetQContributionYArraysub1()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-        }
-      } else if (cha < 0) {
-        mQx2 += (weight*cos(2*track->Phi())/rms[0]);
-        mQy2 += (weight*sin(2*track->Phi())/rms[1]);
-        if (fSaveTrackContribution){
-          EP->GetQContributionXArraysub2()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-          EP->GetQContributionYArraysub2()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-        }
-      }
+      if (fTrackCharge[i] > 0)      subevent[i] = 1;
+      else if (fTrackCharge[i] < 0) subevent[i] = 2;
     }
   } else {
     printf("plane resolution determination method not available!\n\n ");
     return;
   }
+
+  for (Int_t i = 0; i < nt; i++) {
+    if (subevent[i] == 1) {
+      mQx1 += fTrackQx[i];
+      mQy1 += fTrackQy[i];
+      if (fSaveTrackContribution){
+        contributionX1->AddAt(fTrackQx[i],fTrackID[i]);
+        contributionY1->AddAt(fTrackQy[i],fTrackID[i]);
+      }
+    } else if (subevent[i] == 2) {
+      mQx2 += fTrackQx[i];
+      mQy2 += fTrackQy[i];
+      if (fSaveTrackContribution){
+        contributionX2->AddAt(fTrackQx[i],fTrackID[i]);
+        contributionY2->AddAt(fTrackQy[i],fTrackID[i]);
+      }
+    }
+  }
   // apply recenetering
-  mQ[0].Set(mQx1-(mean[0]/rms[0]), mQy1-(mean[1]/rms[1]));
-  mQ[1].Set(mQx2-(mean[0]/rms[0]), mQy2-(mean[1]/rms[1]));
+  mQ[0].Set(mQx1-(fQMean[0]/fQRms[0]), mQy1-(fQMean[1]/fQRms[1]));
+  mQ[1].Set(mQx2-(fQMean[0]/fQRms[0]), mQy2-(fQMean[1]/fQRms[1]));
   Q1 = mQ[0];
   Q2 = mQ[1];
 }
@@ -690,25 +725,25 @@ Double_t AliEPSelectionTask::GetWeight(TObject* track1)
 //________________________________________________________________________
 Double_t AliEPSelectionTask::GetPhiWeight(TObject* track1)
 {
-  Double_t phiweight=1;
   AliVTrack* track = dynamic_cast<AliVTrack*>(track1);
 
   TH1F *phiDist = 0x0;
   if(track) phiDist = SelectPhiDist(track);
 
-  if (fUsePhiWeight && phiDist && track) {
-    Double_t nParticles = phiDist->Integral();
-    Double_t nPhibins = phiDist->GetNbinsX();
-
-    Double_t Phi = track->Phi();
+  if (fUsePhiWeight && phiDist && track) return GetPhiWeight(track, phiDist, phiDist->Integral());
+  return 1;
+}
 
-    while (Phi<0) Phi += TMath::TwoPi();
-    while (Phi>TMath::TwoPi()) Phi -= TMath::TwoPi();
+//________________________________________________________________________
+Double_t AliEPSelectionTask::GetPhiWeight(AliVTrack* track, TH1F* phiDist, Double_t nParticles) const
+{
+  // phi weight of the track from the given phi distribution with nParticles entries
+  Double_t phiweight=1;
+  Double_t nPhibins = phiDist->GetNbinsX();
 
-    Double_t PhiDistValue = phiDist->GetBinContent(1+TMath::FloorNint((track->Phi())*nPhibins/TMath::TwoPi()));
+  Double_t PhiDistValue = phiDist->GetBinContent(1+TMath::FloorNint((track->Phi())*nPhibins/TMath::TwoPi()));
 
-    if (PhiDistValue > 0) phiweight = nParticles/nPhibins/PhiDistValue;
-  }
+  if (PhiDistValue > 0) phiweight = nParticles/nPhibins/PhiDistValue;
   return phiweight;
 }
 
@@ -871,7 +906,11 @@ void AliEPSelectionTask::SetPersonalPhiDistribution(const char* infilename, char
 //_________________________________________________________________________
 TObjArray* AliEPSelectionTask::GetAODTracksAndMaxID(AliAODEvent* aod, Int_t& maxid)
 {
-  TObjArray *acctracks = new TObjArray();
+  // fills the reused fTrackList, which does not own the AOD tracks
+  if (!fTrackList) fTrackList = new TObjArray();
+  fTrackList->SetOwner(kFALSE);
+  fTrackList->Clear();
+  TObjArray *acctracks = fTrackList;
 
   AliAODTrack *tr = 0;
   Int_t maxid1 = 0;
@@ -986,8 +1025,11 @@ TH1F* AliEPSelectionTask::SelectPhiDist(AliVTrack *track)
 TObjArray* AliEPSelectionTask::GetTracksForLHC11h(AliESDEvent* esd)
 {
   // Need to do this hack beacuse only this type of TPC only tracks in AOD is available and one type of Phi-weights is used
-  TObjArray *acctracks = new TObjArray();
-  acctracks->SetOwner(kTRUE);
+  // fills the reused fTrackList, which owns the TPC only tracks until the end of the event
+  if (!fTrackList) fTrackList = new TObjArray();
+  fTrackList->SetOwner(kTRUE);
+  fTrackList->Clear();
+  TObjArray *acctracks = fTrackList;
 
   const AliESDVertex *vtxSPD = esd->GetPrimaryVertexSPD();
 
@@ -9,6 +9,8 @@
 //   author: Alberica Toia, Johanna Gramling
 //*****************************************************
 
+#include <vector>
+
 #include "AliAnalysisTaskSE.h"
 
 class TFile;
@@ -73,6 +75,10 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
   void SetOADBandPeriod();
   TH1F* SelectPhiDist(AliVTrack *track);
   TObjArray* GetTracksForLHC11h(AliESDEvent* esd);
+  Double_t GetPhiWeight(AliVTrack* track, TH1F* phiDist, Double_t nParticles) const;
+  Int_t FillTrackHarmonics(TObjArray* tracklist);
+  TVector2 SumQ(AliEventplane* EP);
+  void SumQsub(TVector2& Q1, TVector2& Q2, AliEventplane* EP);
 
   TString  fAnalysisInput; 		// "ESD", "AOD"
   TString  fTrackType;			// "GLOBAL", "TPC"
@@ -119,7 +125,20 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
   TH2F*	 fHOutDiff;			//! control histogram: Difference of MC RP and EP - only filled if fUseMCRP is true!
   TH2F*  fHOutleadPTPsi;		//! control histogram: emission angle of leading pT track vs EP angle
 
-  ClassDef(AliEPSelectionTask,4); 
+  TObjArray* fTrackList;		//! reused list of accepted tracks (AOD, LHC11h TPC only tracks)
+  Double_t fQMean[2];			//! recentering mean of the current event
+  Double_t fQRms[2];			//! recentering rms of the current event
+  std::vector<Double_t> fTrackQx;	//! weighted cos(2 phi)/rms of each accepted track
+  std::vector<Double_t> fTrackQy;	//! weighted sin(2 phi)/rms of each accepted track
+  std::vector<Double_t> fTrackPhiWeight;//! phi weight of each accepted track
+  std::vector<Double_t> fTrackPhi;	//! phi of each accepted track
+  std::vector<Double_t> fTrackPt;	//! pT of each accepted track
+  std::vector<Double_t> fTrackEta;	//! eta of each accepted track
+  std::vector<Short_t>  fTrackCharge;	//! charge of each accepted track
+  std::vector<Int_t>    fTrackID;	//! index of each accepted track in the Q contribution arrays
+  std::vector<Char_t>   fTrackSubevent;	//! subevent of each accepted track, 0 if in none
+
+  ClassDef(AliEPSelectionTask,5); 
 };
 
 #endif
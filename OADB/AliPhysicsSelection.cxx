@@ -76,12 +76,10 @@
 #include <TPRegexp.h>
 #include <TParameter.h>
 #include <TInterpreter.h>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
 
-#if ROOT_VERSION_CODE >= ROOT_VERSION(6,3,0)
-#include <v5/TFormula.h>
-#else
-#include <TFormula.h>
-#endif
 
 #include "AliPhysicsSelection.h"
 
@@ -127,8 +125,22 @@ fHistStat(0),
 fPSOADB(0),
 fFillOADB(0),
 fTriggerOADB(0),
-fRegexp(new TPRegexp("([[:alpha:]]\\w*)")),
-fCashedTokens(NULL)
+fCashedTokens(NULL),
+fLogicOffset(),
+fLogicCode(),
+fLogicConstants(),
+fLogicValues(),
+fLogicStack(),
+fUseTriggerClassMask(kFALSE),
+fRowRequirement(),
+fRowReturnCode(),
+fRowTriggerLogic(),
+fRequirementType(),
+fRequirementBC(),
+fRequirementMask(),
+fRequirementMaskNext50(),
+fRequirementName(),
+fRequirementNames()
 {
   // constructor
   fCollTrigClasses.SetOwner(1);
@@ -157,8 +169,22 @@ fCashedTokens(NULL)
  fPSOADB(0),
  fFillOADB(0),
  fTriggerOADB(0),
- fRegexp(new TPRegexp("([[:alpha:]]\\w*)")),
- fCashedTokens(NULL)
+ fCashedTokens(NULL),
+ fLogicOffset(),
+ fLogicCode(),
+ fLogicConstants(),
+ fLogicValues(),
+ fLogicStack(),
+ fUseTriggerClassMask(kFALSE),
+ fRowRequirement(),
+ fRowReturnCode(),
+ fRowTriggerLogic(),
+ fRequirementType(),
+ fRequirementBC(),
+ fRequirementMask(),
+ fRequirementMaskNext50(),
+ fRequirementName(),
+ fRequirementNames()
  {
    // constructor
    fCollTrigClasses.SetOwner(1);
@@ -173,64 +199,131 @@ AliPhysicsSelection::~AliPhysicsSelection(){
   if (fPSOADB)       delete fPSOADB;
   if (fFillOADB)     delete fFillOADB;
   if (fTriggerOADB)  delete fTriggerOADB;
-  delete fRegexp;
   delete fCashedTokens;
 }
 
-UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const {
-  // checks if the given trigger class(es) are found for the current event
+namespace {
+  // requirements of a trigger class row, see CheckTriggerClass
+  enum ETriggerClassRequirement { kRequireClass = 0, kRejectClass, kBunchCrossing };
+  const Int_t kNTriggerClassBits = 100; // trigger classes covered by GetTriggerMask and GetTriggerMaskNext50
+}
+
+//______________________________________________________________________________
+void AliPhysicsSelection::InitializeTriggerClasses(const AliVEvent* event){
+  // splits the trigger class rows into their requirements, called for the first event of each run
+  // and resolves the class names to the trigger class indices of the run, if the trigger configuration is available (ESD)
+  fRowRequirement.clear();
+  fRowReturnCode.clear();
+  fRowTriggerLogic.clear();
+  fRequirementType.clear();
+  fRequirementBC.clear();
+  fRequirementMask.clear();
+  fRequirementMaskNext50.clear();
+  fRequirementName.clear();
+  fRequirementNames.clear();
+  
+  std::vector<TString> runClasses;
+  if (event && event->GetDataLayoutType()==AliVEvent::kESD) {
+    const AliESDRun* esdRun = ((const AliESDEvent*) event)->GetESDRun();
+    for (Int_t i=0; esdRun && i<kNTriggerClassBits; i++) {
+      const char* name = esdRun->GetTriggerClass(i);
+      runClasses.push_back(name ? name : "");
+    }
+  }
+  fUseTriggerClassMask = kFALSE;
+  for (UInt_t i=0; i<runClasses.size(); i++)
+    if (!runClasses[i].IsNull()) fUseTriggerClassMask = kTRUE;
+  
+  Int_t nColl = fCollTrigClasses.GetEntries();
+  Int_t nBG   = fBGTrigClasses.GetEntries();
+  for (Int_t row=0; row<nColl+nBG; row++) {
+    const char* trigger = row<nColl ? fCollTrigClasses.At(row)->GetName() : fBGTrigClasses.At(row-nColl)->GetName();
+    fRowRequirement.push_back(fRequirementType.size());
+    UInt_t returnCode = AliVEvent::kUserDefined;
+    Int_t triggerLogic = 0;
+    
+    TString str(trigger);
+    TObjArray* tokens = str.Tokenize(" ");
+    for (Int_t i=0; i < tokens->GetEntries(); i++) {
+      TString str2(((TObjString*) tokens->At(i))->String());
+      if (str2[0] == '+' || str2[0] == '-') {
+        fRequirementType.push_back(str2[0] == '+' ? kRequireClass : kRejectClass);
+        fRequirementBC.push_back(-1);
+        fRequirementName.push_back(fRequirementNames.size());
+        str2.Remove(0, 1);
+        ULong64_t mask = 0;
+        ULong64_t maskNext50 = 0;
+        TObjArray* tokens2 = str2.Tokenize(",");
+        for (Int_t j=0; j < tokens2->GetEntries(); j++) {
+          TString str3(((TObjString*) tokens2->At(j))->String());
+          fRequirementNames.push_back(str3);
+          // same substring matching as on the fired trigger classes
+          for (UInt_t k=0; k<runClasses.size(); k++) {
+            if (runClasses[k].IsNull() || !runClasses[k].Contains(str3)) continue;
+            if (k < 50) mask       |= (1ull << k);
+            else        maskNext50 |= (1ull << (k-50));
+          }
+        }
+        delete tokens2;
+        fRequirementMask.push_back(mask);
+        fRequirementMaskNext50.push_back(maskNext50);
+      }
+      else if (str2[0] == '#') {
+        str2.Remove(0, 1);
+        fRequirementType.push_back(kBunchCrossing);
+        fRequirementBC.push_back(str2.Atoi());
+        fRequirementName.push_back(fRequirementNames.size());
+        fRequirementMask.push_back(0);
+        fRequirementMaskNext50.push_back(0);
+      }
+      else if (str2[0] == '&') { str2.Remove(0, 1); returnCode = str2.Atoll();  }
+      else if (str2[0] == '*') { str2.Remove(0, 1); triggerLogic = str2.Atoi(); }
+      else AliFatal(Form("Invalid trigger syntax: %s", trigger));
+    }
+    delete tokens;
+    
+    fRowReturnCode.push_back(returnCode);
+    fRowTriggerLogic.push_back(triggerLogic);
+  }
+  fRowRequirement.push_back(fRequirementType.size());
+  fRequirementName.push_back(fRequirementNames.size());
+  
+  AliInfo(Form("Prepared %d trigger class rows, matching %s", nColl+nBG, fUseTriggerClassMask ? "trigger class masks" : "fired trigger class names"));
+}
+
+//______________________________________________________________________________
+UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, Int_t row, Int_t& triggerLogic) const {
+  // checks if the trigger class(es) of the given row of fCollTrigClasses + fBGTrigClasses are found for the current event
   // format of trigger: +TRIGGER1,TRIGGER1b,TRIGGER1c -TRIGGER2 [#XXX] [&YY] [*ZZ]
   //   requires one out of TRIGGER1,TRIGGER1b,TRIGGER1c and rejects TRIGGER2
   //   in bunch crossing XXX
   //   if successful, YY is returned (for association between entry in fCollTrigClasses and AliVEvent::EOfflineTriggerTypes)
   //   triggerLogic is filled with ZZ, defaults to 0
+  // The rows are split in InitializeTriggerClasses; the class requirements are tested on the trigger mask
+  // if the class names of the run are known, otherwise on the fired trigger class names
   
-  TString classes = event->GetFiredTriggerClasses();
+  ULong64_t firedMask = 0;
+  ULong64_t firedMaskNext50 = 0;
+  TString classes;
+  if (fUseTriggerClassMask) {
+    firedMask       = event->GetTriggerMask();
+    firedMaskNext50 = event->GetTriggerMaskNext50();
+  } else {
+    classes = event->GetFiredTriggerClasses();
+  }
   
   Bool_t foundBCRequirement = kFALSE;
   Bool_t foundCorrectBC = kFALSE;
   
-  UInt_t returnCode = AliVEvent::kUserDefined;
-  triggerLogic = 0;
+  triggerLogic = fRowTriggerLogic[row];
   
   AliDebug(AliLog::kDebug+1, Form("Processing event with triggers %s", event->GetFiredTriggerClasses().Data()));
   
-  TString str(trigger);
-  TObjArray* tokens = str.Tokenize(" ");
-  
-  for (Int_t i=0; i < tokens->GetEntries(); i++) {
-    TString str2(((TObjString*) tokens->At(i))->String());
-    if (str2[0] == '+' || str2[0] == '-') {
-      Bool_t flag = (str2[0] == '+');
-      str2.Remove(0, 1);
-      TObjArray* tokens2 = str2.Tokenize(",");
-      Bool_t foundTriggerClass = kFALSE;
-      for (Int_t j=0; j < tokens2->GetEntries(); j++) {
-        TString str3(((TObjString*) tokens2->At(j))->String());
-        if (flag && classes.Contains(str3)) foundTriggerClass = kTRUE;
-        if (!flag && classes.Contains(str3)) {
-          AliDebug(AliLog::kDebug+1, Form("Rejecting event because trigger class %s is present", str3.Data()));
-          delete tokens2;
-          delete tokens;
-          return kFALSE;
-        }
-      }
-      
-      delete tokens2;
-      
-      if (flag && !foundTriggerClass) {
-        AliDebug(AliLog::kDebug+1, Form("Rejecting event because (none of the) trigger class(es) %s is present", str2.Data()));
-        delete tokens;
-        return kFALSE;
-      }
-    }
-    else if (str2[0] == '#')
-    {
+  for (Int_t i=fRowRequirement[row]; i<fRowRequirement[row+1]; i++) {
+    if (fRequirementType[i] == kBunchCrossing) {
       foundBCRequirement = kTRUE;
       
-      str2.Remove(0, 1);
-      
-      Int_t bcNumber = str2.Atoi();
+      Int_t bcNumber = fRequirementBC[i];
       AliDebug(AliLog::kDebug+1, Form("Checking for bunch crossing number %d", bcNumber));
       
       if (event->GetBunchCrossNumber() == bcNumber)
@@ -238,74 +331,253 @@ UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char
         foundCorrectBC = kTRUE;
         AliDebug(AliLog::kDebug+1, Form("Found correct bunch crossing %d", bcNumber));
       }
+      continue;
+    }
+    
+    Bool_t flag = (fRequirementType[i] == kRequireClass);
+    Bool_t foundTriggerClass = kFALSE;
+    if (fUseTriggerClassMask) {
+      foundTriggerClass = (firedMask & fRequirementMask[i]) || (firedMaskNext50 & fRequirementMaskNext50[i]);
+    } else {
+      for (Int_t j=fRequirementName[i]; j<fRequirementName[i+1] && !foundTriggerClass; j++)
+        if (classes.Contains(fRequirementNames[j])) foundTriggerClass = kTRUE;
+    }
+    
+    if (!flag && foundTriggerClass) {
+      AliDebug(AliLog::kDebug+1, Form("Rejecting event because trigger class %s is present", fRequirementNames[fRequirementName[i]].Data()));
+      return kFALSE;
+    }
+    if (flag && !foundTriggerClass) {
+      AliDebug(AliLog::kDebug+1, Form("Rejecting event because (none of the) trigger class(es) %s is present", fRequirementNames[fRequirementName[i]].Data()));
+      return kFALSE;
     }
-    else if (str2[0] == '&') { str2.Remove(0, 1); returnCode = str2.Atoll();  }
-    else if (str2[0] == '*') { str2.Remove(0, 1); triggerLogic = str2.Atoi(); }
-    else AliFatal(Form("Invalid trigger syntax: %s", trigger));
   }
   
-  delete tokens;
-  
   if (foundBCRequirement && !foundCorrectBC) return kFALSE;
   
-  return returnCode;
+  return fRowReturnCode[row];
 }
 
-//______________________________________________________________________________
-Bool_t AliPhysicsSelection::EvaluateTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, const char* triggerLogic, Bool_t offline){
-  // evaluates trigger logic. If called with no event pointer/triggerAnalysis pointer, it just caches the tokens
-  // Fills the statistics histogram, if booked at row i
-  TString trigger(triggerLogic);
-  
-  // add space after each token (to use ReplaceAll later)
-  fRegexp->Substitute(trigger, "$1 ", "g");
-  
-  while (1) {
-    AliDebug(AliLog::kDebug, trigger.Data());
-    
-    TArrayI pos;
-    Int_t nMatches = fRegexp->Match(trigger, "", 0, 2, &pos);
-    
-    if (nMatches <= 0) break;
-    
-    TString token(trigger(pos[0], pos[1]-pos[0]+1));
+namespace {
+  // opcodes of the compiled trigger logic, evaluated in postfix order
+  enum ETriggerLogicOp { kOpConstant = 0, kOpToken, kOpNot, kOpMinus,
+                         kOpOr, kOpAnd, kOpEqual, kOpNotEqual, kOpLess, kOpLessEqual, kOpGreater, kOpGreaterEqual,
+                         kOpAdd, kOpSubtract, kOpMultiply, kOpDivide };
 
-    TParameter<Int_t>* param = dynamic_cast<TParameter<Int_t> *>(fCashedTokens->FindObject(token));
-    if (!param) {
-      TInterpreter::EErrorCode error;
-      Int_t bit = gInterpreter->ProcessLine(Form("AliTriggerAnalysis::k%s;", token.Data()), &error);
-      
-      if (error > 0) AliFatal(Form("Trigger token %s unknown", token.Data()));
-      
-      param = new TParameter<Int_t>(token, bit);
-      fCashedTokens->Add(param);
-      AliDebug(AliLog::kDebug, "Added token");
+  // recursive descent parser for the trigger logic expressions, e.g. "(SPDGFO >= 1 || V0A || V0C) && !V0ABG"
+  // operator precedence as in C/TFormula: || < && < ==,!= < <,<=,>,>= < +,- < *,/ < unary !,-
+  class TriggerLogicParser {
+  public:
+    TriggerLogicParser(const char* logic) : fOps(), fConstants(), fTokens(), fLogic(logic ? logic : ""), fPos(0), fOk(kTRUE) {}
+
+    Bool_t Parse() {
+      SkipSpaces();
+      if (!fLogic[fPos]) return kFALSE;
+      ParseOr();
+      SkipSpaces();
+      return fOk && !fLogic[fPos];
     }
+
+    std::vector<Int_t>    fOps;       // (opcode, argument) pairs in postfix order
+    std::vector<Double_t> fConstants; // numeric constants, argument of kOpConstant
+    std::vector<TString>  fTokens;    // distinct trigger tokens in order of appearance, argument of kOpToken
+
+  private:
+    void SkipSpaces() { while (fLogic[fPos] == ' ' || fLogic[fPos] == '\t') fPos++; }
+    Bool_t Accept(const char* op) {
+      SkipSpaces();
+      size_t len = strlen(op);
+      if (strncmp(fLogic + fPos, op, len) != 0) return kFALSE;
+      fPos += len;
+      return kTRUE;
+    }
+    void Emit(Int_t op, Int_t arg = 0) { fOps.push_back(op); fOps.push_back(arg); }
+
+    void ParseOr()  { ParseAnd(); while (fOk && Accept("||")) { ParseAnd(); Emit(kOpOr); } }
+    void ParseAnd() { ParseEquality(); while (fOk && Accept("&&")) { ParseEquality(); Emit(kOpAnd); } }
+    void ParseEquality() {
+      ParseRelational();
+      while (fOk) {
+        if      (Accept("==")) { ParseRelational(); Emit(kOpEqual); }
+        else if (Accept("!=")) { ParseRelational(); Emit(kOpNotEqual); }
+        else break;
+      }
+    }
+    void ParseRelational() {
+      ParseAdditive();
+      while (fOk) {
+        if      (Accept("<=")) { ParseAdditive(); Emit(kOpLessEqual); }
+        else if (Accept(">=")) { ParseAdditive(); Emit(kOpGreaterEqual); }
+        else if (Accept("<"))  { ParseAdditive(); Emit(kOpLess); }
+        else if (Accept(">"))  { ParseAdditive(); Emit(kOpGreater); }
+        else break;
+      }
+    }
+    void ParseAdditive() {
+      ParseMultiplicative();
+      while (fOk) {
+        if      (Accept("+")) { ParseMultiplicative(); Emit(kOpAdd); }
+        else if (Accept("-")) { ParseMultiplicative(); Emit(kOpSubtract); }
+        else break;
+      }
+    }
+    void ParseMultiplicative() {
+      ParseUnary();
+      while (fOk) {
+        if      (Accept("*")) { ParseUnary(); Emit(kOpMultiply); }
+        else if (Accept("/")) { ParseUnary(); Emit(kOpDivide); }
+        else break;
+      }
+    }
+    void ParseUnary() {
+      SkipSpaces();
+      if (fLogic[fPos] == '!' && fLogic[fPos+1] != '=') { fPos++; ParseUnary(); Emit(kOpNot); }
+      else if (Accept("-")) { ParseUnary(); Emit(kOpMinus); }
+      else if (Accept("+")) { ParseUnary(); }
+      else ParsePrimary();
+    }
+    void ParsePrimary() {
+      SkipSpaces();
+      const char c = fLogic[fPos];
+      if (c == '(') {
+        fPos++;
+        ParseOr();
+        if (!Accept(")")) fOk = kFALSE;
+      } else if (isdigit(c) || c == '.') {
+        char* end = 0;
+        Double_t value = strtod(fLogic + fPos, &end);
+        if (end == fLogic + fPos) { fOk = kFALSE; return; }
+        fPos = end - fLogic;
+        Emit(kOpConstant, fConstants.size());
+        fConstants.push_back(value);
+      } else if (isalpha(c)) {
+        size_t begin = fPos;
+        while (isalnum(fLogic[fPos]) || fLogic[fPos] == '_') fPos++;
+        TString token(fLogic + begin, fPos - begin);
+        Int_t index = 0;
+        while (index < (Int_t) fTokens.size() && fTokens[index] != token) index++;
+        if (index == (Int_t) fTokens.size()) fTokens.push_back(token);
+        Emit(kOpToken, index);
+      } else {
+        fOk = kFALSE;
+      }
+    }
+
+    const char* fLogic; // expression
+    size_t fPos;        // current position in fLogic
+    Bool_t fOk;         // kFALSE after a syntax error
+  };
+}
+
+//______________________________________________________________________________
+Int_t AliPhysicsSelection::GetTriggerToken(const TString& token){
+  // returns the AliTriggerAnalysis::Trigger value of the given token, looked up once through the interpreter
+  TParameter<Int_t>* param = dynamic_cast<TParameter<Int_t> *>(fCashedTokens->FindObject(token));
+  if (!param) {
+    TInterpreter::EErrorCode error;
+    Int_t bit = gInterpreter->ProcessLine(Form("AliTriggerAnalysis::k%s;", token.Data()), &error);
     
-    Long64_t bit = param->GetVal();
-    
-    AliDebug(AliLog::kDebug, Form("Tok %d %d %s %lld", pos[0], pos[1], token.Data(), bit));
+    if (error > 0) AliFatal(Form("Trigger token %s unknown", token.Data()));
     
+    param = new TParameter<Int_t>(token, bit);
+    fCashedTokens->Add(param);
+    AliDebug(AliLog::kDebug, Form("Added token %s %d", token.Data(), bit));
+  }
+  return param->GetVal();
+}
+
+//______________________________________________________________________________
+Int_t AliPhysicsSelection::CompileTriggerLogic(Int_t triggerLogic, Bool_t offline){
+  // compiles the online or offline trigger logic ZZ of the current run and returns its offset in fLogicCode
+  // layout: number of tokens, trigger bit of each token, number of operations, (opcode, argument) pairs
+  // The programs are reset in Initialize, so each logic is parsed once per run
+  if (triggerLogic < 0 || triggerLogic >= NTRIGGERLOGICS)
+    AliFatal(Form("Invalid trigger logic %d", triggerLogic));
+  
+  Int_t& offset = fLogicOffset[2*triggerLogic + (offline ? 1 : 0)];
+  if (offset >= 0) return offset;
+  
+  TString logic = offline ? fPSOADB->GetOfflineTrigger(triggerLogic) : fPSOADB->GetHardwareTrigger(triggerLogic);
+  TriggerLogicParser parser(logic.Data());
+  if (!parser.Parse())
+    AliFatal(Form("Could not evaluate trigger logic %s", logic.Data()));
+  
+  offset = fLogicCode.size();
+  Int_t nTokens = parser.fTokens.size();
+  fLogicCode.push_back(nTokens);
+  for (Int_t i=0; i<nTokens; i++) {
+    Int_t bit = GetTriggerToken(parser.fTokens[i]);
     if (offline) 
       bit |= AliTriggerAnalysis::kOfflineFlag;
-    
-    if(event && triggerAnalysis) {
-      trigger.ReplaceAll(token, Form("%d", triggerAnalysis->EvaluateTrigger(event, (AliTriggerAnalysis::Trigger) bit)));
+    fLogicCode.push_back(bit);
+  }
+  
+  Int_t constantOffset = fLogicConstants.size();
+  fLogicConstants.insert(fLogicConstants.end(), parser.fConstants.begin(), parser.fConstants.end());
+  
+  Int_t nOps = parser.fOps.size()/2;
+  fLogicCode.push_back(nOps);
+  for (Int_t i=0; i<nOps; i++) {
+    Int_t op  = parser.fOps[2*i];
+    Int_t arg = parser.fOps[2*i+1];
+    fLogicCode.push_back(op);
+    fLogicCode.push_back(op == kOpConstant ? arg + constantOffset : arg);
+  }
+  
+  if ((Int_t) fLogicValues.size() < nTokens) fLogicValues.resize(nTokens);
+  if ((Int_t) fLogicStack.size()  < nOps)    fLogicStack.resize(nOps);
+  
+  AliDebug(AliLog::kDebug, Form("Compiled trigger logic %s with %d tokens and %d operations", logic.Data(), nTokens, nOps));
+  
+  return offset;
+}
+
+//______________________________________________________________________________
+Bool_t AliPhysicsSelection::EvaluateTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, Int_t triggerLogic, Bool_t offline){
+  // evaluates the online or offline trigger logic ZZ, compiled once per run
+  // each distinct token is evaluated exactly once per call, also if the result is already determined,
+  // as AliTriggerAnalysis fills its control histograms while evaluating the triggers
+  const Int_t* code = &fLogicCode[CompileTriggerLogic(triggerLogic, offline)];
+  
+  Int_t nTokens = *code++;
+  for (Int_t i=0; i<nTokens; i++)
+    fLogicValues[i] = triggerAnalysis->EvaluateTrigger(event, (AliTriggerAnalysis::Trigger) code[i]);
+  code += nTokens;
+  
+  Int_t nOps = *code++;
+  Double_t* stack = nOps > 0 ? &fLogicStack[0] : 0;
+  Int_t n = 0;
+  for (Int_t i=0; i<nOps; i++, code += 2) {
+    const Int_t arg = code[1];
+    switch (code[0]) {
+      case kOpConstant:     stack[n++] = fLogicConstants[arg]; break;
+      case kOpToken:        stack[n++] = fLogicValues[arg];    break;
+      case kOpNot:          stack[n-1] = (stack[n-1] == 0);    break;
+      case kOpMinus:        stack[n-1] = -stack[n-1];          break;
+      default: {
+        const Double_t b = stack[--n];
+        Double_t& a = stack[n-1];
+        switch (code[0]) {
+          case kOpOr:           a = (a != 0 || b != 0); break;
+          case kOpAnd:          a = (a != 0 && b != 0); break;
+          case kOpEqual:        a = (a == b);           break;
+          case kOpNotEqual:     a = (a != b);           break;
+          case kOpLess:         a = (a <  b);           break;
+          case kOpLessEqual:    a = (a <= b);           break;
+          case kOpGreater:      a = (a >  b);           break;
+          case kOpGreaterEqual: a = (a >= b);           break;
+          case kOpAdd:          a += b;                 break;
+          case kOpSubtract:     a -= b;                 break;
+          case kOpMultiply:     a *= b;                 break;
+          case kOpDivide:       a = (b == 0) ? 0 : a/b; break;
+        }
+      }
     }
   }
   
-#if ROOT_VERSION_CODE >= ROOT_VERSION(6,3,0)
-  // In case of ROOT6 it is necessary to stay for the moment with the v5 version of TFormula
-  // as the v6 version produces a large amount of warnings at runtime.
-  ROOT::v5::TFormula formula("formula",trigger);
-#else
-  TFormula formula("formula", trigger);
-#endif
-  if (formula.Compile() > 0)
-    AliFatal(Form("Could not evaluate trigger logic %s (evaluated to %s)", triggerLogic, trigger.Data()));
-  Bool_t result = formula.Eval(0);
+  Bool_t result = (n == 1 && stack[0] != 0);
   
-  AliDebug(AliLog::kDebug, Form("%s --> %d", trigger.Data(), result));
+  AliDebug(AliLog::kDebug, Form("trigger logic %d (%s) --> %d", triggerLogic, offline ? "offline" : "online", result));
   
   return result;
 }
@@ -326,6 +598,8 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
     if (eventType != 7) return kFALSE;
   }
   
+  if (fRowRequirement.empty()) InitializeTriggerClasses(event);
+  
   UInt_t accept = 0;
   Int_t nColl = fCollTrigClasses.GetEntries();
   Int_t nBG   = fBGTrigClasses.GetEntries();
@@ -337,10 +611,10 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
     triggerAnalysis->FillTriggerClasses(event);
     
     Int_t triggerLogic = 0;
-    UInt_t singleTriggerResult = CheckTriggerClass(event, triggerClass, triggerLogic);
+    UInt_t singleTriggerResult = CheckTriggerClass(event, i, triggerLogic);
     if (!singleTriggerResult) continue;
-    Bool_t onlineDecision  = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetHardwareTrigger(triggerLogic), kFALSE);
-    Bool_t offlineDecision = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetOfflineTrigger(triggerLogic), kTRUE);
+    Bool_t onlineDecision  = EvaluateTriggerLogic(event, triggerAnalysis, triggerLogic, kFALSE);
+    Bool_t offlineDecision = EvaluateTriggerLogic(event, triggerAnalysis, triggerLogic, kTRUE);
     triggerAnalysis->FillHistograms(event,onlineDecision,offlineDecision);
     if (!onlineDecision) continue;
     if (!offlineDecision) continue;
@@ -515,6 +789,14 @@ Bool_t AliPhysicsSelection::Initialize(Int_t runNumber){
     fCashedTokens->SetOwner();
   }
   
+  // the trigger logics of this run are compiled on first use
+  fLogicOffset.assign(2*NTRIGGERLOGICS, -1);
+  fLogicCode.clear();
+  fLogicConstants.clear();
+  
+  // the trigger class rows are prepared with the first event of the run
+  fRowRequirement.clear();
+  
   fCurrentRun = runNumber;
 
   TH1::AddDirectory(oldStatus);
@@ -16,6 +16,7 @@
 //           Michele Floris, CERN
 //-------------------------------------------------------------------------
 
+#include <vector>
 #include <AliAnalysisCuts.h>
 #include <TList.h>
 #include "TObjString.h"
@@ -33,7 +34,6 @@ class AliAnalysisTaskSE;
 class AliOADBPhysicsSelection;
 class AliOADBFillingScheme;
 class AliOADBTriggerAnalysis;
-class TPRegexp;
 
 class AliPhysicsSelection : public AliAnalysisCuts{
 public:
@@ -86,8 +86,11 @@ public:
   void ReadOCDB(Bool_t val) { fReadOCDB=val; }
   Bool_t IsMC() const { return fMC; }
 protected:
-  UInt_t CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const;
-  Bool_t EvaluateTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, const char* triggerLogic, Bool_t offline);
+  UInt_t CheckTriggerClass(const AliVEvent* event, Int_t row, Int_t& triggerLogic) const;
+  void InitializeTriggerClasses(const AliVEvent* event);
+  Bool_t EvaluateTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, Int_t triggerLogic, Bool_t offline);
+  Int_t CompileTriggerLogic(Int_t triggerLogic, Bool_t offline);
+  Int_t GetTriggerToken(const TString& token);
   const char * GetTriggerString(TObjString * obj);
 
   TString fPassName;          // pass name for current run
@@ -108,10 +111,26 @@ protected:
   AliOADBFillingScheme*    fFillOADB;    // Filling scheme OADB object
   AliOADBTriggerAnalysis*  fTriggerOADB; // Trigger analysis OADB object
 
-  TPRegexp* fRegexp;        //! regular expression for trigger tokens
   TList* fCashedTokens;     //! trigger token lookup list
 
-  ClassDef(AliPhysicsSelection, 22)
+  std::vector<Int_t>    fLogicOffset;    //! offset of the compiled trigger logic in fLogicCode, per logic and online/offline, -1 if not compiled
+  std::vector<Int_t>    fLogicCode;      //! compiled trigger logics: token bits followed by postfix (opcode, argument) pairs
+  std::vector<Double_t> fLogicConstants; //! numeric constants of the compiled trigger logics
+  std::vector<Double_t> fLogicValues;    //! scratch buffer with the token values of the current event
+  std::vector<Double_t> fLogicStack;     //! scratch evaluation stack
+
+  Bool_t                 fUseTriggerClassMask;   //! class requirements are tested on the trigger mask instead of the fired class names
+  std::vector<Int_t>     fRowRequirement;        //! first requirement of each trigger class row, followed by the end marker
+  std::vector<UInt_t>    fRowReturnCode;         //! &YY of each trigger class row
+  std::vector<Int_t>     fRowTriggerLogic;       //! *ZZ of each trigger class row
+  std::vector<Int_t>     fRequirementType;       //! required classes, rejected classes or bunch crossing
+  std::vector<Int_t>     fRequirementBC;         //! bunch crossing number of a bunch crossing requirement
+  std::vector<ULong64_t> fRequirementMask;       //! trigger classes 0-49 of the run matching a class requirement
+  std::vector<ULong64_t> fRequirementMaskNext50; //! trigger classes 50-99 of the run matching a class requirement
+  std::vector<Int_t>     fRequirementName;       //! first class name of each requirement in fRequirementNames, followed by the end marker
+  std::vector<TString>   fRequirementNames;      //! class names of the class requirements
+
+  ClassDef(AliPhysicsSelection, 23)
 private:
   AliPhysicsSelection(const AliPhysicsSelection&);
   AliPhysicsSelection& operator=(const AliPhysicsSelection&);
@@ -47,6 +47,7 @@
 #include "AliVCaloTrigger.h"
 #include "AliAODTZERO.h"
 #include "AliAODEvent.h"
+#include "AliAnalysisManager.h"
 ClassImp(AliTriggerAnalysis)
 
 AliTriggerAnalysis::AliTriggerAnalysis(TString name) :
@@ -112,7 +113,17 @@ fHistFMDSum(0),
 fHistT0(0),
 fHistOFOvsTKLAcc(0),
 fHistV0MOnVsOfAcc(0),
-fTriggerClasses(new TMap)
+fTriggerClasses(new TMap),
+fCachedEvent(0),
+fCachedRun(-1),
+fCachedPeriod(0),
+fCachedOrbit(0),
+fCachedBC(0),
+fCachedEventInFile(-1),
+fCachedEntry(-1),
+fCacheGeneration(0),
+fCacheStamp(3*kStartOfFlags, 0),
+fCacheValue(3*kStartOfFlags, 0)
 {
   // constructor
   fHistList->SetName("histos");
@@ -173,6 +184,7 @@ void AliTriggerAnalysis::SetParameters(AliOADBTriggerAnalysis* oadb){
   fTRDmaxSectorHEE      = oadb->GetTRDmaxSectorHEE();
   fTRDptHJT             = oadb->GetTRDptHJT();
   fTRDnHJT              = oadb->GetTRDnHJT();
+  ResetEventCache();
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -427,6 +439,21 @@ Bool_t AliTriggerAnalysis::IsTriggerBitFired(const AliVEvent* event, ULong64_t t
 Int_t AliTriggerAnalysis::EvaluateTrigger(const AliVEvent* event, Trigger trigger){
   // evaluates a given trigger
   // trigger combinations are not supported, for that see IsOfflineTriggerFired
+  // the decision is computed once per event and trigger code, see UpdateEventCache
+  UInt_t triggerNoFlags = (UInt_t) trigger % (UInt_t) kStartOfFlags;
+  UInt_t index = triggerNoFlags + ((trigger & kOfflineFlag) ? kStartOfFlags : 0);
+  UpdateEventCache(event);
+  if (fCacheStamp[index] != fCacheGeneration) {
+    fCacheValue[index] = ComputeTrigger(event, trigger);
+    fCacheStamp[index] = fCacheGeneration;
+  }
+  return fCacheValue[index];
+}
+
+
+//-------------------------------------------------------------------------------------------------
+Int_t AliTriggerAnalysis::ComputeTrigger(const AliVEvent* event, Trigger trigger){
+  // evaluates a given trigger without the event cache
 
   UInt_t triggerNoFlags = (UInt_t) trigger % (UInt_t) kStartOfFlags;
   Bool_t offline = trigger & kOfflineFlag;
@@ -552,16 +579,33 @@ Int_t AliTriggerAnalysis::EvaluateTrigger(const AliVEvent* event, Trigger trigge
 //-------------------------------------------------------------------------------------------------
 Bool_t AliTriggerAnalysis::IsOfflineTriggerFired(const AliVEvent* event, Trigger trigger){
   // checks if an event has been triggered "offline"
+  // the decision is computed once per event and trigger code, see UpdateEventCache
   UInt_t triggerNoFlags = (UInt_t) trigger % (UInt_t) kStartOfFlags;
   if (trigger & kOneParticle) AliError("AliTriggerAnalysis::kOneParticle functionality is obsolete");
   if (trigger & kOneTrack)    AliError("AliTriggerAnalysis::kOneTrack functionality is obsolete");
 
+  UInt_t index = triggerNoFlags + 2*kStartOfFlags;
+  UpdateEventCache(event);
+  if (fCacheStamp[index] != fCacheGeneration) {
+    fCacheValue[index] = ComputeOfflineTrigger(event, trigger);
+    fCacheStamp[index] = fCacheGeneration;
+  }
+  return fCacheValue[index];
+}
+
+
+//-------------------------------------------------------------------------------------------------
+Bool_t AliTriggerAnalysis::ComputeOfflineTrigger(const AliVEvent* event, Trigger trigger){
+  // checks if an event has been triggered "offline" without the event cache
+  // combinations are built from the cached single triggers
+  UInt_t triggerNoFlags = (UInt_t) trigger % (UInt_t) kStartOfFlags;
+
   Bool_t decision = kFALSE;
   switch (triggerNoFlags) {
     case kAcceptAll:        return kTRUE; 
-    case kMB1:              return SPDGFOTrigger(event, 0) ||  V0Trigger(event, kASide, kFALSE) == kV0BB || V0Trigger(event, kCSide, kFALSE) == kV0BB;
-    case kMB2:              return SPDGFOTrigger(event, 0) && (V0Trigger(event, kASide, kFALSE) == kV0BB || V0Trigger(event, kCSide, kFALSE) == kV0BB);
-    case kMB3:              return SPDGFOTrigger(event, 0) &&  V0Trigger(event, kASide, kFALSE) == kV0BB && V0Trigger(event, kCSide, kFALSE) == kV0BB;
+    case kMB1:              return IsOfflineTriggerFired(event, kSPDGFO) ||  IsOfflineTriggerFired(event, kV0A) || IsOfflineTriggerFired(event, kV0C);
+    case kMB2:              return IsOfflineTriggerFired(event, kSPDGFO) && (IsOfflineTriggerFired(event, kV0A) || IsOfflineTriggerFired(event, kV0C));
+    case kMB3:              return IsOfflineTriggerFired(event, kSPDGFO) &&  IsOfflineTriggerFired(event, kV0A) && IsOfflineTriggerFired(event, kV0C);
     case kSPDGFO:           return SPDGFOTrigger(event, 0);
     case kSPDGFOBits:       return SPDGFOTrigger(event, 1);
     case kV0MOnVsOfPileup:  return IsV0MOnVsOfPileup(event);
@@ -576,13 +620,13 @@ Bool_t AliTriggerAnalysis::IsOfflineTriggerFired(const AliVEvent* event, Trigger
     case kADCBG:            return ADTrigger(event, kCSide, kFALSE) == kADBG;
     case kV0A:              return V0Trigger(event, kASide, kFALSE) == kV0BB;
     case kV0C:              return V0Trigger(event, kCSide, kFALSE) == kV0BB;
-    case kV0OR:             return V0Trigger(event, kASide, kFALSE) == kV0BB || V0Trigger(event, kCSide, kFALSE) == kV0BB;
-    case kV0AND:            return V0Trigger(event, kASide, kFALSE) == kV0BB && V0Trigger(event, kCSide, kFALSE) == kV0BB;
+    case kV0OR:             return IsOfflineTriggerFired(event, kV0A) || IsOfflineTriggerFired(event, kV0C);
+    case kV0AND:            return IsOfflineTriggerFired(event, kV0A) && IsOfflineTriggerFired(event, kV0C);
     case kV0ABG:            return V0Trigger(event, kASide, kFALSE) == kV0BG;
     case kV0CBG:            return V0Trigger(event, kCSide, kFALSE) == kV0BG;
     case kV0M:              return V0MTrigger(event,kFALSE);
     case kTKL:              return TKLTrigger(event);
-    case kZDC:              return ZDCTrigger(event, kASide) || ZDCTrigger(event, kCentralBarrel) || ZDCTrigger(event, kCSide);
+    case kZDC:              return IsOfflineTriggerFired(event, kZDCA) || ZDCTrigger(event, kCentralBarrel) || IsOfflineTriggerFired(event, kZDCC);
     case kZDCA:             return ZDCTrigger(event, kASide);
     case kZDCC:             return ZDCTrigger(event, kCSide);
     case kZNA:              return ZDCTDCTrigger(event,kASide,kTRUE,kFALSE,kFALSE);
@@ -602,19 +646,19 @@ Bool_t AliTriggerAnalysis::IsOfflineTriggerFired(const AliVEvent* event, Trigger
     case kTRDHSE:           return TRDTrigger(event,kTRDHSE);
     case kTRDHQU:           return TRDTrigger(event,kTRDHQU);
     case kTRDHEE:           return TRDTrigger(event,kTRDHEE);
-    case kNSD1:             return SPDFiredChips(event, 0) >= 5 || (V0Trigger(event, kASide, kFALSE) == kV0BB && V0Trigger(event, kCSide, kFALSE) == kV0BB);
-    case kFPANY:            decision |= SPDGFOTrigger(event, 0); 
-                            decision |= V0Trigger(event, kASide, kFALSE) == kV0BB;
-                            decision |= V0Trigger(event, kCSide, kFALSE) == kV0BB;
-                            decision |= ZDCTrigger(event, kASide);
+    case kNSD1:             return EvaluateTrigger(event, (Trigger) (kSPDGFO | kOfflineFlag)) >= 5 || (IsOfflineTriggerFired(event, kV0A) && IsOfflineTriggerFired(event, kV0C));
+    case kFPANY:            decision |= IsOfflineTriggerFired(event, kSPDGFO); 
+                            decision |= IsOfflineTriggerFired(event, kV0A);
+                            decision |= IsOfflineTriggerFired(event, kV0C);
+                            decision |= IsOfflineTriggerFired(event, kZDCA);
                             decision |= ZDCTrigger(event, kCentralBarrel);
-                            decision |= ZDCTrigger(event, kCSide);
-                            decision |= FMDTrigger(event, kASide);
-                            decision |= FMDTrigger(event, kCSide);
+                            decision |= IsOfflineTriggerFired(event, kZDCC);
+                            decision |= IsOfflineTriggerFired(event, kFMDA);
+                            decision |= IsOfflineTriggerFired(event, kFMDC);
                             return decision; 
-    case kMB1Prime:         decision |= SPDGFOTrigger(event, 0) && V0Trigger(event, kASide, kFALSE) == kV0BB;
-                            decision |= SPDGFOTrigger(event, 0) && V0Trigger(event, kCSide, kFALSE) == kV0BB;
-                            decision |= V0Trigger(event, kASide, kFALSE) == kV0BB && V0Trigger(event, kCSide, kFALSE) == kV0BB;
+    case kMB1Prime:         decision |= IsOfflineTriggerFired(event, kSPDGFO) && IsOfflineTriggerFired(event, kV0A);
+                            decision |= IsOfflineTriggerFired(event, kSPDGFO) && IsOfflineTriggerFired(event, kV0C);
+                            decision |= IsOfflineTriggerFired(event, kV0A) && IsOfflineTriggerFired(event, kV0C);
                             return decision;
     default:                AliFatal(Form("Trigger type %d not implemented", triggerNoFlags));
   }
@@ -623,6 +667,37 @@ Bool_t AliTriggerAnalysis::IsOfflineTriggerFired(const AliVEvent* event, Trigger
 }
 
 
+//-------------------------------------------------------------------------------------------------
+void AliTriggerAnalysis::UpdateEventCache(const AliVEvent* event){
+  // invalidates the cached trigger decisions when a new event is processed
+  // the input handlers reuse the event object, so the event is identified by its pointer together with
+  // the header information and the entry of the analysis manager
+  AliAnalysisManager* mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+  if (event              == fCachedEvent &&
+      entry              == fCachedEntry &&
+      event->GetRunNumber()          == fCachedRun &&
+      event->GetPeriodNumber()       == fCachedPeriod &&
+      event->GetOrbitNumber()        == fCachedOrbit &&
+      event->GetBunchCrossNumber()   == fCachedBC &&
+      event->GetEventNumberInFile()  == fCachedEventInFile) return;
+  
+  fCachedEvent       = event;
+  fCachedEntry       = entry;
+  fCachedRun         = event->GetRunNumber();
+  fCachedPeriod      = event->GetPeriodNumber();
+  fCachedOrbit       = event->GetOrbitNumber();
+  fCachedBC          = event->GetBunchCrossNumber();
+  fCachedEventInFile = event->GetEventNumberInFile();
+  
+  if (++fCacheGeneration == 0) {
+    // wrap around, forget all stamps
+    fCacheStamp.assign(fCacheStamp.size(), 0);
+    fCacheGeneration = 1;
+  }
+}
+
+
 //-------------------------------------------------------------------------------------------------
 Int_t AliTriggerAnalysis::SPDFiredChips(const AliVEvent* event, Int_t origin, Int_t fillHists, Int_t layer){
   // returns the number of fired chips in the SPD
@@ -12,6 +12,7 @@
 // Current support and development: Evgeny Kryshen, PNPI
 //-------------------------------------------------------------------------
 
+#include <vector>
 #include "AliOADBTriggerAnalysis.h"
 #include "TBrowser.h"
 class AliVEvent;
@@ -45,13 +46,14 @@ public:
   AliTriggerAnalysis(TString name="default");
   virtual ~AliTriggerAnalysis();
   void EnableHistograms(Bool_t isLowFlux = kFALSE);
-  void SetAnalyzeMC(Bool_t flag = kTRUE) { fMC = flag; }
-  void ApplyPileupCuts(Bool_t val = kTRUE) { fPileupCutsEnabled = val; }
+  void SetAnalyzeMC(Bool_t flag = kTRUE) { fMC = flag; ResetEventCache(); }
+  void ApplyPileupCuts(Bool_t val = kTRUE) { fPileupCutsEnabled = val; ResetEventCache(); }
   void SetParameters(AliOADBTriggerAnalysis* oadb);
   Bool_t IsTriggerFired(const AliVEvent* event, Trigger trigger);
   Int_t EvaluateTrigger(const AliVEvent* event, Trigger trigger);
   Bool_t IsTriggerBitFired(const AliVEvent* event, ULong64_t tclass) const;
   Bool_t IsOfflineTriggerFired(const AliVEvent* event, Trigger trigger);
+  void ResetEventCache() { fCachedEvent = 0; } // to be called if the trigger parameters are changed within an event
   
   // some "raw" trigger functions
   ADDecision ADTrigger           (const AliVEvent* event, AliceSide side, Bool_t online, Int_t fillHists = 0);
@@ -86,8 +88,8 @@ public:
   void FillHistograms(const AliVEvent* event, Bool_t onlineDecision, Bool_t offlineDecision);
   void FillTriggerClasses(const AliVEvent* event);
   
-  void SetSPDGFOEfficiency(TH1F* hist) { fSPDGFOEfficiency = hist; }
-  void SetDoFMD(Bool_t flag = kTRUE) {fDoFMD = flag;}
+  void SetSPDGFOEfficiency(TH1F* hist) { fSPDGFOEfficiency = hist; ResetEventCache(); }
+  void SetDoFMD(Bool_t flag = kTRUE) {fDoFMD = flag; ResetEventCache(); }
   
   TObject* GetHistogram(const char* histName);
   TList* GetHistList() { return fHistList; }
@@ -99,6 +101,9 @@ public:
 
 protected:
   Int_t FMDHitCombinations(const AliESDEvent* aEsd, AliceSide side, Int_t fillHists = 0);
+  Int_t ComputeTrigger(const AliVEvent* event, Trigger trigger);
+  Bool_t ComputeOfflineTrigger(const AliVEvent* event, Trigger trigger);
+  void UpdateEventCache(const AliVEvent* event);
   
   TH1F* fSPDGFOEfficiency;   //! FO efficiency applied in SPDFiredChips. function of chip number (bin 1..400: first layer; 401..1200: second layer)
   
@@ -166,7 +171,18 @@ protected:
 
   TMap* fTriggerClasses;     // counts the active trigger classes (uses the full string)
   
-  ClassDef(AliTriggerAnalysis, 35)
+  const AliVEvent* fCachedEvent;    //! event of the cached trigger decisions
+  Int_t     fCachedRun;             //! run number of the cached event
+  UInt_t    fCachedPeriod;          //! period number of the cached event
+  UInt_t    fCachedOrbit;           //! orbit number of the cached event
+  UShort_t  fCachedBC;              //! bunch crossing number of the cached event
+  Int_t     fCachedEventInFile;     //! event number in file of the cached event
+  Long64_t  fCachedEntry;           //! analysis manager entry of the cached event, -1 without manager
+  UInt_t    fCacheGeneration;       //! incremented for each new event
+  std::vector<UInt_t> fCacheStamp;  //! generation of each cached decision: online, offline EvaluateTrigger and IsOfflineTriggerFired
+  std::vector<Int_t>  fCacheValue;  //! cached decisions
+  
+  ClassDef(AliTriggerAnalysis, 36)
 private:
   AliTriggerAnalysis(const AliTriggerAnalysis&);
   AliTriggerAnalysis& operator=(const AliTriggerAnalysis&);
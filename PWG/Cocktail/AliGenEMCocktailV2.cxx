@@ -217,12 +217,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genpizero->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(namePizero,genpizero);
-    TF1 *fPtPizero = genpizero->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kPizero] = fPtPizero->Integral(fPtMin,fPtMax,1.e-6);
-#else
-    fYieldArray[kPizero] = fPtPizero->Integral(fPtMin,fPtMax,(Double_t *)0,1.e-6);
-#endif
+    fYieldArray[kPizero] = IntegratePt(genpizero->GetPt(), fPtMax);
   }
   
   // eta
@@ -238,12 +233,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     geneta->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameEta,geneta,maxPtStretchFactor);
-    TF1 *fPtEta = geneta->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kEta] = fPtEta->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kEta] = fPtEta->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t *)0,1.e-6);
-#endif
+    fYieldArray[kEta] = IntegratePt(geneta->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // rho
@@ -259,12 +249,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genrho->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameRho,genrho,maxPtStretchFactor);
-    TF1 *fPtRho = genrho->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kRho0] = fPtRho->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kRho0] = fPtRho->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t *)0,1.e-6);
-#endif
+    fYieldArray[kRho0] = IntegratePt(genrho->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // omega
@@ -280,12 +265,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genomega->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameOmega,genomega,maxPtStretchFactor);
-    TF1 *fPtOmega = genomega->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kOmega] = fPtOmega->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kOmega] = fPtOmega->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t *)0,1.e-6);
-#endif
+    fYieldArray[kOmega] = IntegratePt(genomega->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // etaprime
@@ -301,12 +281,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genetaprime->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameEtaprime,genetaprime,maxPtStretchFactor);
-    TF1 *fPtEtaprime = genetaprime->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kEtaprime] = fPtEtaprime->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kEtaprime] = fPtEtaprime->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t *)0,1.e-6);
-#endif
+    fYieldArray[kEtaprime] = IntegratePt(genetaprime->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // phi
@@ -322,12 +297,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genphi->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(namePhi,genphi,maxPtStretchFactor);
-    TF1 *fPtPhi = genphi->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kPhi] = fPtPhi->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kPhi] = fPtPhi->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t *)0,1.e-6);
-#endif
+    fYieldArray[kPhi] = IntegratePt(genphi->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // jpsi
@@ -343,12 +313,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genjpsi->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameJpsi,genjpsi,maxPtStretchFactor);
-    TF1 *fPtJpsi = genjpsi->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kJpsi] = fPtJpsi->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kJpsi] = fPtJpsi->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t *)0,1.e-6);
-#endif
+    fYieldArray[kJpsi] = IntegratePt(genjpsi->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // sigma
@@ -363,12 +328,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     gensigma->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameSigma,gensigma,maxPtStretchFactor);
-    TF1 *fPtSigma = gensigma->GetPt();
-#if ROOT_VERSION_CODE < ROOT_VERSION(5,99,0)
-    fYieldArray[kSigma0] = fPtSigma->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t*)0,1.e-6);
-#else
-    fYieldArray[kSigma0] = fPtSigma->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#endif
+    fYieldArray[kSigma0] = IntegratePt(gensigma->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // k0short
@@ -383,12 +343,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genkzeroshort->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameK0short,genkzeroshort,maxPtStretchFactor);
-    TF1 *fPtK0short = genkzeroshort->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kK0s] = fPtK0short->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kK0s] = fPtK0short->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t*)0,1.e-6);
-#endif
+    fYieldArray[kK0s] = IntegratePt(genkzeroshort->GetPt(), maxPtStretchFactor*fPtMax);
   }
 
   // k0long
@@ -403,12 +358,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genkzerolong->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameK0long,genkzerolong,maxPtStretchFactor);
-    TF1 *fPtK0long = genkzerolong->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kK0l] = fPtK0long->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kK0l] = fPtK0long->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t*)0,1.e-6);
-#endif
+    fYieldArray[kK0l] = IntegratePt(genkzerolong->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // Lambda
@@ -423,12 +373,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genLambda->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameLambda,genLambda,maxPtStretchFactor);
-    TF1 *fPtLambda = genLambda->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kLambda] = fPtLambda->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kLambda] = fPtLambda->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t*)0,1.e-6);
-#endif
+    fYieldArray[kLambda] = IntegratePt(genLambda->GetPt(), maxPtStretchFactor*fPtMax);
   }
 
   // Delta++
@@ -443,12 +388,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genkdeltaPlPl->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameDeltaPlPl,genkdeltaPlPl,maxPtStretchFactor);
-    TF1 *fPtDeltaPlPl = genkdeltaPlPl->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kDeltaPlPl] = fPtDeltaPlPl->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kDeltaPlPl] = fPtDeltaPlPl->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t*)0,1.e-6);
-#endif
+    fYieldArray[kDeltaPlPl] = IntegratePt(genkdeltaPlPl->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // Delta+
@@ -462,12 +402,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genkdeltaPl = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kDeltaPl, "DUMMY");
     genkdeltaPl->SetYRange(fYMin, fYMax);
     AddSource2Generator(nameDeltaPl,genkdeltaPl,maxPtStretchFactor);
-    TF1 *fPtDeltaPl = genkdeltaPl->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kDeltaPl] = fPtDeltaPl->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kDeltaPl] = fPtDeltaPl->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t*)0,1.e-6);
-#endif
+    fYieldArray[kDeltaPl] = IntegratePt(genkdeltaPl->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // Delta-
@@ -482,12 +417,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genkdeltaMi->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameDeltaMi,genkdeltaMi,maxPtStretchFactor);
-    TF1 *fPtDeltaMi = genkdeltaMi->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kDeltaMi] = fPtDeltaMi->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kDeltaMi] = fPtDeltaMi->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t*)0,1.e-6);
-#endif
+    fYieldArray[kDeltaMi] = IntegratePt(genkdeltaMi->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // Delta0
@@ -502,12 +432,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genkdeltaZero->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameDeltaZero,genkdeltaZero,maxPtStretchFactor);
-    TF1 *fPtDeltaZero = genkdeltaZero->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kDeltaZero] = fPtDeltaZero->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kDeltaZero] = fPtDeltaZero->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t*)0,1.e-6);
-#endif
+    fYieldArray[kDeltaZero] = IntegratePt(genkdeltaZero->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // rho+
@@ -522,12 +447,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genkrhoPl->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameRhoPl,genkrhoPl,maxPtStretchFactor);
-    TF1 *fPtRhoPl = genkrhoPl->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kRhoPl] = fPtRhoPl->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kRhoPl] = fPtRhoPl->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t*)0,1.e-6);
-#endif
+    fYieldArray[kRhoPl] = IntegratePt(genkrhoPl->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // rho-
@@ -542,12 +462,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genkrhoMi->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameRhoMi,genkrhoMi,maxPtStretchFactor);
-    TF1 *fPtRhoMi = genkrhoMi->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kRhoMi] = fPtRhoMi->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kRhoMi] = fPtRhoMi->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t*)0,1.e-6);
-#endif
+    fYieldArray[kRhoMi] = IntegratePt(genkrhoMi->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   // K0*
@@ -562,12 +477,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genkK0star->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameK0star,genkK0star,maxPtStretchFactor);
-    TF1 *fPtK0star = genkK0star->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kK0star] = fPtK0star->Integral(fPtMin,maxPtStretchFactor*fPtMax,1.e-6);
-#else
-    fYieldArray[kK0star] = fPtK0star->Integral(fPtMin,maxPtStretchFactor*fPtMax,(Double_t*)0,1.e-6);
-#endif
+    fYieldArray[kK0star] = IntegratePt(genkK0star->GetPt(), maxPtStretchFactor*fPtMax);
   }
   
   TParticlePDG *elPDG=TDatabasePDG::Instance()->GetParticle(11);
@@ -588,12 +498,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genDirectRealG = new AliGenParam(fNPart, new AliGenEMlibV2(), AliGenEMlibV2::kDirectRealGamma, "DUMMY");
     genDirectRealG->SetYRange(fYMin, fYMax);
     AddSource2Generator(nameDirectRealG,genDirectRealG);
-    TF1 *fPtDirectRealG = genDirectRealG->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kDirectRealGamma] = fPtDirectRealG->Integral(fPtMin,fPtMax,1.e-6);
-#else
-    fYieldArray[kDirectRealGamma] = fPtDirectRealG->Integral(fPtMin,fPtMax,(Double_t *)0,1.e-6);
-#endif
+    fYieldArray[kDirectRealGamma] = IntegratePt(genDirectRealG->GetPt(), fPtMax);
   }
   
   if(fSelectedParticles&kGenDirectVirtGamma){
@@ -605,12 +510,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     genDirectVirtG = new AliGenParam(fNPart, new AliGenEMlibV2(), AliGenEMlibV2::kDirectVirtGamma, "DUMMY");
     genDirectVirtG->SetYRange(fYMin, fYMax);
     AddSource2Generator(nameDirectVirtG,genDirectVirtG);
-    TF1 *fPtDirectVirtG = genDirectVirtG->GetPt();
-#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
-    fYieldArray[kDirectVirtGamma] = fPtDirectVirtG->Integral(fPtMin,fPtMax,1.e-6);
-#else
-    fYieldArray[kDirectVirtGamma] = fPtDirectVirtG->Integral(fPtMin,fPtMax,(Double_t *)0,1.e-6);
-#endif
+    fYieldArray[kDirectVirtGamma] = IntegratePt(genDirectVirtG->GetPt(), fPtMax);
   }
 }
 
@@ -633,6 +533,17 @@ void AliGenEMCocktailV2::AddSource2Generator(Char_t* nameSource,
   AddGenerator(genSource,nameSource,1.); // Adding Generator
 }
 
+//-------------------------------------------------------------------
+Double_t AliGenEMCocktailV2::IntegratePt(TF1* fPt, Double_t ptMax)
+{
+  // yield of a source, integral of its pt function between fPtMin and ptMax
+#if ROOT_VERSION_CODE >= ROOT_VERSION(5,99,0)
+  return fPt->Integral(fPtMin,ptMax,1.e-6);
+#else
+  return fPt->Integral(fPtMin,ptMax,(Double_t *)0,1.e-6);
+#endif
+}
+
 //-------------------------------------------------------------------
 void AliGenEMCocktailV2::Init()
 {
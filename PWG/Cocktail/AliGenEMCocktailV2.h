@@ -108,6 +108,7 @@ private:
   AliGenEMCocktailV2 & operator=(const AliGenEMCocktailV2 &cocktail);
   
   void AddSource2Generator(Char_t *nameReso, AliGenParam* const genReso, Double_t maxPtStretchFactor = 1.);
+  Double_t IntegratePt(TF1* fPt, Double_t ptMax);
 
   AliDecayer*     fDecayer;                             // External decayer
   Decay_t         fDecayMode;                           // decay mode in which resonances are forced to decay, default: kAll
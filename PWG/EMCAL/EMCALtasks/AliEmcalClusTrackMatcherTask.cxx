@@ -203,8 +203,9 @@ void AliEmcalClusTrackMatcherTask::GenerateEmcalParticles()
   AliParticleContainer *tracks = GetParticleContainer(0);
   AliClusterContainer *clusters = GetClusterContainer(0);
 
-  fEmcalTracks->Delete();
-  fEmcalClusters->Delete();
+  // AliEmcalParticle does not own memory, the slots of the arrays are reused in each event
+  fEmcalTracks->Clear();
+  fEmcalClusters->Clear();
 
   fNEmcalTracks = 0;
   fNEmcalClusters = 0;
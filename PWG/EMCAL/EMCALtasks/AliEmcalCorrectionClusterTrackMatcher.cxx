@@ -3,8 +3,13 @@
 
 #include "AliEmcalCorrectionClusterTrackMatcher.h"
 
+#include <algorithm>
+
 #include <TH1.h>
 #include <TList.h>
+#include <TStopwatch.h>
+#include <TVector2.h>
+#include <TVector3.h>
 
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
@@ -45,6 +50,19 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fNEmcalClusters(0),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0),
+  fHistMatchingTime(0),
+  fClusterEta(),
+  fClusterPhi(),
+  fClusterBinStart(),
+  fClusterBinIndex(),
+  fUnbinnedClusters(),
+  fMatchCandidates(),
+  fNEtaBins(0),
+  fNPhiBins(0),
+  fGridEtaMin(0),
+  fGridEtaWidth(1),
+  fGridPhiWidth(1),
+  fGridWindow(0),
   fMCGenerToAcceptForTrack(1),
   fNMCGenerToAccept(0)
 {
@@ -155,6 +173,9 @@ void AliEmcalCorrectionClusterTrackMatcher::UserCreateOutputObjects()
     fHistMatchPhiAll = new TH1F("fHistMatchPhiAll", "fHistMatchPhiAll", 400, -0.2, 0.2);
     fOutput->Add(fHistMatchEtaAll);
     fOutput->Add(fHistMatchPhiAll);
+    fHistMatchingTime = new TH1F("fHistMatchingTime", "fHistMatchingTime", 1000, 0, 100);
+    fHistMatchingTime->SetXTitle("matching time per event (ms)");
+    fOutput->Add(fHistMatchingTime);
     
     const Int_t nCentChBins = fNcentBins * 2;
     for(Int_t icent=0; icent<nCentChBins; ++icent) {
@@ -236,8 +257,9 @@ Int_t AliEmcalCorrectionClusterTrackMatcher::GetMomBin(Double_t p) const
  */
 void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
 {
-  fEmcalTracks->Delete();
-  fEmcalClusters->Delete();
+  // AliEmcalParticle does not own memory, the slots of the arrays are reused in each event
+  fEmcalTracks->Clear();
+  fEmcalClusters->Clear();
 
   fNEmcalTracks = 0;
   fNEmcalClusters = 0;
@@ -362,18 +384,125 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
   }
 }
 
+/**
+ * Sort the clusters of the event into an eta-phi grid. The bins are at least as wide as
+ * the matching window, so that for each track only the neighbouring bins have to be tested.
+ * Cluster positions are calculated in the same way as in GetEtaPhiDiff.
+ */
+void AliEmcalCorrectionClusterTrackMatcher::BuildClusterGrid()
+{
+  const Int_t kMaxEtaBins = 1000;
+
+  // Small margin on top of the matching distance to be safe against rounding
+  fGridWindow = TMath::Abs(fMaxDistance) * (1. + 1e-6) + 1e-9;
+
+  fClusterEta.resize(fNEmcalClusters);
+  fClusterPhi.resize(fNEmcalClusters);
+  fUnbinnedClusters.clear();
+
+  Double_t etamin = 0, etamax = 0;
+  Bool_t first = kTRUE;
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliVCluster* cluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster))->GetCluster();
+    Float_t pos[3] = {0};
+    cluster->GetPosition(pos);
+    TVector3 cpos(pos);
+    fClusterEta[icluster] = cpos.Eta();
+    fClusterPhi[icluster] = cpos.Phi();
+    if (!TMath::Finite(fClusterEta[icluster]) || !TMath::Finite(fClusterPhi[icluster])) {
+      fUnbinnedClusters.push_back(icluster);
+      continue;
+    }
+    if (first || fClusterEta[icluster] < etamin) etamin = fClusterEta[icluster];
+    if (first || fClusterEta[icluster] > etamax) etamax = fClusterEta[icluster];
+    first = kFALSE;
+  }
+
+  fGridEtaMin = etamin;
+  fNEtaBins = static_cast<Int_t>(TMath::Min((etamax - etamin) / fGridWindow, Double_t(kMaxEtaBins - 1))) + 1;
+  fGridEtaWidth = TMath::Max(fGridWindow, (etamax - etamin) / fNEtaBins);
+  fNPhiBins = static_cast<Int_t>(TMath::Min(TMath::TwoPi() / fGridWindow, 360.));
+  if (fNPhiBins < 1) fNPhiBins = 1;
+  fGridPhiWidth = TMath::TwoPi() / fNPhiBins;
+
+  // Fill the bins in cluster order, such that the clusters in each bin are sorted
+  const Int_t nbins = fNEtaBins * fNPhiBins;
+  std::vector<Int_t> clusterbin(fNEmcalClusters, -1);
+  fClusterBinStart.assign(nbins + 1, 0);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    if (!TMath::Finite(fClusterEta[icluster]) || !TMath::Finite(fClusterPhi[icluster])) continue;
+    Int_t etabin = TMath::Min(static_cast<Int_t>((fClusterEta[icluster] - fGridEtaMin) / fGridEtaWidth), fNEtaBins - 1);
+    Int_t phibin = TMath::Min(static_cast<Int_t>((fClusterPhi[icluster] + TMath::Pi()) / fGridPhiWidth), fNPhiBins - 1);
+    if (phibin < 0) phibin = 0;
+    clusterbin[icluster] = etabin * fNPhiBins + phibin;
+    fClusterBinStart[clusterbin[icluster] + 1]++;
+  }
+  for (Int_t ibin = 0; ibin < nbins; ibin++) fClusterBinStart[ibin + 1] += fClusterBinStart[ibin];
+  fClusterBinIndex.resize(fClusterBinStart[nbins]);
+  std::vector<Int_t> fill(fClusterBinStart.begin(), fClusterBinStart.end() - 1);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    if (clusterbin[icluster] >= 0) fClusterBinIndex[fill[clusterbin[icluster]]++] = icluster;
+  }
+}
+
+/**
+ * Collect the clusters in the eta-phi bins within the matching window around a track.
+ * Candidates are sorted by their index, such that matches are found in the same order
+ * as when testing all clusters.
+ * @param[in] eta Track eta on the EMCal surface
+ * @param[in] phi Track phi on the EMCal surface
+ */
+void AliEmcalCorrectionClusterTrackMatcher::FindMatchCandidates(Double_t eta, Double_t phi)
+{
+  fMatchCandidates.clear();
+  if (!TMath::Finite(eta) || !TMath::Finite(phi)) {
+    // No valid position: test all clusters
+    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) fMatchCandidates.push_back(icluster);
+    return;
+  }
+  fMatchCandidates.insert(fMatchCandidates.end(), fUnbinnedClusters.begin(), fUnbinnedClusters.end());
+
+  Double_t etalow = (eta - fGridWindow - fGridEtaMin) / fGridEtaWidth, etahigh = (eta + fGridWindow - fGridEtaMin) / fGridEtaWidth;
+  if (etahigh >= 0 && etalow < fNEtaBins) {
+    Int_t etabinmin = etalow < 0 ? 0 : static_cast<Int_t>(etalow);
+    Int_t etabinmax = etahigh >= fNEtaBins ? fNEtaBins - 1 : static_cast<Int_t>(etahigh);
+    Double_t phinorm = TVector2::Phi_mpi_pi(phi) + TMath::Pi();
+    Int_t phibinmin = static_cast<Int_t>(TMath::Floor((phinorm - fGridWindow) / fGridPhiWidth)),
+          phibinmax = static_cast<Int_t>(TMath::Floor((phinorm + fGridWindow) / fGridPhiWidth));
+    if (phibinmax - phibinmin + 1 >= fNPhiBins) {
+      phibinmin = 0;
+      phibinmax = fNPhiBins - 1;
+    }
+    for (Int_t etabin = etabinmin; etabin <= etabinmax; etabin++) {
+      for (Int_t iphi = phibinmin; iphi <= phibinmax; iphi++) {
+        Int_t bin = etabin * fNPhiBins + (iphi % fNPhiBins + fNPhiBins) % fNPhiBins;
+        fMatchCandidates.insert(fMatchCandidates.end(), fClusterBinIndex.begin() + fClusterBinStart[bin], fClusterBinIndex.begin() + fClusterBinStart[bin + 1]);
+      }
+    }
+  }
+  std::sort(fMatchCandidates.begin(), fMatchCandidates.end());
+}
+
 /**
  * Set the links between tracks and clusters.
+ * Only the clusters in the neighbouring eta-phi bins of each track are tested.
  */
 void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
+  TStopwatch watch;
+  if (fHistMatchingTime) watch.Start();
+
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  BuildClusterGrid();
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    FindMatchCandidates(track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal());
+    for (std::vector<Int_t>::const_iterator candidate = fMatchCandidates.begin(); candidate != fMatchCandidates.end(); ++candidate) {
+      Int_t icluster = *candidate;
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
       
@@ -408,6 +537,8 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
       }
     }
   }
+
+  if (fHistMatchingTime) fHistMatchingTime->Fill(watch.RealTime() * 1000.);
 }
 
 /**
@@ -1,6 +1,8 @@
 #ifndef ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 #define ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 
+#include <vector>
+
 #include "AliEmcalCorrectionComponent.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
@@ -69,6 +71,8 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Int_t         GetMomBin(Double_t p) const;
   void          GenerateEmcalParticles();
   void          DoMatching();
+  void          BuildClusterGrid();
+  void          FindMatchCandidates(Double_t eta, Double_t phi);
   void          UpdateTracks();
   void          UpdateClusters();
   Bool_t        IsTrackInEmcalAcceptance(AliVParticle* part, Double_t edges=0.9) const;
@@ -102,6 +106,21 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   TH1          *fHistMatchPhiAll;       //!<!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!<!deta distribution
   TH1          *fHistMatchPhi[10][9][2]; //!<!dphi distribution
+  TH1          *fHistMatchingTime;      //!<!time spent in the matching per event
+  
+  // Clusters binned in eta-phi for the matching (rebuilt each event)
+  std::vector<Double_t> fClusterEta;      //!<!cluster eta, as used in the matching
+  std::vector<Double_t> fClusterPhi;      //!<!cluster phi, as used in the matching
+  std::vector<Int_t>    fClusterBinStart; //!<!first entry of each eta-phi bin in fClusterBinIndex
+  std::vector<Int_t>    fClusterBinIndex; //!<!cluster indices ordered by eta-phi bin
+  std::vector<Int_t>    fUnbinnedClusters; //!<!clusters without valid position, always tested
+  std::vector<Int_t>    fMatchCandidates; //!<!candidate clusters of the current track
+  Int_t         fNEtaBins;              //!<!number of eta bins of the cluster grid
+  Int_t         fNPhiBins;              //!<!number of phi bins of the cluster grid
+  Double_t      fGridEtaMin;            //!<!lower eta edge of the cluster grid
+  Double_t      fGridEtaWidth;          //!<!eta bin width of the cluster grid
+  Double_t      fGridPhiWidth;          //!<!phi bin width of the cluster grid
+  Double_t      fGridWindow;            //!<!search window around the tracks
   
   Int_t      fNMCGenerToAccept;          ///<  Number of MC generators that should not be included in analysis
   TString    fMCGenerToAccept[5];        ///<  List with name of generators that should not be included
@@ -115,7 +134,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 4); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 5); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
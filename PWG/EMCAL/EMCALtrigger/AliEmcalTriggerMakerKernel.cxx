@@ -12,6 +12,7 @@
  * about the suitability of this software for any purpose. It is          *
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <cstring>
@@ -65,6 +66,9 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fSmearModelMean(nullptr),
   fSmearModelSigma(nullptr),
   fSmearThreshold(0.1),
+  fUseSummedAreaPatchFinder(kFALSE),
+  fPatchMaterializationThreshold(0.),
+  fL1AlgorithmSetup(),
   fGeometry(nullptr),
   fPatchAmplitudes(nullptr),
   fPatchADCSimple(nullptr),
@@ -72,10 +76,14 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fPatchEnergySimpleSmeared(nullptr),
   fLevel0TimeMap(nullptr),
   fTriggerBitMap(nullptr),
-  fADCtoGeV(1.)
+  fADCtoGeV(1.),
+  fSummedAreaSums(),
+  fSummedAreaCounts(),
+  fSummedAreaValid(0)
 {
   memset(fThresholdConstants, 0, sizeof(Int_t) * 12);
   memset(fL1ThresholdsOffline, 0, sizeof(ULong64_t) * 4);
+  memset(fL0AlgorithmSetup, 0, sizeof(Int_t) * 5);
   fCellTimeLimits[0] = -10000.;
   fCellTimeLimits[1] = 10000.;
 }
@@ -128,6 +136,9 @@ void AliEmcalTriggerMakerKernel::AddL1TriggerAlgorithm(Int_t rowmin, Int_t rowma
   trigger->SetPatchSize(patchSize);
   trigger->SetSubregionSize(subregionSize);
   fPatchFinder->AddTriggerAlgorithm(trigger);
+
+  Int_t setup[5] = {rowmin, rowmax, static_cast<Int_t>(bitmask), patchSize, subregionSize};
+  fL1AlgorithmSetup.insert(fL1AlgorithmSetup.end(), setup, setup + 5);
 }
 
 void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize)
@@ -136,6 +147,12 @@ void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowma
   fLevel0PatchFinder = new AliEMCALTriggerAlgorithm<double>(rowmin, rowmax, bitmask);
   fLevel0PatchFinder->SetPatchSize(patchSize);
   fLevel0PatchFinder->SetSubregionSize(subregionSize);
+
+  fL0AlgorithmSetup[0] = rowmin;
+  fL0AlgorithmSetup[1] = rowmax;
+  fL0AlgorithmSetup[2] = static_cast<Int_t>(bitmask);
+  fL0AlgorithmSetup[3] = patchSize;
+  fL0AlgorithmSetup[4] = subregionSize;
 }
 
 void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
@@ -146,6 +163,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSetup.clear();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -163,6 +181,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSetup.clear();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -180,6 +199,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPPb2013()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSetup.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -195,6 +215,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2012()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSetup.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -210,6 +231,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSetup.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -225,6 +247,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSetup.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   fConfigured = true;
@@ -296,9 +319,11 @@ void AliEmcalTriggerMakerKernel::Reset(){
   fTriggerBitMap->Reset();
   if(fPatchEnergySimpleSmeared) fPatchEnergySimpleSmeared->Reset();
   memset(fL1ThresholdsOffline, 0, sizeof(ULong64_t) * 4);
+  InvalidateSummedAreaTables();
 }
 
 void AliEmcalTriggerMakerKernel::ReadTriggerData(AliVCaloTrigger *trigger){
+  InvalidateSummedAreaTables();
   trigger->Reset();
   Int_t globCol=-1, globRow=-1;
   Int_t adcAmp=-1, bitmap = 0;
@@ -384,6 +409,7 @@ void AliEmcalTriggerMakerKernel::ReadTriggerData(AliVCaloTrigger *trigger){
 }
 
 void AliEmcalTriggerMakerKernel::ReadCellData(AliVCaloCells *cells){
+  InvalidateSummedAreaTables();
   // fill the patch ADCs from cells
   Int_t nCell = cells->GetNumberOfCells();
   for(Int_t iCell = 0; iCell < nCell; ++iCell) {
@@ -488,7 +514,12 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
       //l0PatchMask = 1 << fTriggerBitConfig->GetLevel0Bit();
 
   std::vector<AliEMCALTriggerRawPatch> patches;
-  if (fPatchFinder) {
+  if (fPatchFinder && fUseSummedAreaPatchFinder) {
+    for(std::vector<Int_t>::size_type ialgo = 0; ialgo + 5 <= fL1AlgorithmSetup.size(); ialgo += 5){
+      FindPatchesSummedArea(&fL1AlgorithmSetup[ialgo], useL0amp ? kAmplitudeTable : kADCTable, patches);
+    }
+  }
+  else if (fPatchFinder) {
     if (useL0amp) {
       patches = fPatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
     }
@@ -544,7 +575,10 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
 
   // Find Level0 patches
   std::vector<AliEMCALTriggerRawPatch> l0patches;
-  if (fLevel0PatchFinder) l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
+  if (fLevel0PatchFinder) {
+    if (fUseSummedAreaPatchFinder) FindPatchesSummedArea(fL0AlgorithmSetup, kAmplitudeTable, l0patches);
+    else l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
+  }
   for(std::vector<AliEMCALTriggerRawPatch>::iterator patchit = l0patches.begin(); patchit != l0patches.end(); ++patchit){
     Int_t offlinebits = 0, onlinebits = 0;
     if(HasPHOSOverlap(*patchit)) continue;
@@ -574,6 +608,117 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
   // std::cout << "Finished finding trigger patches" << std::endl;
 }
 
+AliEMCALTriggerDataGrid<double> *AliEmcalTriggerMakerKernel::GetSummedAreaGrid(Int_t table) const {
+  switch(table){
+  case kADCTable: return fPatchADC;
+  case kAmplitudeTable: return fPatchAmplitudes;
+  default: return fPatchADCSimple;
+  }
+}
+
+void AliEmcalTriggerMakerKernel::BuildSummedAreaTable(Int_t table){
+  if(TESTBIT(fSummedAreaValid, table)) return;
+  AliEMCALTriggerDataGrid<double> &grid = *GetSummedAreaGrid(table);
+  const int ncols = grid.GetNumberOfCols(), nrows = grid.GetNumberOfRows(), stride = ncols + 1;
+  const std::size_t tablesize = static_cast<std::size_t>(stride) * (nrows + 1);
+  if(fSummedAreaSums.size() != kNSummedAreaTables * tablesize){
+    // first row and column stay 0 for all events
+    fSummedAreaSums.assign(kNSummedAreaTables * tablesize, 0.);
+    fSummedAreaCounts.assign(kNSummedAreaTables * tablesize, 0);
+    fSummedAreaValid = 0;
+  }
+  double *sums = &fSummedAreaSums[table * tablesize];
+  int *counts = &fSummedAreaCounts[table * tablesize];
+  for(int irow = 0; irow < nrows; irow++){
+    double rowsum = 0;
+    int rowcount = 0;
+    const int below = irow * stride, current = below + stride;
+    for(int icol = 0; icol < ncols; icol++){
+      double value = grid(icol, irow);
+      rowsum += value;
+      if(value > 0) rowcount++;
+      sums[current + icol + 1] = sums[below + icol + 1] + rowsum;
+      counts[current + icol + 1] = counts[below + icol + 1] + rowcount;
+    }
+  }
+  SETBIT(fSummedAreaValid, table);
+}
+
+void AliEmcalTriggerMakerKernel::FindPatchesSummedArea(const Int_t *setup, Int_t onlinetable, std::vector<AliEMCALTriggerRawPatch> &patches){
+  BuildSummedAreaTable(onlinetable);
+  BuildSummedAreaTable(kADCSimpleTable);
+  AliEMCALTriggerDataGrid<double> &onlinegrid = *GetSummedAreaGrid(onlinetable), &offlinegrid = *fPatchADCSimple;
+  const int ncols = onlinegrid.GetNumberOfCols(), nrows = onlinegrid.GetNumberOfRows(), stride = ncols + 1;
+  const std::size_t tablesize = static_cast<std::size_t>(stride) * (nrows + 1);
+  const double *onlinesums = &fSummedAreaSums[onlinetable * tablesize], *offlinesums = &fSummedAreaSums[kADCSimpleTable * tablesize];
+  const int *onlinecounts = &fSummedAreaCounts[onlinetable * tablesize], *offlinecounts = &fSummedAreaCounts[kADCSimpleTable * tablesize];
+
+  const int rowmin = setup[0], rowmax = std::min(setup[1], nrows - 1), bitmask = setup[2], patchsize = setup[3], subregion = setup[4];
+  if(patchsize <= 0 || subregion <= 0) return;
+  const bool materializeAll = fPatchMaterializationThreshold <= 0;
+  // Summed-area values are only used to pre-select the patches, the decision is
+  // done on the directly summed ADC. The tolerance covers the rounding in the tables.
+  const double tolerance = 1e-9 * (1. + onlinesums[tablesize - 1] + offlinesums[tablesize - 1]);
+
+  // Direct sum over the patch, same order as in the sliding-window algorithm
+  auto patchsum = [patchsize](AliEMCALTriggerDataGrid<double> &grid, int col, int row) -> double {
+    double sum = 0;
+    for(int irow = 0; irow < patchsize; irow++){
+      for(int icol = 0; icol < patchsize; icol++) sum += grid(col + icol, row + irow);
+    }
+    return sum;
+  };
+  auto materialize = [&](int col, int row, double online, double offline) {
+    AliEMCALTriggerRawPatch recpatch(col, row, patchsize, online, offline);
+    recpatch.SetBitmask(bitmask);
+    patches.push_back(recpatch);
+  };
+
+  int maxonline[2] = {-1, -1}, maxoffline[2] = {-1, -1};
+  double maxonlineval = 0, maxofflineval = 0;
+  bool maxonlinekept = false, maxofflinekept = false;
+  for(int irow = rowmin; irow + patchsize - 1 <= rowmax; irow += subregion){
+    for(int icol = 0; icol + patchsize <= ncols; icol += subregion){
+      const int i00 = irow * stride + icol, i01 = i00 + patchsize, i10 = i00 + patchsize * stride, i11 = i10 + patchsize;
+      const int nonline = onlinecounts[i11] - onlinecounts[i10] - onlinecounts[i01] + onlinecounts[i00],
+                noffline = offlinecounts[i11] - offlinecounts[i10] - offlinecounts[i01] + offlinecounts[i00];
+      if(!nonline && !noffline) continue;
+      if(materializeAll){
+        materialize(icol, irow, patchsum(onlinegrid, icol, irow), patchsum(offlinegrid, icol, irow));
+        continue;
+      }
+      const double online = nonline ? onlinesums[i11] - onlinesums[i10] - onlinesums[i01] + onlinesums[i00] : 0.,
+                   offline = noffline ? offlinesums[i11] - offlinesums[i10] - offlinesums[i01] + offlinesums[i00] : 0.;
+      bool kept = false;
+      if(online > fPatchMaterializationThreshold - tolerance || offline > fPatchMaterializationThreshold - tolerance){
+        const double exactonline = patchsum(onlinegrid, icol, irow), exactoffline = patchsum(offlinegrid, icol, irow);
+        if(exactonline > fPatchMaterializationThreshold || exactoffline > fPatchMaterializationThreshold){
+          materialize(icol, irow, exactonline, exactoffline);
+          kept = true;
+        }
+      }
+      if(nonline && online > maxonlineval){
+        maxonlineval = online;
+        maxonline[0] = icol;
+        maxonline[1] = irow;
+        maxonlinekept = kept;
+      }
+      if(noffline && offline > maxofflineval){
+        maxofflineval = offline;
+        maxoffline[0] = icol;
+        maxoffline[1] = irow;
+        maxofflinekept = kept;
+      }
+    }
+  }
+  if(materializeAll) return;
+  // Keep the highest patches of the algorithm also if below the materialization threshold
+  if(maxonline[0] >= 0 && !maxonlinekept)
+    materialize(maxonline[0], maxonline[1], patchsum(onlinegrid, maxonline[0], maxonline[1]), patchsum(offlinegrid, maxonline[0], maxonline[1]));
+  if(maxoffline[0] >= 0 && !maxofflinekept && !(maxoffline[0] == maxonline[0] && maxoffline[1] == maxonline[1]))
+    materialize(maxoffline[0], maxoffline[1], patchsum(onlinegrid, maxoffline[0], maxoffline[1]), patchsum(offlinegrid, maxoffline[0], maxoffline[1]));
+}
+
 
 double AliEmcalTriggerMakerKernel::GetTriggerChannelADC(Int_t col, Int_t row) const{
   double adc = 0;
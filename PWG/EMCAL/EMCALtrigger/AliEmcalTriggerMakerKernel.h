@@ -379,6 +379,30 @@ public:
    */
   void SetSmearThreshold(Double_t threshold) { fSmearThreshold = threshold; }
 
+  /**
+   * @brief Use summed-area tables instead of the sliding-window patch finders
+   *
+   * The data grids are integrated once per event into 2D prefix sums, from which
+   * the online and offline ADC of any patch are obtained in constant time. The
+   * tables are cached until the grids are reset or refilled, so running the patch
+   * finding several times on the same event reuses them. The patch geometry follows
+   * the algorithms defined via AddL1TriggerAlgorithm and SetL0TriggerAlgorithm.
+   * @param[in] doUse If true the summed-area patch finder is used
+   */
+  void SetUseSummedAreaPatchFinder(Bool_t doUse = kTRUE) { fUseSummedAreaPatchFinder = doUse; }
+
+  /**
+   * @brief Set the minimum ADC for patches to be materialized by the summed-area patch finder
+   *
+   * Only patches with online or offline ADC above the threshold are converted into
+   * patch info objects. In addition, for each trigger algorithm the patches with
+   * the highest online and offline ADC are kept, so that the main patches remain
+   * available. With the default (0) all non-empty patches are created, as with the
+   * sliding-window patch finders.
+   * @param[in] threshold Minimum online or offline ADC
+   */
+  void SetPatchMaterializationThreshold(Double_t threshold) { fPatchMaterializationThreshold = threshold; }
+
   /**
    * Check whether the trigger maker has been specially configured. Status has to
    * be set in the functions ConfigureForXX.
@@ -421,6 +445,50 @@ protected:
     kColsEta = 48
   };
 
+  /**
+   * @enum ESummedAreaTable_t
+   * @brief Data grids with a summed-area table
+   */
+  enum ESummedAreaTable_t {
+    kADCTable = 0,                ///< Online L1 ADC (fPatchADC)
+    kAmplitudeTable = 1,          ///< TRU amplitudes (fPatchAmplitudes)
+    kADCSimpleTable = 2,          ///< Offline ADC (fPatchADCSimple)
+    kNSummedAreaTables = 3        ///< Number of tables
+  };
+
+  /**
+   * @brief Get the data grid belonging to a summed-area table
+   * @param[in] table Index of the table
+   * @return Underlying data grid
+   */
+  AliEMCALTriggerDataGrid<double> *GetSummedAreaGrid(Int_t table) const;
+
+  /**
+   * @brief Build the summed-area table of a data grid, if not yet valid for the current event
+   *
+   * Next to the sums, the number of non-empty channels is integrated. As the grids
+   * contain only non-negative values, this decides exactly whether a patch is empty.
+   * @param[in] table Index of the table
+   */
+  void BuildSummedAreaTable(Int_t table);
+
+  /**
+   * @brief Find patches of one trigger algorithm using the summed-area tables
+   *
+   * Patches are enumerated in the same order as the sliding-window algorithm. The ADC
+   * of the materialized patches is summed directly from the data grids, so that their
+   * values are identical to the ones of the sliding-window algorithm.
+   * @param[in] setup Algorithm setup (rowmin, rowmax, bitmask, patch size, subregion size)
+   * @param[in] onlinetable Table used for the online ADC
+   * @param[out] patches Container the patches are appended to
+   */
+  void FindPatchesSummedArea(const Int_t *setup, Int_t onlinetable, std::vector<AliEMCALTriggerRawPatch> &patches);
+
+  /**
+   * @brief Invalidate the summed-area tables after the data grids changed
+   */
+  void InvalidateSummedAreaTables() { fSummedAreaValid = 0; }
+
   /**
    * @brief Accept trigger patch as Level0 patch.
    *
@@ -484,6 +552,10 @@ protected:
   TF1                                       *fSmearModelMean;             ///< Smearing parameterization for the mean
   TF1                                       *fSmearModelSigma;            ///< Smearing parameterization for the width
   Double_t                                  fSmearThreshold;              ///< Smear threshold: Only cell energies above threshold are smeared
+  Bool_t                                    fUseSummedAreaPatchFinder;    ///< Use summed-area tables instead of the sliding-window patch finders
+  Double_t                                  fPatchMaterializationThreshold; ///< Min. online or offline ADC of patches materialized by the summed-area patch finder
+  std::vector<Int_t>                        fL1AlgorithmSetup;            ///< Setup of the L1 algorithms (rowmin, rowmax, bitmask, patch size, subregion size)
+  Int_t                                     fL0AlgorithmSetup[5];         ///< Setup of the L0 algorithm (rowmin, rowmax, bitmask, patch size, subregion size)
 
   const AliEMCALGeometry                    *fGeometry;                   //!<! Underlying EMCAL geometry
   AliEMCALTriggerDataGrid<double>           *fPatchAmplitudes;            //!<! TRU Amplitudes (for L0)
@@ -494,9 +566,12 @@ protected:
   AliEMCALTriggerDataGrid<int>              *fTriggerBitMap;              //!<! Map of trigger bits
 
   Double_t                                  fADCtoGeV;                    //!<! Conversion factor from ADC to GeV
+  std::vector<double>                       fSummedAreaSums;              //!<! Summed-area tables of the data grids
+  std::vector<int>                          fSummedAreaCounts;            //!<! Summed-area tables of the number of non-empty channels
+  UInt_t                                    fSummedAreaValid;             //!<! Bitmap of summed-area tables valid for the current event
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalTriggerMakerKernel, 4);
+  ClassDef(AliEmcalTriggerMakerKernel, 5);
   /// \endcond
 };
 
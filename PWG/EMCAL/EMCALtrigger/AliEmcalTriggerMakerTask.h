@@ -118,6 +118,18 @@ public:
    */
   void SetL0TimeRange(Int_t min, Int_t max) { if (fTriggerMaker) fTriggerMaker->SetL0TimeRange(min, max); }
 
+  /**
+   * @brief Use summed-area tables for the patch finding in the trigger maker kernel
+   * @param[in] doUse If true the summed-area patch finder is used
+   */
+  void SetUseSummedAreaPatchFinder(Bool_t doUse = kTRUE) { if (fTriggerMaker) fTriggerMaker->SetUseSummedAreaPatchFinder(doUse); }
+
+  /**
+   * @brief Set the minimum ADC of patches created by the summed-area patch finder
+   * @param[in] threshold Minimum online or offline ADC (0: all non-empty patches)
+   */
+  void SetPatchMaterializationThreshold(Double_t threshold) { if (fTriggerMaker) fTriggerMaker->SetPatchMaterializationThreshold(threshold); }
+
 
   /**
    * @brief Set the name of the output container
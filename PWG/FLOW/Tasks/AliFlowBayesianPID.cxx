@@ -26,6 +26,7 @@
 #include "TH1D.h"
 #include "TFile.h"
 #include "AliPIDResponse.h"
+#include "AliExternalTrackParam.h"
 
 
 ClassImp(AliFlowBayesianPID)
@@ -36,7 +37,7 @@ TH1D* AliFlowBayesianPID::fgHtofChannelDist=NULL;
 
 //________________________________________________________________________
 AliFlowBayesianPID::AliFlowBayesianPID(AliESDpid *esdpid) 
-  :      AliPIDResponse(), fPIDesd(NULL), fDB(TDatabasePDG::Instance()), fNewTrackParam(0), fTOFresolution(84.0), fTOFResponseF(NULL), fTPCResponseF(NULL),fWTofMism(0.0), fProbTofMism(0.0), fZ(0) ,fMassTOF(0), fBBdata(NULL),fCurrCentrality(100),fPsi(999),fPsiRes(999),fIsMC(kFALSE),fForceOldDedx(kFALSE),fDedx(0.0),fIsTOFheaderAOD(0)
+  :      AliPIDResponse(), fPIDesd(NULL), fDB(TDatabasePDG::Instance()), fNewTrackParam(0), fTOFresolution(84.0), fTOFResponseF(NULL), fTPCResponseF(NULL),fWTofMism(0.0), fProbTofMism(0.0), fZ(0) ,fMassTOF(0), fBBdata(NULL),fCurrCentrality(100),fPsi(999),fPsiRes(999),fIsMC(kFALSE),fForceOldDedx(kFALSE),fDedx(0.0),fIsTOFheaderAOD(0),fUseResponseFunctions(kFALSE)
 {
   // Constructor
   Bool_t redopriors = kFALSE;
@@ -126,6 +127,8 @@ AliFlowBayesianPID::AliFlowBayesianPID(AliESDpid *esdpid)
 
   fBBdata = new TF1("fBBdata", "[0] * AliExternalTrackParam::BetheBlochAleph(x, [1], [2], [3], [4], [5])",0.1, 4000.);
 
+  SetResponseParameters();
+
   // initialize the mask
   for(Int_t i=0;i < fgkNdetectors;i++){
     fMaskAND[i] = 0; // no dets required
@@ -147,6 +150,39 @@ AliFlowBayesianPID::~AliFlowBayesianPID(){
   if(fBBdata) delete fBBdata;
 }
 //________________________________________________________________________
+void AliFlowBayesianPID::SetResponseParameters(){
+  // copy the parameters of the TPC and TOF response functions for the compiled kernels
+  for(Int_t ipar=0;ipar < 4;ipar++){
+    fTPCResponsePar[ipar] = fTPCResponseF->GetParameter(ipar);
+    fTOFResponsePar[ipar] = fTOFResponseF->GetParameter(ipar);
+  }
+}
+//________________________________________________________________________
+Double_t AliFlowBayesianPID::EvalResponse(const Double_t *par,Double_t x){
+  // Gaussian+tail response, same expression as fTPCResponseF/fTOFResponseF
+  // (only the branch which contributes is evaluated)
+  Double_t tail = par[1]+par[3]*par[2];
+  if(x < tail) return par[0]*TMath::Exp(-(x-par[1])*(x-par[1])/2/par[2]/par[2]);
+  if(x > tail) return par[0]*TMath::Exp(-(x-par[1]-par[3]*par[2]*0.5)*par[3]/par[2]);
+  return 0;
+}
+//________________________________________________________________________
+Double_t AliFlowBayesianPID::EvalTPCResponse(Double_t x) const{
+  if(fUseResponseFunctions) return fTPCResponseF->Eval(x);
+  return EvalResponse(fTPCResponsePar,x);
+}
+//________________________________________________________________________
+Double_t AliFlowBayesianPID::EvalTOFResponse(Double_t x) const{
+  if(fUseResponseFunctions) return fTOFResponseF->Eval(x);
+  return EvalResponse(fTOFResponsePar,x);
+}
+//________________________________________________________________________
+Double_t AliFlowBayesianPID::EvalBBdata(Double_t x) const{
+  if(fUseResponseFunctions) return fBBdata->Eval(x);
+  const Double_t *par = fBBdata->GetParameters();
+  return par[0] * AliExternalTrackParam::BetheBlochAleph(x, par[1], par[2], par[3], par[4], par[5]);
+}
+//________________________________________________________________________
 void AliFlowBayesianPID::SetDetResponse(AliESDEvent *esd,Float_t centrality,EStartTimeType_t flagStart,Bool_t){
   // Set the detector responses (including also TPC dE/dx paramterization vs. centrality)
   if(!esd){
@@ -538,6 +574,91 @@ Float_t AliFlowBayesianPID::GetExpDeDx(const AliVTrack *t,Float_t mass) const{
   return dedxExp;
 }
 //________________________________________________________________________
+void AliFlowBayesianPID::GetExpDeDx(const AliVTrack *t,Float_t *dedxExp) const{
+  // tuned dE/dx (vs. eta and centrality) for all the species, as GetExpDeDx(t,iS)
+  Float_t momtpc=t->GetTPCmomentum();
+
+  AliAnalysisManager *man=AliAnalysisManager::GetAnalysisManager();
+  AliInputEventHandler* inputHandler = (AliInputEventHandler*) (man->GetInputEventHandler());
+  AliPIDResponse *PIDResponse=inputHandler->GetPIDResponse();
+
+  if(PIDResponse && (!fForceOldDedx)){ // if PID task is running use the official TPC parameterization
+    for(Int_t iS=0;iS<fgkNspecies;iS++) dedxExp[iS]=PIDResponse->GetTPCResponse().GetExpectedSignal(t,(AliPID::EParticleType) iS,AliTPCPIDResponse::kdEdxDefault,kTRUE);
+    return;
+  }
+
+  for(Int_t iS=0;iS<7;iS++) dedxExp[iS] = fPIDesd->GetTPCResponse().GetExpectedSignal(momtpc,(AliPID::EParticleType) iS);
+  dedxExp[7] = fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[7])*5;
+  dedxExp[8] = fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[8])*5;
+
+  Float_t eta = t->Eta();
+  Float_t etaCorr = 7.98368e-03 - 1.67208e-02 - 1.89776e-01*eta*eta  -2.90836e-02*eta*eta + 5.96093e-01*eta*eta*eta*eta + 6.06450e-02*eta*eta*eta*eta - 3.55884e-01*eta*eta*eta*eta*eta*eta;
+  if(fCurrCentrality < 0){
+  }
+  else if(fCurrCentrality < 5) etaCorr += 17E-3;
+  else if(fCurrCentrality < 10) etaCorr += 21E-3;
+  else if(fCurrCentrality < 20) etaCorr += 21E-3;
+  else if(fCurrCentrality < 30) etaCorr += 21E-3;
+  else if(fCurrCentrality < 40) etaCorr += 21E-3;
+  else if(fCurrCentrality < 50) etaCorr += 14E-3;
+  else if(fCurrCentrality < 60) etaCorr += 21E-3;
+  else etaCorr += 14E-3;
+
+  for(Int_t iS=0;iS<fgkNspecies;iS++) dedxExp[iS] *= 1+etaCorr;
+
+// Add correction using the EP information (the same for all the species)
+  if(fPsi < 10){
+      Float_t corrPhi = 0;
+      Float_t deltaphi = t->Phi() - fPsi;
+      if(fCurrCentrality < 5) corrPhi = 1.29827e-02 - 1.57371e-02*fPsiRes*TMath::Cos(2*deltaphi);
+      else if(fCurrCentrality < 10) corrPhi = 1.52380e-02 - 1.45004e-02*fPsiRes*TMath::Cos(2*deltaphi);
+      else if(fCurrCentrality < 20) corrPhi = -4.91239e-02 - 1.96066e-02*fPsiRes*TMath::Cos(2*deltaphi);
+      else if(fCurrCentrality < 30) corrPhi = -3.37852e-02 - 1.48797e-02*fPsiRes*TMath::Cos(2*deltaphi);
+      else if(fCurrCentrality < 40) corrPhi = -8.49345e-02 - 2.29301e-02*fPsiRes*TMath::Cos(2*deltaphi);
+      else if(fCurrCentrality < 50) corrPhi = -6.19127e-03 - 1.52834e-02*fPsiRes*TMath::Cos(2*deltaphi);
+      else if(fCurrCentrality < 60) corrPhi = -8.90954e-02 - 1.43747e-02*fPsiRes*TMath::Cos(2*deltaphi);
+      else if(fCurrCentrality < 70) corrPhi = 1.64934e-02 - 1.43747e-02*fPsiRes*TMath::Cos(2*deltaphi);
+      else corrPhi = -1.43593e-02 - 1.43747e-02*fPsiRes*TMath::Cos(2*deltaphi);
+      Double_t shift = corrPhi * fPIDesd->GetTPCResponse().GetExpectedSignal(3.0,AliPID::kPion) * 0.07;
+      for(Int_t iS=0;iS<fgkNspecies;iS++) dedxExp[iS] += shift;
+  }
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::ComputeTPCWeights(const AliVTrack *t,Float_t dedx,Float_t momtpc){
+  // TPC weights for all the species
+  Float_t dedxExp[fgkNspecies];
+  GetExpDeDx(t,dedxExp);
+
+  Float_t centr = fCurrCentrality;
+  Double_t resolutionScale = 1.0;
+  if(centr < 0) resolutionScale = 0.78;
+  else if(centr < 10) resolutionScale = 1.0;
+  else if(centr < 20) resolutionScale = 1.0;
+  else if(centr < 30) resolutionScale = 1.0;
+  else if(centr < 40) resolutionScale = 0.95;
+  else if(centr < 50) resolutionScale = 0.93;
+  else if(centr < 60) resolutionScale = 0.91;
+  else if(centr < 70) resolutionScale = 0.88;
+  else resolutionScale = 0.83;
+
+  Float_t resolutionTPC[fgkNspecies];
+  for(Int_t iS=0;iS<7;iS++) resolutionTPC[iS] = fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),(AliPID::EParticleType) iS);
+  resolutionTPC[7] = fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[7])*5*0.07;
+  resolutionTPC[8] = fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[8])*5*0.07;
+
+  for(Int_t iS=0;iS<fgkNspecies;iS++){
+    resolutionTPC[iS] *= resolutionScale;
+    fWeights[0][iS] = EvalTPCResponse((dedx - dedxExp[iS])/resolutionTPC[iS])/resolutionTPC[iS];
+  }
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::ComputePriors(Float_t pt,Float_t *priors) const{
+  // priors for all the species (all the prior histos share the same binning)
+  Int_t binCentr = fghPriors[0]->GetXaxis()->FindBin(fCurrCentrality);
+  Int_t binPt = fghPriors[0]->GetYaxis()->FindBin(pt);
+  for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = fghPriors[iS]->GetBinContent(binCentr,binPt);
+}
+//________________________________________________________________________
 void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
   // compute Detector weights for Bayesian probablities
   Float_t centr = fCurrCentrality;
@@ -609,32 +730,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
   fDedx = dedx;
 
   if(t->GetStatus() & AliESDtrack::kTPCout && dedx > 40 && fMaskOR[0]){ // if TPC PID available    
-    for(Int_t iS=0;iS<fgkNspecies;iS++){
-      Float_t dedxExp=GetExpDeDx(t,iS);
-      
-      Float_t resolutionTPC = 1;
-      if(iS==0) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kElectron); 
-      else if(iS==1) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kMuon);
-      else if(iS==2) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kPion);
-      else if(iS==3) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kKaon);
-      else if(iS==4) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kProton);
-      else if(iS==5) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kDeuteron);
-      else if(iS==6) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kTriton);
-      else if(iS==7) resolutionTPC =  fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[7])*5*0.07;
-      else if(iS==8) resolutionTPC =  fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[8])*5*0.07;
-      
-      if(centr < 0) resolutionTPC *= 0.78;
-      if(centr < 10) resolutionTPC *= 1.0;
-      else if(centr < 20) resolutionTPC *= 1.0;
-      else if(centr < 30) resolutionTPC *= 1.0;
-      else if(centr < 40) resolutionTPC *= 0.95;
-      else if(centr < 50) resolutionTPC *= 0.93;
-      else if(centr < 60) resolutionTPC *= 0.91;
-      else if(centr < 70) resolutionTPC *= 0.88;
-      else resolutionTPC *= 0.83;
-      
-      fWeights[0][iS] = fTPCResponseF->Eval((dedx - dedxExp)/resolutionTPC)/resolutionTPC;
-    }
+    ComputeTPCWeights(t,dedx,momtpc);
     fMaskCurrent[0] = kTRUE;
   }
   else{
@@ -674,7 +770,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
       if (TMath::Abs(delta) > 5*expsigma) {
 	fWeights[1][iS] = mismfrac*mismweight;
       } else
-	fWeights[1][iS] = fTOFResponseF->Eval(delta/expsigma)/expsigma + mismfrac*mismweight;
+	fWeights[1][iS] = EvalTOFResponse(delta/expsigma)/expsigma + mismfrac*mismweight;
     }
     fMaskCurrent[1] = kTRUE;
   }
@@ -757,33 +853,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliAODTrack *t,const AliAODEvent *
 
   // TPC
   if(t->GetStatus() & AliESDtrack::kTPCout && dedx > 40 && fMaskOR[0]){ // if TPC PID available    
-    for(Int_t iS=0;iS<fgkNspecies;iS++){
-
-      Float_t dedxExp=GetExpDeDx(t,iS);
-
-      Float_t resolutionTPC = 1;
-      if(iS==0) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kElectron); 
-      else if(iS==1) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kMuon);
-      else if(iS==2) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kPion);
-      else if(iS==3) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kKaon);
-      else if(iS==4) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kProton);
-      else if(iS==5) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kDeuteron);
-      else if(iS==6) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kTriton);
-      else if(iS==7) resolutionTPC =  fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[7])*5*0.07;
-      else if(iS==8) resolutionTPC =  fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[8])*5*0.07;
-
-      if(centr < 0) resolutionTPC *= 0.78;
-      if(centr < 10) resolutionTPC *= 1.0;
-      else if(centr < 20) resolutionTPC *= 1.0;
-      else if(centr < 30) resolutionTPC *= 1.0;
-      else if(centr < 40) resolutionTPC *= 0.95;
-      else if(centr < 50) resolutionTPC *= 0.93;
-      else if(centr < 60) resolutionTPC *= 0.91;
-      else if(centr < 70) resolutionTPC *= 0.88;
-      else resolutionTPC *= 0.83;
-      
-      fWeights[0][iS] = fTPCResponseF->Eval((dedx - dedxExp)/resolutionTPC)/resolutionTPC;
-    }
+    ComputeTPCWeights(t,dedx,momtpc);
     fMaskCurrent[0] = kTRUE;
   }
   else{
@@ -850,7 +920,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliAODTrack *t,const AliAODEvent *
       if (TMath::Abs(delta) > 5*expsigma) {
 	fWeights[1][iS] = mismfrac*mismweight;
       } else
-	fWeights[1][iS] = fTOFResponseF->Eval(delta/expsigma)/expsigma + mismfrac*mismweight;
+	fWeights[1][iS] = EvalTOFResponse(delta/expsigma)/expsigma + mismfrac*mismweight;
     }
     fMaskCurrent[1] = kTRUE;
   }
@@ -875,9 +945,7 @@ void AliFlowBayesianPID::ComputeProb(const AliESDtrack *t,Float_t /*centrObsolet
   Float_t priors[fgkNspecies];
   fProbTofMism = 0;
 
-  Float_t centr = fCurrCentrality;
-
-  for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = fghPriors[iS]->GetBinContent(fghPriors[iS]->GetXaxis()->FindBin(centr),fghPriors[iS]->GetYaxis()->FindBin(t->Pt()));
+  ComputePriors(t->Pt(),priors);
 
 
   if((!fMaskAND[0] || fMaskCurrent[0]) && (!fMaskAND[1] || fMaskCurrent[1])){
@@ -920,7 +988,7 @@ void AliFlowBayesianPID::ComputeProb(const AliESDtrack *t,Float_t /*centrObsolet
     }
     fMassTOF = t->P()/beta/gamma;
     
-    Float_t bb = fBBdata->Eval(momtpc/fMassTOF);
+    Float_t bb = EvalBBdata(momtpc/fMassTOF);
     fZ = TMath::Power(t->GetTPCsignal()/bb,0.431)*t->GetSign();
 
     fMassTOF *= signMass;
@@ -938,9 +1006,7 @@ void AliFlowBayesianPID::ComputeProb(const AliAODTrack *t, const AliAODEvent *ao
   Float_t priors[fgkNspecies];
   fProbTofMism = 0;
 
-  Float_t centr = fCurrCentrality;
-
-  for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = fghPriors[iS]->GetBinContent(fghPriors[iS]->GetXaxis()->FindBin(centr),fghPriors[iS]->GetYaxis()->FindBin(t->Pt()));
+  ComputePriors(t->Pt(),priors);
 
 
   if((!fMaskAND[0] || fMaskCurrent[0]) && (!fMaskAND[1] || fMaskCurrent[1])){
@@ -994,6 +1060,22 @@ void AliFlowBayesianPID::ComputeProb(const AliAODTrack *t, const AliAODEvent *ao
   
 }
 //________________________________________________________________________
+void AliFlowBayesianPID::ComputeProb(Int_t ntracks,const AliESDtrack * const *t,Float_t *prob){
+  // compute Bayesian probablities for a batch of tracks
+  for(Int_t itrack=0;itrack < ntracks;itrack++){
+    ComputeProb(t[itrack]);
+    for(Int_t iS=0;iS<fgkNspecies;iS++) prob[itrack*fgkNspecies + iS] = fProb[iS];
+  }
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::ComputeProb(Int_t ntracks,const AliAODTrack * const *t,Float_t *prob,const AliAODEvent *aod){
+  // compute Bayesian probablities for a batch of tracks
+  for(Int_t itrack=0;itrack < ntracks;itrack++){
+    ComputeProb(t[itrack],aod);
+    for(Int_t iS=0;iS<fgkNspecies;iS++) prob[itrack*fgkNspecies + iS] = fProb[iS];
+  }
+}
+//________________________________________________________________________
 void AliFlowBayesianPID::SetPsiCorrectionDeDx(Float_t psi,Float_t res){
   fPsi=psi;
   fPsiRes=res;
@@ -68,6 +68,15 @@ More details:
      TH2D *hPr = mypid->GetHistoPriors(isp); // 2D (centrality - pT) histo for the priors of specie-isp (centrality < 0 means pp collisions)
                                              // all the priors are normalized to the pion ones
 
+for a batch of tracks (probabilities stored as prob[itrack*AliFlowBayesianPID::GetNspecies() + isp])
+
+     mypid->ComputeProb(ntracks,tracks,prob);
+
+The detector responses are evaluated with compiled kernels using the parameters of the TF1 objects above.
+The TF1 evaluation can be switched on as a reference for validation
+
+  mypid->SetUseResponseFunctions();
+
 */
 
 class AliFlowBayesianPID : public AliPIDResponse{
@@ -88,6 +97,7 @@ class AliFlowBayesianPID : public AliPIDResponse{
   void ResetDetOR(Int_t idet){if(idet < fgkNdetectors && idet >= 0) fMaskOR[idet] = kFALSE;};
   void SetPsiCorrectionDeDx(Float_t psi,Float_t res);
   void SetMC(Bool_t flag){fIsMC=flag;};
+  void SetUseResponseFunctions(Bool_t flag=kTRUE){fUseResponseFunctions=flag;}; // evaluate the TF1 response objects (reference) instead of the compiled kernels
 
   // getter
   AliESDpid* GetESDpid(){return fPIDesd;};
@@ -107,6 +117,9 @@ class AliFlowBayesianPID : public AliPIDResponse{
 
   Float_t GetExpDeDx(const AliVTrack *t,Int_t iS) const;
   Float_t GetExpDeDx(const AliVTrack *t,Float_t m) const;
+  void GetExpDeDx(const AliVTrack *t,Float_t *dedxExp) const; // all species at once
+
+  static Int_t GetNspecies() {return fgkNspecies;};
 
   // methods for Bayesina Combined PID
   void ComputeWeights(const AliESDtrack *t);
@@ -114,6 +127,8 @@ class AliFlowBayesianPID : public AliPIDResponse{
   void ComputeProb(const AliESDtrack *t){ComputeProb(t,0.0);}; 
   void ComputeWeights(const AliAODTrack *t,const AliAODEvent *aod=NULL);
   void ComputeProb(const AliAODTrack *t,const AliAODEvent *aod=NULL); // obsolete method
+  void ComputeProb(Int_t ntracks,const AliESDtrack * const *t,Float_t *prob); // batch: prob[itrack*fgkNspecies + iS]
+  void ComputeProb(Int_t ntracks,const AliAODTrack * const *t,Float_t *prob,const AliAODEvent *aod=NULL); // batch: prob[itrack*fgkNspecies + iS]
 
   void SetTOFres(Float_t res){fTOFresolution=res;};
 
@@ -123,6 +138,13 @@ class AliFlowBayesianPID : public AliPIDResponse{
 
  private: 
   void SetPriors();
+  void SetResponseParameters();
+  void ComputeTPCWeights(const AliVTrack *t,Float_t dedx,Float_t momtpc);
+  void ComputePriors(Float_t pt,Float_t *priors) const;
+  Double_t EvalTPCResponse(Double_t x) const;
+  Double_t EvalTOFResponse(Double_t x) const;
+  Double_t EvalBBdata(Double_t x) const;
+  static Double_t EvalResponse(const Double_t *par,Double_t x);
 
   static const Int_t fgkNdetectors = 2; // Number of detector used for PID
   static const Int_t fgkNspecies = 9;// 0=el, 1=mu, 2=pi, 3=ka, 4=pr, 5=deuteron, 6=triton, 7=He3 
@@ -164,7 +186,11 @@ class AliFlowBayesianPID : public AliPIDResponse{
 
   static TH1D *fgHtofChannelDist; // channel distance from IP
 
-  ClassDef(AliFlowBayesianPID, 10); // example of analysis
+  Bool_t fUseResponseFunctions; // switch to evaluate the TF1 response objects instead of the compiled kernels
+  Double_t fTPCResponsePar[4]; //! parameters of fTPCResponseF for the compiled kernel
+  Double_t fTOFResponsePar[4]; //! parameters of fTOFResponseF for the compiled kernel
+
+  ClassDef(AliFlowBayesianPID, 11); // example of analysis
 };
 
 #endif
@@ -24,6 +24,8 @@
 ClassImp(AliEmcalJet);
 /// \endcond
 
+const Int_t AliEmcalJet::fgkMaxIndexBitsRange = 1 << 16;
+
 /**
  * Default constructor
  */
@@ -62,7 +64,18 @@ AliEmcalJet::AliEmcalJet() :
   fHasGhost(kFALSE),
   fGhosts(),
   fJetShapeProperties(0),
-  fJetAcceptanceType(0)
+  fJetAcceptanceType(0),
+  fConstituentCacheValid(kFALSE),
+  fCachedTrackPt(),
+  fCachedTrackEta(),
+  fCachedTrackPhi(),
+  fCachedTrackM(),
+  fCachedTrackCharge(),
+  fCachedTrackPtOrder(),
+  fTrackIDBits(),
+  fTrackIDBitsOffset(-1),
+  fClusterIDBits(),
+  fClusterIDBitsOffset(-1)
 {
   fClosestJets[0] = 0;
   fClosestJets[1] = 0;
@@ -112,7 +125,18 @@ AliEmcalJet::AliEmcalJet(Double_t px, Double_t py, Double_t pz) :
   fHasGhost(kFALSE),
   fGhosts(),
   fJetShapeProperties(0),
-  fJetAcceptanceType(0)
+  fJetAcceptanceType(0),
+  fConstituentCacheValid(kFALSE),
+  fCachedTrackPt(),
+  fCachedTrackEta(),
+  fCachedTrackPhi(),
+  fCachedTrackM(),
+  fCachedTrackCharge(),
+  fCachedTrackPtOrder(),
+  fTrackIDBits(),
+  fTrackIDBitsOffset(-1),
+  fClusterIDBits(),
+  fClusterIDBitsOffset(-1)
 {
   if (fPt != 0) {
     fPhi = TVector2::Phi_0_2pi(TMath::ATan2(py, px));
@@ -167,7 +191,18 @@ AliEmcalJet::AliEmcalJet(Double_t pt, Double_t eta, Double_t phi, Double_t m) :
   fHasGhost(kFALSE),
   fGhosts(),
   fJetShapeProperties(0),
-  fJetAcceptanceType(0)
+  fJetAcceptanceType(0),
+  fConstituentCacheValid(kFALSE),
+  fCachedTrackPt(),
+  fCachedTrackEta(),
+  fCachedTrackPhi(),
+  fCachedTrackM(),
+  fCachedTrackCharge(),
+  fCachedTrackPtOrder(),
+  fTrackIDBits(),
+  fTrackIDBitsOffset(-1),
+  fClusterIDBits(),
+  fClusterIDBitsOffset(-1)
 {
   fPhi = TVector2::Phi_0_2pi(fPhi);
 
@@ -216,7 +251,18 @@ AliEmcalJet::AliEmcalJet(const AliEmcalJet& jet) :
   fHasGhost(jet.fHasGhost),
   fGhosts(jet.fGhosts),
   fJetShapeProperties(0),
-  fJetAcceptanceType(jet.fJetAcceptanceType)
+  fJetAcceptanceType(jet.fJetAcceptanceType),
+  fConstituentCacheValid(jet.fConstituentCacheValid),
+  fCachedTrackPt(jet.fCachedTrackPt),
+  fCachedTrackEta(jet.fCachedTrackEta),
+  fCachedTrackPhi(jet.fCachedTrackPhi),
+  fCachedTrackM(jet.fCachedTrackM),
+  fCachedTrackCharge(jet.fCachedTrackCharge),
+  fCachedTrackPtOrder(jet.fCachedTrackPtOrder),
+  fTrackIDBits(jet.fTrackIDBits),
+  fTrackIDBitsOffset(jet.fTrackIDBitsOffset),
+  fClusterIDBits(jet.fClusterIDBits),
+  fClusterIDBitsOffset(jet.fClusterIDBitsOffset)
 {
   // Copy constructor.
   fClosestJets[0]     = jet.fClosestJets[0];
@@ -285,6 +331,17 @@ AliEmcalJet& AliEmcalJet::operator=(const AliEmcalJet& jet)
       fJetShapeProperties = new AliEmcalJetShapeProperties(*(jet.fJetShapeProperties));
     }
     fJetAcceptanceType  = jet.fJetAcceptanceType;
+    fConstituentCacheValid = jet.fConstituentCacheValid;
+    fCachedTrackPt      = jet.fCachedTrackPt;
+    fCachedTrackEta     = jet.fCachedTrackEta;
+    fCachedTrackPhi     = jet.fCachedTrackPhi;
+    fCachedTrackM       = jet.fCachedTrackM;
+    fCachedTrackCharge  = jet.fCachedTrackCharge;
+    fCachedTrackPtOrder = jet.fCachedTrackPtOrder;
+    fTrackIDBits        = jet.fTrackIDBits;
+    fTrackIDBitsOffset  = jet.fTrackIDBitsOffset;
+    fClusterIDBits      = jet.fClusterIDBits;
+    fClusterIDBitsOffset = jet.fClusterIDBitsOffset;
   }
 
   return *this;
@@ -379,7 +436,35 @@ TLorentzVector AliEmcalJet::SubtractRhoVect(Double_t rho, Bool_t save)
 void AliEmcalJet::SortConstituents()
 {
   std::sort(fClusterIDs.GetArray(), fClusterIDs.GetArray() + fClusterIDs.GetSize());
-  std::sort(fTrackIDs.GetArray(), fTrackIDs.GetArray() + fTrackIDs.GetSize());
+
+  Int_t nt = fTrackIDs.GetSize();
+  if (nt == 0 || fCachedTrackPt.size() != static_cast<UInt_t>(nt)) {
+    std::sort(fTrackIDs.GetArray(), fTrackIDs.GetArray() + nt);
+    return;
+  }
+
+  // Keep the cached kinematics aligned with the sorted track ids
+  std::vector<std::pair<Int_t, Int_t> > order(nt);
+  for (Int_t i = 0; i < nt; i++) order[i] = std::make_pair(fTrackIDs[i], i);
+  std::sort(order.begin(), order.end());
+
+  std::vector<Double_t> pt(nt), eta(nt), phi(nt), m(nt);
+  std::vector<Short_t> charge(nt);
+  for (Int_t i = 0; i < nt; i++) {
+    Int_t j = order[i].second;
+    fTrackIDs[i] = order[i].first;
+    pt[i] = fCachedTrackPt[j];
+    eta[i] = fCachedTrackEta[j];
+    phi[i] = fCachedTrackPhi[j];
+    m[i] = fCachedTrackM[j];
+    charge[i] = fCachedTrackCharge[j];
+  }
+  fCachedTrackPt.swap(pt);
+  fCachedTrackEta.swap(eta);
+  fCachedTrackPhi.swap(phi);
+  fCachedTrackM.swap(m);
+  fCachedTrackCharge.swap(charge);
+  fConstituentCacheValid = kFALSE;
 }
 
 /**
@@ -412,6 +497,8 @@ Double_t AliEmcalJet::DeltaR(const AliVParticle* part) const
  */
 std::vector<int> AliEmcalJet::GetPtSortedTrackConstituentIndexes(TClonesArray* tracks) const
 {
+  if (fConstituentCacheValid) return std::vector<int>(fCachedTrackPtOrder.begin(), fCachedTrackPtOrder.end());
+
   typedef std::pair<Double_t, Int_t> ptidx_pair;
 
   // Create vector for Pt sorting
@@ -437,6 +524,104 @@ std::vector<int> AliEmcalJet::GetPtSortedTrackConstituentIndexes(TClonesArray* t
   return index_sorted_list;
 }
 
+/**
+ * Remove the constituent cache and the membership bitmaps.
+ */
+void AliEmcalJet::ResetConstituentCache()
+{
+  fConstituentCacheValid = kFALSE;
+  fCachedTrackPt.clear();
+  fCachedTrackEta.clear();
+  fCachedTrackPhi.clear();
+  fCachedTrackM.clear();
+  fCachedTrackCharge.clear();
+  fCachedTrackPtOrder.clear();
+  fTrackIDBits.ResetAllBits();
+  fTrackIDBitsOffset = -1;
+  fClusterIDBits.ResetAllBits();
+  fClusterIDBitsOffset = -1;
+}
+
+/**
+ * Store the kinematics of a track constituent in the constituent cache.
+ * This function should be called by the jet finder together with AddTrackAt(), using the same position.
+ * The cache becomes available only after BuildConstituentCache() is called.
+ * @param idx Position of the track constituent (as in AddTrackAt())
+ * @param pt Transverse momentum of the constituent
+ * @param eta Pseudo-rapidity of the constituent
+ * @param phi Azimuthal angle of the constituent
+ * @param m Mass of the constituent
+ * @param charge Charge of the constituent
+ */
+void AliEmcalJet::SetTrackConstituentKinematics(Int_t idx, Double_t pt, Double_t eta, Double_t phi, Double_t m, Short_t charge)
+{
+  if (idx < 0) return;
+  if (fCachedTrackPt.size() <= static_cast<UInt_t>(idx)) {
+    fCachedTrackPt.resize(idx + 1, 0.);
+    fCachedTrackEta.resize(idx + 1, 0.);
+    fCachedTrackPhi.resize(idx + 1, 0.);
+    fCachedTrackM.resize(idx + 1, 0.);
+    fCachedTrackCharge.resize(idx + 1, 0);
+  }
+  fCachedTrackPt[idx] = pt;
+  fCachedTrackEta[idx] = eta;
+  fCachedTrackPhi[idx] = phi;
+  fCachedTrackM[idx] = m;
+  fCachedTrackCharge[idx] = charge;
+  fConstituentCacheValid = kFALSE;
+}
+
+/**
+ * Finalize the constituent cache once all the constituents are set (and sorted, if needed):
+ * the pt-sorted view of the track constituents and the membership bitmaps of the track and
+ * cluster ids are built. ContainsTrack(Int_t) and ContainsCluster(Int_t) use the bitmaps
+ * to reject non-constituents in constant time, GetPtSortedTrackConstituentIndexes()
+ * returns the cached order. The kinematic cache is only enabled if the kinematics of
+ * all the track constituents were set with SetTrackConstituentKinematics().
+ */
+void AliEmcalJet::BuildConstituentCache()
+{
+  fTrackIDBitsOffset = FillIndexBits(fTrackIDs, fTrackIDBits);
+  fClusterIDBitsOffset = FillIndexBits(fClusterIDs, fClusterIDBits);
+
+  Int_t nt = fTrackIDs.GetSize();
+  fCachedTrackPtOrder.clear();
+  fConstituentCacheValid = (fCachedTrackPt.size() == static_cast<UInt_t>(nt));
+  if (!fConstituentCacheValid) return;
+
+  // same ordering as GetPtSortedTrackConstituentIndexes()
+  std::vector<std::pair<Double_t, Int_t> > pair_list(nt);
+  for (Int_t i = 0; i < nt; i++) pair_list[i] = std::make_pair(fCachedTrackPt[i], i);
+  std::stable_sort(pair_list.begin(), pair_list.end(), sort_descend());
+
+  fCachedTrackPtOrder.resize(nt);
+  for (Int_t i = 0; i < nt; i++) fCachedTrackPtOrder[i] = pair_list[i].second;
+}
+
+/**
+ * Fill a membership bitmap for a list of constituent ids.
+ * @param ids Constituent ids
+ * @param bits Bitmap to be filled, bit i corresponds to the id offset + i
+ * @return Offset of the bitmap (smallest id), -1 if the ids span a range too large for a bitmap
+ */
+Int_t AliEmcalJet::FillIndexBits(const TArrayI& ids, TBits& bits)
+{
+  bits.ResetAllBits();
+  Int_t n = ids.GetSize();
+  if (n == 0) return 0;
+
+  Int_t min = ids[0];
+  Int_t max = ids[0];
+  for (Int_t i = 1; i < n; i++) {
+    if (ids[i] < min) min = ids[i];
+    if (ids[i] > max) max = ids[i];
+  }
+  if (min < 0 || max - min >= fgkMaxIndexBitsRange) return -1;
+
+  for (Int_t i = 0; i < n; i++) bits.SetBitNumber(ids[i] - min);
+  return min;
+}
+
 /**
  * Get the momentum fraction of a jet constituent
  * @param trkPx First transverse component of the momentum of the jet constituent
@@ -531,6 +716,7 @@ void AliEmcalJet::ResetMatching()
  */
 Int_t AliEmcalJet::ContainsTrack(Int_t it) const
 {
+  if (fTrackIDBitsOffset >= 0 && (it < fTrackIDBitsOffset || !fTrackIDBits.TestBitNumber(it - fTrackIDBitsOffset))) return -1;
   for (Int_t i = 0; i < fTrackIDs.GetSize(); i++) {
     if (it == fTrackIDs[i]) return i;
   }
@@ -544,6 +730,7 @@ Int_t AliEmcalJet::ContainsTrack(Int_t it) const
  */
 Int_t AliEmcalJet::ContainsCluster(Int_t ic) const
 {
+  if (fClusterIDBitsOffset >= 0 && (ic < fClusterIDBitsOffset || !fClusterIDBits.TestBitNumber(ic - fClusterIDBitsOffset))) return -1;
   for (Int_t i = 0; i < fClusterIDs.GetSize(); i++) {
     if (ic == fClusterIDs[i]) return i;
   }
@@ -670,6 +857,7 @@ void AliEmcalJet::Clear(Option_t */*option*/)
   fPtSub = 0;
   fGhosts.clear();
   fHasGhost = kFALSE;
+  ResetConstituentCache();
 }
 
 /**
@@ -9,6 +9,7 @@
 
 #include <iosfwd>
 #include <TArrayI.h>
+#include <TBits.h>
 #include <TMath.h>
 #include <TClonesArray.h>
 #include <TVector2.h>
@@ -190,8 +191,8 @@ class AliEmcalJet : public AliVParticle
   void              SetMaxNeutralPt(Double32_t t)      { fMaxNPt  = t;                     }
   void              SetMaxChargedPt(Double32_t t)      { fMaxCPt  = t;                     }
   void              SetNEF(Double_t nef)               { fNEF     = nef;                   }
-  void              SetNumberOfClusters(Int_t n)       { fClusterIDs.Set(n);               }
-  void              SetNumberOfTracks(Int_t n)         { fTrackIDs.Set(n);                 }
+  void              SetNumberOfClusters(Int_t n)       { fClusterIDs.Set(n); fClusterIDBitsOffset = -1;                        }
+  void              SetNumberOfTracks(Int_t n)         { fTrackIDs.Set(n); fTrackIDBitsOffset = -1; fConstituentCacheValid = kFALSE; }
   void              SetNumberOfCharged(Int_t n)        { fNch = n;                         }
   void              SetNumberOfNeutrals(Int_t n)       { fNn = n;                          }
   void              SetMCPt(Double_t p)                { fMCPt = p;                        }
@@ -199,14 +200,31 @@ class AliEmcalJet : public AliVParticle
   void              SetPtEmc(Double_t pt)              { fPtEmc          = pt;             }
   void              SetPtSub(Double_t ps)              { fPtSub          = ps;             }
   void              SetPtSubVect(Double_t ps)          { fPtSubVect      = ps;             }
-  void              AddClusterAt(Int_t clus, Int_t idx){ fClusterIDs.AddAt(clus, idx);     }
-  void              AddTrackAt(Int_t track, Int_t idx) { fTrackIDs.AddAt(track, idx);      }
+  void              AddClusterAt(Int_t clus, Int_t idx){ fClusterIDs.AddAt(clus, idx); fClusterIDBitsOffset = -1;                        }
+  void              AddTrackAt(Int_t track, Int_t idx) { fTrackIDs.AddAt(track, idx); fTrackIDBitsOffset = -1; fConstituentCacheValid = kFALSE; }
   void              Clear(Option_t */*option*/="");
 
   // Sorting methods
   void              SortConstituents();
   std::vector<int>  GetPtSortedTrackConstituentIndexes(TClonesArray *tracks) const;
 
+  // Constituent cache (optional, transient)
+  void              ResetConstituentCache();
+  void              SetTrackConstituentKinematics(Int_t idx, Double_t pt, Double_t eta, Double_t phi, Double_t m, Short_t charge);
+  void              BuildConstituentCache();
+  Bool_t            HasConstituentCache()                          const { return fConstituentCacheValid        ; }
+  Double_t          CachedTrackPt(Int_t idx)                       const { return fCachedTrackPt[idx]           ; }
+  Double_t          CachedTrackEta(Int_t idx)                      const { return fCachedTrackEta[idx]          ; }
+  Double_t          CachedTrackPhi(Int_t idx)                      const { return fCachedTrackPhi[idx]          ; }
+  Double_t          CachedTrackM(Int_t idx)                        const { return fCachedTrackM[idx]            ; }
+  Short_t           CachedTrackCharge(Int_t idx)                   const { return fCachedTrackCharge[idx]       ; }
+  const std::vector<Double_t>& GetCachedTrackPt()                  const { return fCachedTrackPt                ; }
+  const std::vector<Double_t>& GetCachedTrackEta()                 const { return fCachedTrackEta               ; }
+  const std::vector<Double_t>& GetCachedTrackPhi()                 const { return fCachedTrackPhi               ; }
+  const std::vector<Double_t>& GetCachedTrackM()                   const { return fCachedTrackM                 ; }
+  const std::vector<Short_t>&  GetCachedTrackCharge()              const { return fCachedTrackCharge            ; }
+  const std::vector<Int_t>&    GetCachedPtSortedTrackIndexes()     const { return fCachedTrackPtOrder           ; }
+
   // Trigger
   Bool_t            IsTriggerJet(UInt_t trigger=AliVEvent::kEMCEJE) const   { return (Bool_t)((fTriggers & trigger) != 0); }
   void              SetTrigger(UInt_t trigger)                              { fTriggers  = trigger;                        }
@@ -313,7 +331,23 @@ class AliEmcalJet : public AliVParticle
   AliEmcalJetShapeProperties *fJetShapeProperties; //!<! Pointer to the jet shape properties
   UInt_t fJetAcceptanceType;    //!<!  Jet acceptance type (stored bitwise)
 
+  Bool_t                fConstituentCacheValid; //!<! Whether the constituent cache is filled and consistent with fTrackIDs
+  std::vector<Double_t> fCachedTrackPt;         //!<! Cached pt of the track constituents (same order as fTrackIDs)
+  std::vector<Double_t> fCachedTrackEta;        //!<! Cached eta of the track constituents
+  std::vector<Double_t> fCachedTrackPhi;        //!<! Cached phi of the track constituents
+  std::vector<Double_t> fCachedTrackM;          //!<! Cached mass of the track constituents
+  std::vector<Short_t>  fCachedTrackCharge;     //!<! Cached charge of the track constituents
+  std::vector<Int_t>    fCachedTrackPtOrder;    //!<! Positions of the track constituents sorted by decreasing pt
+  TBits                 fTrackIDBits;           //!<! Membership bitmap of the track ids, relative to fTrackIDBitsOffset
+  Int_t                 fTrackIDBitsOffset;     //!<! Smallest track id, -1 if no bitmap is available
+  TBits                 fClusterIDBits;         //!<! Membership bitmap of the cluster ids, relative to fClusterIDBitsOffset
+  Int_t                 fClusterIDBitsOffset;   //!<! Smallest cluster id, -1 if no bitmap is available
+
  private:
+  static Int_t      FillIndexBits(const TArrayI& ids, TBits& bits);
+
+  static const Int_t fgkMaxIndexBitsRange;  ///< Largest id range covered by the membership bitmaps
+
   /**
    * @struct sort_descend
    * @brief Simple C structure to allow sorting in descending order
@@ -324,7 +358,7 @@ class AliEmcalJet : public AliVParticle
   };
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJet,19);
+  ClassDef(AliEmcalJet,20);
   /// \endcond
 };
 
@@ -6,6 +6,9 @@
 // A local value of rho is evaluated in area phi-r, phi+r where r is a user defined
 // parameter (e.g. a jet radius)
 // Functions are implemented inline for optimization.
+// The producing task can in addition pass the fourier coefficients of the function
+// (SetLocalRhoFourier, AddLocalRhoHarmonic), in which case rho and its integrals are
+// evaluated directly from the coefficients instead of through the TF1.
 //
 // Author: Redmer Alexander Bertens, Utrecht University, Utrecht, Netherlands
 //         (rbertens@cern.ch, rbertens@nikhef.nl, r.a.bertens@uu.nl)
@@ -18,15 +21,51 @@ ClassImp(AliLocalRhoParameter)
 //________________________________________________________________________
 AliLocalRhoParameter::AliLocalRhoParameter() : 
   AliRhoParameter(),
-  fLocalRho(0) 
+  fLocalRho(0),
+  fNHarmonics(-1),
+  fFourierNorm(0),
+  fFourierConst(0)
 { 
   // Constructor for root IO. 
+  for(Int_t i(0); i < kMaxHarmonics; i++) fHarmonicOrder[i] = fHarmonicAmp[i] = fHarmonicPsi[i] = 0;
 }
 
 //________________________________________________________________________
 AliLocalRhoParameter::AliLocalRhoParameter(const char* name, Double_t val) : 
   AliRhoParameter(name, val), 
-  fLocalRho(0x0)
+  fLocalRho(0x0),
+  fNHarmonics(-1),
+  fFourierNorm(0),
+  fFourierConst(0)
 { 
   // Constructor
+  for(Int_t i(0); i < kMaxHarmonics; i++) fHarmonicOrder[i] = fHarmonicAmp[i] = fHarmonicPsi[i] = 0;
+}
+
+//________________________________________________________________________
+void AliLocalRhoParameter::SetLocalRhoFromModulationFit(TF1* f, Int_t fitType)
+{
+  // set the local rho function and, if the parameter layout of the fit type is
+  // known, its fourier coefficients. the layouts are
+  //   kModulationNoFit         [0]
+  //   kModulationV2, V3        [0]*([1]+[2]*[3]*cos([2]*(x-[4])))
+  //   combined (all others)    [0]*([1]+[2]*([3]*cos([2]*(x-[4]))+[7]*cos([5]*(x-[6]))))
+  SetLocalRho(f);
+  if(!f) return;
+  switch (fitType) {
+    case kModulationNoFit : {
+      if(f->GetNpar() == 1) SetLocalRhoFourier(f->GetParameter(0), 1.);
+    } break;
+    case kModulationV2 : case kModulationV3 : {
+      if(f->GetNpar() != 5) break;
+      SetLocalRhoFourier(f->GetParameter(0), f->GetParameter(1));
+      AddLocalRhoHarmonic(f->GetParameter(2), f->GetParameter(2)*f->GetParameter(3), f->GetParameter(4));
+    } break;
+    default : {
+      if(f->GetNpar() != 8) break;
+      SetLocalRhoFourier(f->GetParameter(0), f->GetParameter(1));
+      AddLocalRhoHarmonic(f->GetParameter(2), f->GetParameter(2)*f->GetParameter(3), f->GetParameter(4));
+      AddLocalRhoHarmonic(f->GetParameter(5), f->GetParameter(2)*f->GetParameter(7), f->GetParameter(6));
+    } break;
+  }
 }
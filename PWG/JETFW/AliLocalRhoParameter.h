@@ -11,9 +11,60 @@ class AliLocalRhoParameter : public AliRhoParameter {
  public: 
   AliLocalRhoParameter();
   AliLocalRhoParameter(const char* name, Double_t val);
-  void     SetLocalRho(TF1* f)             { fLocalRho = f;        }
+  enum { kMaxHarmonics = 4 };
+  // fit types of the producing tasks (fitModulationType), only those with a known
+  // parameter layout are listed, all others are treated as the combined v2 + v3 fit
+  enum { kModulationNoFit = 0, kModulationV2 = 1, kModulationV3 = 2 };
+
+  void     SetLocalRho(TF1* f)             { fLocalRho = f; fNHarmonics = -1; }
   TF1*     GetLocalRho() const             { return fLocalRho;     }
+  void     SetLocalRhoFromModulationFit(TF1* f, Int_t fitType);
+  void     SetLocalRhoFourier(Double_t norm, Double_t c) {
+      // plain fourier representation of the local rho function,
+      // rho(phi) = norm * (c + sum_k a_k cos(n_k (phi - psi_k))) with the terms 
+      // added via AddLocalRhoHarmonic. has to be called after SetLocalRho
+      fFourierNorm = norm; fFourierConst = c; fNHarmonics = 0;
+  }
+  Bool_t   AddLocalRhoHarmonic(Double_t n, Double_t a, Double_t psi) {
+      if(fNHarmonics < 0 || fNHarmonics >= kMaxHarmonics) return kFALSE;
+      fHarmonicOrder[fNHarmonics] = n; fHarmonicAmp[fNHarmonics] = a; fHarmonicPsi[fNHarmonics] = psi;
+      fNHarmonics++;
+      return kTRUE;
+  }
+  Bool_t   HasLocalRhoFourier() const      { return fNHarmonics >= 0; }
+  Int_t    GetNHarmonics() const           { return fNHarmonics;   }
+  Double_t GetHarmonicOrder(Int_t i) const { return fHarmonicOrder[i]; }
+  Double_t GetHarmonicAmp(Int_t i) const   { return fHarmonicAmp[i]; }
+  Double_t GetHarmonicPsi(Int_t i) const   { return fHarmonicPsi[i]; }
+  Double_t EvalLocalRho(Double_t phi) const {
+      // rho at phi, from the fourier coefficients if available
+      if(!HasLocalRhoFourier()) return (fLocalRho) ? fLocalRho->Eval(phi) : GetVal();
+      Double_t sum(fFourierConst);
+      for(Int_t i(0); i < fNHarmonics; i++) sum += fHarmonicAmp[i]*TMath::Cos(fHarmonicOrder[i]*(phi-fHarmonicPsi[i]));
+      return fFourierNorm*sum;
+  }
+  Double_t IntegralLocalRho(Double_t a, Double_t b) const {
+      // integral of rho from a to b, analytic if the fourier coefficients are available
+      if(!HasLocalRhoFourier()) return (fLocalRho) ? fLocalRho->Integral(a, b) : GetVal()*(b-a);
+      Double_t sum(fFourierConst*(b-a));
+      for(Int_t i(0); i < fNHarmonics; i++) {
+          Double_t n(fHarmonicOrder[i]);
+          if(n == 0) sum += fHarmonicAmp[i]*(b-a);
+          else sum += fHarmonicAmp[i]*(TMath::Sin(n*(b-fHarmonicPsi[i]))-TMath::Sin(n*(a-fHarmonicPsi[i])))/n;
+      }
+      return fFourierNorm*sum;
+  }
   Double_t GetLocalVal(Double_t phi, Double_t r, Double_t n) const {
+    if(HasLocalRhoFourier()) {
+      // average of rho over [phi-r, phi+r] in closed form, the normalization drops out
+      if(r*fFourierNorm <= 0.) return GetVal();
+      Double_t sum(fFourierConst);
+      for(Int_t i(0); i < fNHarmonics; i++) {
+        Double_t nr(fHarmonicOrder[i]*r);
+        sum += fHarmonicAmp[i]*TMath::Cos(fHarmonicOrder[i]*(phi-fHarmonicPsi[i]))*((nr == 0) ? 1. : TMath::Sin(nr)/nr);
+      }
+      return n*sum;
+    }
     if(!fLocalRho) return GetVal();
     Double_t denom(2*r*fLocalRho->GetParameter(0));
     return  (denom <= 0.) ? GetVal() : n*(fLocalRho->Integral(phi-r, phi+r)/denom); 
@@ -29,8 +80,8 @@ class AliLocalRhoParameter : public AliRhoParameter {
   Double_t GetLocalValInEtaPhi(Double_t phi, Double_t r, Double_t n, Int_t gran = 20) const {
       // numerical approximation for integrating over a circular area in eta phi
       // instead of 'rectangle' around phi - gran determines step size of integral
-      if(!fLocalRho) return GetVal();       // fallback value
-      Double_t denom(2*r*fLocalRho->GetParameter(0));
+      if(!fLocalRho && !HasLocalRhoFourier()) return GetVal();       // fallback value
+      Double_t denom(2*r*((HasLocalRhoFourier()) ? fFourierNorm : fLocalRho->GetParameter(0)));
       if (denom < 0) return GetVal();
       Double_t sum(0), sumWeight(0), weight(0);
       // make sure gran is an even number and then divide it by two 
@@ -42,8 +93,8 @@ class AliLocalRhoParameter : public AliRhoParameter {
           // fraction of the circle that covers a given eta, phi region set by the granularity
           weight = TMath::Sqrt(r*r-((r/(double)gran)*(double)i)*(r/(double)gran)*(double)i);
           sumWeight+=weight;
-          sum += TMath::Abs(weight * fLocalRho->Integral(phi + (r/(double)gran)*(double)(i), phi + (r/(double)gran)*(double)(i+1)));
-          sum += TMath::Abs(weight * fLocalRho->Integral(phi - (r/(double)gran)*(double)(i), phi - (r/(double)gran)*(double)(i+1)));
+          sum += TMath::Abs(weight * IntegralLocalRho(phi + (r/(double)gran)*(double)(i), phi + (r/(double)gran)*(double)(i+1)));
+          sum += TMath::Abs(weight * IntegralLocalRho(phi - (r/(double)gran)*(double)(i), phi - (r/(double)gran)*(double)(i+1)));
       }
       if(sumWeight>0) sum/=sumWeight;
       else return GetVal();
@@ -60,6 +111,12 @@ class AliLocalRhoParameter : public AliRhoParameter {
   }
  private:
   TF1*     fLocalRho;      // ! rho as function of phi
+  Int_t    fNHarmonics;    // ! number of fourier terms, -1 if only the function is available
+  Double_t fFourierNorm;   // ! normalization of the fourier representation
+  Double_t fFourierConst;  // ! constant term of the fourier representation
+  Double_t fHarmonicOrder[kMaxHarmonics]; // ! harmonic numbers n_k
+  Double_t fHarmonicAmp[kMaxHarmonics];   // ! amplitudes a_k
+  Double_t fHarmonicPsi[kMaxHarmonics];   // ! symmetry planes psi_k
 
   AliLocalRhoParameter(const AliLocalRhoParameter&);             // not implemented
   AliLocalRhoParameter& operator=(const AliLocalRhoParameter&);  // not implemented
@@ -31,6 +31,11 @@
  * - \ref Event to access the current event
  * - \ref MCEvent to access to current MC event (if available)
  *
+ * In their Fill methods, daughter classes should prefer the TableHisto/TableProf family
+ * over Histo/Prof : the histogram ids are registered once in \ref DefineHistoTableIds,
+ * all the histograms of a path are looked up once per run (see \ref SetHistoTablePath),
+ * and later accesses are a plain index computation.
+ *
  * A few trivial cut methods (\ref AlwaysTrue and \ref AlwaysFalse) are defined as well and
  * can be used to register some control cut combinations (see \ref AliAnalysisMuMuCutCombination)
  *
@@ -39,6 +44,7 @@
 #include "AliMergeableCollection.h"
 #include "AliCounterCollection.h"
 #include "TList.h"
+#include "THashList.h"
 #include "TObjString.h"
 #include "TMath.h"
 #include "TObjArray.h"
@@ -55,6 +61,7 @@
 #include "AliLog.h"
 #include "AliAnalysisMuMuCutCombination.h"
 #include "AliAnalysisMuMuCutRegistry.h"
+#include <algorithm>
 
 ClassImp(AliAnalysisMuMuBase)
 
@@ -69,11 +76,34 @@ fCutRegistry(0x0),
 fEvent(0x0),
 fMCEvent(0x0),
 fHistogramToDisable(0x0),
-fHasMC(kFALSE)
+fHasMC(kFALSE),
+fHistoTableIdsDefined(kFALSE),
+fHistoTableNames(0x0),
+fHistoTableIds(0x0),
+fHistoTableFolders(0x0),
+fHistoTableCutType(-1),
+fHistoTable(),
+fHistoTableResolved(),
+fHistoTableNEventSelections(0),
+fHistoTableNCentralities(0),
+fHistoTableNFolders(0),
+fHistoTableNHistos(0),
+fHistoTableBlockSize(0),
+fHistoTableBlock(0x0),
+fHistoTableCut(-1)
 {
  /// default ctor
 }
 
+//_____________________________________________________________________________
+AliAnalysisMuMuBase::~AliAnalysisMuMuBase()
+{
+  /// dtor
+  delete fHistoTableIds;
+  delete fHistoTableNames;
+  delete fHistoTableFolders;
+}
+
 //_____________________________________________________________________________
 TString AliAnalysisMuMuBase::BuildPath(const char* eventSelection, const char* triggerClassName,
                                        const char* centrality, const char* cut) const
@@ -429,6 +459,185 @@ Int_t AliAnalysisMuMuBase::GetNbins(Double_t xmin, Double_t xmax, Double_t xstep
   return TMath::Nint(TMath::Abs((xmax-xmin)/xstep));
 }
 
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBase::HistoTableId(const char* histoname)
+{
+  /// Get the table id of a histogram name, registering it if needed.
+  /// Ids have to be registered from DefineHistoTableIds and kept by
+  /// the daughter class : this method does a hash lookup.
+
+  if (!fHistoTableNames)
+  {
+    fHistoTableNames = new THashList;
+    fHistoTableNames->SetOwner(kTRUE);
+    fHistoTableIds = new TObjArray;
+  }
+
+  TObject* o = fHistoTableNames->FindObject(histoname);
+
+  if (!o)
+  {
+    o = new TObjString(histoname);
+    o->SetUniqueID(fHistoTableNames->GetEntries());
+    fHistoTableNames->Add(o);
+    fHistoTableIds->Add(o);
+  }
+
+  return o->GetUniqueID();
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBase::HistoTableFolder(const char* folder)
+{
+  /// Get the table folder of a sub-directory of the centrality (e.g. "INYRANGE"),
+  /// registering it if needed. Folder 0 is the centrality directory itself.
+  /// Folders have to be registered from DefineHistoTableIds.
+
+  if (!fHistoTableFolders)
+  {
+    fHistoTableFolders = new TObjArray;
+    fHistoTableFolders->SetOwner(kTRUE);
+    fHistoTableFolders->Add(new TObjString(""));
+  }
+
+  TObject* o = fHistoTableFolders->FindObject(folder);
+
+  if (!o)
+  {
+    o = new TObjString(folder);
+    fHistoTableFolders->Add(o);
+  }
+
+  return fHistoTableFolders->IndexOf(o);
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::ResetHistoTable(Int_t nEventSelections, Int_t nCentralities)
+{
+  /// Forget all resolved pointers and size the table for the given number of
+  /// event selections and centralities.
+  /// Called by AliAnalysisTaskMuMu at each new run.
+
+  if (!fHistoTableIdsDefined)
+  {
+    fHistoTableIdsDefined = kTRUE;
+    HistoTableFolder("");
+    DefineHistoTableIds();
+  }
+
+  Int_t nCuts(0);
+
+  if ( fHistoTableCutType >= 0 && CutRegistry() )
+  {
+    nCuts = CutRegistry()->GetCutCombinations(static_cast<AliAnalysisMuMuCutElement::ECutType>(fHistoTableCutType))->GetEntries();
+  }
+
+  fHistoTable.clear();
+  fHistoTableResolved.clear();
+  fHistoTableNEventSelections = nEventSelections;
+  fHistoTableNCentralities    = nCentralities;
+  fHistoTableNFolders         = fHistoTableFolders->GetEntries() + nCuts;
+  fHistoTableNHistos          = fHistoTableNames ? fHistoTableNames->GetEntries() : 0;
+  fHistoTableBlockSize        = 2LL*fHistoTableNFolders*fHistoTableNHistos;
+  fHistoTableBlock            = 0x0;
+  fHistoTableCut              = -1;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::SetHistoTablePath(Int_t eventSelectionIndex, Int_t triggerIndex, Int_t centralityIndex,
+                                            const char* eventSelection, const char* triggerClassName, const char* centrality)
+{
+  /// Select the table block of the current path, looking up its histograms
+  /// if this is the first time the path is seen in this run.
+  /// Negative indices select the scratch block, which is looked up each time.
+
+  fHistoTableBlock = 0x0;
+  fHistoTableCut   = -1;
+
+  if ( !fHistogramCollection || fHistoTableNEventSelections <= 0 || fHistoTableBlockSize == 0 ) return;
+
+  Long64_t block(0);
+
+  if ( triggerIndex >= 0 &&
+       eventSelectionIndex >= 0 && eventSelectionIndex < fHistoTableNEventSelections &&
+       centralityIndex >= 0 && centralityIndex < fHistoTableNCentralities )
+  {
+    // trigger is the outermost dimension so the table can grow when new trigger classes show up
+    block = 1 + ( static_cast<Long64_t>(triggerIndex)*fHistoTableNEventSelections + eventSelectionIndex )*fHistoTableNCentralities + centralityIndex;
+  }
+
+  if ( block >= static_cast<Long64_t>(fHistoTableResolved.size()) )
+  {
+    Long64_t nBlocks = 1 + static_cast<Long64_t>(triggerIndex+1)*fHistoTableNEventSelections*fHistoTableNCentralities;
+    fHistoTable.resize(nBlocks*fHistoTableBlockSize,0x0);
+    fHistoTableResolved.resize(nBlocks,kFALSE);
+  }
+
+  TObject** slots = &fHistoTable[block*fHistoTableBlockSize];
+
+  if ( block == 0 || !fHistoTableResolved[block] )
+  {
+    ResolveHistoTableBlock(slots,eventSelection,triggerClassName,centrality);
+    fHistoTableResolved[block] = ( block > 0 );
+  }
+
+  fHistoTableBlock = slots;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::SetHistoTableCut(AliAnalysisMuMuCutElement::ECutType type, Int_t cutIndex)
+{
+  /// Select the table folder of a cut combination, if the table has folders for that cut type
+
+  if ( type != fHistoTableCutType ) return;
+
+  fHistoTableCut = ( cutIndex >= 0 ) ? fHistoTableFolders->GetEntries() + cutIndex : -1;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::ResolveHistoTableBlock(TObject** block, const char* eventSelection,
+                                                 const char* triggerClassName, const char* centrality) const
+{
+  /// Look up all the (folder,mc,id) slots of one path in the histogram collection.
+  /// Missing objects (e.g. disabled histograms) leave a null slot.
+
+  const TObjArray* cuts(0x0);
+
+  if ( fHistoTableCutType >= 0 )
+  {
+    cuts = CutRegistry()->GetCutCombinations(static_cast<AliAnalysisMuMuCutElement::ECutType>(fHistoTableCutType));
+  }
+
+  Int_t nFixedFolders = fHistoTableFolders->GetEntries();
+  TString path;
+
+  for ( Int_t folder = 0; folder < fHistoTableNFolders; ++folder )
+  {
+    const char* what = ( folder < nFixedFolders ) ? fHistoTableFolders->UncheckedAt(folder)->GetName()
+                                                  : cuts->UncheckedAt(folder-nFixedFolders)->GetName();
+
+    for ( Int_t mc = 0; mc < 2; ++mc )
+    {
+      TObject** slot = block + (folder*2 + mc)*fHistoTableNHistos;
+
+      if ( mc && !HasMC() )
+      {
+        std::fill(slot,slot+fHistoTableNHistos,static_cast<TObject*>(0x0));
+        continue;
+      }
+
+      if ( mc ) path.Form("/%s/%s/%s/%s",MCInputPrefix(),eventSelection,triggerClassName,centrality);
+      else path.Form("/%s/%s/%s",eventSelection,triggerClassName,centrality);
+      if ( strlen(what) > 0 ) path += Form("/%s",what);
+
+      for ( Int_t id = 0; id < fHistoTableNHistos; ++id )
+      {
+        slot[id] = fHistogramCollection->GetObject(path.Data(),fHistoTableIds->UncheckedAt(id)->GetName());
+      }
+    }
+  }
+}
+
 //_____________________________________________________________________________
 TH1* AliAnalysisMuMuBase::Histo(const char* eventSelection, const char* triggerClassName, const char* histoname)
 {
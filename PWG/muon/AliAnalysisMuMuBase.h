@@ -13,6 +13,8 @@
 #include "TObject.h"
 #include "TString.h"
 #include "TProfile.h"
+#include "AliAnalysisMuMuCutElement.h"
+#include <vector>
 
 class AliCounterCollection;
 class AliAnalysisMuMuBinning;
@@ -23,13 +25,15 @@ class AliMCEvent;
 class TH1;
 class AliInputEventHandler;
 class AliAnalysisMuMuCutRegistry;
+class THashList;
+class TObjArray;
 
 class AliAnalysisMuMuBase : public TObject
 {
 public:
 
   AliAnalysisMuMuBase();
-  virtual ~AliAnalysisMuMuBase() {}
+  virtual ~AliAnalysisMuMuBase();
 
   /** Define the histograms needed for the path starting at eventSelection/triggerClassName/centrality.
    * This method has to ensure the histogram creation is performed only once !
@@ -103,6 +107,25 @@ public:
 
   void SetHistogramCollection(AliMergeableCollection* h) { fHistogramCollection = h; }
 
+  /** Size the histogram table for a new run. Trigger classes are not known
+   * in advance, so that dimension grows as new indices are used.
+   * The first call also registers the histogram ids (see DefineHistoTableIds).
+   */
+  void ResetHistoTable(Int_t nEventSelections, Int_t nCentralities);
+
+  /** Indices and names of the eventSelection/triggerClassName/centrality path being filled.
+   * Must be called after DefineHistogramCollection : the first time a path is seen in a run,
+   * all its table slots are looked up in the histogram collection.
+   */
+  void SetHistoTablePath(Int_t eventSelectionIndex, Int_t triggerIndex, Int_t centralityIndex,
+                         const char* eventSelection, const char* triggerClassName, const char* centrality);
+
+  /** Index of the pair cut combination being filled */
+  void SetHistoTablePairCut(Int_t pairCutIndex) { SetHistoTableCut(AliAnalysisMuMuCutElement::kTrackPair,pairCutIndex); }
+
+  /** Index of the track cut combination being filled */
+  void SetHistoTableTrackCut(Int_t trackCutIndex) { SetHistoTableCut(AliAnalysisMuMuCutElement::kTrack,trackCutIndex); }
+
 protected:
 
   TString BuildPath(const char* eventSelection, const char* triggerClassName, const char* centrality,
@@ -194,6 +217,41 @@ protected:
 
   Int_t GetNbins(Double_t xmin, Double_t xmax, Double_t xstep);
 
+  /** Register the ids of all the histograms the Fill methods get from the table,
+   * using HistoTableId, HistoTableFolder and SetHistoTableCutType.
+   * Called once, before the table is sized for the first run.
+   */
+  virtual void DefineHistoTableIds() {}
+
+  Int_t HistoTableId(const char* histoname);
+
+  Int_t HistoTableFolder(const char* folder);
+
+  void SetHistoTableCutType(AliAnalysisMuMuCutElement::ECutType type) { fHistoTableCutType = type; }
+
+  /** Table folder of the cut combination being filled (-1 if none) */
+  Int_t HistoTableCutFolder() const { return fHistoTableCut; }
+
+  /** Object of the current path, in the given folder (0 = directly under the centrality) */
+  TObject* TableObject(Int_t histoId, Bool_t mc=kFALSE, Int_t folder=0) const
+  {
+    if ( !fHistoTableBlock || histoId < 0 || histoId >= fHistoTableNHistos ||
+         folder < 0 || folder >= fHistoTableNFolders ) return 0x0;
+    return fHistoTableBlock[(folder*2 + ( mc ? 1 : 0 ))*fHistoTableNHistos + histoId];
+  }
+
+  TH1* TableHisto(Int_t histoId, Int_t folder=0) const
+  { return static_cast<TH1*>(TableObject(histoId,kFALSE,folder)); }
+
+  TH1* TableMCHisto(Int_t histoId, Int_t folder=0) const
+  { return static_cast<TH1*>(TableObject(histoId,kTRUE,folder)); }
+
+  TProfile* TableProf(Int_t histoId, Int_t folder=0) const
+  { return static_cast<TProfile*>(TableObject(histoId,kFALSE,folder)); }
+
+  TProfile* TableMCProf(Int_t histoId, Int_t folder=0) const
+  { return static_cast<TProfile*>(TableObject(histoId,kTRUE,folder)); }
+
   AliCounterCollection* CounterCollection() const { return fEventCounters; }
   AliMergeableCollection* HistogramCollection() const { return fHistogramCollection; }
   const AliAnalysisMuMuBinning* Binning() const { return fBinning; }
@@ -215,7 +273,27 @@ private:
   TList* fHistogramToDisable; // list of regexp of histo name to disable
   Bool_t fHasMC; // whether or not we're dealing with MC data
 
-  ClassDef(AliAnalysisMuMuBase,1) // base class for a companion class to AliAnalysisMuMu
+  void SetHistoTableCut(AliAnalysisMuMuCutElement::ECutType type, Int_t cutIndex);
+
+  void ResolveHistoTableBlock(TObject** block, const char* eventSelection,
+                              const char* triggerClassName, const char* centrality) const;
+
+  Bool_t fHistoTableIdsDefined; //! whether DefineHistoTableIds has been called
+  THashList* fHistoTableNames; //! names of the histograms reachable through the table (id = UniqueID)
+  TObjArray* fHistoTableIds; //! same names, indexed by id (not owner)
+  TObjArray* fHistoTableFolders; //! fixed folders below the centrality (folder 0 = none)
+  Int_t fHistoTableCutType; //! cut type whose combinations get a table folder each (-1 = none)
+  std::vector<TObject*> fHistoTable; //! one block of pointers per (trigger,eventSelection,centrality), block 0 is scratch
+  std::vector<Bool_t> fHistoTableResolved; //! whether a block has been looked up already
+  Int_t fHistoTableNEventSelections; //! number of event selections in the table (0 = table disabled)
+  Int_t fHistoTableNCentralities; //! number of centrality bins in the table
+  Int_t fHistoTableNFolders; //! number of folders (fixed ones + cut combinations)
+  Int_t fHistoTableNHistos; //! number of histogram ids
+  Long64_t fHistoTableBlockSize; //! number of slots in one block (folder,mc,id)
+  TObject** fHistoTableBlock; //! block of the current path
+  Int_t fHistoTableCut; //! folder of the current cut combination
+
+  ClassDef(AliAnalysisMuMuBase,2) // base class for a companion class to AliAnalysisMuMu
 };
 
 #endif
@@ -31,6 +31,60 @@ ClassImp(AliAnalysisMuMuGlobal)
 AliAnalysisMuMuGlobal::AliAnalysisMuMuGlobal() : AliAnalysisMuMuBase()
 {
   /// ctor
+  for ( Int_t i = 0; i < kNGlobalHistos; ++i ) fHistoIds[i] = -1;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuGlobal::DefineHistoTableIds()
+{
+  /// Register the histograms of the Fill methods in the histogram table.
+  /// Names must follow the EGlobalHisto order.
+
+  const char* names[kNGlobalHistos] =
+  {
+    "BCX",
+    "Nevents",
+    "EventsWOL0inputs",
+    "Xvertex",
+    "Yvertex",
+    "Zvertex",
+    "ZvertexNContributors",
+    "ZvertexMinusZvertexSPD",
+    "SPDXvertex",
+    "SPDYvertex",
+    "SPDZvertex",
+    "SPDZvertexNContributors",
+    "ZvertexMinusSPDZvertexNContributors",
+    "SPDZvertexResolutionNContributors",
+    "SPDVertexType",
+    "VertexType",
+    "VertexClass",
+    "T0Zvertex",
+    "V0AMult",
+    "V0CMult",
+    "V0TotMult",
+    "V02D",
+    "V02DwT0BG",
+    "V02DwT0PU",
+    "V02DwT0SAT",
+    "V02DwT0BB",
+    "PileUpEstimators",
+    "RecZvertexVsMCZvertex",
+    "RecSPDZvertexVsMCZvertex",
+    "NofEvWSPDZvertexVsMCZvertex",
+    "NofEvWSPDZvertexAndNoVtexerZVsMCZvertex",
+    "NofEvPassingVtxQAVsMCZvertex",
+    "NofEvNotPassingVtxResCutVsMCZvertex",
+    "NofEvWSPDZvertexAndVtexerZVsMCZvertex",
+    "NofEvWOSPDZvertexVsMCZvertex"
+  };
+
+  for ( Int_t i = 0; i < kNGlobalHistos; ++i )
+  {
+    // the MC vertex histograms after RecZvertexVsMCZvertex are all enabled or disabled along with it
+    Bool_t disabled = IsHistogramDisabled( i > kRecZvertexVsMCZvertex ? names[kRecZvertexVsMCZvertex] : names[i] );
+    fHistoIds[i] = disabled ? -1 : HistoTableId(names[i]);
+  }
 }
 
 //_____________________________________________________________________________
@@ -45,24 +99,26 @@ Bool_t AliAnalysisMuMuGlobal::SelectAnyTriggerClass(const TString& firedTriggerC
 }
 
 //_____________________________________________________________________________
-void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
+void AliAnalysisMuMuGlobal::FillHistosForEvent(const char* /*eventSelection*/,
+                                               const char* /*triggerClassName*/,
+                                               const char* /*centrality*/)
 {
   // Fill event-wise histograms
   
-  if (!IsHistogramDisabled("BCX"))
+  if (GlobalHisto(kBCX))
   {
-    p.Histo("BCX")->Fill(1.0*Event()->GetBunchCrossNumber());
+    GlobalHisto(kBCX)->Fill(1.0*Event()->GetBunchCrossNumber());
   }
-  if (!IsHistogramDisabled("Nevents"))
+  if (GlobalHisto(kNevents))
   {
-    p.Histo("Nevents")->Fill(1.0);
+    GlobalHisto(kNevents)->Fill(1.0);
   }
   
-  if (!IsHistogramDisabled("EventsWOL0inputs"))
+  if (GlobalHisto(kEventsWOL0inputs))
   {
     UInt_t l0 = Event()->GetHeader()->GetL0TriggerInputs();
     
-    if ( l0 == 0 ) p.Histo("EventsWOL0inputs")->Fill(1.);
+    if ( l0 == 0 ) GlobalHisto(kEventsWOL0inputs)->Fill(1.);
   }
   
   const AliVVertex* vertex = Event()->GetPrimaryVertex();
@@ -72,69 +128,69 @@ void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
   {
     if ( vertex->GetNContributors() > 0 )
     {
-      if (!IsHistogramDisabled("Xvertex"))
+      if (GlobalHisto(kXvertex))
       {
-        p.Histo("Xvertex")->Fill(vertex->GetX());
+        GlobalHisto(kXvertex)->Fill(vertex->GetX());
       }
-      if (!IsHistogramDisabled("Yvertex"))
+      if (GlobalHisto(kYvertex))
       {
-        p.Histo("Yvertex")->Fill(vertex->GetY());
+        GlobalHisto(kYvertex)->Fill(vertex->GetY());
       }
-      if (!IsHistogramDisabled("Zvertex"))
+      if (GlobalHisto(kZvertex))
       {
-        p.Histo("Zvertex")->Fill(vertex->GetZ());
+        GlobalHisto(kZvertex)->Fill(vertex->GetZ());
       }
       if ( vertexFromSPD )
       {
-        if (!IsHistogramDisabled("ZvertexMinusZvertexSPD"))
+        if (GlobalHisto(kZvertexMinusZvertexSPD))
         {
-          p.Histo("ZvertexMinusZvertexSPD")->Fill(vertexFromSPD->GetZ()-vertex->GetZ());
+          GlobalHisto(kZvertexMinusZvertexSPD)->Fill(vertexFromSPD->GetZ()-vertex->GetZ());
         }
-        if (!IsHistogramDisabled("SPDXvertex"))
+        if (GlobalHisto(kSPDXvertex))
         {
-          p.Histo("SPDXvertex")->Fill(vertexFromSPD->GetX());
+          GlobalHisto(kSPDXvertex)->Fill(vertexFromSPD->GetX());
         }
-        if (!IsHistogramDisabled("SPDYvertex"))
+        if (GlobalHisto(kSPDYvertex))
         {
-          p.Histo("SPDYvertex")->Fill(vertexFromSPD->GetY());
+          GlobalHisto(kSPDYvertex)->Fill(vertexFromSPD->GetY());
         }
-        if (!IsHistogramDisabled("SPDZvertex"))
+        if (GlobalHisto(kSPDZvertex))
         {
-          p.Histo("SPDZvertex")->Fill(vertexFromSPD->GetZ());
+          GlobalHisto(kSPDZvertex)->Fill(vertexFromSPD->GetZ());
         }
-        if (!IsHistogramDisabled("SPDZvertexNContributors"))
+        if (GlobalHisto(kSPDZvertexNContributors))
         {
-          p.Histo("SPDZvertexNContributors")->Fill(vertexFromSPD->GetNContributors());
+          GlobalHisto(kSPDZvertexNContributors)->Fill(vertexFromSPD->GetNContributors());
         }
-        if (!IsHistogramDisabled("ZvertexMinusSPDZvertexNContributors"))
+        if (GlobalHisto(kZvertexMinusSPDZvertexNContributors))
         {
-          p.Histo("ZvertexMinusSPDZvertexNContributors")->Fill(vertexFromSPD->GetNContributors(),vertex->GetZ() - vertexFromSPD->GetZ());
+          GlobalHisto(kZvertexMinusSPDZvertexNContributors)->Fill(vertexFromSPD->GetNContributors(),vertex->GetZ() - vertexFromSPD->GetZ());
         }
-        if (!IsHistogramDisabled("SPDZvertexResolutionNContributors"))
+        if (GlobalHisto(kSPDZvertexResolutionNContributors))
         {
           Double_t cov[6]={0};
           static_cast<const AliAODVertex*>(vertexFromSPD)->GetCovarianceMatrix(cov);
           
-          p.Histo("SPDZvertexResolutionNContributors")->Fill(vertexFromSPD->GetNContributors(),TMath::Sqrt(cov[5]));
+          GlobalHisto(kSPDZvertexResolutionNContributors)->Fill(vertexFromSPD->GetNContributors(),TMath::Sqrt(cov[5]));
         }
-        if (!IsHistogramDisabled("SPDVertexType"))
+        if (GlobalHisto(kSPDVertexType))
         {
-          p.Histo("SPDVertexType")->Fill(vertexFromSPD->GetTitle(),1.0);
+          GlobalHisto(kSPDVertexType)->Fill(vertexFromSPD->GetTitle(),1.0);
         }
         
       }
-      if (!IsHistogramDisabled("VertexType"))
+      if (GlobalHisto(kVertexType))
       {
-        p.Histo("VertexType")->Fill(vertex->GetTitle(),1.0);
+        GlobalHisto(kVertexType)->Fill(vertex->GetTitle(),1.0);
       }
-      if (!IsHistogramDisabled("VertexClass"))
+      if (GlobalHisto(kVertexClass))
       {
-        p.Histo("VertexClass")->Fill(static_cast<const AliAODVertex*>(vertex)->GetType(),1.0);
+        GlobalHisto(kVertexClass)->Fill(static_cast<const AliAODVertex*>(vertex)->GetType(),1.0);
       }
     }
-    if (!IsHistogramDisabled("ZvertexNContributors"))
+    if (GlobalHisto(kZvertexNContributors))
     {
-      p.Histo("ZvertexNContributors")->Fill(vertex->GetNContributors());
+      GlobalHisto(kZvertexNContributors)->Fill(vertex->GetNContributors());
     }
   }
   
@@ -142,18 +198,18 @@ void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
   {
     const AliAODTZERO* tzero = static_cast<const AliAODEvent*>(Event())->GetTZEROData();
     
-    if (tzero && !IsHistogramDisabled("T0Zvertex"))
+    if (tzero && GlobalHisto(kT0Zvertex))
     {
-      p.Histo("T0Zvertex")->Fill(tzero->GetT0VertexRaw());
+      GlobalHisto(kT0Zvertex)->Fill(tzero->GetT0VertexRaw());
     }
   }
   else
   {
     const AliESDTZERO* tzero = static_cast<const AliESDEvent*>(Event())->GetESDTZERO();
     
-    if (tzero && !IsHistogramDisabled("T0Zvertex"))
+    if (tzero && GlobalHisto(kT0Zvertex))
     {
-      p.Histo("T0Zvertex")->Fill(tzero->GetT0zVertex());
+      GlobalHisto(kT0Zvertex)->Fill(tzero->GetT0zVertex());
     }
   }
   
@@ -176,24 +232,24 @@ void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
       Float_t v0aMult = AliESDUtils::GetCorrV0A(multV0A,vertexFromSPD->GetZ());
       Float_t v0cMult = AliESDUtils::GetCorrV0C(multV0C,vertexFromSPD->GetZ());
       
-      if (!IsHistogramDisabled("V0AMult"))
+      if (GlobalHisto(kV0AMult))
       {
-        p.Histo("V0AMult")->Fill(v0aMult);
+        GlobalHisto(kV0AMult)->Fill(v0aMult);
       }
-      if (!IsHistogramDisabled("V0CMult"))
+      if (GlobalHisto(kV0CMult))
       {
-        p.Histo("V0CMult")->Fill(v0cMult);
+        GlobalHisto(kV0CMult)->Fill(v0cMult);
       }
-      if (!IsHistogramDisabled("V0TotMult"))
+      if (GlobalHisto(kV0TotMult))
       {
-        p.Histo("V0TotMult")->Fill(multV0);
+        GlobalHisto(kV0TotMult)->Fill(multV0);
       }
     }
     
     
-    if (!IsHistogramDisabled("V02D"))
+    if (GlobalHisto(kV02D))
     {
-      p.Histo("V02D")->Fill(x,y);
+      GlobalHisto(kV02D)->Fill(x,y);
     }
     
     Bool_t background,pileup,satellite;
@@ -204,38 +260,38 @@ void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
     {
       if ( background )
       {
-        if (!IsHistogramDisabled("V02DwT0BG"))
+        if (GlobalHisto(kV02DwT0BG))
         {
-          p.Histo("V02DwT0BG")->Fill(x,y);
+          GlobalHisto(kV02DwT0BG)->Fill(x,y);
         }
       }
       
       if ( pileup )
       {
-        if (!IsHistogramDisabled("V02DwT0PU"))
+        if (GlobalHisto(kV02DwT0PU))
         {
-          p.Histo("V02DwT0PU")->Fill(x,y);
+          GlobalHisto(kV02DwT0PU)->Fill(x,y);
         }
         
-        if ( !IsHistogramDisabled("PileUpEstimators") )
+        if ( GlobalHisto(kPileUpEstimators) )
         {
-          p.Histo("PileUpEstimators")->Fill("TZERO",1.0);
+          GlobalHisto(kPileUpEstimators)->Fill("TZERO",1.0);
         }
       }
       
       if ( satellite )
       {
-        if (!IsHistogramDisabled("V02DwT0SAT"))
+        if (GlobalHisto(kV02DwT0SAT))
         {
-          p.Histo("V02DwT0SAT")->Fill(x,y);
+          GlobalHisto(kV02DwT0SAT)->Fill(x,y);
         }
       }
       
       if ( !background && !pileup && !satellite )
       {
-        if (!IsHistogramDisabled("V02DwT0BB"))
+        if (GlobalHisto(kV02DwT0BB))
         {
-          p.Histo("V02DwT0BB")->Fill(x,y);
+          GlobalHisto(kV02DwT0BB)->Fill(x,y);
         }
       }
     }
@@ -244,8 +300,9 @@ void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
   //  /* FIXME : how to properly get multiplicity from AOD and ESD consistently ?
   //   is is doable at all ?
   
-  TH1* hpileup = p.Histo("PileUpEstimators");
+  TH1* hpileup = GlobalHisto(kPileUpEstimators);
   
+  if (!hpileup) return;
   
   //  virtual Bool_t  IsPileupFromSPD(Int_t minContributors=3, Double_t minZdist=0.8, Double_t nSigmaZdist=3., Double_t nSigmaDiamXY=2., Double_t nSigmaDiamZ=5.) const;
   
@@ -266,34 +323,36 @@ void AliAnalysisMuMuGlobal::FillHistosForEvent(AliMergeableCollectionProxy& p)
 }
 
 //_____________________________________________________________________________
-void AliAnalysisMuMuGlobal::FillHistosForMCEvent(AliMergeableCollectionProxy& p)
+void AliAnalysisMuMuGlobal::FillHistosForMCEvent(const char* /*eventSelection*/,
+                                                 const char* /*triggerClassName*/,
+                                                 const char* /*centrality*/)
 {
   // Fill MCEvent-wise histograms
   
   Double_t Zvertex = AliAnalysisMuonUtility::GetMCVertexZ(Event(),MCEvent());
   
-  if (!IsHistogramDisabled("Zvertex"))
+  if (GlobalMCHisto(kZvertex))
   {
-    p.Histo("Zvertex")->Fill(Zvertex);
+    GlobalMCHisto(kZvertex)->Fill(Zvertex);
   }
   
-  if (!IsHistogramDisabled("RecZvertexVsMCZvertex"))
+  if (GlobalMCHisto(kRecZvertexVsMCZvertex))
   {
     const AliVVertex* vertex = Event()->GetPrimaryVertex();
     if  (vertex && vertex->GetNContributors()>0)
     {
-      p.Histo("RecZvertexVsMCZvertex")->Fill(Zvertex,vertex->GetZ());
+      GlobalMCHisto(kRecZvertexVsMCZvertex)->Fill(Zvertex,vertex->GetZ());
     }
     
     const AliVVertex* vertexFromSPD = Event()->GetPrimaryVertexSPD();
     if  (vertexFromSPD && vertexFromSPD->GetNContributors()>0)
     {
-      p.Histo("RecSPDZvertexVsMCZvertex")->Fill(Zvertex,vertexFromSPD->GetZ());
-      p.Histo("NofEvWSPDZvertexVsMCZvertex")->Fill(Zvertex,1);
+      GlobalMCHisto(kRecSPDZvertexVsMCZvertex)->Fill(Zvertex,vertexFromSPD->GetZ());
+      GlobalMCHisto(kNofEvWSPDZvertexVsMCZvertex)->Fill(Zvertex,1);
       
       if ( !vertexFromSPD->IsFromVertexerZ() )
       {
-        p.Histo("NofEvWSPDZvertexAndNoVtexerZVsMCZvertex")->Fill(Zvertex,1);
+        GlobalMCHisto(kNofEvWSPDZvertexAndNoVtexerZVsMCZvertex)->Fill(Zvertex,1);
         
         Double_t cov[6]={0};
         vertexFromSPD->GetCovarianceMatrix(cov);
@@ -301,44 +360,16 @@ void AliAnalysisMuMuGlobal::FillHistosForMCEvent(AliMergeableCollectionProxy& p)
         Double_t zvertex = vertexFromSPD->GetZ();
         if ( (zRes <= 0.25) && TMath::Abs(zvertex - vertex->GetZ()) <= 0.5 ) //These events are those passing AliAnalysisMuMuEventCutter::IsSPDzQA()
         {
-          p.Histo("NofEvPassingVtxQAVsMCZvertex")->Fill(Zvertex,1);
+          GlobalMCHisto(kNofEvPassingVtxQAVsMCZvertex)->Fill(Zvertex,1);
         }
-        else p.Histo("NofEvNotPassingVtxResCutVsMCZvertex")->Fill(Zvertex,1);
+        else GlobalMCHisto(kNofEvNotPassingVtxResCutVsMCZvertex)->Fill(Zvertex,1);
       }
-      else p.Histo("NofEvWSPDZvertexAndVtexerZVsMCZvertex")->Fill(Zvertex,1);
+      else GlobalMCHisto(kNofEvWSPDZvertexAndVtexerZVsMCZvertex)->Fill(Zvertex,1);
     }
-    else p.Histo("NofEvWOSPDZvertexVsMCZvertex")->Fill(Zvertex,1);
+    else GlobalMCHisto(kNofEvWOSPDZvertexVsMCZvertex)->Fill(Zvertex,1);
   }
 }
 
-//_____________________________________________________________________________
-void AliAnalysisMuMuGlobal::FillHistosForEvent(const char* eventSelection,
-                                               const char* triggerClassName,
-                                               const char* centrality)
-{
-  // Fill event-wise histograms
-  
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality));
-
-  FillHistosForEvent(*proxy);
-  
-  delete proxy;
-}
-
-//_____________________________________________________________________________
-void AliAnalysisMuMuGlobal::FillHistosForMCEvent(const char* eventSelection,
-                                                 const char* triggerClassName,
-                                                 const char* centrality)
-{
-  // Fill MCEvent-wise histograms
-
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality));
-
-  FillHistosForMCEvent(*proxy);
-  
-  delete proxy;
-}
-
 //_____________________________________________________________________________
 void AliAnalysisMuMuGlobal::DefineHistogramCollection(const char* eventSelection,
                                                       const char* triggerClassName,
@@ -9,8 +9,6 @@
 
 #include "AliAnalysisMuMuBase.h"
 
-class AliMergeableCollectionProxy;
-
 class AliAnalysisMuMuGlobal : public AliAnalysisMuMuBase
 {
 public:
@@ -28,13 +26,38 @@ public:
 
   Bool_t SelectAnyTriggerClass(const TString& firedTriggerClasses, TString& acceptedTriggerClasses) const;
   
+protected:
+
+  void DefineHistoTableIds();
 
 private:
   
-  void FillHistosForEvent(AliMergeableCollectionProxy& p);
-  void FillHistosForMCEvent(AliMergeableCollectionProxy& p);
-  
-  ClassDef(AliAnalysisMuMuGlobal,1) // implementation of AliAnalysisMuMuBase for global event properties
+  /// histograms filled by this class, used to index fHistoIds
+  enum EGlobalHisto
+  {
+    kBCX, kNevents, kEventsWOL0inputs,
+    kXvertex, kYvertex, kZvertex, kZvertexNContributors,
+    kZvertexMinusZvertexSPD, kSPDXvertex, kSPDYvertex, kSPDZvertex, kSPDZvertexNContributors,
+    kZvertexMinusSPDZvertexNContributors, kSPDZvertexResolutionNContributors,
+    kSPDVertexType, kVertexType, kVertexClass, kT0Zvertex,
+    kV0AMult, kV0CMult, kV0TotMult, kV02D, kV02DwT0BG, kV02DwT0PU, kV02DwT0SAT, kV02DwT0BB,
+    kPileUpEstimators,
+    kRecZvertexVsMCZvertex, kRecSPDZvertexVsMCZvertex, kNofEvWSPDZvertexVsMCZvertex,
+    kNofEvWSPDZvertexAndNoVtexerZVsMCZvertex, kNofEvPassingVtxQAVsMCZvertex,
+    kNofEvNotPassingVtxResCutVsMCZvertex, kNofEvWSPDZvertexAndVtexerZVsMCZvertex,
+    kNofEvWOSPDZvertexVsMCZvertex,
+    kNGlobalHistos
+  };
+
+  /// histogram of the current path (0x0 if disabled)
+  TH1* GlobalHisto(EGlobalHisto which) const { return TableHisto(fHistoIds[which]); }
+
+  /// MC input histogram of the current path (0x0 if disabled)
+  TH1* GlobalMCHisto(EGlobalHisto which) const { return TableMCHisto(fHistoIds[which]); }
+
+  Int_t fHistoIds[kNGlobalHistos]; //! histogram table ids (-1 = disabled)
+
+  ClassDef(AliAnalysisMuMuGlobal,2) // implementation of AliAnalysisMuMuBase for global event properties
 };
 
 #endif
@@ -49,10 +49,18 @@ fmcptcutmax(12.0),
 fPtFuncOld(0x0),
 fPtFuncNew(0x0),
 fYFuncOld(0x0),
-fYFuncNew(0x0)
+fYFuncNew(0x0),
+fHistoIds(),
+fInYRangeFolder(-1),
+fPtPaireVsPtTrackId(-1),
+fPtRecVsSimId(-1),
+fNchForJpsiId(-1),
+fNchForPsiPId(-1)
 {
   // FIXME ? find the AccxEff histogram from HistogramCollection()->Histo("/EXCHANGE/JpsiAccEff")
 
+  for ( Int_t ik = 0; ik < kNKineHistos; ++ik ) fMCKineIds[ik] = -1;
+
   if ( accEffHisto )
   {
     fAccEffHisto = static_cast<TH2F*>(accEffHisto->Clone());
@@ -328,11 +336,16 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   // Usual cuts
   if (!AliAnalysisMuonUtility::IsMuonTrack(&tracki) || !AliAnalysisMuonUtility::IsMuonTrack(&trackj) ) return;
 
+  // Histogram ids are registered once per task (see DefineHistoTableIds) : only integer indices are used below
+  if ( fHistoIds.empty() ) return;
+  Int_t pairCutFolder = HistoTableCutFolder();
+
   // Get total charge in order to get the correct histo name
   Double_t PairCharge = tracki.Charge() + trackj.Charge();
-  TString scharge  = "";
-  if( PairCharge == +2 )      scharge = "PP";
-  else if( PairCharge == -2 ) scharge = "MM";
+  Int_t chargeIndex = 0;
+  if( PairCharge == +2 )      chargeIndex = 1;
+  else if( PairCharge == -2 ) chargeIndex = 2;
+  Int_t mixIndex = IsMixedHisto ? 1 : 0;
 
   // Pointers in case running on MC
   Int_t labeli               = 0;
@@ -342,13 +355,6 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   TLorentzVector             * pair4MomentumMC(0x0);
   Double_t inputWeightMC(1.);
 
-  // Usefull string :)
-  TString smix = IsMixedHisto ? "Mix" : "";
-
-  // Create proxy in AliMergeableCollection
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality,pairCutName));
-  AliMergeableCollectionProxy* mcProxy(0x0); // to be set later maybe
-
   // Construct dimuons vector
   TLorentzVector pi(tracki.Px(),tracki.Py(),tracki.Pz(),
                     TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+tracki.P()*tracki.P()));
@@ -373,47 +379,23 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
     // Check if first track is a muon
     mcTracki = MCEvent()->GetTrack(labeli);
     if(!mcTracki) return;
-    if ( TMath::Abs(mcTracki->PdgCode()) != 13 ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if ( TMath::Abs(mcTracki->PdgCode()) != 13 ) return;
 
     // Check if second track is a muon
     mcTrackj = MCEvent()->GetTrack(labelj);
     if(!mcTrackj) return;
-    if ( TMath::Abs(mcTrackj->PdgCode()) != 13 ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if ( TMath::Abs(mcTrackj->PdgCode()) != 13 ) return;
 
     // Check if tracks has the same mother
     Int_t currMotheri = mcTracki->GetMother();
     Int_t currMotherj = mcTrackj->GetMother();
-    if( currMotheri!=currMotherj ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
-    if( currMotheri<0 ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if( currMotheri!=currMotherj ) return;
+    if( currMotheri<0 ) return;
 
     // Check if mother is J/psi
     AliMCParticle* mother = static_cast<AliMCParticle*>(MCEvent()->GetTrack(currMotheri));
-    if(!mother){
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
-    if(mother->PdgCode() !=443) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if(!mother) return;
+    if(mother->PdgCode() !=443) return;
 
     // Weight tracks if specified
     if(!fWeightMuon)      inputWeightMC = WeightPairDistribution(mother->Pt(),mother->Y());
@@ -423,13 +405,9 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
 
     if(!mcTracki || !mcTrackj){
       AliError("Miss one or several MC track");
-      delete proxy;
-      delete mcProxy;
       return;
     }
 
-    // Create proxy for MC
-    mcProxy = HistogramCollection()->CreateProxy(BuildMCPath(eventSelection,triggerClassName,centrality,pairCutName));
     TLorentzVector mcpi(mcTracki->Px(),mcTracki->Py(),mcTracki->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTracki->P()*mcTracki->P()));
     TLorentzVector mcpj(mcTrackj->Px(),mcTrackj->Py(),mcTrackj->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTrackj->P()*mcTrackj->P()));
     mcpj+=mcpi;
@@ -441,25 +419,21 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   else if(fWeightMuon)  inputWeight = WeightMuonDistribution(tracki.Pt()) * WeightMuonDistribution(trackj.Pt());
 
   // Fill some distribution histos
-  if ( !IsHistogramDisabled("Pt")  ) {
-    Double_t x[2] = {pair4Momentum.Pt(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Pt%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Pt%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
-  }
-  if ( !IsHistogramDisabled("Y")   ){
-    Double_t x[2] = {pair4Momentum.Rapidity(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Y%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Y%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
-  }
-  if ( !IsHistogramDisabled("Eta") ){
-    Double_t x[2] = {pair4Momentum.Eta(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Eta%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Eta%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
+  Double_t xkine[kNKineHistos] = {pair4Momentum.Pt(),pair4Momentum.Rapidity(),pair4Momentum.Eta()};
+  for ( Int_t ik = 0; ik < kNKineHistos; ++ik ){
+    Int_t id = fHistoIds[KineHistoIndex(ik,chargeIndex,mixIndex)];
+    if ( id < 0 ) continue; // disabled
+    THnSparse* hs = static_cast<THnSparse*>(TableObject(id,kFALSE,pairCutFolder));
+    if ( hs ){
+      Double_t x[2] = {xkine[ik],pair4Momentum.M()};
+      hs->Fill(x,inputWeight);
+    }
   }
 
-  if ( !IsHistogramDisabled("PtPaireVsPtTrack") && !IsMixedHisto &&  static_cast<int>(PairCharge) == 0) {
-    static_cast<TH2*>( proxy->Histo("PtPaireVsPtTrack"))->Fill(pair4Momentum.Pt(),tracki.Pt(),inputWeight);
-    static_cast<TH2*>( proxy->Histo("PtPaireVsPtTrack"))->Fill(pair4Momentum.Pt(),trackj.Pt(),inputWeight);
+  if ( fPtPaireVsPtTrackId >= 0 && !IsMixedHisto &&  static_cast<int>(PairCharge) == 0) {
+    TH1* h = TableHisto(fPtPaireVsPtTrackId,pairCutFolder);
+    static_cast<TH2*>(h)->Fill(pair4Momentum.Pt(),tracki.Pt(),inputWeight);
+    static_cast<TH2*>(h)->Fill(pair4Momentum.Pt(),trackj.Pt(),inputWeight);
   }
 
   // Fill histos with MC stack info (only opposite charge muons)
@@ -472,21 +446,26 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
 
 
     // Fill histo
-    if ( proxy->Histo("PtRecVsSim") )  proxy->Histo("PtRecVsSim")->Fill(mcpj.Pt(),pair4Momentum.Pt());
-    if ( mcProxy->Histo("Pt"))  mcProxy->Histo("Pt")->Fill(mcpj.Pt(),inputWeightMC);
-    if ( mcProxy->Histo("Y"))   mcProxy->Histo("Y")->Fill(mcpj.Rapidity(),inputWeightMC);
-    if ( mcProxy->Histo("Eta")) mcProxy->Histo("Eta")->Fill(mcpj.Eta());
+    TH1* hRecVsSim = TableHisto(fPtRecVsSimId,pairCutFolder);
+    if ( hRecVsSim )  hRecVsSim->Fill(mcpj.Pt(),pair4Momentum.Pt());
+    TH1* hmc = TableMCHisto(fMCKineIds[0],pairCutFolder);
+    if ( hmc ) hmc->Fill(mcpj.Pt(),inputWeightMC);
+    hmc = TableMCHisto(fMCKineIds[1],pairCutFolder);
+    if ( hmc ) hmc->Fill(mcpj.Rapidity(),inputWeightMC);
+    hmc = TableMCHisto(fMCKineIds[2],pairCutFolder);
+    if ( hmc ) hmc->Fill(mcpj.Eta());
 
     // set pair4MomentumMC for the rest of the function
     pair4MomentumMC = &mcpj;
   }
 
-  TIter nextBin(fBinsToFill);
-  nextBin.Reset();
-  AliAnalysisMuMuBinning::Range* r;
+  TH1* hNchForJpsi = TableHisto(fNchForJpsiId,pairCutFolder);
+  TH1* hNchForPsiP = TableHisto(fNchForPsiPId,pairCutFolder);
 
   // Loop over all bin ranges
-  while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(nextBin()) ) ){
+  for ( Int_t ibin = 0; ibin <= fBinsToFill->GetLast(); ++ibin ){
+
+    AliAnalysisMuMuBinning::Range* r = static_cast<AliAnalysisMuMuBinning::Range*>(fBinsToFill->UncheckedAt(ibin));
 
     // --- In this loop we first check if the pairs pass some tests and we fill histo accordingly. ---
 
@@ -494,19 +473,13 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
     Bool_t ok(kFALSE);
     Bool_t okMC(kFALSE);
 
-    ok = CheckBinRangeCut(r,&pair4Momentum,proxy);
-    if( pair4MomentumMC ) okMC = CheckBinRangeCut(r,pair4MomentumMC,proxy);
+    ok = CheckBinRangeCut(r,&pair4Momentum,hNchForJpsi,hNchForPsiP);
+    if( pair4MomentumMC ) okMC = CheckBinRangeCut(r,pair4MomentumMC,hNchForJpsi,hNchForPsiP);
 
     // Check if pair pass all conditions, either MC or not, and fill Minv Histogrames
     if ( ok )
     {
-      // Get Minv histo name associated to the bin
-      TString minvName       = GetMinvHistoName(*r,kFALSE,PairCharge,IsMixedHisto);
-      TString hprofName      = Form("MeanPtVs%s",minvName.Data());
-      TString hprofNameSquare= Form("MeanPtSquareVs%s",minvName.Data());
-      TProfile* hprof        = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-      TProfile* hprofsquare  = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-      FillMinvHisto(&minvName,hprof,hprofsquare,proxy,&pair4Momentum,inputWeight);
+      FillMinvHisto(ibin,kFALSE,chargeIndex,mixIndex,kFALSE,&pair4Momentum,inputWeight);
 
       // Create, fill and store Minv histo already corrected with accxeff
       if ( ShouldCorrectDimuonForAccEff() )
@@ -519,23 +492,13 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
         if ( AccxEff <= 0.0 ) AliError(Form("AccxEff < 0 for pt = %f & y = %f ",pair4Momentum.Pt(),pair4Momentum.Rapidity()));
         else okAccEff = kTRUE;
 
-        minvName        = GetMinvHistoName(*r,kTRUE,PairCharge,IsMixedHisto);
-        hprofName       = Form("MeanPtVs%s",minvName.Data());
-        hprofNameSquare = Form("MeanPtSquareVs%s",minvName.Data());
-        hprof           = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-        hprofsquare     = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-        if( okAccEff ) FillMinvHisto(&minvName,hprof,hprofsquare,proxy,&pair4Momentum,inputWeight/AccxEff);
+        if( okAccEff ) FillMinvHisto(ibin,kTRUE,chargeIndex,mixIndex,kFALSE,&pair4Momentum,inputWeight/AccxEff);
       }
     }
 
     if ( okMC ) {
 
-      TString minvName       = GetMinvHistoName(*r,kFALSE,PairCharge,IsMixedHisto);
-      TString hprofName      = Form("MeanPtVs%s",minvName.Data());
-      TString hprofNameSquare= Form("MeanPtSquareVs%s",minvName.Data());
-      TProfile* hprof        = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-      TProfile* hprofsquare  = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-      FillMinvHisto(&minvName,hprof,hprofsquare,mcProxy,&pair4Momentum,inputWeight);
+      FillMinvHisto(ibin,kFALSE,chargeIndex,mixIndex,kTRUE,&pair4Momentum,inputWeight);
 
       // Create, fill and store Minv histo already corrected with accxeff
       if ( ShouldCorrectDimuonForAccEff() ){
@@ -548,18 +511,11 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
         if ( AccxEff <= 0.0 ) AliError(Form("AccxEff < 0 for pt = %f & y = %f ",pair4MomentumMC->Pt(),pair4MomentumMC->Rapidity()));
         else okAccEff = kTRUE;
 
-        minvName        = GetMinvHistoName(*r,kTRUE,PairCharge,IsMixedHisto);
-        hprofName       = Form("MeanPtVs%s",minvName.Data());
-        hprofNameSquare = Form("MeanPtSquareVs%s",minvName.Data());
-        hprof           = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-        hprofsquare     = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-        if( okAccEff ) FillMinvHisto(&minvName,hprof,hprofsquare,mcProxy,&pair4Momentum,inputWeight/AccxEff);
+        if( okAccEff ) FillMinvHisto(ibin,kTRUE,chargeIndex,mixIndex,kTRUE,&pair4Momentum,inputWeight/AccxEff);
 
       }
     }
   }
-  delete proxy;
-  delete mcProxy;
 }
 
 
@@ -570,24 +526,14 @@ void AliAnalysisMuMuMinv::FillHistosForMCEvent(const char* eventSelection,const
   /// Fill MC inputs histograms.
   ///
 
-  if ( !HasMC() ) return;
+  if ( !HasMC() || fHistoIds.empty() ) return;
 
-  // Create general proxies to the Histogram Collection
-  TString mcPath = BuildMCPath(eventSelection,triggerClassName,centrality);
-  AliMergeableCollectionProxy* mcProxy = HistogramCollection()->CreateProxy(mcPath);
-
-  // Create proxy to the Histogram Collection for input particles satisfying Y cut
-  TString mcInYRangeProxyPath = mcPath;
-  mcInYRangeProxyPath += "INYRANGE/";
-  AliMergeableCollectionProxy* mcInYRangeProxy = HistogramCollection()->CreateProxy(mcInYRangeProxyPath,kTRUE);
-  if(!mcInYRangeProxy) printf("Warning :  unable to create proxy for mcInYRangeProxy, will not be filled \n");
+  // Histograms of the input particles satisfying the Y cut are in the INYRANGE folder
+  Int_t folders[2] = {0,fInYRangeFolder};
 
   // number of tracks in Event
   Int_t nMCTracks = MCEvent()->GetNumberOfTracks();
 
-  TIter nextBin(fBinsToFill);
-  AliAnalysisMuMuBinning::Range* r;
-
   // Loop over all events
   for ( Int_t i = 0; i < nMCTracks; ++i ){
     // Get particle
@@ -599,22 +545,22 @@ void AliAnalysisMuMuMinv::FillHistosForMCEvent(const char* eventSelection,const
       // Get the default WeightPairDistribution
       Double_t inputWeight = WeightPairDistribution(part->Pt(),part->Y());
 
-      // Fill Pt, Y, Eta histos
-      if(mcProxy->Histo("Pt"))  mcProxy->Histo("Pt")->Fill(part->Pt(),inputWeight);
-      if(mcProxy->Histo("Y"))   mcProxy->Histo("Y")->Fill(part->Y(),inputWeight);
-      if(mcProxy->Histo("Eta")) mcProxy->Histo("Eta")->Fill(part->Eta());
+      // Fill Pt, Y, Eta histos, in the Y range folder as well if tracks rapidity in range
+      Int_t nFolders = ( -4.0 < part->Y() && part->Y() < -2.5 ) ? 2 : 1;
 
-      // Fill Pt, Y, Eta histos if tracks rapidity in range
-      if ( -4.0 < part->Y() && part->Y() < -2.5 && mcInYRangeProxy ){
-        if(mcInYRangeProxy->Histo("Pt") )  mcInYRangeProxy->Histo("Pt")->Fill(part->Pt(),inputWeight);
-        if(mcInYRangeProxy->Histo("Y") )   mcInYRangeProxy->Histo("Y")->Fill(part->Y(),inputWeight);
-        if(mcInYRangeProxy->Histo("Eta") ) mcInYRangeProxy->Histo("Eta")->Fill(part->Eta());
+      for ( Int_t ifolder = 0; ifolder < nFolders; ++ifolder ){
+        TH1* h = TableMCHisto(fMCKineIds[0],folders[ifolder]);
+        if ( h ) h->Fill(part->Pt(),inputWeight);
+        h = TableMCHisto(fMCKineIds[1],folders[ifolder]);
+        if ( h ) h->Fill(part->Y(),inputWeight);
+        h = TableMCHisto(fMCKineIds[2],folders[ifolder]);
+        if ( h ) h->Fill(part->Eta());
       }
 
-      nextBin.Reset();
-
       // Loop on all range in order to fill Histo
-      while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(nextBin()) ) ){
+      for ( Int_t ibin = 0; ibin <= fBinsToFill->GetLast(); ++ibin ){
+
+        AliAnalysisMuMuBinning::Range* r = static_cast<AliAnalysisMuMuBinning::Range*>(fBinsToFill->UncheckedAt(ibin));
 
         // Check if particles pass all the cuts for different bins
         Bool_t ok(kFALSE);
@@ -638,73 +584,112 @@ void AliAnalysisMuMuMinv::FillHistosForMCEvent(const char* eventSelection,const
         }
 
         // Fill Minv histo if bin is in range
-        if ( ok ){
-
-          // Get histo name
-          TString hname = GetMinvHistoName(*r,kFALSE);
-
-          // Chek if histo disabled
-          if (!IsHistogramDisabled(hname.Data())){
-            TH1* h = mcProxy->Histo(hname.Data());
-            if (!h) {
-              AliError(Form("Could not get /%s/%s/%s/%s/%s",MCInputPrefix(),eventSelection,triggerClassName,centrality,hname.Data()));
-              continue;
-            }
-            h->Fill(part->M(),inputWeight);
-
-            if ( -4.0 < part->Y() && part->Y() < -2.5 && mcInYRangeProxy  ){
-              h = mcInYRangeProxy->Histo(hname.Data());
-              if (!h){
-                AliError(Form("Could not get /%s/%s/%s/%s/INYRANGE %s",MCInputPrefix(),eventSelection,triggerClassName,centrality,hname.Data()));
-                continue;
-              }
-              h->Fill(part->M(),inputWeight);
-            }
+        if ( !ok ) continue;
+
+        // Histo disabled
+        Int_t id = fHistoIds[MinvHistoIndex(ibin,0,0,0,kMinvHisto)];
+        if ( id < 0 ) continue;
+
+        for ( Int_t ifolder = 0; ifolder < nFolders; ++ifolder ){
+
+          TH1* h = TableMCHisto(id,folders[ifolder]);
+          if (!h) {
+            AliError(Form("Could not get /%s/%s/%s/%s%s %s",MCInputPrefix(),eventSelection,triggerClassName,centrality,ifolder ? "/INYRANGE" : "",
+                          GetMinvHistoName(*r,kFALSE).Data()));
+            break;
           }
+          h->Fill(part->M(),inputWeight);
 
           // Fill compute mean pt histo
           if ( fComputeMeanPt ){
-
-            TString hprofName = Form("MeanPtVs%s",hname.Data());
-            TProfile* hprof   = MCProf(eventSelection,triggerClassName,centrality,hprofName.Data());
-
-            if ( !hprof )AliError(Form("Could not get %s",hprofName.Data()));
+            TProfile* hprof = TableMCProf(fHistoIds[MinvHistoIndex(ibin,0,0,0,kMeanPtProf)],folders[ifolder]);
+            if ( !hprof ) AliError(Form("Could not get MeanPtVs%s",GetMinvHistoName(*r,kFALSE).Data()));
             else hprof->Fill(part->M(),part->Pt(),inputWeight);
-
-            if ( -4.0 < part->Y() && part->Y() < -2.5 ){
-              hprof = MCProf(eventSelection,triggerClassName,Form("%s/INYRANGE",centrality),hprofName.Data());
-              if ( !hprof )AliError(Form("Could not get %s",hprofName.Data()));
-              else hprof->Fill(part->M(),part->Pt(),inputWeight);
-            }
           }
         }
       }
     } else continue;
   }
+}
 
-  delete mcProxy;
-  delete mcInYRangeProxy;
+//_____________________________________________________________________________
+void AliAnalysisMuMuMinv::FillMinvHisto(Int_t ibin, Bool_t accEffCorrected, Int_t chargeIndex, Int_t mixIndex, Bool_t mc,
+                                        TLorentzVector* pair4Momentum, Double_t inputWeight)
+{
+  /// Fill Minv histo (and mean pt profiles) of one bin, in the folder of the current pair cut
+
+  Int_t id = fHistoIds[MinvHistoIndex(ibin,accEffCorrected,chargeIndex,mixIndex,kMinvHisto)];
+  if ( id < 0 ) return; // disabled
+
+  Int_t pairCutFolder = HistoTableCutFolder();
+
+  TH1* h = static_cast<TH1*>(TableObject(id,mc,pairCutFolder));
+  if (h) h->Fill(pair4Momentum->M(),inputWeight);
+
+  // Fill Mean pT
+  if ( fComputeMeanPt ){
+    Int_t idProf  = fHistoIds[MinvHistoIndex(ibin,accEffCorrected,chargeIndex,mixIndex,kMeanPtProf)];
+    Int_t idProf2 = fHistoIds[MinvHistoIndex(ibin,accEffCorrected,chargeIndex,mixIndex,kMeanPtSquareProf)];
+    TProfile* hprof  = static_cast<TProfile*>(TableObject(idProf,mc,pairCutFolder));
+    TProfile* hprof2 = static_cast<TProfile*>(TableObject(idProf2,mc,pairCutFolder));
+    if ( !hprof ) AliError(Form("Could not get hprofile for bin %d",ibin));
+    else hprof->Fill(pair4Momentum->M(),pair4Momentum->Pt(),inputWeight);
+    if ( !hprof2 ) AliError(Form("Could not get hprofile for bin %d",ibin));
+    else hprof2->Fill(pair4Momentum->M(),pair4Momentum->Pt()*pair4Momentum->Pt(),inputWeight);
+  }
 }
 
 //_____________________________________________________________________________
-void AliAnalysisMuMuMinv::FillMinvHisto(TString* minvName,TProfile* hprof,TProfile* hprof2,AliMergeableCollectionProxy* proxy, TLorentzVector* pair4Momentum, Double_t inputWeight)
+void AliAnalysisMuMuMinv::DefineHistoTableIds()
 {
-  /// Create, fill and store Minv histo
-  if (!IsHistogramDisabled(minvName->Data())){
+  /// Register in the histogram table all the names the Fill methods may use,
+  /// so that the per-pair and per-particle code only deals with integer ids.
+  /// Disabled histograms get a negative id.
 
-    TH1* h(0x0);
+  SetHistoTableCutType(AliAnalysisMuMuCutElement::kTrackPair);
+  fInYRangeFolder = HistoTableFolder("INYRANGE");
 
-    h = proxy->Histo(minvName->Data());
-    if (h) h->Fill(pair4Momentum->M(),inputWeight);
+  if (!fBinsToFill) SetBinsToFill("psi","integrated,ptvsy,yvspt,pt,y,phi,ntrcorr,ntr,nch,v0a,v0acorr,v0ccorr,v0mcorr");
 
-    // Fill Mean pT
-    if ( fComputeMeanPt ){
-      if ( !hprof ) AliError(Form("Could not get hprofile for %s",minvName->Data()));
-      else hprof->Fill(pair4Momentum->M(),pair4Momentum->Pt(),inputWeight);
-      if ( !hprof2 ) AliError(Form("Could not get hprofile for %s",minvName->Data()));
-      else hprof2->Fill(pair4Momentum->M(),pair4Momentum->Pt()*pair4Momentum->Pt(),inputWeight);
+  Int_t nBins = fBinsToFill->GetLast()+1;
+  fHistoIds.assign(KineHistoIndex(kNKineHistos-1,2,1)+1,-1);
+
+  const Double_t charges[3] = {0,2,-2};
+
+  for ( Int_t ibin = 0; ibin < nBins; ++ibin ){
+    AliAnalysisMuMuBinning::Range* r = static_cast<AliAnalysisMuMuBinning::Range*>(fBinsToFill->UncheckedAt(ibin));
+    for ( Int_t iacc = 0; iacc < 2; ++iacc ){
+      for ( Int_t ic = 0; ic < 3; ++ic ){
+        for ( Int_t im = 0; im < 2; ++im ){
+          TString minvName = GetMinvHistoName(*r,iacc,charges[ic],im);
+          if ( IsHistogramDisabled(minvName.Data()) ) continue;
+          fHistoIds[MinvHistoIndex(ibin,iacc,ic,im,kMinvHisto)]        = HistoTableId(minvName.Data());
+          fHistoIds[MinvHistoIndex(ibin,iacc,ic,im,kMeanPtProf)]       = HistoTableId(Form("MeanPtVs%s",minvName.Data()));
+          fHistoIds[MinvHistoIndex(ibin,iacc,ic,im,kMeanPtSquareProf)] = HistoTableId(Form("MeanPtSquareVs%s",minvName.Data()));
+        }
+      }
     }
   }
+
+  const char* kine[kNKineHistos] = {"Pt","Y","Eta"};
+  const char* scharge[3] = {"","PP","MM"};
+
+  for ( Int_t ik = 0; ik < kNKineHistos; ++ik ){
+    if ( IsHistogramDisabled(kine[ik]) ) continue;
+    for ( Int_t ic = 0; ic < 3; ++ic ){
+      for ( Int_t im = 0; im < 2; ++im ){
+        fHistoIds[KineHistoIndex(ik,ic,im)] = HistoTableId(Form("%s%s%s",kine[ik],im ? "Mix" : "",scharge[ic]));
+      }
+    }
+  }
+
+  // MC inputs are not subject to histogram disabling
+  for ( Int_t ik = 0; ik < kNKineHistos; ++ik ) fMCKineIds[ik] = HistoTableId(kine[ik]);
+
+  fPtPaireVsPtTrackId = IsHistogramDisabled("PtPaireVsPtTrack") ? -1 : HistoTableId("PtPaireVsPtTrack");
+  fPtRecVsSimId       = HistoTableId("PtRecVsSim");
+  fNchForJpsiId       = HistoTableId("NchForJpsi");
+  fNchForPsiPId       = HistoTableId("NchForPsiP");
 }
 
 //_____________________________________________________________________________
@@ -818,7 +803,7 @@ Bool_t AliAnalysisMuMuMinv::IsPtInRange(const AliVParticle& t1, const AliVPartic
 }
 
 //_____________________________________________________________________________
-Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, AliMergeableCollectionProxy* proxy)
+Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, TH1* hNchForJpsi, TH1* hNchForPsiP)
 {
   /// Check if our pairs match conditions from the binning range
 
@@ -835,7 +820,7 @@ Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, T
     // Fill NchForJpsi histo according to pair4Momentum.M()
     if ( pair4Momentum->M() >= 2.9 && pair4Momentum->M() <= 3.3 ){
 
-      h = proxy->Histo("NchForJpsi");
+      h = hNchForJpsi;
 
       Double_t ntrcorr = (-1.);
       TList* list = static_cast<TList*>(Event()->FindListObject("NCH"));
@@ -855,11 +840,11 @@ Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, T
           }
         }
       }
-      h->Fill(ntrcorr);
+      if (h) h->Fill(ntrcorr);
     }
     else if ( pair4Momentum->M() >= 3.6 && pair4Momentum->M() <= 3.9){
 
-      h = proxy->Histo("NchForPsiP");
+      h = hNchForPsiP;
       Double_t ntrcorr = (-1.);
 
       TList* list = static_cast<TList*>(Event()->FindListObject("NCH"));
@@ -879,7 +864,7 @@ Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, T
           }
         }
       }
-      h->Fill(ntrcorr);
+      if (h) h->Fill(ntrcorr);
     }
   }
 
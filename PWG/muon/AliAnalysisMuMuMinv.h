@@ -14,6 +14,7 @@
 #include "TString.h"
 #include "TLorentzVector.h"
 #include "TH2.h"
+#include <vector>
 
 class TH2F;
 class AliVParticle;
@@ -72,10 +73,27 @@ protected:
 
   void FillHistosForMCEvent(const char* eventSelection,const char* triggerClassName,const char* centrality);
 
-  void FillMinvHisto(TString* minvName,TProfile* hprof,TProfile* hprof2,AliMergeableCollectionProxy* proxy, TLorentzVector* pair4Momentum, Double_t inputWeight);
+  void FillMinvHisto(Int_t ibin, Bool_t accEffCorrected, Int_t chargeIndex, Int_t mixIndex, Bool_t mc,
+                     TLorentzVector* pair4Momentum, Double_t inputWeight);
+
+  void DefineHistoTableIds();
 
 private:
 
+  /// kinds of per-bin histograms, used to index fHistoIds
+  enum EMinvHistoKind { kMinvHisto, kMeanPtProf, kMeanPtSquareProf, kNMinvHistoKinds };
+
+  /// number of (Pt,Y,Eta) vs minv sparse histograms
+  enum { kNKineHistos = 3 };
+
+  /// position in fHistoIds of a per-bin histogram (chargeIndex : 0 = +-, 1 = ++, 2 = --)
+  Int_t MinvHistoIndex(Int_t ibin, Int_t accEff, Int_t chargeIndex, Int_t mixIndex, Int_t kind) const
+  { return (((ibin*2 + accEff)*3 + chargeIndex)*2 + mixIndex)*kNMinvHistoKinds + kind; }
+
+  /// position in fHistoIds of a (Pt,Y,Eta) sparse histogram, stored after the per-bin ones
+  Int_t KineHistoIndex(Int_t ikine, Int_t chargeIndex, Int_t mixIndex) const
+  { return MinvHistoIndex(fBinsToFill->GetLast()+1,0,0,0,0) + (ikine*3 + chargeIndex)*2 + mixIndex; }
+
   void CreateMinvHistograms(const char* eventSelection, const char* triggerClassName, const char* centrality);
 
   // normalize the function to its integral in the given range
@@ -91,7 +109,7 @@ private:
 
   Double_t TriggerLptApt(Double_t *x, Double_t *par);
 
-  Bool_t  CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, AliMergeableCollectionProxy* proxy);
+  Bool_t  CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, TH1* hNchForJpsi, TH1* hNchForPsiP);
 
   Bool_t CheckMCTracksMatchingStackAndMother(Int_t labeli, Int_t labelj, AliVParticle* mcTracki, AliVParticle* mcTrackj, Double_t inputWeightMC);
 
@@ -111,8 +129,15 @@ private:
   Double_t fMinvMax;
   Double_t fmcptcutmin;
   Double_t fmcptcutmax;
-
-  ClassDef(AliAnalysisMuMuMinv,8) // implementation of AliAnalysisMuMuBase for muon pairs
+  std::vector<Int_t> fHistoIds; //! histogram table ids of the per-bin and sparse histograms (-1 = disabled)
+  Int_t fMCKineIds[kNKineHistos]; //! histogram table ids of the MC input Pt, Y and Eta histograms
+  Int_t fInYRangeFolder; //! histogram table folder of the MC inputs within the rapidity range
+  Int_t fPtPaireVsPtTrackId; //! histogram table id
+  Int_t fPtRecVsSimId; //! histogram table id
+  Int_t fNchForJpsiId; //! histogram table id
+  Int_t fNchForPsiPId; //! histogram table id
+
+  ClassDef(AliAnalysisMuMuMinv,9) // implementation of AliAnalysisMuMuBase for muon pairs
 };
 
 #endif
@@ -132,9 +132,20 @@ fSPD2LR(0x0),
 fSPD2LL(0x0),
 fMCWeightList(0x0),
 fMCWeight(1.),
-fV0side(0x0)
+fV0side(0x0),
+fBinsDNchdEta(0x0),
+fBinsNtr(0x0),
+fBinsNtrCorr(0x0),
+fBinsRelNtrCorr(0x0),
+fDNchdEtaIds(),
+fNtrIds(),
+fMCNtrIds(),
+fNtrCorrIds(),
+fMCNtrCorrIds(),
+fRelNtrCorrIds()
 {
   /// default ctor
+  for ( Int_t i = 0; i < kNNchHistos; ++i ) fHistoIds[i] = -1;
 }
 
 
@@ -200,8 +211,20 @@ fSPD2LR(0x0),
 fSPD2LL(0x0),
 fMCWeightList(0x0),
 fMCWeight(1.),
-fV0side(0x0)
+fV0side(0x0),
+fBinsDNchdEta(0x0),
+fBinsNtr(0x0),
+fBinsNtrCorr(0x0),
+fBinsRelNtrCorr(0x0),
+fDNchdEtaIds(),
+fNtrIds(),
+fMCNtrIds(),
+fNtrCorrIds(),
+fMCNtrCorrIds(),
+fRelNtrCorrIds()
 {
+  for ( Int_t i = 0; i < kNNchHistos; ++i ) fHistoIds[i] = -1;
+
   //FIXME: Add a protection to avoid an etamin or etamax non multiple of the eta bin size
 
   /// Constructor for tracklets multiplicity analysis
@@ -279,8 +302,20 @@ fSPD2LR(0x0),
 fSPD2LL(0x0),
 fMCWeightList(0x0),
 fMCWeight(1.),
-fV0side(0x0)
+fV0side(0x0),
+fBinsDNchdEta(0x0),
+fBinsNtr(0x0),
+fBinsNtrCorr(0x0),
+fBinsRelNtrCorr(0x0),
+fDNchdEtaIds(),
+fNtrIds(),
+fMCNtrIds(),
+fNtrCorrIds(),
+fMCNtrCorrIds(),
+fRelNtrCorrIds()
 {
+  for ( Int_t i = 0; i < kNNchHistos; ++i ) fHistoIds[i] = -1;
+
   //FIXME: Add a protection to avoid an etamin or etamax non multiple of the eta bin size
 
   /// Constructor for tracklets multiplicity analysis
@@ -349,8 +384,20 @@ fSPD2LR(0x0),
 fSPD2LL(0x0),
 fMCWeightList(0x0),
 fMCWeight(1.),
-fV0side(0x0)
+fV0side(0x0),
+fBinsDNchdEta(0x0),
+fBinsNtr(0x0),
+fBinsNtrCorr(0x0),
+fBinsRelNtrCorr(0x0),
+fDNchdEtaIds(),
+fNtrIds(),
+fMCNtrIds(),
+fNtrCorrIds(),
+fMCNtrCorrIds(),
+fRelNtrCorrIds()
 {
+  for ( Int_t i = 0; i < kNNchHistos; ++i ) fHistoIds[i] = -1;
+
   //FIXME: Add a protection to avoid an etamin or etamax non multiple of the eta bin size
 
   /// This construction is designed to compute everything in etaMin < eta < etaMax and correct with spdMeanCorrection (main eta tange and correction), but when filling the histos in FillHistosForEvent is able to compute the number of tracklets in etaMinToCompare < eta < etaMaxToCompare and correct them with spdMeanCorrectionToCompare (secondary eta range and correction) in order to compare N_{tr}^{|eta|< etaMax} vs N_{tr}^{|eta|< etaMaxToCompare}
@@ -421,8 +468,20 @@ fSPD2LR(0x0),
 fSPD2LL(0x0),
 fMCWeightList(0x0),
 fMCWeight(1.),
-fV0side(0x0)
+fV0side(0x0),
+fBinsDNchdEta(0x0),
+fBinsNtr(0x0),
+fBinsNtrCorr(0x0),
+fBinsRelNtrCorr(0x0),
+fDNchdEtaIds(),
+fNtrIds(),
+fMCNtrIds(),
+fNtrCorrIds(),
+fMCNtrCorrIds(),
+fRelNtrCorrIds()
 {
+  for ( Int_t i = 0; i < kNNchHistos; ++i ) fHistoIds[i] = -1;
+
   //FIXME: Add a protection to avoid an etamin or etamax non multiple of the eta bin size
 
   // Uses a different correction for each group of runs (both SPD AccxEff OR mean tracklets are supported)
@@ -488,8 +547,19 @@ fSPD2LR(0x0),
 fSPD2LL(0x0),
 fMCWeightList(0x0),
 fMCWeight(1.),
-fV0side(new TString(V0side))
+fV0side(new TString(V0side)),
+fBinsDNchdEta(0x0),
+fBinsNtr(0x0),
+fBinsNtrCorr(0x0),
+fBinsRelNtrCorr(0x0),
+fDNchdEtaIds(),
+fNtrIds(),
+fMCNtrIds(),
+fNtrCorrIds(),
+fMCNtrCorrIds(),
+fRelNtrCorrIds()
 {
+  for ( Int_t i = 0; i < kNNchHistos; ++i ) fHistoIds[i] = -1;
 
   /// Constructor for tracklets multiplicity analysis
   /// With this constructor we can correct compute the raw V0(A,C,TOT) multiplicity, the corrected V0 multiplicity and also compare with the tracklets
@@ -546,6 +616,10 @@ AliAnalysisMuMuNch::~AliAnalysisMuMuNch()
   delete fGeneratorHeaderClass;
   delete fMCWeightList;
   delete fV0side;
+  delete fBinsDNchdEta;
+  delete fBinsNtr;
+  delete fBinsNtrCorr;
+  delete fBinsRelNtrCorr;
 }
 
 //_____________________________________________________________________________
@@ -805,6 +879,67 @@ void AliAnalysisMuMuNch::DefineHistogramCollection(const char* eventSelection,
 
 }
 
+//_____________________________________________________________________________
+void AliAnalysisMuMuNch::DefineHistoTableIds()
+{
+  /// Register the histograms of the Fill methods in the histogram table,
+  /// together with the bins of the per-bin histograms (which then do not need
+  /// to be created at each event).
+
+  // names must follow the ENchHisto order
+  const char* names[kNNchHistos] =
+  {
+    "MeanTrackletsVsEta", "MeanNchVsEta", "MeandNchdEtaVsEta", "EventsVsZVertexVsEta",
+    "TrackletsVsZVertexVsPhi", "TrackletsVsZVertexVsEta", "NchVsZVertexVsEta", "Tracklets",
+    "MeanTrackletsVsZVertex", "TrackletsCorrection", "TrackletsSecVsZVertexVsEta",
+    "CorrTrackletsEtaSecVsCorrTrackletsEtaPrim", "MeanNchEtaSecVsZVertex", "MeanTrackletsEtaSecVsZVertex",
+    "dNchdetaComparison2Corrections", "CheckMeanNtrCorrVsZVertex",
+    "DispersiondNchdetaComparison2Corrections", "CheckNtrCorr", "TrackletsVsNch", "Nch", "MeanNchVsZVertex",
+    "V0Mult", "V0MultVsTracklets", "V0MultVsZVertex", "MeanV0MultVsZVertex", "V0CorrMult", "V0CorrMultVsNch",
+    "V0CorrMultVsZVertex", "MeanV0CorrMultVsZVertex", "dNchdEtaRescaled", "dNchdEta",
+    "MeandNchdEtaVsZVertex", "SPDZvResVsnC", "SPDZvResVsMCz", "Eta", "MCEta", "EtaRes", "EtaResVsZ",
+    "EtaResVsnC", "Phi", "MCPhi", "PhiRes", "PhiResVsZ", "PhiResShifted", "PhiResVsnC",
+    "NBkgTrackletsVsZVertexVsEta", "NchVsZVertexVsPhi", "NchVsRecoZVertexVsEta", "CorrTrackletsVsNch",
+    "dNchdetaFromNtrCorrVsdNchdEtaMC", "RelDispersiondNchdetaFromNtrCorrVsdNchdEtaMC",
+    "DispersiondNchdetaFromNtrCorrVsdNchdEtaMC", "dNchdetaVsMCdNchdeta", "dNchdetaFromAccEffVsdNchdEtaMC",
+    "RelDispersiondNchdetaFromAccEffVsdNchdEtaMC", "DispersiondNchdetaFromAccEffVsdNchdEtaMC",
+    "V0AMultVsNch", "V0CMultVsNch"
+  };
+
+  for ( Int_t i = 0; i < kNNchHistos; ++i ) fHistoIds[i] = HistoTableId(names[i]);
+
+  fBinsDNchdEta   = DefineBinnedHistoTableIds("dnchdeta","DNCHDETA","EventsIn",fDNchdEtaIds);
+  fBinsNtr        = DefineBinnedHistoTableIds("ntr","NTR","MeanTrackletsVsZVertex",fNtrIds,"MeanNchVsZVertex",&fMCNtrIds);
+  fBinsNtrCorr    = DefineBinnedHistoTableIds("ntrcorr","NTRCORR","MeanNchVsZVertex",fNtrCorrIds,"GenNchVsZVertex",&fMCNtrCorrIds);
+  fBinsRelNtrCorr = DefineBinnedHistoTableIds("relntrcorr","RELNTRCORR","EventsIn",fRelNtrCorrIds);
+}
+
+//_____________________________________________________________________________
+TObjArray* AliAnalysisMuMuNch::DefineBinnedHistoTableIds(const char* what, const char* quantity,
+                                                         const char* prefix, std::vector<Int_t>& ids,
+                                                         const char* mcPrefix, std::vector<Int_t>* mcIds)
+{
+  /// Get the psi bins of a given type and register the prefix+bin (and mcPrefix+bin)
+  /// histograms. Bins of another quantity get a negative id.
+
+  TObjArray* bins = Binning()->CreateBinObjArray("psi",what,"");
+
+  ids.assign(bins->GetEntries(),-1);
+  if ( mcIds ) mcIds->assign(bins->GetEntries(),-1);
+
+  for ( Int_t i = 0; i < bins->GetEntries(); ++i )
+  {
+    AliAnalysisMuMuBinning::Range* r = static_cast<AliAnalysisMuMuBinning::Range*>(bins->At(i));
+
+    if ( r->Quantity() != quantity ) continue;
+
+    ids[i] = HistoTableId(Form("%s%s",prefix,r->AsString().Data()));
+    if ( mcIds ) (*mcIds)[i] = HistoTableId(Form("%s%s",mcPrefix,r->AsString().Data()));
+  }
+
+  return bins;
+}
+
 //_____________________________________________________________________________
 void AliAnalysisMuMuNch::DefineSPDAcceptance()
 {
@@ -930,19 +1065,12 @@ void AliAnalysisMuMuNch::DefineSPDFluctuationsMap(TH2F* spdFluctuations)
 }
 
 //_____________________________________________________________________________
-void AliAnalysisMuMuNch::AddHisto(const char* eventSelection,
-                                  const char* triggerClassName,
-                                  const char* centrality,
-                                  const char* histoname,
-                                  Double_t z,
-                                  TH1* h,Bool_t isMC)
+void AliAnalysisMuMuNch::AddHisto(TH1* hzeta, Double_t z, TH1* h)
 {
   // Adds the content of a 1D histo to a 2D histo a the z position
 
   Int_t zbin = fZAxis->FindBin(z);
-  TH2F* h2;
-  if (isMC) h2 = static_cast<TH2F*>(MCHisto(eventSelection,triggerClassName,centrality,histoname));
-  else h2 = static_cast<TH2F*>(Histo(eventSelection,triggerClassName,centrality,histoname));
+  TH2F* h2 = static_cast<TH2F*>(hzeta);
 
   for ( Int_t i = 1; i <= h->GetXaxis()->GetNbins(); ++i )
   {
@@ -1078,11 +1206,11 @@ void AliAnalysisMuMuNch::FillHistosForEvent(const char* eventSelection,
 
   TH1* hNchVsEta = static_cast<TH1*>(hNTrackletVsEta->Clone("NchVsEta"));
 
-  TProfile* hMeanTrackletsVsEta = static_cast<TProfile*>(Histo(eventSelection,triggerClassName,centrality,"MeanTrackletsVsEta"));
-  TProfile* hMeanNchVsEta       = static_cast<TProfile*>(Histo(eventSelection,triggerClassName,centrality,"MeanNchVsEta"));
-  TProfile* hMeandNchdEtaVsEta  = static_cast<TProfile*>(Histo(eventSelection,triggerClassName,centrality,"MeandNchdEtaVsEta"));
+  TProfile* hMeanTrackletsVsEta = static_cast<TProfile*>(NchHisto(kMeanTrackletsVsEta));
+  TProfile* hMeanNchVsEta       = static_cast<TProfile*>(NchHisto(kMeanNchVsEta));
+  TProfile* hMeandNchdEtaVsEta  = static_cast<TProfile*>(NchHisto(kMeandNchdEtaVsEta));
 
-  TH2* hEventsVsZVertexVsEta    = static_cast<TH2*>(Histo(eventSelection,triggerClassName,centrality,"EventsVsZVertexVsEta"));
+  TH2* hEventsVsZVertexVsEta    = static_cast<TH2*>(NchHisto(kEventsVsZVertexVsEta));
 
   Int_t nBins(0);
 
@@ -1129,13 +1257,13 @@ void AliAnalysisMuMuNch::FillHistosForEvent(const char* eventSelection,
     hEventsVsZVertexVsEta->Fill(SPDZv,eta,1.0); // Fill 1 count each eta bin where the events contributes
   }
 
-  AddHisto(eventSelection,triggerClassName,centrality,"TrackletsVsZVertexVsPhi",SPDZv,hNTrackletVsPhi);
-  AddHisto(eventSelection,triggerClassName,centrality,"TrackletsVsZVertexVsEta",SPDZv,hNTrackletVsEta);
+  AddHisto(NchHisto(kTrackletsVsZVertexVsPhi),SPDZv,hNTrackletVsPhi);
+  AddHisto(NchHisto(kTrackletsVsZVertexVsEta),SPDZv,hNTrackletVsEta);
 
-  AddHisto(eventSelection,triggerClassName,centrality,"NchVsZVertexVsEta",SPDZv,hNchVsEta);
+  AddHisto(NchHisto(kNchVsZVertexVsEta),SPDZv,hNchVsEta);
 
-  Histo(eventSelection,triggerClassName,centrality,"Tracklets")->Fill(nTracklets[0]);
-  Histo(eventSelection,triggerClassName,centrality,"MeanTrackletsVsZVertex")->Fill(SPDZv,nTracklets[0]);
+  NchHisto(kTracklets)->Fill(nTracklets[0]);
+  NchHisto(kMeanTrackletsVsZVertex)->Fill(SPDZv,nTracklets[0]);
 
 
   delete hNchVsEta; // We delete the clone to avoid memory leak
@@ -1145,23 +1273,23 @@ void AliAnalysisMuMuNch::FillHistosForEvent(const char* eventSelection,
   {
     Double_t SPDr = GetTrackletsMeanCorrection(SPDZv,nTracklets[0]); // Get 'mean correction' for the zvtx
 
-    Histo(eventSelection,triggerClassName,centrality,"TrackletsCorrection")->Fill(SPDr);
+    NchHisto(kTrackletsCorrection)->Fill(SPDr);
 
     if ( SPDr < -999.) nch[0] = -1;
     else nch[0] = nTracklets[0] + SPDr; // In case of 'mean correction' nch has not be filled in the eta bins loop //FIXME: Due to the TRamdon the correction for a given event is not the same here and in SetEvent()
 
     if ( fSPDMeanTrackletsCorrToCompare ) // Comparison of corrected tracklets in the primary and secondary eta ranges
     {
-      AddHisto(eventSelection,triggerClassName,centrality,"TrackletsSecVsZVertexVsEta",SPDZv,hNTrackletSecVsEta);
+      AddHisto(NchHisto(kTrackletsSecVsZVertexVsEta),SPDZv,hNTrackletSecVsEta);
 
       Double_t SPDrEtaComp = GetTrackletsMeanCorrection(SPDZv,nTracklets[1],kTRUE); // Get secondary 'mean correction' for the zvtx
 
       if ( SPDrEtaComp < -999.) nch[1] = -1;
       else nch[1] = nTracklets[1] + SPDrEtaComp; // In case of 'mean correction' nch has not be filled in the eta bins loop
 
-      Histo(eventSelection,triggerClassName,centrality,"CorrTrackletsEtaSecVsCorrTrackletsEtaPrim")->Fill(nch[0],nch[1]);
-      Histo(eventSelection,triggerClassName,centrality,"MeanNchEtaSecVsZVertex")->Fill(SPDZv,nch[1]); // Control plot to check if the secondary correction is applied correctly
-      Histo(eventSelection,triggerClassName,centrality,"MeanTrackletsEtaSecVsZVertex")->Fill(SPDZv,nTracklets[1]);
+      NchHisto(kCorrTrackletsEtaSecVsCorrTrackletsEtaPrim)->Fill(nch[0],nch[1]);
+      NchHisto(kMeanNchEtaSecVsZVertex)->Fill(SPDZv,nch[1]); // Control plot to check if the secondary correction is applied correctly
+      NchHisto(kMeanTrackletsEtaSecVsZVertex)->Fill(SPDZv,nTracklets[1]);
     }
 
   }
@@ -1197,22 +1325,22 @@ void AliAnalysisMuMuNch::FillHistosForEvent(const char* eventSelection,
       // Double_t dNchdetaPubli = 17.35; //FIXME: hardcoded (pPb value)
       Double_t ctToNch = 1.11; //FIXME: hardcoded (value for Nch vs NtrCorr(eta<0.5) in pPb)
 
-      Histo(eventSelection,triggerClassName,centrality,"dNchdetaComparison2Corrections")->Fill(dNchdeta,ctToNch*NtrCorr/(2*fEtaMax));
-      Histo(eventSelection,triggerClassName,centrality,"CheckMeanNtrCorrVsZVertex")->Fill(SPDZv,NtrCorr);
+      NchHisto(kdNchdetaComparison2Corrections)->Fill(dNchdeta,ctToNch*NtrCorr/(2*fEtaMax));
+      NchHisto(kCheckMeanNtrCorrVsZVertex)->Fill(SPDZv,NtrCorr);
       if ( dNchdeta !=0 )
       {
-        Histo(eventSelection,triggerClassName,centrality,"DispersiondNchdetaComparison2Corrections")->Fill((dNchdeta - ctToNch*NtrCorr/(2*fEtaMax)) / dNchdeta);
+        NchHisto(kDispersiondNchdetaComparison2Corrections)->Fill((dNchdeta - ctToNch*NtrCorr/(2*fEtaMax)) / dNchdeta);
       }
 
-      Histo(eventSelection,triggerClassName,centrality,"CheckNtrCorr")->Fill(NtrCorr);
+      NchHisto(kCheckNtrCorr)->Fill(NtrCorr);
 
     }
   }
 
 
-  Histo(eventSelection,triggerClassName,centrality,"TrackletsVsNch")->Fill(nch[0],nTracklets[0]);
-  Histo(eventSelection,triggerClassName,centrality,"Nch")->Fill(nch[0]);
-  Histo(eventSelection,triggerClassName,centrality,"MeanNchVsZVertex")->Fill(SPDZv,nch[0]);
+  NchHisto(kTrackletsVsNch)->Fill(nch[0],nTracklets[0]);
+  NchHisto(kNch)->Fill(nch[0]);
+  NchHisto(kMeanNchVsZVertex)->Fill(SPDZv,nch[0]);
 
   //___V0A multiplicity
   Int_t i(-1);
@@ -1228,17 +1356,17 @@ void AliAnalysisMuMuNch::FillHistosForEvent(const char* eventSelection,
 
     if (  TString(p->GetName()).Contains("V0ARaw") ||  TString(p->GetName()).Contains("V0CRaw") ||  TString(p->GetName()).Contains("V0MRaw") )
     {
-      Histo(eventSelection,triggerClassName,centrality,"V0Mult")->Fill(p->GetVal());
-      Histo(eventSelection,triggerClassName,centrality,"V0MultVsTracklets")->Fill(nTracklets[0],p->GetVal());
-      Histo(eventSelection,triggerClassName,centrality,"V0MultVsZVertex")->Fill(SPDZv,p->GetVal());
-      Histo(eventSelection,triggerClassName,centrality,"MeanV0MultVsZVertex")->Fill(SPDZv,p->GetVal());
+      NchHisto(kV0Mult)->Fill(p->GetVal());
+      NchHisto(kV0MultVsTracklets)->Fill(nTracklets[0],p->GetVal());
+      NchHisto(kV0MultVsZVertex)->Fill(SPDZv,p->GetVal());
+      NchHisto(kMeanV0MultVsZVertex)->Fill(SPDZv,p->GetVal());
     }
     else if ( TString(p->GetName()).Contains("V0ACorr") || TString(p->GetName()).Contains("V0CCorr") || TString(p->GetName()).Contains("V0MCorr") )
     {
-      Histo(eventSelection,triggerClassName,centrality,"V0CorrMult")->Fill(p->GetVal());
-      Histo(eventSelection,triggerClassName,centrality,"V0CorrMultVsNch")->Fill(nch[0],p->GetVal());
-      Histo(eventSelection,triggerClassName,centrality,"V0CorrMultVsZVertex")->Fill(SPDZv,p->GetVal());
-      Histo(eventSelection,triggerClassName,centrality,"MeanV0CorrMultVsZVertex")->Fill(SPDZv,p->GetVal());
+      NchHisto(kV0CorrMult)->Fill(p->GetVal());
+      NchHisto(kV0CorrMultVsNch)->Fill(nch[0],p->GetVal());
+      NchHisto(kV0CorrMultVsZVertex)->Fill(SPDZv,p->GetVal());
+      NchHisto(kMeanV0CorrMultVsZVertex)->Fill(SPDZv,p->GetVal());
     }
   }
   //__________
@@ -1263,96 +1391,65 @@ void AliAnalysisMuMuNch::FillHistosForEvent(const char* eventSelection,
       meandNchdEta = nch[0] / (2.*fEtaMax); //fEtaAxis->GetBinWidth(5);
 
       Double_t ctToNch = 1.11; //FIXME: hardcoded (value for Nch vs NtrCorr(eta<0.5) in pPb)
-      Histo(eventSelection,triggerClassName,centrality,"dNchdEtaRescaled")->Fill(ctToNch*meandNchdEta);
+      NchHisto(kdNchdEtaRescaled)->Fill(ctToNch*meandNchdEta);
     }
   }
 
-  Histo(eventSelection,triggerClassName,centrality,"dNchdEta")->Fill(meandNchdEta);
-  Histo(eventSelection,triggerClassName,centrality,"MeandNchdEtaVsZVertex")->Fill(SPDZv,meandNchdEta);
+  NchHisto(kdNchdEta)->Fill(meandNchdEta);
+  NchHisto(kMeandNchdEtaVsZVertex)->Fill(SPDZv,meandNchdEta);
 
 
   //_____________These were tests //FIXME: Check if this tests are still neccesary_____________
-  TObjArray* bins = Binning()->CreateBinObjArray("psi","dnchdeta","");
-  TIter nextBin(bins);
-  AliAnalysisMuMuBinning::Range* r;
-
-  while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(nextBin()) ) )
+  for ( Int_t i = 0; i < static_cast<Int_t>(fDNchdEtaIds.size()); ++i )
   {
-    Bool_t ok(kFALSE);
-    if ( r->Quantity() == "DNCHDETA" )
-    {
-      ok = r->IsInRange(meandNchdEta);
-    }
+    if ( fDNchdEtaIds[i] < 0 ) continue; // not a DNCHDETA bin
+
+    AliAnalysisMuMuBinning::Range* r = static_cast<AliAnalysisMuMuBinning::Range*>(fBinsDNchdEta->UncheckedAt(i));
 
-    if ( ok )
+    if ( r->IsInRange(meandNchdEta) )
     {
-      Histo(eventSelection,triggerClassName,centrality,Form("EventsIn%s",r->AsString().Data()))->Fill(1.);
+      TableHisto(fDNchdEtaIds[i])->Fill(1.);
     }
   }
 
-  delete bins;
-
 
-  TObjArray* binsNtrRaw = Binning()->CreateBinObjArray("psi","ntr","");
-  TIter nextBinNtrRaw(binsNtrRaw);
-  AliAnalysisMuMuBinning::Range* rNtrRaw;
-
-  while ( ( rNtrRaw = static_cast<AliAnalysisMuMuBinning::Range*>(nextBinNtrRaw()) ) )
+  for ( Int_t i = 0; i < static_cast<Int_t>(fNtrIds.size()); ++i )
   {
-    Bool_t ok(kFALSE);
-    if ( rNtrRaw->Quantity() == "NTR" )
-    {
-      ok = rNtrRaw->IsInRange(nTracklets[0]);
-    }
+    if ( fNtrIds[i] < 0 ) continue; // not a NTR bin
+
+    AliAnalysisMuMuBinning::Range* rNtrRaw = static_cast<AliAnalysisMuMuBinning::Range*>(fBinsNtr->UncheckedAt(i));
 
-    if ( ok )
+    if ( rNtrRaw->IsInRange(nTracklets[0]) )
     {
-      Histo(eventSelection,triggerClassName,centrality,Form("MeanTrackletsVsZVertex%s",rNtrRaw->AsString().Data()))->Fill(SPDZv,nTracklets[0]);
+      TableHisto(fNtrIds[i])->Fill(SPDZv,nTracklets[0]);
     }
   }
 
-  delete binsNtrRaw;
-
-
-  TObjArray* binsNtr = Binning()->CreateBinObjArray("psi","ntrcorr","");
-  TIter nextBinNtr(binsNtr);
-  AliAnalysisMuMuBinning::Range* rNtr;
 
-  while ( ( rNtr = static_cast<AliAnalysisMuMuBinning::Range*>(nextBinNtr()) ) )
+  for ( Int_t i = 0; i < static_cast<Int_t>(fNtrCorrIds.size()); ++i )
   {
-    Bool_t ok(kFALSE);
-    if ( rNtr->Quantity() == "NTRCORR" )
-    {
-      ok = rNtr->IsInRange(nch[0]);
-    }
+    if ( fNtrCorrIds[i] < 0 ) continue; // not a NTRCORR bin
 
-    if ( ok )
+    AliAnalysisMuMuBinning::Range* rNtr = static_cast<AliAnalysisMuMuBinning::Range*>(fBinsNtrCorr->UncheckedAt(i));
+
+    if ( rNtr->IsInRange(nch[0]) )
     {
-      Histo(eventSelection,triggerClassName,centrality,Form("MeanNchVsZVertex%s",rNtr->AsString().Data()))->Fill(SPDZv,nch[0]);
+      TableHisto(fNtrCorrIds[i])->Fill(SPDZv,nch[0]);
     }
   }
 
-  delete binsNtr;
-
 
-  TObjArray* binsRel = Binning()->CreateBinObjArray("psi","relntrcorr","");
-  TIter nextBinRel(binsRel);
-  AliAnalysisMuMuBinning::Range* rRel;
-  while ( ( rRel = static_cast<AliAnalysisMuMuBinning::Range*>(nextBinRel()) ) )
+  for ( Int_t i = 0; i < static_cast<Int_t>(fRelNtrCorrIds.size()); ++i )
   {
-    Bool_t ok(kFALSE);
-    if ( rRel->Quantity() == "RELNTRCORR" )
-    {
-      ok = rRel->IsInRange(nch[0]/fMeanTrRef);
-    }
+    if ( fRelNtrCorrIds[i] < 0 ) continue; // not a RELNTRCORR bin
 
-    if ( ok )
+    AliAnalysisMuMuBinning::Range* rRel = static_cast<AliAnalysisMuMuBinning::Range*>(fBinsRelNtrCorr->UncheckedAt(i));
+
+    if ( rRel->IsInRange(nch[0]/fMeanTrRef) )
     {
-      Histo(eventSelection,triggerClassName,centrality,Form("EventsIn%s",rRel->AsString().Data()))->Fill(1.);
+      TableHisto(fRelNtrCorrIds[i])->Fill(1.);
     }
   }
-
-  delete binsRel;
   //_________________________________________________________________________________________
 
 }
@@ -1383,8 +1480,8 @@ void AliAnalysisMuMuNch::FillHistosForMCEvent(const char* eventSelection,const c
   {
     Int_t nContributors  = vertex->GetNContributors();
 
-    MCHisto(eventSelection,triggerClassName,centrality,"SPDZvResVsnC")->Fill(nContributors,SPDZv - MCZv);
-    MCHisto(eventSelection,triggerClassName,centrality,"SPDZvResVsMCz")->Fill(MCZv,SPDZv - MCZv);
+    NchMCHisto(kSPDZvResVsnC)->Fill(nContributors,SPDZv - MCZv);
+    NchMCHisto(kSPDZvResVsMCz)->Fill(MCZv,SPDZv - MCZv);
 
     Double_t EtaReco(0.),EtaMC(0.),PhiReco(0.),PhiMC(0.);
     Int_t i(-1),labelEtaReco(-1),labelEtaMC(-1),labelPhiReco(-1),labelPhiMC(-1);
@@ -1405,21 +1502,21 @@ void AliAnalysisMuMuNch::FillHistosForMCEvent(const char* eventSelection,const c
       {
         sscanf(p->GetName(),"EtaReco%d",&labelEtaReco);
         EtaReco = p->GetVal();
-        MCHisto(eventSelection,triggerClassName,centrality,"Eta")->Fill(EtaReco);
+        NchMCHisto(kEta)->Fill(EtaReco);
       }
       else if ( TString(p->GetName()).Contains("EtaMC") ) // We take the generated eta
       {
         sscanf(p->GetName(),"EtaMC%d",&labelEtaMC);
         EtaMC = p->GetVal();
-        MCHisto(eventSelection,triggerClassName,centrality,"MCEta")->Fill(EtaMC);
+        NchMCHisto(kMCEta)->Fill(EtaMC);
       }
       if ( labelEtaReco > 0 && labelEtaReco == labelEtaMC ) // To be sure we compute the difference for the same particle
       {
         labelEtaReco = -1; // Restart of the label value to avoid double count the eta difference when computing the phi one
         Double_t EtaDif = EtaReco - EtaMC;
-        MCHisto(eventSelection,triggerClassName,centrality,"EtaRes")->Fill(EtaDif);
-        MCHisto(eventSelection,triggerClassName,centrality,"EtaResVsZ")->Fill(MCZv,EtaDif);
-        MCHisto(eventSelection,triggerClassName,centrality,"EtaResVsnC")->Fill(nContributors,EtaDif);
+        NchMCHisto(kEtaRes)->Fill(EtaDif);
+        NchMCHisto(kEtaResVsZ)->Fill(MCZv,EtaDif);
+        NchMCHisto(kEtaResVsnC)->Fill(nContributors,EtaDif);
       }
 
          //Phi Resolution
@@ -1427,20 +1524,20 @@ void AliAnalysisMuMuNch::FillHistosForMCEvent(const char* eventSelection,const c
       {
         sscanf(p->GetName(),"PhiReco%d",&labelPhiReco);
         PhiReco = p->GetVal();
-        MCHisto(eventSelection,triggerClassName,centrality,"Phi")->Fill(PhiReco);
+        NchMCHisto(kPhi)->Fill(PhiReco);
       }
       else if ( TString(p->GetName()).Contains("PhiMC") ) // We take the generated phi
       {
         sscanf(p->GetName(),"PhiMC%d",&labelPhiMC);
         PhiMC = p->GetVal();
-        MCHisto(eventSelection,triggerClassName,centrality,"MCPhi")->Fill(PhiMC);
+        NchMCHisto(kMCPhi)->Fill(PhiMC);
       }
 
       if ( labelPhiReco > 0 && labelPhiReco == labelPhiMC ) // To be sure we compute the difference for the same particle
       {
         labelPhiReco = -1; // Restart of the label value to avoid double count the phi difference when computing the eta one
         Double_t PhiDif = PhiReco - PhiMC;
-        MCHisto(eventSelection,triggerClassName,centrality,"PhiRes")->Fill(PhiDif);
+        NchMCHisto(kPhiRes)->Fill(PhiDif);
 
         //___With the following algorithm we refer the differences to the interval [-Pi/2,Pi/2]
         if ( PhiDif < -TMath::PiOver2() && PhiDif > -TMath::Pi() )
@@ -1470,9 +1567,9 @@ void AliAnalysisMuMuNch::FillHistosForMCEvent(const char* eventSelection,const c
         }
         //___
 
-        MCHisto(eventSelection,triggerClassName,centrality,"PhiResVsZ")->Fill(MCZv,PhiDif);
-        MCHisto(eventSelection,triggerClassName,centrality,"PhiResShifted")->Fill(PhiDif);
-        MCHisto(eventSelection,triggerClassName,centrality,"PhiResVsnC")->Fill(nContributors,PhiDif);
+        NchMCHisto(kPhiResVsZ)->Fill(MCZv,PhiDif);
+        NchMCHisto(kPhiResShifted)->Fill(PhiDif);
+        NchMCHisto(kPhiResVsnC)->Fill(nContributors,PhiDif);
       }
     }
 
@@ -1488,9 +1585,9 @@ void AliAnalysisMuMuNch::FillHistosForMCEvent(const char* eventSelection,const c
   TH1* hNTrackletVsEta = static_cast<TH1*>(nchList->FindObject("MCNTrackletVsEta"));
   TH1* hNTrackletVsPhi = static_cast<TH1*>(nchList->FindObject("MCNTrackletVsPhi"));
 
-  TProfile* hMeanNchVsEta = static_cast<TProfile*>(MCHisto(eventSelection,triggerClassName,centrality,"MeanNchVsEta"));
+  TProfile* hMeanNchVsEta = static_cast<TProfile*>(NchMCHisto(kMeanNchVsEta));
 
-  TH2* hEventsVsZVertexVsEta = static_cast<TH2*>(MCHisto(eventSelection,triggerClassName,centrality,"EventsVsZVertexVsEta"));
+  TH2* hEventsVsZVertexVsEta = static_cast<TH2*>(NchMCHisto(kEventsVsZVertexVsEta));
 
   Int_t nBins(0);
 
@@ -1515,20 +1612,18 @@ void AliAnalysisMuMuNch::FillHistosForMCEvent(const char* eventSelection,const c
     hEventsVsZVertexVsEta->Fill(MCZv,eta,fMCWeight); // Fill 1 count (or weight) each eta bin where the events contributes
   }
 
-  MCHisto(eventSelection,triggerClassName,centrality,"Tracklets")->Fill(nTracklets,fMCWeight); // Note that these are NOT the same tracklets as in the FillHistosForEvent() since here the SPD "dead" zones (the ones where correction > threshold) are not rejected
-
-  Bool_t isMChisto = kTRUE; // Used to get the MC histos in the Add method
+  NchMCHisto(kTracklets)->Fill(nTracklets,fMCWeight); // Note that these are NOT the same tracklets as in the FillHistosForEvent() since here the SPD "dead" zones (the ones where correction > threshold) are not rejected
 
-  AddHisto(eventSelection,triggerClassName,centrality,"NBkgTrackletsVsZVertexVsEta",SPDZv,hNBkgTrackletsVSEta,isMChisto); //These histos are never weighted
-  AddHisto(eventSelection,triggerClassName,centrality,"NchVsZVertexVsPhi",MCZv,hNchVsPhi,isMChisto);
-  AddHisto(eventSelection,triggerClassName,centrality,"NchVsZVertexVsEta",MCZv,hNchVsEta,isMChisto);
-  AddHisto(eventSelection,triggerClassName,centrality,"NchVsRecoZVertexVsEta",SPDZv,hNchVsEta,isMChisto);
-  AddHisto(eventSelection,triggerClassName,centrality,"TrackletsVsZVertexVsEta",SPDZv,hNTrackletVsEta,isMChisto);
-  AddHisto(eventSelection,triggerClassName,centrality,"TrackletsVsZVertexVsPhi",SPDZv,hNTrackletVsPhi,isMChisto);
+  AddHisto(NchMCHisto(kNBkgTrackletsVsZVertexVsEta),SPDZv,hNBkgTrackletsVSEta); //These histos are never weighted
+  AddHisto(NchMCHisto(kNchVsZVertexVsPhi),MCZv,hNchVsPhi);
+  AddHisto(NchMCHisto(kNchVsZVertexVsEta),MCZv,hNchVsEta);
+  AddHisto(NchMCHisto(kNchVsRecoZVertexVsEta),SPDZv,hNchVsEta);
+  AddHisto(NchMCHisto(kTrackletsVsZVertexVsEta),SPDZv,hNTrackletVsEta);
+  AddHisto(NchMCHisto(kTrackletsVsZVertexVsPhi),SPDZv,hNTrackletVsPhi);
 
-  static_cast<TProfile*>(MCHisto(eventSelection,triggerClassName,centrality,"MeanNchVsZVertex"))->Fill(MCZv,nchSum,fMCWeight);
+  static_cast<TProfile*>(NchMCHisto(kMeanNchVsZVertex))->Fill(MCZv,nchSum,fMCWeight);
 
-  MCHisto(eventSelection,triggerClassName,centrality,"Nch")->Fill(nchSum,fMCWeight);
+  NchMCHisto(kNch)->Fill(nchSum,fMCWeight);
 
 
   // Mean dNch/dEta computation
@@ -1538,7 +1633,7 @@ void AliAnalysisMuMuNch::FillHistosForMCEvent(const char* eventSelection,const c
     meandNchdEta = nchSum / (nBins*fEtaAxis->GetBinWidth(5)); // Divide by nBins to get the mean and by the binWidht to get the d/dEta
   }
 
-  MCHisto(eventSelection,triggerClassName,centrality,"dNchdEta")->Fill(meandNchdEta,fMCWeight);
+  NchMCHisto(kdNchdEta)->Fill(meandNchdEta,fMCWeight);
 
 
   Int_t i(-1);
@@ -1558,7 +1653,7 @@ void AliAnalysisMuMuNch::FillHistosForMCEvent(const char* eventSelection,const c
 
     if ( ( TString(p->GetName()).Contains("NtrCorr") || TString(p->GetName()).BeginsWith("Nch") ) && ( (fSPDMeanTracklets && !fSPDOneOverAccxEff) || (!fSPDMeanTracklets && fSPDOneOverAccxEff) ))
     {
-      static_cast<TH2*>(MCHisto(eventSelection,triggerClassName,centrality,"CorrTrackletsVsNch"))->Fill(nchSum,p->GetVal(),fMCWeight);
+      static_cast<TH2*>(NchMCHisto(kCorrTrackletsVsNch))->Fill(nchSum,p->GetVal(),fMCWeight);
 
 //      if (SPDZv > -0.5 && SPDZv < 0.5 )
 //      {
@@ -1572,40 +1667,30 @@ void AliAnalysisMuMuNch::FillHistosForMCEvent(const char* eventSelection,const c
 //        if ( p->GetVal() > 79.5 && p->GetVal() < 80.5) MCHisto(eventSelection,triggerClassName,centrality,"FluctuationsAfterCorrNtrCorr80")->Fill(nchSum - p->GetVal(),fMCWeight);
 //      }
 
-      TObjArray* binsNtrCorr = Binning()->CreateBinObjArray("psi","ntrcorr","");
-      TIter nextBinNtrCorr(binsNtrCorr);
-      AliAnalysisMuMuBinning::Range* rNtrCorr;
-
-      while ( ( rNtrCorr = static_cast<AliAnalysisMuMuBinning::Range*>(nextBinNtrCorr()) ) )
+      for ( Int_t j = 0; j < static_cast<Int_t>(fMCNtrCorrIds.size()); ++j )
       {
-        Bool_t ok(kFALSE);
-        if ( rNtrCorr->Quantity() == "NTRCORR" )
-        {
-          ok = rNtrCorr->IsInRange(p->GetVal());
-        }
+        if ( fMCNtrCorrIds[j] < 0 ) continue; // not a NTRCORR bin
 
-        if ( ok )
-        {
-          static_cast<TH2*>(MCHisto(eventSelection,triggerClassName,centrality,
-                                                Form("GenNchVsZVertex%s",rNtrCorr->AsString().Data())))->Fill(SPDZv,nchSum,fMCWeight);
+        AliAnalysisMuMuBinning::Range* rNtrCorr = static_cast<AliAnalysisMuMuBinning::Range*>(fBinsNtrCorr->UncheckedAt(j));
 
+        if ( rNtrCorr->IsInRange(p->GetVal()) )
+        {
+          static_cast<TH2*>(TableMCHisto(fMCNtrCorrIds[j]))->Fill(SPDZv,nchSum,fMCWeight);
         }
       }
-
-      delete binsNtrCorr;
     }
     else if ( TString(p->GetName()).Contains("NtrCorr") )
     {
       nTrCorr = p->GetVal();
-      static_cast<TH2*>(MCHisto(eventSelection,triggerClassName,centrality,"dNchdetaFromNtrCorrVsdNchdEtaMC"))->Fill(meandNchdEta,ctToNch*nTrCorr/(2*fEtaMax),fMCWeight);
+      static_cast<TH2*>(NchMCHisto(kdNchdetaFromNtrCorrVsdNchdEtaMC))->Fill(meandNchdEta,ctToNch*nTrCorr/(2*fEtaMax),fMCWeight);
 
-      MCHisto(eventSelection,triggerClassName,centrality,"RelDispersiondNchdetaFromNtrCorrVsdNchdEtaMC")->Fill((meandNchdEta - ctToNch*nTrCorr/(2*fEtaMax)) / meandNchdEta,fMCWeight);
-      MCHisto(eventSelection,triggerClassName,centrality,"DispersiondNchdetaFromNtrCorrVsdNchdEtaMC")->Fill((meandNchdEta - ctToNch*nTrCorr/(2*fEtaMax)),fMCWeight);
+      NchMCHisto(kRelDispersiondNchdetaFromNtrCorrVsdNchdEtaMC)->Fill((meandNchdEta - ctToNch*nTrCorr/(2*fEtaMax)) / meandNchdEta,fMCWeight);
+      NchMCHisto(kDispersiondNchdetaFromNtrCorrVsdNchdEtaMC)->Fill((meandNchdEta - ctToNch*nTrCorr/(2*fEtaMax)),fMCWeight);
 
     }
     else if ( TString(p->GetName()).Contains("Ntr") && !TString(p->GetName()).Contains("SPDOk") && !TString(p->GetName()).Contains("Corr"))
     {
-      static_cast<TH2*>(MCHisto(eventSelection,triggerClassName,centrality,"TrackletsVsNch"))->Fill(nchSum,p->GetVal(),fMCWeight);
+      static_cast<TH2*>(NchMCHisto(kTrackletsVsNch))->Fill(nchSum,p->GetVal(),fMCWeight);
 
 //      if (SPDZv > 4. && SPDZv < 5.5 )
 //      {
@@ -1619,33 +1704,25 @@ void AliAnalysisMuMuNch::FillHistosForMCEvent(const char* eventSelection,const c
 //        if ( p->GetVal() > 79.5 && p->GetVal() < 80.5) MCHisto(eventSelection,triggerClassName,centrality,"FluctuationsNtr80")->Fill(nchSum - p->GetVal(),fMCWeight);
 //      }
 
-      TObjArray* binsNtrRaw = Binning()->CreateBinObjArray("psi","ntr","");
-      TIter nextBinNtrRaw(binsNtrRaw);
-      AliAnalysisMuMuBinning::Range* rNtrRaw;
-
-      while ( ( rNtrRaw = static_cast<AliAnalysisMuMuBinning::Range*>(nextBinNtrRaw()) ) )
+      for ( Int_t j = 0; j < static_cast<Int_t>(fMCNtrIds.size()); ++j )
       {
-        Bool_t ok(kFALSE);
-        if ( rNtrRaw->Quantity() == "NTR" )
-        {
-          ok = rNtrRaw->IsInRange(p->GetVal());
-        }
+        if ( fMCNtrIds[j] < 0 ) continue; // not a NTR bin
+
+        AliAnalysisMuMuBinning::Range* rNtrRaw = static_cast<AliAnalysisMuMuBinning::Range*>(fBinsNtr->UncheckedAt(j));
 
-        if ( ok )
+        if ( rNtrRaw->IsInRange(p->GetVal()) )
         {
-          static_cast<TProfile*>(MCHisto(eventSelection,triggerClassName,centrality,Form("MeanNchVsZVertex%s",rNtrRaw->AsString().Data())))->Fill(SPDZv,nchSum,fMCWeight);
+          static_cast<TProfile*>(TableMCHisto(fMCNtrIds[j]))->Fill(SPDZv,nchSum,fMCWeight);
         }
       }
-
-      delete binsNtrRaw;
     }
     else if ( TString(p->GetName()).Contains("MeandNchdEta") )
     {
       dNchdetaReco = p->GetVal();
-      static_cast<TH2*>(MCHisto(eventSelection,triggerClassName,centrality,"dNchdetaVsMCdNchdeta"))->Fill(meandNchdEta,dNchdetaReco,fMCWeight);
-      static_cast<TH2*>(MCHisto(eventSelection,triggerClassName,centrality,"dNchdetaFromAccEffVsdNchdEtaMC"))->Fill(meandNchdEta,dNchdetaReco,fMCWeight);
-      MCHisto(eventSelection,triggerClassName,centrality,"RelDispersiondNchdetaFromAccEffVsdNchdEtaMC")->Fill((meandNchdEta - dNchdetaReco) / meandNchdEta,fMCWeight);
-      MCHisto(eventSelection,triggerClassName,centrality,"DispersiondNchdetaFromAccEffVsdNchdEtaMC")->Fill((meandNchdEta - dNchdetaReco),fMCWeight);
+      static_cast<TH2*>(NchMCHisto(kdNchdetaVsMCdNchdeta))->Fill(meandNchdEta,dNchdetaReco,fMCWeight);
+      static_cast<TH2*>(NchMCHisto(kdNchdetaFromAccEffVsdNchdEtaMC))->Fill(meandNchdEta,dNchdetaReco,fMCWeight);
+      NchMCHisto(kRelDispersiondNchdetaFromAccEffVsdNchdEtaMC)->Fill((meandNchdEta - dNchdetaReco) / meandNchdEta,fMCWeight);
+      NchMCHisto(kDispersiondNchdetaFromAccEffVsdNchdEtaMC)->Fill((meandNchdEta - dNchdetaReco),fMCWeight);
     }
   }
 
@@ -1662,8 +1739,8 @@ void AliAnalysisMuMuNch::FillHistosForMCEvent(const char* eventSelection,const c
 //      Double_t multV0C = vzero->GetMTotV0C();
 //      V0CMult = AliESDUtils::GetCorrV0C(multV0C,MCZv);
 
-      static_cast<TH2*>(MCHisto(eventSelection,triggerClassName,centrality,"V0AMultVsNch"))->Fill(V0AMult,nchSum,fMCWeight);
-      static_cast<TH2*>(MCHisto(eventSelection,triggerClassName,centrality,"V0CMultVsNch"))->Fill(V0CMult,nchSum,fMCWeight);
+      static_cast<TH2*>(NchMCHisto(kV0AMultVsNch))->Fill(V0AMult,nchSum,fMCWeight);
+      static_cast<TH2*>(NchMCHisto(kV0CMultVsNch))->Fill(V0CMult,nchSum,fMCWeight);
 
     }
   }
@@ -11,6 +11,7 @@
 #include "AliAnalysisMuMuBase.h"
 #include "TRandom3.h"
 #include "TMap.h"
+#include <vector>
 
 class TH2F;
 class TH2;
@@ -60,13 +61,7 @@ public:
 
 protected:
 
-  void AddHisto(const char* eventSelection,
-                const char* triggerClassName,
-                const char* centrality,
-                const char* histoname,
-                Double_t z,
-                TH1* h,
-                Bool_t isMC=kFALSE);
+  void AddHisto(TH1* hzeta, Double_t z, TH1* h);
 
   void AttachSPDAcceptance(UInt_t dataType,
                            const char* eventSelection,
@@ -85,6 +80,8 @@ protected:
   virtual void DefineHistogramCollection(const char* eventSelection, const char* triggerClassName,
                                          const char* centrality, Bool_t mix = kFALSE);
 
+  void DefineHistoTableIds();
+
   void DefineSPDAcceptance();
 
   void DefineSPDFluctuationsMap(TH2F* spdFluctuations);
@@ -108,6 +105,38 @@ private:
 
   void DefineSPDCorrectionMap(TObjArray* spdCorrectionList);
 
+  /// histograms filled by this class (data and/or MC input), used to index fHistoIds
+  enum ENchHisto
+  {
+    kMeanTrackletsVsEta, kMeanNchVsEta, kMeandNchdEtaVsEta, kEventsVsZVertexVsEta,
+    kTrackletsVsZVertexVsPhi, kTrackletsVsZVertexVsEta, kNchVsZVertexVsEta, kTracklets,
+    kMeanTrackletsVsZVertex, kTrackletsCorrection, kTrackletsSecVsZVertexVsEta,
+    kCorrTrackletsEtaSecVsCorrTrackletsEtaPrim, kMeanNchEtaSecVsZVertex,
+    kMeanTrackletsEtaSecVsZVertex, kdNchdetaComparison2Corrections, kCheckMeanNtrCorrVsZVertex,
+    kDispersiondNchdetaComparison2Corrections, kCheckNtrCorr, kTrackletsVsNch, kNch,
+    kMeanNchVsZVertex, kV0Mult, kV0MultVsTracklets, kV0MultVsZVertex, kMeanV0MultVsZVertex,
+    kV0CorrMult, kV0CorrMultVsNch, kV0CorrMultVsZVertex, kMeanV0CorrMultVsZVertex,
+    kdNchdEtaRescaled, kdNchdEta, kMeandNchdEtaVsZVertex, kSPDZvResVsnC, kSPDZvResVsMCz, kEta,
+    kMCEta, kEtaRes, kEtaResVsZ, kEtaResVsnC, kPhi, kMCPhi, kPhiRes, kPhiResVsZ, kPhiResShifted,
+    kPhiResVsnC, kNBkgTrackletsVsZVertexVsEta, kNchVsZVertexVsPhi, kNchVsRecoZVertexVsEta,
+    kCorrTrackletsVsNch, kdNchdetaFromNtrCorrVsdNchdEtaMC,
+    kRelDispersiondNchdetaFromNtrCorrVsdNchdEtaMC, kDispersiondNchdetaFromNtrCorrVsdNchdEtaMC,
+    kdNchdetaVsMCdNchdeta, kdNchdetaFromAccEffVsdNchdEtaMC,
+    kRelDispersiondNchdetaFromAccEffVsdNchdEtaMC, kDispersiondNchdetaFromAccEffVsdNchdEtaMC,
+    kV0AMultVsNch, kV0CMultVsNch,
+    kNNchHistos
+  };
+
+  /// histogram of the current path
+  TH1* NchHisto(ENchHisto which) const { return TableHisto(fHistoIds[which]); }
+
+  /// MC input histogram of the current path
+  TH1* NchMCHisto(ENchHisto which) const { return TableMCHisto(fHistoIds[which]); }
+
+  TObjArray* DefineBinnedHistoTableIds(const char* what, const char* quantity,
+                                       const char* prefix, std::vector<Int_t>& ids,
+                                       const char* mcPrefix=0x0, std::vector<Int_t>* mcIds=0x0);
+
 private:
   TH2F* fSPDOneOverAccxEff; // Nch/Tracklets_SPD (eta vs z). SPD AccxEffCorrection for tracklets
   TObjArray* fSPDFluctuationsList; // Array for the fluctuations distributions in Ntr corrected by SPD AccxEff slices
@@ -142,7 +171,19 @@ private:
   Double_t fMCWeight; // Weight of current MC run
   TString* fV0side; // Which V0 side will be use to estimate multiplicicty
 
-  ClassDef(AliAnalysisMuMuNch,7) // implementation of AliAnalysisMuMuBase for Nch analysis
+  Int_t fHistoIds[kNNchHistos]; //! histogram table ids
+  TObjArray* fBinsDNchdEta; //! dnchdeta bins of the EventsIn histograms
+  TObjArray* fBinsNtr; //! ntr bins of the MeanTrackletsVsZVertex (and MC MeanNchVsZVertex) histograms
+  TObjArray* fBinsNtrCorr; //! ntrcorr bins of the MeanNchVsZVertex (and MC GenNchVsZVertex) histograms
+  TObjArray* fBinsRelNtrCorr; //! relntrcorr bins of the EventsIn histograms
+  std::vector<Int_t> fDNchdEtaIds; //! histogram table ids, one per fBinsDNchdEta bin (-1 = wrong quantity)
+  std::vector<Int_t> fNtrIds; //! histogram table ids, one per fBinsNtr bin
+  std::vector<Int_t> fMCNtrIds; //! MC histogram table ids, one per fBinsNtr bin
+  std::vector<Int_t> fNtrCorrIds; //! histogram table ids, one per fBinsNtrCorr bin
+  std::vector<Int_t> fMCNtrCorrIds; //! MC histogram table ids, one per fBinsNtrCorr bin
+  std::vector<Int_t> fRelNtrCorrIds; //! histogram table ids, one per fBinsRelNtrCorr bin
+
+  ClassDef(AliAnalysisMuMuNch,8) // implementation of AliAnalysisMuMuBase for Nch analysis
 };
 
 #endif
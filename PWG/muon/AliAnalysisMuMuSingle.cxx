@@ -35,9 +35,15 @@ fMuonTrackCuts(0x0),
 fShouldSeparatePlusAndMinus(kFALSE),
 fAccEffHisto(0x0),
 fPtEtaSpectraPerBCX(kFALSE),
-fDCAHistos(kFALSE)
+fDCAHistos(kFALSE),
+fBCXId(-1),
+fChi2MatchTriggerId(-1)
 {
   /// ctor
+  for ( Int_t i = 0; i < kNChargedHistos; ++i )
+  {
+    for ( Int_t c = 0; c < 3; ++c ) fChargedHistoIds[i][c] = -1;
+  }
 }
 
 //_____________________________________________________________________________
@@ -264,11 +270,46 @@ void AliAnalysisMuMuSingle::DefineHistogramCollection(const char* eventSelection
 
 
 //_____________________________________________________________________________
-void AliAnalysisMuMuSingle::FillHistosForMuonTrack(AliMergeableCollectionProxy& proxy,
-                                                   const AliVParticle& track)
+void AliAnalysisMuMuSingle::DefineHistoTableIds()
+{
+  /// Register the histograms of FillHistosForTrack in the histogram table.
+  /// The track histograms are in one folder per track cut combination.
+
+  SetHistoTableCutType(AliAnalysisMuMuCutElement::kTrack);
+
+  fBCXId = IsHistogramDisabled("BCX") ? -1 : HistoTableId("BCX");
+  fChi2MatchTriggerId = IsHistogramDisabled("Chi2MatchTrigger") ? -1 : HistoTableId("Chi2MatchTrigger");
+
+  // names must follow the EChargedHisto order
+  const char* names[kNChargedHistos] =
+  {
+    "EtaRapidityMu", "PtEtaMu", "PtRapidityMu", "PEtaMu", "PtPhiMu", "Chi2Mu",
+    "dcaP23Mu", "dcaPwPtCut23Mu", "dcaP310Mu", "dcaPwPtCut310Mu"
+  };
+  const char* charges[3] = { "", "Plus", "Minus" };
+
+  for ( Int_t i = 0; i < kNChargedHistos; ++i )
+  {
+    if ( IsHistogramDisabled(Form("%s*",names[i])) ) continue;
+
+    for ( Int_t c = 0; c < 3; ++c )
+    {
+      fChargedHistoIds[i][c] = HistoTableId(Form("%s%s",names[i],charges[c]));
+    }
+  }
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuSingle::FillHistosForTrack(const char* eventSelection,
+                                               const char* triggerClassName,
+                                               const char* centrality,
+                                               const char* trackCutName,
+                                               const AliVParticle& track)
 {
   /// Fill histograms for one track
 
+  if (!AliAnalysisMuonUtility::IsMuonTrack(&track) ) return;
+
   AliCodeTimerAuto("",0);
 
   if ( HasMC() )
@@ -280,17 +321,17 @@ void AliAnalysisMuMuSingle::FillHistosForMuonTrack(AliMergeableCollectionProxy&
                    TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+track.P()*track.P()));
 
 
-  TString charge("");
+  Int_t charge(0);
 
   if ( ShouldSeparatePlusAndMinus() )
   {
     if ( track.Charge() < 0 )
     {
-      charge = "Minus";
+      charge = 2;
     }
     else
     {
-      charge = "Plus";
+      charge = 1;
     }
   }
 
@@ -298,60 +339,82 @@ void AliAnalysisMuMuSingle::FillHistosForMuonTrack(AliMergeableCollectionProxy&
 
   Double_t theta = AliAnalysisMuonUtility::GetThetaAbsDeg(&track);
 
-  if (!IsHistogramDisabled("BCX"))
+  Int_t folder = HistoTableCutFolder();
+
+  TH1* h = TableHisto(fBCXId,folder);
+
+  if ( h )
   {
-    proxy.Histo("BCX")->Fill(1.0*Event()->GetBunchCrossNumber());
+    h->Fill(1.0*Event()->GetBunchCrossNumber());
   }
 
-  if (!IsHistogramDisabled("Chi2MatchTrigger"))
+  h = TableHisto(fChi2MatchTriggerId,folder);
+
+  if ( h )
   {
-    proxy.Histo("Chi2MatchTrigger")->Fill(AliAnalysisMuonUtility::GetChi2MatchTrigger(&track));
+    h->Fill(AliAnalysisMuonUtility::GetChi2MatchTrigger(&track));
   }
 
-  if (!IsHistogramDisabled("EtaRapidityMu*"))
+  h = ChargedHisto(kEtaRapidityMu,charge);
+
+  if ( h )
   {
-    proxy.Histo(Form("EtaRapidityMu%s",charge.Data()))->Fill(p.Rapidity(),p.Eta());
+    h->Fill(p.Rapidity(),p.Eta());
   }
 
-  if (!IsHistogramDisabled("PtEtaMu*"))
-  {
-    TH1* h = proxy.Histo(Form("PtEtaMu%s",charge.Data()));
+  h = ChargedHisto(kPtEtaMu,charge);
 
+  if ( h )
+  {
     h->Fill(p.Eta(),p.Pt());
 
     if  ( fPtEtaSpectraPerBCX )
     {
-      if (!IsHistogramDisabled("BCX"))
+      if ( fBCXId >= 0 )
       {
-        TH1* hbcx = proxy.Histo(Form("PtEtaMu%sBCX%d",charge.Data(),Event()->GetBunchCrossNumber()));
+        // bunch-crossing histograms are created on the fly, hence not in the histogram table
+        AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality,trackCutName));
+
+        TString hbcxName(Form("%sBCX%d",h->GetName(),Event()->GetBunchCrossNumber()));
+        TH1* hbcx = proxy->Histo(hbcxName.Data());
 
         if (!hbcx)
         {
-          hbcx = static_cast<TH1*>(h->Clone(Form("PtEtaMu%sBCX%d",charge.Data(),Event()->GetBunchCrossNumber())));
-          proxy.Adopt(hbcx);
+          hbcx = static_cast<TH1*>(h->Clone(hbcxName.Data()));
+          proxy->Adopt(hbcx);
         }
+
+        delete proxy;
       }
     }
   }
 
-  if (!IsHistogramDisabled("PtRapidityMu*"))
+  h = ChargedHisto(kPtRapidityMu,charge);
+
+  if ( h )
   {
-    proxy.Histo(Form("PtRapidityMu%s",charge.Data()))->Fill(p.Rapidity(),p.Pt());
+    h->Fill(p.Rapidity(),p.Pt());
   }
 
-  if (!IsHistogramDisabled("PEtaMu*"))
+  h = ChargedHisto(kPEtaMu,charge);
+
+  if ( h )
   {
-    proxy.Histo(Form("PEtaMu%s",charge.Data()))->Fill(p.Eta(),p.P());
+    h->Fill(p.Eta(),p.P());
   }
 
-  if (!IsHistogramDisabled("PtPhiMu*"))
+  h = ChargedHisto(kPtPhiMu,charge);
+
+  if ( h )
   {
-    proxy.Histo(Form("PtPhiMu%s",charge.Data()))->Fill(p.Phi(),p.Pt());
+    h->Fill(p.Phi(),p.Pt());
   }
 
-  if (!IsHistogramDisabled("Chi2Mu*"))
+  h = ChargedHisto(kChi2Mu,charge);
+
+  if ( h )
   {
-    proxy.Histo(Form("Chi2Mu%s",charge.Data()))->Fill(AliAnalysisMuonUtility::GetChi2perNDFtracker(&track));
+    h->Fill(AliAnalysisMuonUtility::GetChi2perNDFtracker(&track));
   }
 
   // if (!IsHistogramDisabled("HitperTriggerLocalBoardMu*"))
@@ -371,54 +434,43 @@ void AliAnalysisMuMuSingle::FillHistosForMuonTrack(AliMergeableCollectionProxy&
 
   if ( theta >= 2.0 && theta < 3.0 )
   {
+    h = ChargedHisto(kdcaP23Mu,charge);
 
-    if (!IsHistogramDisabled("dcaP23Mu*"))
+    if ( h )
     {
-      proxy.Histo(Form("dcaP23Mu%s",charge.Data()))->Fill(p.P(),dca);
+      h->Fill(p.P(),dca);
     }
 
     if ( p.Pt() > 2 )
     {
-      if (!IsHistogramDisabled("dcaPwPtCut23Mu*"))
+      h = ChargedHisto(kdcaPwPtCut23Mu,charge);
+
+      if ( h )
       {
-        proxy.Histo(Form("dcaPwPtCut23Mu%s",charge.Data()))->Fill(p.P(),dca);
+        h->Fill(p.P(),dca);
       }
     }
   }
   else if ( theta >= 3.0 && theta < 10.0 )
   {
-    if (!IsHistogramDisabled("dcaP310Mu*"))
+    h = ChargedHisto(kdcaP310Mu,charge);
+
+    if ( h )
     {
-      proxy.Histo(Form("dcaP310Mu%s",charge.Data()))->Fill(p.P(),dca);
+      h->Fill(p.P(),dca);
     }
     if ( p.Pt() > 2 )
     {
-      if (!IsHistogramDisabled("dcaPwPtCut310Mu*"))
+      h = ChargedHisto(kdcaPwPtCut310Mu,charge);
+
+      if ( h )
       {
-        proxy.Histo(Form("dcaPwPtCut310Mu%s",charge.Data()))->Fill(p.P(),dca);
+        h->Fill(p.P(),dca);
       }
     }
   }
 }
 
-//_____________________________________________________________________________
-void AliAnalysisMuMuSingle::FillHistosForTrack(const char* eventSelection,
-                                               const char* triggerClassName,
-                                               const char* centrality,
-                                               const char* trackCutName,
-                                               const AliVParticle& track)
-{
-  /// Fill histograms for one track
-
-  if (!AliAnalysisMuonUtility::IsMuonTrack(&track) ) return;
-
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality,trackCutName));
-
-  FillHistosForMuonTrack(*proxy,track);
-
-  delete proxy;
-}
-
 //_____________________________________________________________________________
 AliMuonTrackCuts* AliAnalysisMuMuSingle::MuonTrackCuts()
 {
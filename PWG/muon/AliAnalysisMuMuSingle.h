@@ -70,7 +70,7 @@ protected:
                                   const char* trackCutName,
                                   const AliVParticle& part);
 
-  void FillHistosForMuonTrack(AliMergeableCollectionProxy& proxy, const AliVParticle& track);
+  void DefineHistoTableIds();
 
 
 private:
@@ -103,6 +103,18 @@ private:
 
   Double_t EAGetTrackDCA(const AliVParticle& particle) const;
 
+  /// per-charge track histograms, used to index fChargedHistoIds
+  enum EChargedHisto
+  {
+    kEtaRapidityMu, kPtEtaMu, kPtRapidityMu, kPEtaMu, kPtPhiMu, kChi2Mu,
+    kdcaP23Mu, kdcaPwPtCut23Mu, kdcaP310Mu, kdcaPwPtCut310Mu,
+    kNChargedHistos
+  };
+
+  /// histogram of the current track cut (chargeIndex : 0 = both, 1 = Plus, 2 = Minus), 0x0 if disabled
+  TH1* ChargedHisto(EChargedHisto which, Int_t chargeIndex) const
+  { return TableHisto(fChargedHistoIds[which][chargeIndex],HistoTableCutFolder()); }
+
 private:
 
   /// not implemented on purpose
@@ -117,7 +129,11 @@ private:
   Bool_t fPtEtaSpectraPerBCX; // make pt vs eta spectra bunch by bunch (caution : much slower !)
   Bool_t fDCAHistos; // make DCA histograms
 
-  ClassDef(AliAnalysisMuMuSingle,3) // implementation of AliAnalysisMuMuBase for single mu analysis
+  Int_t fBCXId; //! histogram table id (-1 = disabled)
+  Int_t fChi2MatchTriggerId; //! histogram table id (-1 = disabled)
+  Int_t fChargedHistoIds[kNChargedHistos][3]; //! histogram table ids (-1 = disabled)
+
+  ClassDef(AliAnalysisMuMuSingle,4) // implementation of AliAnalysisMuMuBase for single mu analysis
 };
 
 #endif
@@ -90,7 +90,8 @@ fDisableHistoLoop(kFALSE),
 fLegacyCentrality(kFALSE),
 fPool(0x0),
 fMaxPoolSize(0),
-fMix(kFALSE)
+fMix(kFALSE),
+fTriggerClassIndex(0x0)
 {
   /// Constructor with a predefined list of triggers to consider
   /// Note that we take ownership of cutRegister
@@ -129,6 +130,8 @@ AliAnalysisTaskMuMu::~AliAnalysisTaskMuMu()
 
   if (fPool) delete fPool;
 
+  delete fTriggerClassIndex;
+
   delete fHistogramToDisable;
 
   delete fCutRegistry;
@@ -291,14 +294,22 @@ void AliAnalysisTaskMuMu::Fill(const char* eventSelection, const char* triggerCl
   // Fill counter collections (only for UserExec() )
   FillCounters(seventSelection.Data(), triggerClassName, "ALL", fCurrentRunNumber);
 
+  // indices of this path in the sub-analysis histogram tables
+  const TObjArray* eventCuts = CutRegistry()->GetCutCombinations(AliAnalysisMuMuCutElement::kEvent);
+  Int_t eventSelectionIndex  = eventCuts->IndexOf(eventCuts->FindObject(eventSelection));
+  Int_t triggerIndex         = TriggerClassIndex(triggerClassName);
+
   TObjArray* centralities = fBinning->CreateBinObjArray("centrality");
 
   TIter next(centralities);
   AliAnalysisMuMuBinning::Range* r;
+  Int_t centralityIndex(-1);
 
   next.Reset();
   while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(next()) ) ){
 
+    ++centralityIndex;
+
     Float_t fcent     = -42.0;
     TString estimator = r->Quantity();
     if(estimator.Contains("V0MPLUS05")) estimator ="V0Mplus05";
@@ -316,7 +327,7 @@ void AliAnalysisTaskMuMu::Fill(const char* eventSelection, const char* triggerCl
     if ( isPP || r->IsInRange(fcent) ){
       if ( !isPP  && !r->IsInRange(fcent) ) continue;
 
-      FillHistos(eventSelection,triggerClassName,r->AsString(),fcent);
+      FillHistos(eventSelection,triggerClassName,r->AsString(),fcent,eventSelectionIndex,triggerIndex,centralityIndex);
 
       // FIXME: this filling of global centrality histo is misplaced somehow...
       TH1* hcent = fHistogramCollection->Histo(Form("/%s/%s/V0M/Centrality",eventSelection,triggerClassName));
@@ -367,9 +378,13 @@ void AliAnalysisTaskMuMu::FillPools(const char* eventSelection, const char* trig
 void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
                                      const char* triggerClassName,
                                      const char* centrality,
-                                     Float_t cent)
+                                     Float_t cent,
+                                     Int_t eventSelectionIndex,
+                                     Int_t triggerIndex,
+                                     Int_t centralityIndex)
 {
   /// Fill histograms
+  /// The indices locate eventSelection/triggerClassName/centrality in the sub-analysis histogram tables
 
   // Fill counter collections (only for UserExec() )
   FillCounters( eventSelection, triggerClassName, centrality, fCurrentRunNumber);
@@ -394,6 +409,7 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
 
       // Create proxy for the Histogram collections
       analysis->DefineHistogramCollection(eventSelection,triggerClassName,centrality,fMix);
+      analysis->SetHistoTablePath(eventSelectionIndex,triggerIndex,centralityIndex,eventSelection,triggerClassName,centrality);
 
       if ( MCEvent() != 0x0 )
       {
@@ -413,13 +429,16 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
 
         nextTrackCut.Reset();
         AliAnalysisMuMuCutCombination* trackCut;
+        Int_t trackCutIndex(-1);
 
         // Loop on all track selections and fill histos for track that pass it
         while ( ( trackCut = static_cast<AliAnalysisMuMuCutCombination*>(nextTrackCut()) ) )
         {
+          ++trackCutIndex;
           if ( trackCut->Pass(*tracki) )
           {
             AliCodeTimerAuto(Form("%s (FillHistosForTrack)",analysis->ClassName()),2);
+            analysis->SetHistoTableTrackCut(trackCutIndex);
             analysis->FillHistosForTrack(eventSelection,triggerClassName,centrality,trackCut->GetName(),*tracki);
           }
         }
@@ -435,10 +454,12 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
 
           nextPairCut.Reset();
           AliAnalysisMuMuCutCombination* pairCut;
+          Int_t pairCutIndex(-1);
 
           // Fill pair histo
           while ( ( pairCut = static_cast<AliAnalysisMuMuCutCombination*>(nextPairCut()) ) )
           {
+            ++pairCutIndex;
             // Weither or not the pairs pass the tests
             Bool_t testi  = (pairCut->IsTrackCutter()) ? pairCut->Pass(*tracki) : kTRUE;
             Bool_t testj  = (pairCut->IsTrackCutter()) ? pairCut->Pass(*trackj) : kTRUE;
@@ -447,6 +468,7 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
             if ( ( testi && testj ) && testij )
             {
               AliCodeTimerAuto(Form("%s (FillHistosForPair)",analysis->ClassName()),3);
+              analysis->SetHistoTablePairCut(pairCutIndex);
               analysis->FillHistosForPair(eventSelection,triggerClassName,centrality,pairCut->GetName(),*tracki,*trackj,kFALSE);
             }
           }
@@ -461,10 +483,14 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
         nextTrackCut.Reset();
 
         AliAnalysisMuMuCutCombination* pairCut;
+        Int_t pairCutIndex(-1);
 
         // Loop over pair cut
         while ( ( pairCut = static_cast<AliAnalysisMuMuCutCombination*>(nextPairCut()) ) )
         {
+          ++pairCutIndex;
+          analysis->SetHistoTablePairCut(pairCutIndex);
+
           // Loop over single track cut from mixing configuration
           while ( ( trackCut = static_cast<AliAnalysisMuMuCutCombination*>(nextTrackCut()) ) )
           {
@@ -752,10 +778,47 @@ void AliAnalysisTaskMuMu::NotifyRun()
 
   AliDebug(1,Form("Run %09d File %s",fCurrentRunNumber,CurrentFileName()));
 
+  // trigger classes might differ from one run to the other : restart the histogram tables
+  if ( fTriggerClassIndex ) fTriggerClassIndex->Delete();
+
+  TObjArray* centralities = Binning()->CreateBinObjArray("centrality");
+  Int_t nCentralities = centralities->GetEntries();
+  delete centralities;
+
+  Int_t nEventSelections = CutRegistry()->GetCutCombinations(AliAnalysisMuMuCutElement::kEvent)->GetEntries();
+
   TIter next(fSubAnalysisVector);
   AliAnalysisMuMuBase* analysis;
 
-  while ( ( analysis = static_cast<AliAnalysisMuMuBase*>(next()) ) ) analysis->SetRun(fInputHandler);
+  while ( ( analysis = static_cast<AliAnalysisMuMuBase*>(next()) ) )
+  {
+    analysis->SetRun(fInputHandler);
+    analysis->ResetHistoTable(nEventSelections,nCentralities);
+  }
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisTaskMuMu::TriggerClassIndex(const char* triggerClassName)
+{
+  /// Index of a trigger class in the sub-analysis histogram tables.
+  /// Indices are attributed in order of appearance and reset at each run.
+
+  if (!fTriggerClassIndex)
+  {
+    fTriggerClassIndex = new THashList;
+    fTriggerClassIndex->SetOwner(kTRUE);
+  }
+
+  TObject* o = fTriggerClassIndex->FindObject(triggerClassName);
+
+  if (!o)
+  {
+    o = new TObjString(triggerClassName);
+    o->SetUniqueID(fTriggerClassIndex->GetEntries());
+    fTriggerClassIndex->Add(o);
+  }
+
+  return o->GetUniqueID();
 }
 
 //_____________________________________________________________________________
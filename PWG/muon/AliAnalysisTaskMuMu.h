@@ -37,6 +37,7 @@ class AliMergeableCollection;
 class AliVParticle;
 class TList;
 class TObjArray;
+class THashList;
 class AliAnalysisMuMuBase;
 class AliAnalysisMuMuCutRegistry;
 class AliMultiInputEventHandler;
@@ -106,7 +107,8 @@ private:
 
   AliVEvent* Event() const;
 
-  void FillHistos(const char* eventSelection, const char* triggerClassName, const char* centrality, Float_t cent);
+  void FillHistos(const char* eventSelection, const char* triggerClassName, const char* centrality, Float_t cent,
+                  Int_t eventSelectionIndex=-1, Int_t triggerIndex=-1, Int_t centralityIndex=-1);
 
   void FillPoolsWithTracks(const char* eventSelection, const char* triggerClassName, Float_t cent);
 
@@ -130,6 +132,8 @@ private:
 
   Bool_t IsPP() const;
 
+  Int_t TriggerClassIndex(const char* triggerClassName);
+
 private:
 
   AliAnalysisTaskMuMu(const AliAnalysisTaskMuMu&); // not implemented (on purpose)
@@ -174,7 +178,9 @@ private:
 
   Int_t fMaxPoolSize; // pool size
 
-  ClassDef(AliAnalysisTaskMuMu,31) // a class to analyse muon pairs (and single also ;-) )
+  THashList* fTriggerClassIndex; //! index of the trigger classes seen in the current run
+
+  ClassDef(AliAnalysisTaskMuMu,32) // a class to analyse muon pairs (and single also ;-) )
 };
 
 #endif
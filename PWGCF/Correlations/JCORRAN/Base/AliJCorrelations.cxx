@@ -71,7 +71,10 @@ AliJCorrelations::AliJCorrelations( AliJCard *cardIn, AliJHistos *histosIn) :
   fXlongBin(0),
   fIsLikeSign(false),
   fGeometricAcceptanceCorrection(1),
-  fGeometricAcceptanceCorrection3D(1)
+  fGeometricAcceptanceCorrection3D(1),
+  fhDphiAssocHandle(),
+  fhDEtaNearHandle(),
+  fhDEtaNearMHandle()
 {
   // constructor
   
@@ -140,7 +143,10 @@ AliJCorrelations::AliJCorrelations() :
   fXlongBin(0),
   fIsLikeSign(false),
   fGeometricAcceptanceCorrection(1),
-  fGeometricAcceptanceCorrection3D(1)
+  fGeometricAcceptanceCorrection3D(1),
+  fhDphiAssocHandle(),
+  fhDEtaNearHandle(),
+  fhDEtaNearMHandle()
 {
   // default constructor
 }
@@ -183,7 +189,10 @@ AliJCorrelations::AliJCorrelations(const AliJCorrelations& in) :
   fXlongBin(in.fXlongBin),
   fIsLikeSign(in.fIsLikeSign),
   fGeometricAcceptanceCorrection(in.fGeometricAcceptanceCorrection),
-  fGeometricAcceptanceCorrection3D(in.fGeometricAcceptanceCorrection3D)
+  fGeometricAcceptanceCorrection3D(in.fGeometricAcceptanceCorrection3D),
+  fhDphiAssocHandle(in.fhDphiAssocHandle),
+  fhDEtaNearHandle(in.fhDEtaNearHandle),
+  fhDEtaNearMHandle(in.fhDEtaNearMHandle)
 {
   // The pointers to card and histos are just copied. I think this is safe, since they are not created by
   // AliJCorrelations and thus should not disappear if the AliJCorrelation managing them is destroyed.
@@ -230,6 +239,9 @@ AliJCorrelations& AliJCorrelations::operator=(const AliJCorrelations& in){
   fIsLikeSign = in.fIsLikeSign;
   fGeometricAcceptanceCorrection = in.fGeometricAcceptanceCorrection;
   fGeometricAcceptanceCorrection3D = in.fGeometricAcceptanceCorrection3D;
+  fhDphiAssocHandle = in.fhDphiAssocHandle;
+  fhDEtaNearHandle = in.fhDEtaNearHandle;
+  fhDEtaNearMHandle = in.fhDEtaNearMHandle;
   fnReal = in.fnReal;
   fnMix = in.fnMix;
   fsumTriggerAndAssoc = in.fsumTriggerAndAssoc;
@@ -446,9 +458,11 @@ void AliJCorrelations::FillDeltaEtaHistograms(fillType fTyp, int ZBin)
   
   if( fNearSide ){ //one could check the phiGapBin, but in the pi/2 <1.6 and thus phiGap is always>-1
     if( fTyp == 0 ) {
-      fhistos->fhDEtaNear[fCentralityBin][ZBin][fPhiGapBinNear][fpttBin][fptaBin]->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
+      if( !fhDEtaNearHandle.IsValid() ) fhDEtaNearHandle = fhistos->fhDEtaNear.GetHandle();
+      fhDEtaNearHandle.At(fCentralityBin,ZBin,fPhiGapBinNear,fpttBin,fptaBin)->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
     } else {
-      fhistos->fhDEtaNearM[fCentralityBin][ZBin][fPhiGapBinNear][fpttBin][fptaBin]->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
+      if( !fhDEtaNearMHandle.IsValid() ) fhDEtaNearMHandle = fhistos->fhDEtaNearM.GetHandle();
+      fhDEtaNearMHandle.At(fCentralityBin,ZBin,fPhiGapBinNear,fpttBin,fptaBin)->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
       fhistos->fhDetaNearMixAcceptance[fCentralityBin][fpttBin][fptaBin]->Fill( fDeltaEta, fTrackPairEfficiency);
     }
   } else {
@@ -475,7 +489,8 @@ void AliJCorrelations::FillDeltaPhiHistograms(fillType fTyp)
   // When hists are filled for thresholds they are not properly normalized and need to be subtracted
   // This induced improper errors - subtraction of not-independent entries
   
-  fhistos->fhDphiAssoc[fTyp][fCentralityBin][fEtaGapBin][fpttBin][fptaBin]->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection * fTrackPairEfficiency);
+  if( !fhDphiAssocHandle.IsValid() ) fhDphiAssocHandle = fhistos->fhDphiAssoc.GetHandle();
+  fhDphiAssocHandle.At(fTyp,fCentralityBin,fEtaGapBin,fpttBin,fptaBin)->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection * fTrackPairEfficiency);
   if(fXlongBin>=0 && fNearSide3D) fhistos->fhDphiAssocXEbin[fTyp][fCentralityBin][fEtaGapBin][fpttBin][fXlongBin]->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection3D * fTrackPairEfficiency);
   
   if(fIsIsolatedTrigger) fhistos->fhDphiAssocIsolTrigg[fTyp][fCentralityBin][fpttBin][fptaBin]->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection * fTrackPairEfficiency); //FK//
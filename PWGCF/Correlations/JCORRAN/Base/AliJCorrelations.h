@@ -107,6 +107,10 @@ protected:
   
   double fGeometricAcceptanceCorrection;   // Acceptance correction due to the detector geometry
   double fGeometricAcceptanceCorrection3D; // Acceptance correction due to the detector geometry for 3D near side
+
+  AliJTH1DerivedHandle<TH1D> fhDphiAssocHandle;  // direct access to fhistos->fhDphiAssoc, set on first fill
+  AliJTH1DerivedHandle<TH1D> fhDEtaNearHandle;   // direct access to fhistos->fhDEtaNear, set on first fill
+  AliJTH1DerivedHandle<TH1D> fhDEtaNearMHandle;  // direct access to fhistos->fhDEtaNearM, set on first fill
   
 private:
   
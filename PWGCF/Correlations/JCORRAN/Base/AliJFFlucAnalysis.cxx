@@ -405,13 +405,22 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 				QnB_star[ih] = TComplex(0,0);			
 		}
 		//--------------- Calculate Qn--------------------
+		// one pass over the tracks per sub-event for all harmonics
+		CalculateQnSPAll( Eta_config[kSubA][kMin], Eta_config[kSubA][kMax], QnA);
+		CalculateQnSPAll( Eta_config[kSubB][kMin], Eta_config[kSubB][kMax], QnB);
 		for(int ih=0; ih<kNH; ih++){
-				QnA[ih] = CalculateQnSP( Eta_config[kSubA][kMin], Eta_config[kSubA][kMax], ih);
-				QnB[ih] = CalculateQnSP( Eta_config[kSubB][kMin], Eta_config[kSubB][kMax], ih);
 //				fh_Qvector[fCBin][0][ih]->Fill( QnA[ih].Theta() );
 //				fh_Qvector[fCBin][1][ih]->Fill( QnB[ih].Theta() );	
 				QnB_star[ih] = TComplex::Conjugate ( QnB[ih] ) ;
 		}
+		// powers (QnA QnB*)^k, k=0..nKL-1, by iterated multiplication
+		// (instead of TComplex::Power in the loops below)
+		TComplex QnAQnB_star_k[kNH][nKL];
+		for(int ih=0; ih<kNH; ih++){
+				TComplex QnAQnB_star = QnA[ih] * QnB_star[ih];
+				QnAQnB_star_k[ih][0] = TComplex(1,0);
+				for(int ik=1; ik<nKL; ik++) QnAQnB_star_k[ih][ik] = QnAQnB_star_k[ih][ik-1] * QnAQnB_star;
+		}
 		NSubTracks[kSubA] = QnA[0].Re(); // this is number of tracks in Sub A
 		NSubTracks[kSubB] = QnB[0].Re(); // this is number of tracks in Sub B
 		//-------------- Fill histos with below Values ----
@@ -438,22 +447,19 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 							fSingleVn[ih][0] = vn2[ih][ik]; // fill single vn with SP as method 0 	
 						}
 						if(ik!=0){
-								TComplex QnAk;
-								TComplex QnBstark;
-								QnAk = TComplex::Power( QnA[ih], ik) ;
-								QnBstark = TComplex::Power(QnB_star[ih], ik) ;
-								vn2[ih][ik] = ( QnAk * QnBstark ).Re();  
+								vn2[ih][ik] = QnAQnB_star_k[ih][ik].Re();  
 						}		
 				}
 		}
 		// vn^2k calcualted for n.... k....
 		// calculate hvn_vn (2 combination of vn) 
+		// the product is symmetric in (ih,ik) <-> (ihh,ikk), so calculate each pair once
 		for( int ih=2; ih<kNH; ih++){ 
 				for( int ik=1; ik<nKL; ik++){
-						for( int ihh=2; ihh<kNH; ihh++){ 
-								for(int ikk=1; ikk<nKL; ikk++){
-										vn2_vn2[ih][ik][ihh][ikk] = (  
-														TComplex::Power( QnA[ih]*QnB_star[ih],ik)*TComplex::Power(QnA[ihh]*QnB_star[ihh],ikk) ).Re();
+						for( int ihh=ih; ihh<kNH; ihh++){ 
+								for(int ikk=(ihh==ih ? ik : 1); ikk<nKL; ikk++){
+										vn2_vn2[ih][ik][ihh][ikk] = ( QnAQnB_star_k[ih][ik]*QnAQnB_star_k[ihh][ikk] ).Re();
+										vn2_vn2[ihh][ikk][ih][ik] = vn2_vn2[ih][ik][ihh][ikk];
 								}
 						}
 				}
@@ -482,15 +488,18 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 				}
 		}
 		///	Fill more correlators in manualy
-		TComplex V4V2starv2_2 =	QnA[4] *TComplex::Power( QnB_star[2] ,2) * vn2[2][1] ;
-		TComplex V4V2starv2_4 = QnA[4] * TComplex::Power( QnB_star[2], 2) * vn2[2][2] ;
-		TComplex V4V2star = QnA[4] * TComplex::Power( QnB_star[2], 2 ); 
+		TComplex V2star_2 = QnB_star[2] * QnB_star[2];
+		TComplex V2star_3 = V2star_2 * QnB_star[2];
+		TComplex V3star_2 = QnB_star[3] * QnB_star[3];
+		TComplex V4V2starv2_2 =	QnA[4] * V2star_2 * vn2[2][1] ;
+		TComplex V4V2starv2_4 = QnA[4] * V2star_2 * vn2[2][2] ;
+		TComplex V4V2star = QnA[4] * V2star_2; 
 		TComplex V5V2starV3starv2_2 = QnA[5] * QnB_star[2] * QnB_star[3] * vn2[2][1] ;
 		TComplex V5V2starV3star = QnA[5] * QnB_star[2] * QnB_star[3] ;
 		TComplex V5V2starV3startv3_2 = QnA[5] * QnB_star[2] * QnB_star[3] * vn2[3][1];
-		TComplex V6V2star_3 = QnA[6] * TComplex::Power( QnB_star[2] , 3) ;
-		TComplex V6V3star_2 = QnA[6] * TComplex::Power( QnB_star[3], 2) ;
-		TComplex V7V2star_2V3star = QnA[7] * TComplex::Power( QnB_star[2] , 2) * QnB_star[3]; 
+		TComplex V6V2star_3 = QnA[6] * V2star_3 ;
+		TComplex V6V3star_2 = QnA[6] * V3star_2 ;
+		TComplex V7V2star_2V3star = QnA[7] * V2star_2 * QnB_star[3]; 
 
 
 		// New correlattors (Modified by You's corretion term for self-correlations)
@@ -756,6 +765,34 @@ TComplex AliJFFlucAnalysis::CalculateQnSP( Double_t eta1, Double_t eta2, int har
 		if( ih !=0) Qn /= Sub_Ntrk; // Use Qn[0] as total number of tracks(*eff)
 		return Qn;
 }
+//________________________________________________________________________
+void AliJFFlucAnalysis::CalculateQnSPAll( Double_t eta1, Double_t eta2, TComplex Qn[kNH])
+{
+		// same as CalculateQnSP for all harmonics, with one pass over the tracks,
+		// so that the efficiency and phi-module corrections are looked up once per track
+		Double_t Sub_Ntrk = 0; // number of Tracks * effCorr * phi modulation factor 
+		for(int ih=0; ih<kNH; ih++) Qn[ih] = TComplex(0,0);
+		Long64_t ntracks = fInputList->GetEntriesFast();
+		for(Long64_t it=0; it< ntracks; it++){
+				AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
+				Double_t pt = itrack->Pt();
+				Double_t eta = itrack->Eta();
+				Double_t phi = itrack->Phi();
+				if( eta < eta1 || eta > eta2) continue; // eta cut
+
+				Double_t phi_module_corr = 1;
+				int isub = -1;
+				if( eta < 0 ) isub = 0;
+				if( eta > 0 ) isub = 1;
+				if( IsPhiModule == kTRUE){ phi_module_corr = h_phi_module[fCBin][isub]->GetBinContent( (h_phi_module[fCBin][isub]->GetXaxis()->FindBin( phi ) )  );}
+				Double_t effCorr = fEfficiency->GetCorrection( pt, fEffFilterBit, fCent );
+
+				Double_t weight = 1./effCorr * phi_module_corr;
+				for(int ih=0; ih<kNH; ih++) Qn[ih] += TComplex( weight * TMath::Cos(ih*phi), weight * TMath::Sin(ih*phi) );
+				Sub_Ntrk += weight ; 
+		}
+		for(int ih=1; ih<kNH; ih++) Qn[ih] /= Sub_Ntrk; // Use Qn[0] as total number of tracks(*eff)
+}
 ///________________________________________________________________________
 Double_t AliJFFlucAnalysis::Get_QC_Vn(Double_t QnA_real, Double_t QnA_img, Double_t QnB_real, Double_t QnB_img )
 {
@@ -79,6 +79,7 @@ class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 	private:
 		enum{kH0, kH1, kH2, kH3, kH4, kH5, kH6, kH7, kH8, kNH}; //harmonics // do we need vn up to v8? .. yes we need..
 		enum{kK0, kK1, kK2, kK3, kK4, nKL}; // order // do we really need vn^8 
+		void CalculateQnSPAll( double eta1, double eta2, TComplex Qn[kNH]); // all harmonics in one pass
 
 //		TDirectory           *fOutput;     // Output
 		Long64_t AnaEntry; 
@@ -254,6 +254,28 @@ void* AliJArrayBase::GetItem(){
     return item;
 }
 //_____________________________________________________
+void* AliJArrayBase::GetItemAt( int iG ){
+    // item at the global index iG, built if needed
+    if( OutOf( iG, 0, fArraySize-1 ) ){ JERROR( Form("Wrong global index %d in ",iG)+GetName() ); return NULL; }
+    void * item = fAlg->GetArray()[iG];
+    if( !item ){
+        int pos = iG;
+        fAlg->SetPosition( &pos ); // sets fIndex for BuildItem
+        BuildItem();
+        item = fAlg->GetArray()[iG];
+    }
+    return item;
+}
+//_____________________________________________________
+void** AliJArrayBase::GetArray(){
+    return fAlg ? fAlg->GetArray() : NULL;
+}
+//_____________________________________________________
+int AliJArrayBase::DimFactor( int d ){
+    if( OutOfDim(d) ) JERROR("Wrong Dim");
+    return fAlg->DimFactor(d);
+}
+//_____________________________________________________
 void* AliJArrayBase::GetSingleItem(){
     if(fMode == kSingle )return GetItem();
     JERROR("This is not single array");
@@ -30,6 +30,7 @@ class AliJTH1;
 class AliJHistManager;
 template<typename t> class AliJTH1Derived;
 template<typename t> class AliJTH1DerivedPlayer;
+template<typename t> class AliJTH1DerivedHandle;
 
 //////////////////////////////////////////////////////
 //  Utils
@@ -156,7 +157,10 @@ class AliJArrayBase : public AliJNamed{
         void ClearIndex(){ fIndex.clear();fIndex.resize( Dimension(), 0 ); }
 
         void * GetItem();
+        void * GetItemAt( int iG );
         void * GetSingleItem();
+        void ** GetArray();
+        int  DimFactor( int d );
 
         ///void LockBin(bool is=true){}//TODO
         //bool IsBinLocked(){ return fIsBinLocked; }
@@ -215,6 +219,8 @@ class AliJArrayAlgorithm {
         virtual bool IsCurrentPosition(void * pos)=0;
         virtual void SetPosition(void * pos )=0;
         virtual void DeletePosition( void * pos ) =0;
+        virtual void ** GetArray()=0;
+        virtual int DimFactor( int i )=0;
     protected:
         AliJArrayBase * fCMD;
 };
@@ -242,6 +248,8 @@ class AliJArrayAlgorithmSimple : public AliJArrayAlgorithm {
         virtual bool IsCurrentPosition(void * pos){ return *static_cast<int*>(pos)==fPos; }
         virtual void  SetPosition(void *pos){ fPos=*static_cast<int*>(pos);ReverseIndex(fPos); } 
         virtual void  DeletePosition(void *pos){ delete static_cast<int*>(pos); }
+        virtual void ** GetArray(){ return fArray; }
+        virtual int DimFactor( int i ){ return fDimFactor.at(i); }
     private:
         ArrayInt    fDimFactor;
         void    **fArray;
@@ -315,6 +323,7 @@ class AliJTH1Derived : public AliJTH1 {
         virtual ~AliJTH1Derived();
 
         AliJTH1DerivedPlayer<T> & operator[](int i){ fPlayer.Init();fPlayer[i];return fPlayer; }
+        AliJTH1DerivedHandle<T> GetHandle(){ return AliJTH1DerivedHandle<T>(this); }
         T * operator->(){ return static_cast<T*>(GetSingleItem()); }
         operator T*(){ return static_cast<T*>(GetSingleItem()); }
         // Virtual from AliJArrayBase
@@ -369,6 +378,45 @@ class AliJTH1DerivedPlayer {
         AliJTH1Derived<T> * fCMD;
 };
 
+//////////////////////////////////////////////////////////////////////////
+// AliJTH1DerivedHandle                                                 //
+//                                                                      //
+// Direct access to the histograms of a fixed AliJTH1Derived.           //
+// The strides are copied once, Index() turns the bin indices into      //
+// the global index and operator[] reads the pointer array, building    //
+// the histogram on first access as the player does.                    //
+// No range check is done, the indices must be valid.                   //
+//////////////////////////////////////////////////////////////////////////
+template< typename T>
+class AliJTH1DerivedHandle {
+    public:
+        enum { kMaxIndex=5 };
+        AliJTH1DerivedHandle():fCMD(NULL),fArray(NULL),fStride(kMaxIndex,0){}
+        AliJTH1DerivedHandle( AliJTH1Derived<T> * cmd ):fCMD(cmd),fArray(cmd->GetArray()),fStride(kMaxIndex,0){
+            if( cmd->Dimension() > kMaxIndex ) fStride.resize( cmd->Dimension(), 0 );
+            if( fArray ) for( int i=0;i<cmd->Dimension();i++ ) fStride[i] = cmd->DimFactor(i);
+        }
+        bool IsValid() const { return fArray!=NULL; }
+        // missing trailing indices are 0, as for the player
+        int Index( int i0, int i1=0, int i2=0, int i3=0, int i4=0 ) const {
+            return i0*fStride[0]+i1*fStride[1]+i2*fStride[2]+i3*fStride[3]+i4*fStride[4];
+        }
+        int Index( const int * idx, int n ) const {
+            int iG = 0;
+            for( int i=0;i<n;i++ ) iG += idx[i]*fStride[i];
+            return iG;
+        }
+        T* operator[]( int iG ){
+            void * item = fArray[iG];
+            return static_cast<T*>( item ? item : fCMD->GetItemAt(iG) );
+        }
+        T* At( int i0, int i1=0, int i2=0, int i3=0, int i4=0 ){ return (*this)[Index(i0,i1,i2,i3,i4)]; }
+    private:
+        AliJTH1Derived<T> * fCMD;
+        void ** fArray;
+        ArrayInt fStride;
+};
+
 typedef AliJTH1Derived<TH1D> AliJTH1D;
 typedef AliJTH1Derived<TH2D> AliJTH2D;
 typedef AliJTH1Derived<TProfile> AliJTProfile;
@@ -452,19 +452,58 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     secondCorrection[i]  = (Double_t)((AliBFBasicParticle*) particlesSecond->At(i))->Correction();   //==========================correction
   }
   
-  //TLorenzVector implementation for resonances
-  TLorentzVector vectorMother, vectorDaughter[2];
+  //Masses for the resonance veto (looked up once, not per pair)
   TParticle pPion, pProton, pRho0, pK0s, pLambda;
   pPion.SetPdgCode(211); //pion
   pRho0.SetPdgCode(113); //rho0
   pK0s.SetPdgCode(310); //K0s
   pProton.SetPdgCode(2212); //proton
   pLambda.SetPdgCode(3122); //Lambda
+  const Double_t massPion   = pPion.GetMass();
+  const Double_t massProton = pProton.GetMass();
+  const Double_t massRho0   = pRho0.GetMass();
+  const Double_t massK0s    = pK0s.GetMass();
+  const Double_t massLambda = pLambda.GetMass();
   Double_t gWidthForRho0 = 0.01;
   Double_t gWidthForK0s = 0.01;
   Double_t gWidthForLambda = 0.006;
   Double_t nSigmaRejection = 3.0;
 
+  //Cartesian momenta and energies of the 2nd particles for the pion and
+  //proton mass hypotheses (as TLorentzVector::SetPtEtaPhiM), so that
+  //the pair masses are computed directly in the inner loop
+  TArrayD secondPx, secondPy, secondPz, secondEPion, secondEProton;
+  if(fResonancesCut) {
+    secondPx.Set(jMax);
+    secondPy.Set(jMax);
+    secondPz.Set(jMax);
+    secondEPion.Set(jMax);
+    secondEProton.Set(jMax);
+    for (Int_t i=0; i<jMax; i++){
+      Double_t pt = TMath::Abs((Double_t)secondPt[i]);
+      secondPx[i] = pt*TMath::Cos((Double_t)secondPhi[i]);
+      secondPy[i] = pt*TMath::Sin((Double_t)secondPhi[i]);
+      secondPz[i] = pt*TMath::SinH((Double_t)secondEta[i]);
+      Double_t p2 = secondPx[i]*secondPx[i]+secondPy[i]*secondPy[i]+secondPz[i]*secondPz[i];
+      secondEPion[i]   = TMath::Sqrt(p2+massPion*massPion);
+      secondEProton[i] = TMath::Sqrt(p2+massProton*massProton);
+    }
+  }
+
+  //Track bending terms asin(0.075 R/pT) of the 2nd particles at the
+  //fixed radii used by the HBT cut (see GetDPhiStar)
+  TArrayD secondBendMiddle, secondBendInner, secondBendOuter;
+  if(fHBTCut) {
+    secondBendMiddle.Set(jMax);
+    secondBendInner.Set(jMax);
+    secondBendOuter.Set(jMax);
+    for (Int_t i=0; i<jMax; i++){
+      secondBendMiddle[i] = TMath::ASin(0.075 * (Float_t)1.65 / secondPt[i]);
+      secondBendInner[i]  = TMath::ASin(0.075 * (Float_t)0.8 / secondPt[i]);
+      secondBendOuter[i]  = TMath::ASin(0.075 * (Float_t)2.5 / secondPt[i]);
+    }
+  }
+
   // 1st particle loop
   for (Int_t i = 0; i < iMax; i++) {
     //AliVParticle* firstParticle = (AliVParticle*) particles->At(i);
@@ -501,6 +540,24 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     fHistPsiMinusPhi->Fill(gPsiMinusPhiBin,gPsiMinusPhi);
 
     Short_t  charge1 = (Short_t) firstParticle->Charge();
+
+    // same for the 1st particle
+    Double_t firstPx = 0., firstPy = 0., firstPz = 0., firstEPion = 0., firstEProton = 0.;
+    if(fResonancesCut) {
+      Double_t pt = TMath::Abs((Double_t)firstPt);
+      firstPx = pt*TMath::Cos((Double_t)firstPhi);
+      firstPy = pt*TMath::Sin((Double_t)firstPhi);
+      firstPz = pt*TMath::SinH((Double_t)firstEta);
+      Double_t p2 = firstPx*firstPx+firstPy*firstPy+firstPz*firstPz;
+      firstEPion   = TMath::Sqrt(p2+massPion*massPion);
+      firstEProton = TMath::Sqrt(p2+massProton*massProton);
+    }
+    Double_t firstBendMiddle = 0., firstBendInner = 0., firstBendOuter = 0.;
+    if(fHBTCut) {
+      firstBendMiddle = TMath::ASin(0.075 * (Float_t)1.65 / firstPt);
+      firstBendInner  = TMath::ASin(0.075 * (Float_t)0.8 / firstPt);
+      firstBendOuter  = TMath::ASin(0.075 * (Float_t)2.5 / firstPt);
+    }
     
     trackVariablesSingle[0]    =  gPsiMinusPhiBin;
     trackVariablesSingle[1]    =  firstPt;
@@ -549,34 +606,34 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
       if(fResonancesCut) {
 	if (charge1 * charge2 < 0) {
 
+	  //pair momentum (the same for all mass hypotheses)
+	  Double_t px = firstPx + secondPx[j];
+	  Double_t py = firstPy + secondPy[j];
+	  Double_t pz = firstPz + secondPz[j];
+	  Double_t p2 = px*px + py*py + pz*pz;
+
 	  //rho0
-	  vectorDaughter[0].SetPtEtaPhiM(firstPt,firstEta,firstPhi,pPion.GetMass());
-	  vectorDaughter[1].SetPtEtaPhiM(secondPt[j],secondEta[j],secondPhi[j],pPion.GetMass());
-	  vectorMother = vectorDaughter[0] + vectorDaughter[1];
-	  fHistResonancesBefore->Fill(trackVariablesPair[1],trackVariablesPair[2],vectorMother.M());
-	  if(TMath::Abs(vectorMother.M() - pRho0.GetMass()) <= nSigmaRejection*gWidthForRho0)
+	  Double_t massPair = PairMass(firstEPion + secondEPion[j], p2);
+	  fHistResonancesBefore->Fill(trackVariablesPair[1],trackVariablesPair[2],massPair);
+	  if(TMath::Abs(massPair - massRho0) <= nSigmaRejection*gWidthForRho0)
 	    continue;
-	  fHistResonancesRho->Fill(trackVariablesPair[1],trackVariablesPair[2],vectorMother.M());
+	  fHistResonancesRho->Fill(trackVariablesPair[1],trackVariablesPair[2],massPair);
 	  
 	  //K0s
-	  if(TMath::Abs(vectorMother.M() - pK0s.GetMass()) <= nSigmaRejection*gWidthForK0s)
+	  if(TMath::Abs(massPair - massK0s) <= nSigmaRejection*gWidthForK0s)
 	    continue;
-	  fHistResonancesK0->Fill(trackVariablesPair[1],trackVariablesPair[2],vectorMother.M());
+	  fHistResonancesK0->Fill(trackVariablesPair[1],trackVariablesPair[2],massPair);
 	  
 	  
 	  //Lambda
-	  vectorDaughter[0].SetPtEtaPhiM(firstPt,firstEta,firstPhi,pPion.GetMass());
-	  vectorDaughter[1].SetPtEtaPhiM(secondPt[j],secondEta[j],secondPhi[j],pProton.GetMass());
-	  vectorMother = vectorDaughter[0] + vectorDaughter[1];
-	  if(TMath::Abs(vectorMother.M() - pLambda.GetMass()) <= nSigmaRejection*gWidthForLambda)
+	  massPair = PairMass(firstEPion + secondEProton[j], p2);
+	  if(TMath::Abs(massPair - massLambda) <= nSigmaRejection*gWidthForLambda)
 	    continue;
 	  
-	  vectorDaughter[0].SetPtEtaPhiM(firstPt,firstEta,firstPhi,pProton.GetMass());
-	  vectorDaughter[1].SetPtEtaPhiM(secondPt[j],secondEta[j],secondPhi[j],pPion.GetMass());
-	  vectorMother = vectorDaughter[0] + vectorDaughter[1];
-	  if(TMath::Abs(vectorMother.M() - pLambda.GetMass()) <= nSigmaRejection*gWidthForLambda)
+	  massPair = PairMass(firstEProton + secondEPion[j], p2);
+	  if(TMath::Abs(massPair - massLambda) <= nSigmaRejection*gWidthForLambda)
 	    continue;
-	  fHistResonancesLambda->Fill(trackVariablesPair[1],trackVariablesPair[2],vectorMother.M());
+	  fHistResonancesLambda->Fill(trackVariablesPair[1],trackVariablesPair[2],massPair);
 	
 	}//unlike-sign only
       }//resonance cut
@@ -593,7 +650,7 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
 	  dphi = secondPhi[j] - firstPhi;
 
 	// for QA: get dphistar in the middle of the TPC R = 1.65
-	Float_t  dphistarMiddle = GetDPhiStar(firstPhi, firstPt, charge1, secondPhi[j], secondPt[j], charge2, 1.65, bSign);
+	Float_t  dphistarMiddle = GetDPhiStarFromBending(firstPhi, charge1, firstBendMiddle, secondPhi[j], charge2, secondBendMiddle[j], bSign);
 
 	// VERSION 2 (Taken from DPhiCorrelations)
 	// the variables & cuthave been developed by the HBT group 
@@ -611,8 +668,8 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
 	    Float_t phi2rad = secondPhi[j];
 	    
 	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, 0.8, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, 2.5, bSign);
+	    Float_t dphistar1 = GetDPhiStarFromBending(phi1rad, charge1, firstBendInner, phi2rad, charge2, secondBendInner[j], bSign);
+	    Float_t dphistar2 = GetDPhiStarFromBending(phi1rad, charge1, firstBendOuter, phi2rad, charge2, secondBendOuter[j], bSign);
 	    
 	    const Float_t kLimit = fHBTCutValue * 3;
 	    
@@ -2742,7 +2799,16 @@ Float_t AliBalancePsi::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, F
   //
   // calculates dphistar
   //
-  Float_t dphistar = phi1 - phi2 - charge1 * bSign * TMath::ASin(0.075 * radius / pt1) + charge2 * bSign * TMath::ASin(0.075 * radius / pt2);
+  return GetDPhiStarFromBending(phi1, charge1, TMath::ASin(0.075 * radius / pt1), phi2, charge2, TMath::ASin(0.075 * radius / pt2), bSign);
+}
+
+//____________________________________________________________________//
+Float_t AliBalancePsi::GetDPhiStarFromBending(Float_t phi1, Float_t charge1, Double_t bending1, Float_t phi2, Float_t charge2, Double_t bending2, Float_t bSign) const { 
+  //
+  // calculates dphistar from the bending terms asin(0.075 R/pT)
+  // of the two tracks at the radius R
+  //
+  Float_t dphistar = phi1 - phi2 - charge1 * bSign * bending1 + charge2 * bSign * bending2;
   
   static const Double_t kPi = TMath::Pi();
   
@@ -2762,6 +2828,16 @@ Float_t AliBalancePsi::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, F
   return dphistar;
 }
 
+//____________________________________________________________________//
+Double_t AliBalancePsi::PairMass(Double_t energy, Double_t momentum2) { 
+  //
+  // invariant mass of a pair from its energy and squared momentum
+  // (same convention as TLorentzVector::M for space-like vectors)
+  //
+  Double_t mm = energy*energy - momentum2;
+  return mm < 0.0 ? -TMath::Sqrt(-mm) : TMath::Sqrt(mm);
+}
+
 //____________________________________________________________________//
 Double_t* AliBalancePsi::GetBinning(const char* configuration, const char* tag, Int_t& nBins)
 {
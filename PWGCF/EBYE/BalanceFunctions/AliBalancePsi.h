@@ -239,6 +239,8 @@ class AliBalancePsi : public TObject {
 
  private:
   Float_t   GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign); 
+  Float_t   GetDPhiStarFromBending(Float_t phi1, Float_t charge1, Double_t bending1, Float_t phi2, Float_t charge2, Double_t bending2, Float_t bSign) const; 
+  static Double_t PairMass(Double_t energy, Double_t momentum2); 
 
   Bool_t fShuffle; //shuffled balance function object
   TString fAnalysisLevel; //ESD, AOD or MC
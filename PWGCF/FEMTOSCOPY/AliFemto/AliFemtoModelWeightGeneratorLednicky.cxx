@@ -20,6 +20,7 @@
 //#include <stream>
 //#include <iomanip>
 #include <sstream>
+#include <TMath.h>
 
 #ifdef SOLARIS
 # ifndef false
@@ -114,7 +115,10 @@ AliFemtoModelWeightGeneratorLednicky::AliFemtoModelWeightGeneratorLednicky() :
   fSphereApp(false),fT0App(false) ,
   fLL(0), fNuclChargeSign(1), fSwap(0), fLLMax(30), fLLName(0), 
   fNumProcessPair(0), fNumbNonId(0),
-  fKpKmModel(14),fPhi_OffOn(1)
+  fKpKmModel(14),fPhi_OffOn(1),
+  fTabulate(false),fTabNKStar(100),fTabKStarMin(0.001),fTabKStarMax(0.5),
+  fTabNRStar(100),fTabRStarMin(0.01),fTabRStarMax(50.),fTabNCosTheta(21),
+  fTabMaxError(0.01),fTabWeight(),fTabBadCell()
 {
   // default constructor
   fLLName=new char*[fLLMax+1];
@@ -163,7 +167,10 @@ AliFemtoModelWeightGeneratorLednicky::AliFemtoModelWeightGeneratorLednicky(const
   fSphereApp(false),fT0App(false) ,
   fLL(0), fNuclChargeSign(1), fSwap(0), fLLMax(30), fLLName(0), 
   fNumProcessPair(0), fNumbNonId(0),
-  fKpKmModel(14),fPhi_OffOn(1)
+  fKpKmModel(14),fPhi_OffOn(1),
+  fTabulate(false),fTabNKStar(100),fTabKStarMin(0.001),fTabKStarMax(0.5),
+  fTabNRStar(100),fTabRStarMin(0.01),fTabRStarMax(50.),fTabNCosTheta(21),
+  fTabMaxError(0.01),fTabWeight(),fTabBadCell()
 {
   // copy constructor
   fWei = aWeight.fWei; 
@@ -224,6 +231,18 @@ AliFemtoModelWeightGeneratorLednicky::AliFemtoModelWeightGeneratorLednicky(const
   strncpy( fLLName[30],"Proton Anti-proton",40);// gael 21May02
   FsiInit();
   FsiNucl();
+
+  fTabulate = aWeight.fTabulate;
+  fTabNKStar = aWeight.fTabNKStar;
+  fTabKStarMin = aWeight.fTabKStarMin;
+  fTabKStarMax = aWeight.fTabKStarMax;
+  fTabNRStar = aWeight.fTabNRStar;
+  fTabRStarMin = aWeight.fTabRStarMin;
+  fTabRStarMax = aWeight.fTabRStarMax;
+  fTabNCosTheta = aWeight.fTabNCosTheta;
+  fTabMaxError = aWeight.fTabMaxError;
+  fTabWeight = aWeight.fTabWeight;
+  fTabBadCell = aWeight.fTabBadCell;
 }
 
 AliFemtoModelWeightGeneratorLednicky& AliFemtoModelWeightGeneratorLednicky::operator=(const AliFemtoModelWeightGeneratorLednicky& aWeight)
@@ -292,6 +311,18 @@ AliFemtoModelWeightGeneratorLednicky& AliFemtoModelWeightGeneratorLednicky::oper
   strncpy( fLLName[30],"Proton Anti-proton",40);// gael 21May02
   FsiInit();
   FsiNucl();
+
+  fTabulate = aWeight.fTabulate;
+  fTabNKStar = aWeight.fTabNKStar;
+  fTabKStarMin = aWeight.fTabKStarMin;
+  fTabKStarMax = aWeight.fTabKStarMax;
+  fTabNRStar = aWeight.fTabNRStar;
+  fTabRStarMin = aWeight.fTabRStarMin;
+  fTabRStarMax = aWeight.fTabRStarMax;
+  fTabNCosTheta = aWeight.fTabNCosTheta;
+  fTabMaxError = aWeight.fTabMaxError;
+  fTabWeight = aWeight.fTabWeight;
+  fTabBadCell = aWeight.fTabBadCell;
   
   return *this;
 }
@@ -421,6 +452,16 @@ Double_t tDTime =inf1->GetEmissionPoint()->t()  - inf2->GetEmissionPoint()->t();
       fWeightDen=0.;
       return 0;  
     } 
+    if (fTabulate && IsTabulable()) {
+      if (fLL>=(int)fTabWeight.size() || fTabWeight[fLL].empty()) TabulateLL(fLL);
+      double tKR = fKStarOut*fRStarOut + fKStarSide*fRStarSide + fKStarLong*fRStarLong;
+      double tCosTheta = (fKStar>0 && fRStar>0) ? tKR/(fKStar*fRStar) : 1.;
+      double tWeight;
+      if (GetTabulatedWeight(fLL, fKStar, fRStar, tCosTheta, tWeight)) {
+        fWei = fWein = tWeight;
+        return tWeight;
+      }
+    }
     if (fSwap) {
       fsimomentum(*p2,*p1);
     } else {
@@ -497,12 +538,14 @@ void AliFemtoModelWeightGeneratorLednicky::FsiInit(){
    cout <<"mI3c dans FsiInit() = " << fI3c << endl;
    
   fsiin(fItest,fIch,fIqs,fIsi,fI3c);
+  ResetTables();
 }
 
 void AliFemtoModelWeightGeneratorLednicky::FsiSetKpKmModelType(){
   // initialize K+K- model type
   cout<<"******************* AliFemtoModelWeightGeneratorLednicky check FsiInit initialize K+K- model type with FsiSetKpKmModelType(), type= "<<fKpKmModel<<" PhiOffON= "<<fPhi_OffOn<<" *************"<< endl;
    setkpkmmodel(fKpKmModel,fPhi_OffOn);
+   ResetTables();
    cout<<"-----------------END FsiSetKpKmModelType-------"<<endl;
 }
 
@@ -515,15 +558,21 @@ void AliFemtoModelWeightGeneratorLednicky::FsiNucl(){
   fsinucl(fNuclMass,fNuclCharge*fNuclChargeSign);
 }
 
-void AliFemtoModelWeightGeneratorLednicky::FsiSetLL(){
-  // set internal pair type for the module
+int AliFemtoModelWeightGeneratorLednicky::FsiNS() const {
+  // approximation used for the Bethe-Salpeter amplitude of the current pair type
   int tNS;
   if (fSphereApp||(fLL>5)) {
     if (fT0App) { tNS=4;} 
     else {tNS=2;}
   } else { tNS=1;}
-  //cout<<"*********************** AliFemtoModelWeightGeneratorLednicky::FsiSetLL() *********************"<<endl;
   if(fNS_4==4) tNS=4;//K+K- analisys
+  return tNS;
+}
+
+void AliFemtoModelWeightGeneratorLednicky::FsiSetLL(){
+  // set internal pair type for the module
+  int tNS=FsiNS();
+  //cout<<"*********************** AliFemtoModelWeightGeneratorLednicky::FsiSetLL() *********************"<<endl;
   //cout <<"fLL dans FsiSetLL() = "<< fLL << endl;
   //cout <<"tNS dans FsiSetLL() = "<< tNS << endl;
   //cout <<"fItest dans FsiSetLL() = "<< fItest << endl;
@@ -725,10 +774,10 @@ void AliFemtoModelWeightGeneratorLednicky::SetKpKmModelType(const int aModelType
 void AliFemtoModelWeightGeneratorLednicky::SetNuclCharge(const double aNuclCharge) {fNuclCharge=aNuclCharge;FsiNucl();}
 void AliFemtoModelWeightGeneratorLednicky::SetNuclMass(const double aNuclMass){fNuclMass=aNuclMass;FsiNucl();}
 
-void AliFemtoModelWeightGeneratorLednicky::SetSphere(){fSphereApp=true;}
-void AliFemtoModelWeightGeneratorLednicky::SetSquare(){fSphereApp=false;}
-void AliFemtoModelWeightGeneratorLednicky::SetT0ApproxOn(){ fT0App=true;}
-void AliFemtoModelWeightGeneratorLednicky::SetT0ApproxOff(){ fT0App=false;}
+void AliFemtoModelWeightGeneratorLednicky::SetSphere(){fSphereApp=true;ResetTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetSquare(){fSphereApp=false;ResetTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetT0ApproxOn(){ fT0App=true;ResetTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetT0ApproxOff(){ fT0App=false;ResetTables();}
 void AliFemtoModelWeightGeneratorLednicky::SetDefaultCalcPar(){
   fItest=1;fIqs=1;fIsi=1;fI3c=0;fIch=1;FsiInit();
   fSphereApp=false;fT0App=false;}
@@ -751,6 +800,154 @@ Double_t AliFemtoModelWeightGeneratorLednicky::GetRStarOut() const { return AliF
 Double_t AliFemtoModelWeightGeneratorLednicky::GetRStarSide() const { return AliFemtoModelWeightGenerator::GetRStarSide(); }
 Double_t AliFemtoModelWeightGeneratorLednicky::GetRStarLong() const { return AliFemtoModelWeightGenerator::GetRStarLong(); }
 
+//_____________________________________________
+void AliFemtoModelWeightGeneratorLednicky::SetTabulation(int aNKStar, double aKStarMin, double aKStarMax,
+                                                         int aNRStar, double aRStarMin, double aRStarMax,
+                                                         int aNCosTheta, double aMaxError)
+{
+  // switch on the tabulated weights with the given grid
+  if (aNKStar<2 || aNRStar<2 || aNCosTheta<2 || aKStarMin<=0 || aRStarMin<=0 ||
+      aKStarMax<=aKStarMin || aRStarMax<=aRStarMin) {
+    cout << "AliFemtoModelWeightGeneratorLednicky::SetTabulation : bad grid, tabulation off" << endl;
+    SetTabulationOff();
+    return;
+  }
+  fTabulate = true;
+  fTabNKStar = aNKStar;
+  fTabKStarMin = aKStarMin;
+  fTabKStarMax = aKStarMax;
+  fTabNRStar = aNRStar;
+  fTabRStarMin = aRStarMin;
+  fTabRStarMax = aRStarMax;
+  fTabNCosTheta = aNCosTheta;
+  fTabMaxError = aMaxError;
+  ResetTables();
+}
+
+void AliFemtoModelWeightGeneratorLednicky::SetTabulationOff()
+{
+  fTabulate = false;
+  ResetTables();
+}
+
+void AliFemtoModelWeightGeneratorLednicky::ResetTables()
+{
+  // the tables depend on the calculation mode, drop them when it changes
+  fTabWeight.clear();
+  fTabBadCell.clear();
+}
+
+bool AliFemtoModelWeightGeneratorLednicky::IsTabulable() const
+{
+  // the PRF weight depends on k*, r* and cos(theta*) only without the
+  // residual nucleus and with equal emission times
+  return (fI3c==0) && (FsiNS()!=4);
+}
+
+void AliFemtoModelWeightGeneratorLednicky::TabulatePairType(Int_t aPairType)
+{
+  // build the table of a pair type, e.g. before the pairs are processed concurrently
+  SetPairType(aPairType);
+  if (fTabulate && fLL && IsTabulable()) TabulateLL(fLL);
+}
+
+double AliFemtoModelWeightGeneratorLednicky::FsiWeightPRF(double aKStar, double aRStar, double aCosTheta)
+{
+  // fortran weight of the current pair type for a pair at rest, with k*
+  // along z and r* in the xz plane at zero relative time. The pair
+  // velocity is then zero, CVK in BoostToPrf is not used by the weight.
+  double tSinTheta = ::sqrt(TMath::Max(0., 1. - aCosTheta*aCosTheta));
+  double p1[] = {0., 0.,  aKStar};
+  double p2[] = {0., 0., -aKStar};
+  double x1[] = {aRStar*tSinTheta, 0., aRStar*aCosTheta, 0.};
+  double x2[] = {0., 0., 0., 0.};
+  fsimomentum(*p1,*p2);
+  fsiposition(*x1,*x2);
+  ltran12();
+  fsiw(1,fWeif,fWei,fWein);
+  return fWein;
+}
+
+void AliFemtoModelWeightGeneratorLednicky::TabulateLL(int aLL)
+{
+  // tabulate the weight of the pair type aLL at the grid nodes and
+  // check the interpolation at the center of each cell
+  if (aLL<=0 || aLL>fLLMax) return;
+  if ((int)fTabWeight.size()<=fLLMax) {
+    fTabWeight.resize(fLLMax+1);
+    fTabBadCell.resize(fLLMax+1);
+  }
+  int tLL = fLL;
+  fLL = aLL;
+  FsiSetLL();
+
+  const int nk = fTabNKStar, nr = fTabNRStar, nc = fTabNCosTheta;
+  const double dk = (fTabKStarMax-fTabKStarMin)/(nk-1);
+  const double dr = (fTabRStarMax-fTabRStarMin)/(nr-1);
+  const double dc = 2./(nc-1);
+
+  std::vector<double> &tWeight = fTabWeight[aLL];
+  tWeight.resize(nk*nr*nc);
+  for (int ik=0; ik<nk; ik++)
+    for (int ir=0; ir<nr; ir++)
+      for (int ic=0; ic<nc; ic++)
+        tWeight[(ik*nr+ir)*nc+ic] = FsiWeightPRF(fTabKStarMin+ik*dk, fTabRStarMin+ir*dr, -1.+ic*dc);
+
+  std::vector<char> &tBad = fTabBadCell[aLL];
+  tBad.assign((nk-1)*(nr-1)*(nc-1), 0);
+  int tNBad = 0;
+  for (int ik=0; ik<nk-1; ik++)
+    for (int ir=0; ir<nr-1; ir++)
+      for (int ic=0; ic<nc-1; ic++) {
+        double tInterp = 0.;
+        for (int jk=0; jk<2; jk++)
+          for (int jr=0; jr<2; jr++)
+            for (int jc=0; jc<2; jc++)
+              tInterp += tWeight[((ik+jk)*nr+ir+jr)*nc+ic+jc];
+        tInterp *= 0.125;
+        double tExact = FsiWeightPRF(fTabKStarMin+(ik+0.5)*dk, fTabRStarMin+(ir+0.5)*dr, -1.+(ic+0.5)*dc);
+        if (TMath::Abs(tInterp-tExact) > fTabMaxError*TMath::Max(1., TMath::Abs(tExact))) {
+          tBad[(ik*(nr-1)+ir)*(nc-1)+ic] = 1;
+          tNBad++;
+        }
+      }
+  cout << "AliFemtoModelWeightGeneratorLednicky::TabulateLL : " << fLLName[aLL] << " tabulated, "
+       << tNBad << " of " << tBad.size() << " cells use the fortran weight" << endl;
+
+  fLL = tLL;
+}
+
+bool AliFemtoModelWeightGeneratorLednicky::GetTabulatedWeight(int aLL, double aKStar, double aRStar, double aCosTheta, double &aWeight) const
+{
+  // trilinear interpolation of the tabulated weight, false if the
+  // pair type is not tabulated or the point is not covered
+  if (aLL<=0 || aLL>=(int)fTabWeight.size() || fTabWeight[aLL].empty()) return false;
+  if (aKStar<fTabKStarMin || aKStar>fTabKStarMax || aRStar<fTabRStarMin || aRStar>fTabRStarMax) return false;
+
+  const int nk = fTabNKStar, nr = fTabNRStar, nc = fTabNCosTheta;
+  double fk = (aKStar-fTabKStarMin)/(fTabKStarMax-fTabKStarMin)*(nk-1);
+  double fr = (aRStar-fTabRStarMin)/(fTabRStarMax-fTabRStarMin)*(nr-1);
+  double fc = (TMath::Min(1., TMath::Max(-1., aCosTheta))+1.)*0.5*(nc-1);
+  int ik = TMath::Min((int)fk, nk-2);
+  int ir = TMath::Min((int)fr, nr-2);
+  int ic = TMath::Min((int)fc, nc-2);
+  if (fTabBadCell[aLL][(ik*(nr-1)+ir)*(nc-1)+ic]) return false;
+  fk -= ik;
+  fr -= ir;
+  fc -= ic;
+
+  const double *w = &fTabWeight[aLL][(ik*nr+ir)*nc+ic];
+  const int sk = nr*nc, sr = nc;
+  double w00 = w[0]      *(1.-fc) + w[1]        *fc;
+  double w01 = w[sr]     *(1.-fc) + w[sr+1]     *fc;
+  double w10 = w[sk]     *(1.-fc) + w[sk+1]     *fc;
+  double w11 = w[sk+sr]  *(1.-fc) + w[sk+sr+1]  *fc;
+  double w0 = w00*(1.-fr) + w01*fr;
+  double w1 = w10*(1.-fr) + w11*fr;
+  aWeight = w0*(1.-fk) + w1*fk;
+  return true;
+}
+
 AliFemtoModelWeightGenerator* AliFemtoModelWeightGeneratorLednicky::Clone() const {
   AliFemtoModelWeightGenerator* tmp = new AliFemtoModelWeightGeneratorLednicky(*this);
   return tmp;
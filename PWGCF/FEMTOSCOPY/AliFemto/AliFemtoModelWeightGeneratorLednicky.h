@@ -11,6 +11,8 @@
 #ifndef ALIFEMTOMODELWEIGHTGENERATORLEDNICKY_H
 #define ALIFEMTOMODELWEIGHTGENERATORLEDNICKY_H
 
+#include <vector>
+
 #include "AliFemtoTypes.h"
 #include "AliFemtoModelWeightGenerator.h"
 
@@ -66,6 +68,19 @@ class AliFemtoModelWeightGeneratorLednicky : public  AliFemtoModelWeightGenerato
 
   void SetKpKmModelType(const int aModelType, const int aPhi_OffOn);  // K+K- model type,Phi off/on
 
+// >>> Tabulated weights
+// The weight is tabulated per pair type on a k* x r* x cos(theta*) grid
+// and interpolated linearly. Cells where the interpolation at the cell
+// center differs from the fortran weight by more than aMaxError are
+// flagged and, as pairs outside the grid, use the fortran calculation.
+// Not used with 3-body or with the T0 approximation (NS=4).
+  void SetTabulation(int aNKStar=100, double aKStarMin=0.001, double aKStarMax=0.5,
+                     int aNRStar=100, double aRStarMin=0.01, double aRStarMax=50.,
+                     int aNCosTheta=21, double aMaxError=0.01);
+  void SetTabulationOff();
+  void TabulatePairType(Int_t aPairType); // build the table before the first pair
+  bool GetTabulatedWeight(int aLL, double aKStar, double aRStar, double aCosTheta, double &aWeight) const; // no fortran call, no state change
+
   virtual AliFemtoString Report();
 
 protected:
@@ -103,15 +118,33 @@ protected:
   int       fPhi_OffOn;      //0->Phi Off,1->Phi On
   int       fNS_4;           //set NS is equal to 4
 
+  //Tabulated weights
+  bool      fTabulate;       // use the tabulated weights
+  int       fTabNKStar;      // number of k* nodes
+  double    fTabKStarMin;    // first k* node
+  double    fTabKStarMax;    // last k* node
+  int       fTabNRStar;      // number of r* nodes
+  double    fTabRStarMin;    // first r* node
+  double    fTabRStarMax;    // last r* node
+  int       fTabNCosTheta;   // number of cos(theta*) nodes in [-1,1]
+  double    fTabMaxError;    // allowed interpolation error at the cell centers
+  std::vector< std::vector<double> > fTabWeight;  //! weights at the nodes, per fLL
+  std::vector< std::vector<char> >   fTabBadCell; //! cells failing the error check, per fLL
+
   // Interface to the fortran functions
   void FsiSetKpKmModelType();  //// initialize K+K- model type
   void FsiInit();
   void FsiSetLL();
   void FsiNucl();
+  int  FsiNS() const;
+  bool IsTabulable() const;
+  void TabulateLL(int aLL);
+  double FsiWeightPRF(double aKStar, double aRStar, double aCosTheta);
+  void ResetTables();
   bool SetPid(const int aPid1,const int aPid2);
 
 #ifdef __ROOT__
-  ClassDef(AliFemtoModelWeightGeneratorLednicky,1)
+  ClassDef(AliFemtoModelWeightGeneratorLednicky,2)
 #endif
 };
 
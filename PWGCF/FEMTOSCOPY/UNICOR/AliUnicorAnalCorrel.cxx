@@ -25,6 +25,7 @@
 #include <TROOT.h>
 #include <TMath.h>
 #include <TRandom2.h>
+#include <TVector2.h>
 #include "AliUnicorEvent.h"
 #include "AliUnicorHN.h"
 #include "AliUnicorAnalCorrel.h"
@@ -35,7 +36,9 @@ ClassImp(AliUnicorAnalCorrel)
 AliUnicorAnalCorrel::AliUnicorAnalCorrel(const char *nam, Double_t emi, Double_t ema, 
 			 Int_t pid0, Int_t pid1, AnalysisFrame frame): 
   AliUnicorAnal(nam), fPid0(pid0), fPid1(pid1), fMass0(0), fMass1(0), fZ0(0), fZ1(0), 
-  fFrame(frame), fPa() {
+  fFrame(frame), fTrackIndex(), fTrackP(), fTrackTheta(), fTrackPhi(), fTrackPx(), 
+  fTrackPy(), fTrackPz(), fTrackE(), fPairTrack(), fPairSign(), fPairKt(), fPairY(), 
+  fPairPhi(), fPairDTheta(), fPairDPhi(), fPairQCM(), fPairQ(), fPairQTheta(), fPairQPhiOut() {
   // constructor
   // emi and ema define the rapidity range for histogram
 
@@ -107,13 +110,132 @@ AliUnicorAnalCorrel::AliUnicorAnalCorrel(const char *nam, Double_t emi, Double_t
   printf("%s object named %s created\n",ClassName(),GetName());
 }
 //=============================================================================
+void AliUnicorAnalCorrel::Snapshot(Int_t s, const AliUnicorEvent * const ev, Int_t pid, 
+				   Double_t mass, Double_t phirot, const std::vector<Int_t> * const good) 
+{
+  // Copy the good particles of species s into contiguous arrays, so that the 
+  // virtual accessors are called once per particle rather than once per pair. 
+  // If the list of good particles is already known it can be passed as good. 
+
+  std::vector<Int_t> &index = fTrackIndex[s];
+  if (good) index = *good;
+  else {
+    index.clear();
+    for (int i=0; i<ev->NParticles(); i++) if (ev->ParticleGood(i,pid)) index.push_back(i);
+  }
+  int n = index.size();
+  fTrackP[s].resize(n);
+  fTrackTheta[s].resize(n);
+  fTrackPhi[s].resize(n);
+  fTrackPx[s].resize(n);
+  fTrackPy[s].resize(n);
+  fTrackPz[s].resize(n);
+  fTrackE[s].resize(n);
+  for (int k=0; k<n; k++) {
+    int i = index[k];
+    double p   = ev->ParticleP(i);
+    double the = ev->ParticleTheta(i);
+    double phi = ev->ParticlePhi(i)+phirot;
+    double pt  = p*sin(the);
+    fTrackP[s][k]     = p;
+    fTrackTheta[s][k] = the;
+    fTrackPhi[s][k]   = phi;
+    fTrackPx[s][k]    = pt*cos(phi);
+    fTrackPy[s][k]    = pt*sin(phi);
+    fTrackPz[s][k]    = p*cos(the);
+    fTrackE[s][k]     = sqrt(p*p+mass*mass);
+  }
+}
+//=============================================================================
+void AliUnicorAnalCorrel::CalcPairs(Int_t i, Int_t n) 
+{
+  // Calculate the pair variables of track i of species 0 and tracks 
+  // fPairTrack[0...n-1] of species 1. Swapped pairs (fPairSign=-1) have 
+  // q=p0-p1 instead of p1-p0. Same result as AliUnicorPair, but without 
+  // the TLorentzVector overhead and with branch-free inner loop. 
+
+  if (n<=0) return;
+  const double e0 = fTrackE[0][i];
+  const double x0 = fTrackPx[0][i];
+  const double y0 = fTrackPy[0][i];
+  const double z0 = fTrackPz[0][i];
+  const double t0 = fTrackTheta[0][i];
+  const double f0 = fTrackPhi[0][i];
+  const int    *jj = &fPairTrack[0];
+  const double *sg = &fPairSign[0];
+  const double *e1 = &fTrackE[1][0];
+  const double *x1 = &fTrackPx[1][0];
+  const double *y1 = &fTrackPy[1][0];
+  const double *z1 = &fTrackPz[1][0];
+  const double *t1 = &fTrackTheta[1][0];
+  const double *f1 = &fTrackPhi[1][0];
+  const int pairframe = (fFrame==kPairFrame);
+  const int lcms      = (fFrame==kLCMS);
+
+  for (int k=0; k<n; k++) {
+    int j = jj[k];
+    double s = sg[k];
+
+    // LAB total momentum and momentum difference
+
+    double ee = e0+e1[j];
+    double px = x0+x1[j];
+    double py = y0+y1[j];
+    double pz = z0+z1[j];
+    double qe = s*(e1[j]-e0);
+    double qx = s*(x1[j]-x0);
+    double qy = s*(y1[j]-y0);
+    double qz = s*(z1[j]-z0);
+    double pt = sqrt(px*px+py*py);
+    fPairKt[k]     = pt/2.0;
+    fPairY[k]      = 0.5*log((ee+pz)/(ee-pz));
+    fPairPhi[k]    = atan2(py,px);
+    fPairDTheta[k] = s*(t1[j]-t0);
+    fPairDPhi[k]   = TVector2::Phi_mpi_pi(s*(f1[j]-f0));
+
+    // q boosted to pair c.m.s. (argument of Coulomb correction)
+
+    double bx = px/ee;
+    double by = py/ee;
+    double bz = pz/ee;
+    double b2 = bx*bx+by*by+bz*bz;
+    double ga = 1.0/sqrt(1.0-b2);
+    double g2 = b2>0? (ga-1.0)/b2 : 0;
+    double bq = bx*qx+by*qy+bz*qz;
+    double cc = g2*bq-ga*qe;
+    double cx = qx+cc*bx;
+    double cy = qy+cc*by;
+    double cz = qz+cc*bz;
+    fPairQCM[k] = sqrt(cx*cx+cy*cy+cz*cz);
+
+    // q in the analysis frame: pair c.m.s., LCMS, or LAB
+
+    double gz = 1.0/sqrt(1.0-bz*bz);
+    double ax = pairframe? cx : qx;
+    double ay = pairframe? cy : qy;
+    double az = pairframe? cz : (lcms? gz*(qz-bz*qe) : qz);
+    double at = sqrt(ax*ax+ay*ay);
+    fPairQ[k]      = sqrt(at*at+az*az);
+    fPairQTheta[k] = atan2(at,az);
+
+    // out is along the pair transverse velocity
+
+    double ux = pt>0? px/pt : 0;
+    double uy = pt>0? py/pt : 0;
+    fPairQPhiOut[k] = atan2(-ax*uy+ay*ux, ax*ux+ay*uy);
+  }
+}
+//=============================================================================
 void AliUnicorAnalCorrel::Process(Int_t tmr, const AliUnicorEvent * const ev0, const AliUnicorEvent * const ev1, Double_t phirot) 
 {
   // process pairs from one or two (if mixing) events
   // tmr tells which histogram (bins) to fill: tru,mix,rot
 
-  // Could be possibly accelerated by checking the "good particle" only once 
-  // and caching the result. (Maybe the optimizer does it already.)
+  // The good particles of both species are first copied into contiguous 
+  // arrays. Then, for each particle of species 0, the kinematic variables 
+  // of all its pairs are calculated in one go (CalcPairs), and the pairs 
+  // are filled using 1-dim histogram indices whose event-constant part 
+  // (tmr, centrality) is calculated only once per event. 
 
   static TRandom2 ran;
   AliUnicorHN *pair = (AliUnicorHN*) fHistos.At(0);
@@ -131,30 +253,65 @@ void AliUnicorAnalCorrel::Process(Int_t tmr, const AliUnicorEvent * const ev0, c
   ev1->RP(q1x,q1y); 
   double rpphi = atan2(q0y+q1y,q0x+q1x);
 
+  // event-constant part of the histogram indices
+
+  int pairbin = pair->AddAxisBin(pair->AddAxisBin(0,0,(double) tmr),1,cent);
+  int coulbin = pair->AddAxisBin(pair->AddAxisBin(0,0,(double) 3),1,cent);
+  int bimobin = bimo->AddAxisBin(0,0,cent);
+  int twotbin0 = twot->AddAxisBin(twot->AddAxisBin(0,0,(double) tmr),1,0.0);
+  int twotbin1 = twot->AddAxisBin(twot->AddAxisBin(0,0,(double) tmr),1,1.0);
+
+  // good particles
+
+  const int same = (ev0==ev1);
+  const int triangle = (same && fPid0==fPid1);
+  Snapshot(0,ev0,fPid0,fMass0,0);
+  Snapshot(1,ev1,fPid1,fMass1,phirot,triangle? &fTrackIndex[0] : 0);
+  const int n0 = fTrackIndex[0].size();
+  const int n1 = fTrackIndex[1].size();
+  if (int(fPairTrack.size())<n1) {
+    fPairTrack.resize(n1);
+    fPairSign.resize(n1);
+    fPairKt.resize(n1);
+    fPairY.resize(n1);
+    fPairPhi.resize(n1);
+    fPairDTheta.resize(n1);
+    fPairDPhi.resize(n1);
+    fPairQCM.resize(n1);
+    fPairQ.resize(n1);
+    fPairQTheta.resize(n1);
+    fPairQPhiOut.resize(n1);
+  }
+
   // loop over pairs 
 
-  for (int i=0; i<ev0->NParticles(); i++) {
-    if (!ev0->ParticleGood(i,fPid0)) continue;
-    for (int j=0; j<ev1->NParticles(); j++) {
-      if (ev0==ev1 && j<i && fPid0==fPid1 ) continue; 
-      if (ev0==ev1 && j==i) continue; // beware, not even when rotated or non-identical
-      if (!ev1->ParticleGood(j,fPid1)) continue;
-      fPa.Set0(fMass0,ev0->ParticleP(i),ev0->ParticleTheta(i),ev0->ParticlePhi(i));
-      fPa.Set1(fMass1,ev1->ParticleP(j),ev1->ParticleTheta(j),ev1->ParticlePhi(j)+phirot);
-      if (ev0==ev1 && fPid0==fPid1 && ran.Rndm()>=0.5) fPa.Swap();
-      twot->Fill((double) tmr, 0.0, fPa.Pt()/2.0, fPa.DTheta(), fPa.DPhi(),1.0);
-      if (!ev0->PairGood(ev0->ParticleP(i),ev0->ParticleTheta(i),ev0->ParticlePhi(i),fZ0,
-      			 ev1->ParticleP(j),ev1->ParticleTheta(j),ev1->ParticlePhi(j)+phirot,fZ1)) continue;
-      twot->Fill((double) tmr, 1.0, fPa.Pt()/2.0, fPa.DTheta(), fPa.DPhi(),1.0);
-      fPa.CalcLAB(); // this could be organized better. AliUnicorPair should give k*?
-      fPa.CalcPairCM();
-      double qcm = fPa.QCM(); // momdif in pair cm - argument for Coulomb correction
-
-      fPa.CalcLAB();
-      if (fFrame == kPairFrame) fPa.CalcPairCM();
-      if (fFrame == kLCMS)      fPa.CalcLcmsCM();
-      if (fPa.QCM()==0) {printf("AliUnicorAnalCorrel: Q=0\n"); return;} // should not be too frequent
-      double phi = TVector2::Phi_mpi_pi(fPa.Phi()-rpphi);
+  for (int a=0; a<n0; a++) {
+    int i = fTrackIndex[0][a];
+
+    // partners of i; beware, never i itself, not even when rotated or non-identical
+
+    int n = 0;
+    for (int b=(triangle? a+1 : 0); b<n1; b++) {
+      if (same && fTrackIndex[1][b]==i) continue;
+      fPairTrack[n] = b;
+      fPairSign[n] = (triangle && ran.Rndm()>=0.5)? -1 : 1;
+      n++;
+    }
+    if (n==0) continue;
+    CalcPairs(a,n);
+
+    for (int k=0; k<n; k++) {
+      int b = fPairTrack[k];
+      int twotbin = twot->AddAxisBin(0,2,fPairKt[k]);
+      twotbin = twot->AddAxisBin(twotbin,3,fPairDTheta[k]);
+      twotbin = twot->AddAxisBin(twotbin,4,fPairDPhi[k]);
+      if (twotbin0>=0 && twotbin>=0) twot->FillBin(twotbin0+twotbin,1.0);
+      if (!ev0->PairGood(fTrackP[0][a],fTrackTheta[0][a],fTrackPhi[0][a],fZ0,
+			 fTrackP[1][b],fTrackTheta[1][b],fTrackPhi[1][b],fZ1)) continue;
+      if (twotbin1>=0 && twotbin>=0) twot->FillBin(twotbin1+twotbin,1.0);
+      double qcm = fPairQCM[k]; // momdif in pair cm - argument for Coulomb correction
+      if (fPairQ[k]==0) {printf("AliUnicorAnalCorrel: Q=0\n"); return;} // should not be too frequent
+      double phi = TVector2::Phi_mpi_pi(fPairPhi[k]-rpphi);
       double weigth = 1.0;
       /*
       static TH2D *coul = 0; 
@@ -168,28 +325,21 @@ void AliUnicorAnalCorrel::Process(Int_t tmr, const AliUnicorEvent * const ev0, c
 	double co = 0;
 	if (qcm>0.999) co = 1;
 	else if (qcm>0.001) co = coul->Interpolate(7,qcm);
-	weigth = 1.0-0.5+0.5*co*(1+exp(-pow(fPa.QCM()*7/0.197,2))); 
+	weigth = 1.0-0.5+0.5*co*(1+exp(-pow(fPairQ[k]*7/0.197,2))); 
       }
       */
-      pair->Fill((double) tmr,           // 0 for tru, 1 for mix, 2 for rot
-		 cent,                   // centrality
-		 fPa.Rapidity(),         // pair rapidity
-		 phi,                    // pair phi wrt reaction plane
-		 fPa.Pt()/2.0,           // half of pair pt
-		 fPa.QCMTheta(),         // polar angle of Q
-		 fPa.QCMPhiOut(),        // azimuthal angle of Q w.r.t. out
-		 fPa.QCM(),              // |p2-p1| in c.m.s.
-		 weigth);                // weigth
-      if (tmr==0 && fPa.QCM()<0.2) bimo->Fill(cent, fPa.Rapidity(), fPa.Pt()/2.0, weigth);
-      if (tmr==0) pair->Fill((double) 3,             // this is for Coulomb correction, maybe not necessary
-			     cent,                   // centrality
-			     fPa.Rapidity(),         // pair rapidity
-			     phi,                    // pair phi wrt reaction plane
-			     fPa.Pt()/2.0,           // half of pair pt
-			     fPa.QCMTheta(),         // polar angle of Q
-			     fPa.QCMPhiOut(),        // azimuthal angle of Q w.r.t. out
-			     fPa.QCM(),              // |p2-p1| in c.m.s.
-      			     weigth*qcm);            // weigth*Q
+      int bin = pair->AddAxisBin(0,2,fPairY[k]);   // pair rapidity
+      bin = pair->AddAxisBin(bin,3,phi);            // pair phi wrt reaction plane
+      bin = pair->AddAxisBin(bin,4,fPairKt[k]);     // half of pair pt
+      bin = pair->AddAxisBin(bin,5,fPairQTheta[k]); // polar angle of Q
+      bin = pair->AddAxisBin(bin,6,fPairQPhiOut[k]);// azimuthal angle of Q w.r.t. out
+      bin = pair->AddAxisBin(bin,7,fPairQ[k]);      // |p2-p1| in c.m.s.
+      if (bin>=0 && pairbin>=0) pair->FillBin(pairbin+bin,weigth);             // 0 for tru, 1 for mix, 2 for rot
+      if (bin>=0 && coulbin>=0 && tmr==0) pair->FillBin(coulbin+bin,weigth*qcm); // for Coulomb correction, maybe not necessary
+      if (tmr==0 && fPairQ[k]<0.2 && bimobin>=0) {
+	int bimo12 = bimo->AddAxisBin(bimo->AddAxisBin(0,1,fPairY[k]),2,fPairKt[k]);
+	if (bimo12>=0) bimo->FillBin(bimobin+bimo12,weigth);
+      }
     }
   }
 }
@@ -11,8 +11,8 @@
 // two-particle correlation analyzer
 //=============================================================================
 
+#include <vector>
 #include "AliUnicorAnal.h"
-#include "AliUnicorPair.h"
 class AliUnicorEvent;
 
 //=============================================================================
@@ -26,6 +26,13 @@ class AliUnicorAnalCorrel : public AliUnicorAnal {
   // process one (tru) or two (mix) events
   void Process(Int_t tmr, const AliUnicorEvent * const ev0, const AliUnicorEvent * const ev1, Double_t phirot);
 
+ private:
+  // copy good particles of species s into the track arrays
+  void Snapshot(Int_t s, const AliUnicorEvent * const ev, Int_t pid, Double_t mass, Double_t phirot, 
+		const std::vector<Int_t> * const good=0);
+  // pair kinematics of track i of species 0 and the first n entries of fPairTrack
+  void CalcPairs(Int_t i, Int_t n);
+
  protected:
   Int_t    fPid0;                       // particle species 0
   Int_t    fPid1;                       // particle species 1
@@ -34,9 +41,29 @@ class AliUnicorAnalCorrel : public AliUnicorAnal {
   double   fZ0;                         // charge 0 in units of |e|
   double   fZ1;                         // charge 1 in units of |e|
   Int_t    fFrame;                      // analysis frame
-  AliUnicorPair    fPa;                         // pair buffer for calculations
 
-  ClassDef(AliUnicorAnalCorrel,1)
+  std::vector<Int_t>    fTrackIndex[2]; //! event index of good particles of species 0 and 1
+  std::vector<Double_t> fTrackP[2];     //! momentum
+  std::vector<Double_t> fTrackTheta[2]; //! polar angle
+  std::vector<Double_t> fTrackPhi[2];   //! azimuthal angle (species 1 rotated by phirot)
+  std::vector<Double_t> fTrackPx[2];    //! px
+  std::vector<Double_t> fTrackPy[2];    //! py
+  std::vector<Double_t> fTrackPz[2];    //! pz
+  std::vector<Double_t> fTrackE[2];     //! energy
+
+  std::vector<Int_t>    fPairTrack;     //! partner (index in species 1 arrays)
+  std::vector<Double_t> fPairSign;      //! -1 for swapped pairs, +1 otherwise
+  std::vector<Double_t> fPairKt;        //! half of pair pt
+  std::vector<Double_t> fPairY;         //! pair rapidity
+  std::vector<Double_t> fPairPhi;       //! pair azimuth
+  std::vector<Double_t> fPairDTheta;    //! theta1-theta0
+  std::vector<Double_t> fPairDPhi;      //! phi1-phi0
+  std::vector<Double_t> fPairQCM;       //! |p1-p0| in pair c.m.s. (for Coulomb)
+  std::vector<Double_t> fPairQ;         //! |p1-p0| in analysis frame
+  std::vector<Double_t> fPairQTheta;    //! polar angle of Q in analysis frame
+  std::vector<Double_t> fPairQPhiOut;   //! azimuthal angle of Q w.r.t. out
+
+  ClassDef(AliUnicorAnalCorrel,2)
 };
 //=============================================================================
 #endif
@@ -24,6 +24,8 @@
 //=============================================================================
 
 #include <cmath>
+#include <cstdarg>
+#include <algorithm>
 #include <stdlib.h>
 #include <TFile.h>
 #include <TDirectory.h>
@@ -40,7 +42,7 @@ ClassImp(AliUnicorHN)
 //=============================================================================
 AliUnicorHN::AliUnicorHN(const char *nam, Int_t ndim, TAxis **ax) 
   : TH1D(nam, nam, Albins(ndim,ax), 0.5, Albins(ndim,ax)+0.5), 
-    fNdim(ndim) {
+    fNdim(ndim), fAxisCacheReady(kFALSE), fBinBuffer() {
 
   // constructor
  
@@ -58,6 +60,7 @@ AliUnicorHN::AliUnicorHN(const char *nam, Int_t ndim, TAxis **ax)
   for (int i=0; i<fgkMaxNdim; i++) fNbins[i] = fAxis[i].GetNbins();
   for (int i=0; i<fgkMaxNdim; i++) fMbins[i] = 1;
   for (int i=fNdim-1; i>0; i--) fMbins[i-1] = fMbins[i]*fNbins[i];
+  InitAxisCache();
   printf("   %d-dimensional histogram %s with %d bins created\n",fNdim,nam,GetNbinsX());
 }
 //=============================================================================
@@ -124,15 +127,65 @@ Int_t AliUnicorHN::MulToOne(const Int_t * const k) const {
   return n;
 }
 //=============================================================================
-Int_t AliUnicorHN::MulToOne(Double_t *x) {
+Int_t AliUnicorHN::MulToOne(const Double_t * const x) const {
 
   // Calculate the 1-dim index n from n-dim vector x, representing the 
   // abscissa of the n-dim histogram. The result will be between 0 and 
-  // GetNbinsX()-1. 
+  // GetNbinsX()-1. Return -1 if under- or overflow in any dimension.
 
-  Int_t k[fgkMaxNdim] = {0};
-  for (int i=0; i<fNdim; i++) k[i] = fAxis[i].FindFixBin(x[i])-1;
-  return MulToOne(k);
+  Int_t n = 0;
+  for (int i=0; i<fNdim; i++) n = AddAxisBin(n,i,x[i]);
+  return n;
+}
+//=============================================================================
+void AliUnicorHN::InitAxisCache() const {
+
+  // Copy the axis limits and, for variable bin size axes, the bin edges 
+  // into plain arrays, so that GetAxisBin does not need to go through TAxis. 
+  // Called from the constructor; objects created by streaming get it on 
+  // first use. 
+
+  for (int i=0; i<fgkMaxNdim; i++) {
+    fXmin[i] = fAxis[i].GetXmin();
+    fXmax[i] = fAxis[i].GetXmax();
+    fEdges[i].clear();
+    if (i<fNdim && fAxis[i].IsVariableBinSize()) {
+      const TArrayD *edges = fAxis[i].GetXbins();
+      fEdges[i].assign(edges->GetArray(),edges->GetArray()+edges->GetSize());
+    }
+  }
+  fAxisCacheReady = kTRUE;
+}
+//=============================================================================
+Int_t AliUnicorHN::GetAxisBin(Int_t dim, Double_t x) const {
+
+  // Calculate the index of abscissa x along dimension dim. Valid result will 
+  // be between 0 and fNbins[dim]-1; -1 means under- or overflow (or NaN). 
+  // Same result as TAxis::FindFixBin minus one: direct calculation for 
+  // fixed bin size axes, binary search in the bin edges otherwise. 
+
+  if (!fAxisCacheReady) InitAxisCache();
+  if (!(x>=fXmin[dim] && x<fXmax[dim])) return -1;
+  const std::vector<Double_t> &edges = fEdges[dim];
+  if (edges.empty()) {
+    Int_t k = Int_t(fNbins[dim]*(x-fXmin[dim])/(fXmax[dim]-fXmin[dim]));
+    return k<fNbins[dim]? k : -1;
+  }
+  return std::upper_bound(edges.begin(),edges.end(),x)-edges.begin()-1;
+}
+//=============================================================================
+Int_t AliUnicorHN::AddAxisBin(Int_t n, Int_t dim, Double_t x) const {
+
+  // Add the contribution of abscissa x along dimension dim to the partial 
+  // 1-dim index n. Summing over all dimensions, starting from n=0, gives the 
+  // result of MulToOne. Once -1 (under- or overflow), always -1. This allows 
+  // to calculate the part belonging to the axes which are constant over many 
+  // fills only once. 
+
+  if (n<0) return -1;
+  Int_t k = GetAxisBin(dim,x);
+  if (k<0) return -1;
+  return n+fMbins[dim]*k;
 }
 //=============================================================================
 void AliUnicorHN::OneToMul(Int_t n, Int_t *k) const {
@@ -149,28 +202,72 @@ void AliUnicorHN::OneToMul(Int_t n, Int_t *k) const {
   }
 }
 //=============================================================================
+Int_t AliUnicorHN::FillBin(Int_t n, Double_t w) {
+
+  // Fill the 1-dim index n (0...GetNbinsX()-1) with weigth w. Since n is 
+  // known to be within range, the bin content, errors, and statistics are 
+  // updated directly, without the bin search of TH1::Fill. Return the bin 
+  // number of the 1-dim histogram, or 0 if n is out of range. 
+
+  if (n<0) return 0;
+  Int_t bin = n+1;
+  if (fBuffer) return TH1D::Fill(bin,w);
+  Double_t x = bin; // abscissa of the 1-dim histogram
+  if (!fSumw2.fN && w!=1.0 && !TestBit(TH1::kIsNotW)) Sumw2(); // as in TH1::Fill
+  fEntries++;
+  AddBinContent(bin,w);
+  if (fSumw2.fN) fSumw2.fArray[bin] += w*w;
+  fTsumw   += w;
+  fTsumw2  += w*w;
+  fTsumwx  += w*x;
+  fTsumwx2 += w*x*x;
+  return bin;
+}
+//=============================================================================
 Int_t AliUnicorHN::Fill(Double_t *xx, Double_t w) {
 
   // Fill the histogram. The array xx holds the abscissa information, w is the 
-  // weigth. The 1-dim histogram is filled using the standard Fill method 
-  // (direct access to the arrays was tried and was not faster). 
+  // weigth. 
 
-  int nbin = MulToOne(xx);
-  if (nbin == -1) return 0;
-  return TH1D::Fill(nbin+1,w); 
+  return FillBin(MulToOne(xx),w);
 }
 //=============================================================================
 Int_t AliUnicorHN::Fill(Double_t x0, Double_t x1, ...) {
 
   // Fill the histogram. Arguments are passed as doubles rather than array. 
+  // The 1-dim index is accumulated while reading the arguments. 
 
   va_list ap;
-  Double_t xx[fgkMaxNdim] = {x0, x1};
   va_start(ap,x1);
-  for (int i=2; i<fNdim; i++) xx[i] = va_arg(ap,Double_t);
+  Int_t n = AddAxisBin(0,0,x0);
+  if (fNdim>1) n = AddAxisBin(n,1,x1);
+  for (int i=2; i<fNdim; i++) n = AddAxisBin(n,i,va_arg(ap,Double_t));
   Double_t weigth = va_arg(ap,Double_t);
   va_end(ap);
-  return Fill(xx,weigth);
+  return FillBin(n,weigth);
+}
+//=============================================================================
+Int_t AliUnicorHN::Fill(Int_t n, const Double_t * const *xx, const Double_t *w) {
+
+  // Fill n entries at once. xx[i][k] is the abscissa of entry k along 
+  // dimension i, w[k] its weigth (w=0 means all weigths 1). The 1-dim 
+  // indices are accumulated one axis at a time over all entries. 
+  // Return the number of entries within the histogram range. 
+
+  if (n<=0) return 0;
+  fBinBuffer.assign(n,0);
+  Int_t *bin = &fBinBuffer[0];
+  for (int i=0; i<fNdim; i++) {
+    const Double_t *x = xx[i];
+    for (int k=0; k<n; k++) bin[k] = AddAxisBin(bin[k],i,x[k]);
+  }
+  Int_t nfilled = 0;
+  for (int k=0; k<n; k++) {
+    if (bin[k]<0) continue;
+    FillBin(bin[k], w? w[k] : 1.0);
+    nfilled++;
+  }
+  return nfilled;
 }
 //=============================================================================
 Int_t AliUnicorHN::Save() const {
@@ -11,6 +11,7 @@
 // multidimensional histogram 
 //=============================================================================
 
+#include <vector>
 #include <TH1.h>
 class TH2D;
 class TAxis;
@@ -20,7 +21,8 @@ class AliUnicorHN : public TH1D {
 
  public:
   AliUnicorHN(const char *nam="muhi", Int_t ndim=0, TAxis **ax=0);     // constructor
-  AliUnicorHN(TRootIOCtor *) : TH1D(), fNdim(0) {for (int i=0; i<fgkMaxNdim; i++) fNbins[i]=fMbins[i]=0;}  // default constructor
+  AliUnicorHN(TRootIOCtor *) : TH1D(), fNdim(0), fAxisCacheReady(kFALSE), fBinBuffer() 
+    {for (int i=0; i<fgkMaxNdim; i++) fNbins[i]=fMbins[i]=0;}        // default constructor
   virtual ~AliUnicorHN() {}                                            // destructor
   static AliUnicorHN* Retrieve(const char *filnam, const char *nam);   // read from file
 
@@ -32,6 +34,13 @@ class AliUnicorHN : public TH1D {
   Int_t Fill(Double_t x0, Double_t w)       {Double_t x[1]={x0}; return Fill(x,w);} // 1-dim histo fill
   Int_t Fill(Double_t x0, Double_t x1, ...);// 2 or more dim histo fill
   Int_t Fill(const char*, Double_t)         {return -1;} // overload TH1
+  Int_t Fill(Int_t n, const Double_t * const *xx, const Double_t *w=0); // fill n entries, xx[dim][entry]
+
+  // fill via precomputed 1-dim index (0...GetNbinsX()-1, -1 means outside)
+  Int_t GetAxisBin(Int_t dim, Double_t x) const;                // bin of x along axis dim
+  Int_t GetStride(Int_t dim) const          {return fMbins[dim];}
+  Int_t AddAxisBin(Int_t n, Int_t dim, Double_t x) const;       // add axis dim to partial index n
+  Int_t FillBin(Int_t n, Double_t w=1);                         // fill 1-dim index n
 
   Int_t Save() const;                      // save histo and axis on file 
 
@@ -54,9 +63,17 @@ class AliUnicorHN : public TH1D {
   Int_t              fMbins[fgkMaxNdim];        // {...[fNdim-2]*fNbins[fNdim-1],fNbins[fNdim-1],1}
   static Int_t Albins(Int_t n, TAxis **ax);     // product of nbins of ax[0]...ax[n-1]
   Int_t MulToOne(const Int_t * const k) const;  // calc 1-dim index from n-dim indices
-  Int_t MulToOne(Double_t *x);                  // calc 1-dim index from n-dim vector
+  Int_t MulToOne(const Double_t * const x) const; // calc 1-dim index from n-dim vector
+  void InitAxisCache() const;                   // fill fXmin, fXmax, fEdges from fAxis
+
+  // bin search cache, (re)built from fAxis on first use
+  mutable Bool_t     fAxisCacheReady;           //! cache below is valid
+  mutable Double_t   fXmin[fgkMaxNdim];         //! lower edge of each axis
+  mutable Double_t   fXmax[fgkMaxNdim];         //! upper edge of each axis
+  mutable std::vector<Double_t> fEdges[fgkMaxNdim]; //! bin edges of variable bin size axes, empty otherwise
+  std::vector<Int_t> fBinBuffer;                //! 1-dim indices for Fill(n,xx,w)
 
-  ClassDef(AliUnicorHN,1)
+  ClassDef(AliUnicorHN,2)
 };
 //=============================================================================
 #endif
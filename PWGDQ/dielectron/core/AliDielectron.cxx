@@ -48,6 +48,8 @@ The names are available via the function PairClassName(Int_t i)
 #include <TObject.h>
 #include <TGrid.h>
 
+#include <vector>
+
 #include <AliKFParticle.h>
 
 #include <AliESDInputHandler.h>
@@ -128,6 +130,7 @@ AliDielectron::AliDielectron() :
   fNoPairing(kFALSE),
   fProcessLS(kTRUE),
   fUseKF(kTRUE),
+  fCacheKFLegs(kFALSE),
   fHistoArray(0x0),
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
@@ -201,6 +204,7 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fNoPairing(kFALSE),
   fProcessLS(kTRUE),
   fUseKF(kTRUE),
+  fCacheKFLegs(kFALSE),
   fHistoArray(0x0),
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
@@ -1391,6 +1395,20 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
   Int_t ntrack1=arrTracks1.GetEntriesFast();
   Int_t ntrack2=arrTracks2.GetEntriesFast();
 
+  //build the KF legs once per track
+  std::vector<AliKFParticle> kfLegs;
+  Int_t kfOffset2=0;
+  if (fCacheKFLegs){
+    kfLegs.reserve(ntrack1+ntrack2);
+    for (Int_t itrack1=0; itrack1<ntrack1; ++itrack1)
+      kfLegs.push_back(AliKFParticle(*static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1)),fPdgLeg1));
+    if (arr1!=arr2 || fPdgLeg1!=fPdgLeg2){
+      kfOffset2=kfLegs.size();
+      for (Int_t itrack2=0; itrack2<ntrack2; ++itrack2)
+        kfLegs.push_back(AliKFParticle(*static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2)),fPdgLeg2));
+    }
+  }
+
   AliDielectronPair *candidate=new AliDielectronPair;
   candidate->SetKFUsage(fUseKF);
 
@@ -1401,8 +1419,13 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
     if (arr1==arr2) end=itrack1;
     for (Int_t itrack2=0; itrack2<end; ++itrack2){
       //create the pair (direct pointer to the memory by this daughter reference are kept also for ME)
-      candidate->SetTracks(&(*static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1))), fPdgLeg1,
-                           &(*static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2))), fPdgLeg2);
+      if (fCacheKFLegs){
+        candidate->SetTracks(static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1)), kfLegs[itrack1],
+                             static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2)), kfLegs[kfOffset2+itrack2]);
+      } else {
+        candidate->SetTracks(&(*static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1))), fPdgLeg1,
+                             &(*static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2))), fPdgLeg2);
+      }
       candidate->SetType(pairIndex);
 
       Int_t label=AliDielectronMC::Instance()->GetLabelMotherWithPdg(candidate,fPdgMother);
@@ -85,6 +85,7 @@ public:
   void SetNoPairing(Bool_t noPairing=kTRUE) { fNoPairing=noPairing; }
   void SetProcessLS(Bool_t doLS=kTRUE) { fProcessLS=doLS; }
   void SetUseKF(Bool_t useKF=kTRUE) { fUseKF=useKF; }
+  void SetCacheKFLegs(Bool_t cache=kTRUE) { fCacheKFLegs=cache; }
   const TObjArray* GetTrackArray(Int_t i) const {return (i>=0&&i<4)?&fTracks[i]:0;}
   const TObjArray* GetPairArray(Int_t i)  const {return (i>=0&&i<11)?
       static_cast<TObjArray*>(fPairCandidates->UncheckedAt(i)):0;}
@@ -217,6 +218,7 @@ private:
   Bool_t fNoPairing;    // if to skip pairing, can be used for track QA only
   Bool_t fProcessLS; // do the like-sign pairing (default kTRUE)
   Bool_t fUseKF;    // if to skip pairing, can be used for track QA only
+  Bool_t fCacheKFLegs;    // build the KF legs once per track instead of once per pair
 
   AliDielectronHF *fHistoArray;   // Histogram framework
   AliDielectronHistos *fHistos;   // Histogram manager
@@ -297,7 +299,7 @@ private:
   AliDielectron(const AliDielectron &c);
   AliDielectron &operator=(const AliDielectron &c);
 
-  ClassDef(AliDielectron,17);
+  ClassDef(AliDielectron,18);
 };
 
 inline void AliDielectron::InitPairCandidateArrays()
@@ -111,13 +111,21 @@ void AliDielectronPair::SetTracks(AliVTrack * const particle1, Int_t pid1,
   // refParticle1 and 2 are the original tracks. In the case of track rotation
   // they are needed in the framework
   //
+  SetTracks(particle1,AliKFParticle(*particle1,pid1),particle2,AliKFParticle(*particle2,pid2));
+}
+
+//______________________________________________
+void AliDielectronPair::SetTracks(AliVTrack * const particle1, const AliKFParticle &kf1,
+                                  AliVTrack * const particle2, const AliKFParticle &kf2)
+{
+  //
+  // Same as above with the AliKF daughters already built from the tracks,
+  // e.g. once per track when looping over many pairs
+  //
   fPair.Initialize();
   fD1.Initialize();
   fD2.Initialize();
 
-  AliKFParticle kf1(*particle1,pid1);
-  AliKFParticle kf2(*particle2,pid2);
-
   fPair.AddDaughter(kf1);
   fPair.AddDaughter(kf2);
 
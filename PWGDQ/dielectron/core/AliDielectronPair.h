@@ -54,6 +54,9 @@ public:
   void SetTracks(AliVTrack * const particle1, Int_t pid1,
                  AliVTrack * const particle2, Int_t pid2);
 
+  void SetTracks(AliVTrack * const particle1, const AliKFParticle &kf1,
+                 AliVTrack * const particle2, const AliKFParticle &kf2);
+
   void SetGammaTracks(AliVTrack * const particle1, Int_t pid1,
 		      AliVTrack * const particle2, Int_t pid2);
 
@@ -90,7 +90,8 @@ AliHFInvMassFitter::AliHFInvMassFitter() :
   fFixSecMass(kFALSE),
   fFixSecWidth(kFALSE),
   fSecFunc(0x0),
-  fTotFunc(0x0)
+  fTotFunc(0x0),
+  fUseDefaultMinimizer(kFALSE)
 {
   /// default constructor
 }
@@ -140,7 +141,8 @@ AliHFInvMassFitter::AliHFInvMassFitter(const TH1F *histoToFit, Double_t minvalue
   fFixSecMass(kFALSE),
   fFixSecWidth(kFALSE),
   fSecFunc(0x0),
-  fTotFunc(0x0)
+  fTotFunc(0x0),
+  fUseDefaultMinimizer(kFALSE)
 {
   /// standard constructor
   fHistoInvMass=(TH1F*)histoToFit->Clone("fHistoInvMass");
@@ -222,7 +224,7 @@ Int_t AliHFInvMassFitter::MassFitter(Bool_t draw){
   /// returns 1 if the fit succeeds
   /// returns 2 if there is no signal and the fit is performed with only background
 
-  TVirtualFitter::SetDefaultFitter("Minuit");
+  if(!fUseDefaultMinimizer) TVirtualFitter::SetDefaultFitter("Minuit");
 
   Double_t integralHisto=fHistoInvMass->Integral(fHistoInvMass->FindBin(fMinMass),fHistoInvMass->FindBin(fMaxMass),"width");
 
@@ -237,7 +239,7 @@ Int_t AliHFInvMassFitter::MassFitter(Bool_t draw){
       status=0;
     }
   }
-  else status=fHistoInvMass->Fit("funcbkgsb",Form("R,%s,+,0",fFitOption.Data()));
+  else status=fHistoInvMass->Fit(fBkgFuncSb,Form("R,%s,+,0",fFitOption.Data()));
   fBkgFuncSb->SetLineColor(kGray+1);
   if (status != 0){
     printf("   ---> Failed first fit with only background, minuit status = %d\n",status);
@@ -281,7 +283,7 @@ Int_t AliHFInvMassFitter::MassFitter(Bool_t draw){
 
   if(doFinalFit){
     printf("\n--- Final fit with signal+background on the full range ---\n");
-    status=fHistoInvMass->Fit("funcmass",Form("R,%s,+,0",fFitOption.Data()));
+    status=fHistoInvMass->Fit(fTotFunc,Form("R,%s,+,0",fFitOption.Data()));
     if (status != 0){
       printf("   ---> Failed fit with signal+background, minuit status = %d\n",status);
       return 0;
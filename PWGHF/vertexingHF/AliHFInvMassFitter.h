@@ -38,6 +38,7 @@ class AliHFInvMassFitter : public TNamed {
   void SetUseLikelihoodWithWeightsFit(){fFitOption="WL,E";}
   void SetUseChi2Fit(){fFitOption="E";}
   void SetFitOption(TString opt){fFitOption=opt.Data();};
+  void SetUseDefaultMinimizer(Bool_t opt=kTRUE){fUseDefaultMinimizer=opt;}
   void SetParticlePdgMass(Double_t mass){fMassParticle=mass;}
   Double_t GetParticlePdgMass(){return fMassParticle;}
   void SetPolDegreeForBackgroundFit(Int_t deg){
@@ -185,9 +186,10 @@ class AliHFInvMassFitter : public TNamed {
   Bool_t    fFixSecWidth;      /// flag to fix the width of the 2nd peak
   TF1*      fSecFunc;          /// fit function for second peak
   TF1*      fTotFunc;          /// total fit function
+  Bool_t    fUseDefaultMinimizer; /// kTRUE = do not force TMinuit, use ROOT default minimizer (needed for concurrent fits)
 
   /// \cond CLASSIMP     
-  ClassDef(AliHFInvMassFitter,3); /// class for invariant mass fit
+  ClassDef(AliHFInvMassFitter,4); /// class for invariant mass fit
   /// \endcond
 };
 
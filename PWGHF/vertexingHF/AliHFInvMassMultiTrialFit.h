@@ -87,6 +87,7 @@ class AliHFInvMassMultiTrialFit : public TNamed {
   void SetSaveBkgValue(Bool_t opt=kTRUE, Double_t nsigma=3) {fSaveBkgVal=opt; fnSigmaForBkgEval=nsigma;}
 
   void SetDrawIndividualFits(Bool_t opt=kTRUE){fDrawIndividualFits=opt;}
+  void SetNumberOfThreads(Int_t nthr){fNThreads=nthr;}
 
   Bool_t DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad=0x0);
   void SaveToRoot(TString fileName, TString option="recreate") const;
@@ -114,6 +115,11 @@ class AliHFInvMassMultiTrialFit : public TNamed {
   TH1F* RebinHisto(TH1D* hOrig, Int_t reb, Int_t firstUse) const;
   Bool_t DoFitWithPol3Bkg(TH1F* histoToFit, Double_t  hmin, Double_t  hmax,
 			  Int_t theCase);
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+  struct TrialFit;
+  void FitTrials(std::vector<TrialFit>& trials, TH1D* hInvMassHisto, Bool_t keepFitters) const;
+  void FitTrial(TrialFit& trial, TH1D* hInvMassHisto, Bool_t keepFitter, Bool_t concurrent) const;
+#endif
 
   AliHFInvMassMultiTrialFit(const AliHFInvMassMultiTrialFit &source);
   AliHFInvMassMultiTrialFit& operator=(const AliHFInvMassMultiTrialFit& source);
@@ -197,9 +203,10 @@ class AliHFInvMassMultiTrialFit : public TNamed {
   Double_t fMaxYieldGlob;   /// maximum yield
 
   std::vector<AliHFInvMassFitter*> fMassFitters; //!<! Mass fitters
+  Int_t fNThreads;       /// number of threads for the fits (1 = serial, >1 needs ROOT6 and uses Minuit2)
 
   /// \cond CLASSIMP
-  ClassDef(AliHFInvMassMultiTrialFit,2); /// class for multiple trials of invariant mass fit
+  ClassDef(AliHFInvMassMultiTrialFit,3); /// class for multiple trials of invariant mass fit
   /// \endcond
 };
 
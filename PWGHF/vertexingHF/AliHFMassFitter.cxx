@@ -80,7 +80,8 @@ AliHFMassFitter::AliHFMassFitter() :
   fcounter(0),
   fNpfits(0),
   fFitOption("L,E"),
-  fContourGraph(0)
+  fContourGraph(0),
+  fUseDefaultMinimizer(kFALSE)
 {
   // default constructor
 
@@ -120,7 +121,8 @@ AliHFMassFitter::AliHFMassFitter (const TH1F *histoToFit, Double_t minvalue, Dou
  fcounter(0),
  fNpfits(0),
  fFitOption("L,E"),
- fContourGraph(0)
+ fContourGraph(0),
+ fUseDefaultMinimizer(kFALSE)
 {
   // standard constructor
 
@@ -178,7 +180,8 @@ AliHFMassFitter::AliHFMassFitter(const AliHFMassFitter &mfit):
   fcounter(mfit.fcounter),
   fNpfits(mfit.fNpfits),
   fFitOption(mfit.fFitOption),
-  fContourGraph(mfit.fContourGraph)
+  fContourGraph(mfit.fContourGraph),
+  fUseDefaultMinimizer(mfit.fUseDefaultMinimizer)
 {
   //copy constructor
 
@@ -239,6 +242,7 @@ AliHFMassFitter& AliHFMassFitter::operator=(const AliHFMassFitter &mfit){
   fcounter= mfit.fcounter;
   fNpfits = mfit.fNpfits;
   fContourGraph= mfit.fContourGraph;
+  fUseDefaultMinimizer= mfit.fUseDefaultMinimizer;
 
   if(mfit.fParsSize > 0){
     delete[] fFitPars;
@@ -947,7 +951,7 @@ Bool_t AliHFMassFitter::MassFitter(Bool_t draw){
   // Main method of the class: performs the fit of the histogram
 
   //Set default fitter Minuit in order to use gMinuit in the contour plots    
-  TVirtualFitter::SetDefaultFitter("Minuit");
+  if(!fUseDefaultMinimizer) TVirtualFitter::SetDefaultFitter("Minuit");
 
 
   Bool_t isBkgOnly=kFALSE;
@@ -1072,7 +1076,7 @@ Bool_t AliHFMassFitter::MassFitter(Bool_t draw){
   //if only signal and reflection: skip
   if (!(ftypeOfFit4Bkg==3 && ftypeOfFit4Sgn==1)) {
     ftypeOfFit4Sgn=0;
-    fhistoInvMass->Fit(bkgname.Data(),Form("R,%s,0",fFitOption.Data()));
+    fhistoInvMass->Fit(funcbkg,Form("R,%s,0",fFitOption.Data()));
 
     for(Int_t i=0;i<bkgPar;i++){
       fFitPars[i]=funcbkg->GetParameter(i);
@@ -1155,7 +1159,7 @@ Bool_t AliHFMassFitter::MassFitter(Bool_t draw){
     //cout<<"Parameters set to: "<<0.5*(totInt-intbkg1)<<"\t"<<fMass<<"\t"<<ffactor*fSigmaSgn<<"\t"<<intbkg1<<"\t"<<slope1<<"\t"<<conc1<<"\t"<<endl;
     //cout<<"Limits: ("<<fminMass<<","<<fmaxMass<<")\tnPar = "<<bkgPar<<"\tgsidebands = "<<fSideBands<<endl;
 
-    Int_t status=fhistoInvMass->Fit(bkg1name.Data(),Form("R,%s,+,0",fFitOption.Data()));
+    Int_t status=fhistoInvMass->Fit(funcbkg1,Form("R,%s,+,0",fFitOption.Data()));
     if (status != 0){
       cout<<"Minuit returned "<<status<<endl;
       return kFALSE;
@@ -1270,7 +1274,7 @@ Bool_t AliHFMassFitter::MassFitter(Bool_t draw){
 
   Int_t status;
 
-  status = fhistoInvMass->Fit(massname.Data(),Form("R,%s,+,0",fFitOption.Data()));
+  status = fhistoInvMass->Fit(funcmass,Form("R,%s,+,0",fFitOption.Data()));
   if (status != 0){
     cout<<"Minuit returned "<<status<<endl;
     return kFALSE;
@@ -1424,7 +1428,7 @@ Bool_t AliHFMassFitter::RefitWithBkgOnly(Bool_t draw){
   }
 
 
-  Int_t status=fhistoInvMass->Fit(bkgname.Data(),Form("R,%s,+,0",fFitOption.Data()));
+  Int_t status=fhistoInvMass->Fit(funcbkg,Form("R,%s,+,0",fFitOption.Data()));
   if (status != 0){
     cout<<"Minuit returned "<<status<<endl;
     return kFALSE;
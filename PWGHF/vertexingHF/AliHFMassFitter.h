@@ -128,6 +128,9 @@ class AliHFMassFitter : public TNamed {
   void SetUseLikelihoodWithWeightsFit(){fFitOption="WL,E";}
   void SetUseChi2Fit(){fFitOption="E";}
   void SetFitOption(TString opt){fFitOption=opt.Data();};
+  /// keep the current default minimizer instead of forcing TMinuit in MassFitter
+  /// (needed when fits run concurrently, TMinuit being a global)
+  void SetUseDefaultMinimizer(Bool_t opt=kTRUE){fUseDefaultMinimizer=opt;}
 
 
  protected:
@@ -168,9 +171,10 @@ class AliHFMassFitter : public TNamed {
   Int_t     fNpfits;           /// Number of points used in the fit
   TString   fFitOption;        /// L, LW or Chi2
   TList*    fContourGraph;     /// TList of TGraph containing contour plots
+  Bool_t    fUseDefaultMinimizer; /// kTRUE = do not force TMinuit as default fitter
 
   /// \cond CLASSIMP     
-  ClassDef(AliHFMassFitter,9); /// class for invariant mass fit
+  ClassDef(AliHFMassFitter,10); /// class for invariant mass fit
   /// \endcond
 };
 
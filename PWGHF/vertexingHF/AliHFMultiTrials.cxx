@@ -22,6 +22,13 @@
 #include <TF1.h>
 #include <TLatex.h>
 #include <TFile.h>
+#include <RVersion.h>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+#include <TROOT.h>
+#include <Math/MinimizerOptions.h>
+#include <atomic>
+#include <thread>
+#endif
 #include "AliHFMassFitter.h"
 #include "AliHFMassFitterVAR.h"
 #include "AliHFMultiTrials.h"
@@ -90,7 +97,8 @@ AliHFMultiTrials::AliHFMultiTrials() :
   fNtupleMultiTrials(0x0),
   fMinYieldGlob(0),
   fMaxYieldGlob(0),
-  fMassFitters()
+  fMassFitters(),
+  fNThreads(1)
 {
   // constructor
   Int_t rebinStep[4]={3,4,5,6};
@@ -186,6 +194,43 @@ Bool_t AliHFMultiTrials::CreateHistos(){
 
 }
 
+/// Configuration of a single fit of the multi-trial scan and its results.
+/// Trials are enumerated up front so that they can be fitted concurrently
+/// and merged into the output objects in the original scan order.
+struct AliHFMultiTrials::TrialFit {
+  TH1F* fHisto;               // rebinned histogram, shared between trials (read only)
+  Int_t fRebin;               // rebin factor
+  Int_t fFirstBin;            // first bin used in the rebin
+  Double_t fMinMassForFit;    // configured lower fit limit
+  Double_t fMaxMassForFit;    // configured upper fit limit
+  Double_t fHmin;             // lower fit limit within the histogram range
+  Double_t fHmax;             // upper fit limit within the histogram range
+  Int_t fTypeb;               // background function case
+  Int_t fIgs;                 // sigma/mean configuration case
+  Int_t fTrial;               // trial number within the case
+  Int_t fCase;                // background x sigma/mean case
+  Int_t fGlobBin;             // bin in the histograms of all trials
+  Bool_t fAccepted;           // fit converged and passed the quality cuts
+  Float_t fXnt[15];           // ntuple entry
+  Double_t fChisq;
+  Double_t fSigma;
+  Double_t fESigma;
+  Double_t fPos;
+  Double_t fEPos;
+  Double_t fRy;
+  Double_t fERy;
+  Double_t fSignif;
+  Double_t fESignif;
+  Double_t fBkg;
+  Double_t fEBkg;
+  Double_t fBkgBEdge;
+  Double_t fEBkgBEdge;
+  std::vector<Int_t> fBinCStep;  // bin counting steps within the histogram range
+  std::vector<Double_t> fCnts;   // bin counting yields
+  std::vector<Double_t> fECnts;  // bin counting uncertainties
+  AliHFMassFitterVAR* fFitter;   // fitter kept for drawing, 0x0 otherwise
+};
+
 //________________________________________________________________________
 Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
   // perform the multiple fits
@@ -194,20 +239,22 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
   if(!hOK) return kFALSE;
 
   Int_t itrial=0;
-  Int_t types=0;
   Int_t itrialBC=0;
   Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
 
   fMinYieldGlob=999999.;
   fMaxYieldGlob=0.;
-  Float_t xnt[15];
 
+  // enumerate the fit configurations, rebinning the input once per (rebin, first bin)
+  std::vector<TH1F*> rebinned;
+  std::vector<TrialFit> trials;
   for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
     Int_t rebin=fRebinSteps[ir];
     for(Int_t iFirstBin=1; iFirstBin<=fNumOfFirstBinSteps; iFirstBin++) {
       TH1F* hRebinned=0x0;
       if(fNumOfFirstBinSteps==1) hRebinned=RebinHisto(hInvMassHisto,rebin,-1);
       else hRebinned=RebinHisto(hInvMassHisto,rebin,iFirstBin);
+      rebinned.push_back(hRebinned);
       for(Int_t iMinMass=0; iMinMass<fNumOfLowLimFitSteps; iMinMass++){
         Double_t minMassForFit=fLowLimFitSteps[iMinMass];
         Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
@@ -231,208 +278,280 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
               if (igs==kFreeSigFreeMean  && !fUseFreeS) continue;
               if (igs==kFixSigFreeMean  && !fUseFixSigFreeMean) continue;
               if (igs==kFixSigFixMean   && !fUseFixSigFixMean) continue;
-              Int_t theCase=igs*kNBkgFuncCases+typeb;
-              Int_t globBin=itrial+theCase*totTrials;
-              for(Int_t j=0; j<15; j++) xnt[j]=0.;
-
-              Bool_t mustDeleteFitter = kTRUE;
-              AliHFMassFitterVAR*  fitter=0x0;
-              //if D0 Reflection
-              if(fhTemplRefl){
-                fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
-                fitter->SetTemplateReflections(fhTemplRefl);
-                fitter->SetFixReflOverS(fFixRefloS,kTRUE);
-              }
-              else {
-                if(typeb<=kPol2Bkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
-                }else if(typeb==kPowBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);
-                }else if(typeb==kPowTimesExpoBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
-                }else{
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
-                  if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
-                  if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
-                  if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
-                }
-                fitter->SetReflectionSigmaFactor(0);
-              }
-              if(fFitOption==1) fitter->SetUseChi2Fit();
-              fitter->SetInitialGaussianMean(fMassD);
-              fitter->SetInitialGaussianSigma(fSigmaGausMC);
-              xnt[0]=rebin;
-              xnt[1]=iFirstBin;
-              xnt[2]=minMassForFit;
-              xnt[3]=maxMassForFit;
-              xnt[4]=typeb;
-              xnt[6]=0;
-              if(igs==kFixSigFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-                xnt[5]=1;
-              }else if(igs==kFixSigUpFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
-                xnt[5]=2;
-              }else if(igs==kFixSigDownFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
-                xnt[5]=3;
-              }else if(igs==kFreeSigFreeMean){
-                xnt[5]=0;
-              }else if(igs==kFixSigFixMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
-                xnt[5]=1;
-                xnt[6]=1;
-              }else if(igs==kFreeSigFixMean){
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
-                xnt[5]=0;
-                xnt[6]=1;
-              }
-              Bool_t out=kFALSE;
-              Double_t chisq=-1.;
-              Double_t sigma=0.;
-              Double_t esigma=0.;
-              Double_t pos=.0;
-              Double_t epos=.0;
-              Double_t ry=.0;
-              Double_t ery=.0;
-              Double_t significance=0.;
-              Double_t erSignif=0.;
-              Double_t bkg=0.;
-              Double_t erbkg=0.;
-              Double_t bkgBEdge=0;
-              Double_t erbkgBEdge=0;
-              TF1* fB1=0x0;
-              if(typeb<kNBkgFuncCases){
-                printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),rebin,iFirstBin,minMassForFit,maxMassForFit,typeb,igs);
-                out=fitter->MassFitter(0);
-                chisq=fitter->GetReducedChiSquare();
-                fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
-                sigma=fitter->GetSigma();
-                pos=fitter->GetMean();
-                esigma=fitter->GetSigmaUncertainty();
-                if(esigma<0.00001) esigma=0.0001;
-                epos=fitter->GetMeanUncertainty();
-                if(epos<0.00001) epos=0.0001;
-                ry=fitter->GetRawYield();
-                ery=fitter->GetRawYieldError();
-                fB1=fitter->GetBackgroundFullRangeFunc();
-                fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
-                Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
-                Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
-                fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
-                if(out && fDrawIndividualFits && thePad){
-                  thePad->Clear();
-                  fitter->DrawHere(thePad, fnSigmaForBkgEval);
-                  fMassFitters.push_back(fitter);
-                  mustDeleteFitter = kFALSE;
-                  for (auto format : fInvMassFitSaveAsFormats) {
-                    thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
-                  }
-                }
-              }
-              // else{
-              //   out=DoFitWithPol3Bkg(hRebinned,hmin,hmax,igs);
-              //   if(out && thePad){
-              // 	thePad->Clear();
-              // 	hRebinned->Draw();
-              // 	TF1* fSB=(TF1*)hRebinned->GetListOfFunctions()->FindObject("fSB");
-              // 	fB1=new TF1("fB1","[0]+[1]*x+[2]*x*x+[3]*x*x*x",hmin,hmax);
-              // 	for(Int_t j=0; j<4; j++) fB1->SetParameter(j,fSB->GetParameter(3+j));
-              // 	fB1->SetLineColor(2);
-              // 	fB1->Draw("same");
-              // 	fSB->SetLineColor(4);
-              // 	fSB->Draw("same");
-              // 	thePad->Update();
-              // 	chisq=fSB->GetChisquare()/fSB->GetNDF();;
-              // 	sigma=fSB->GetParameter(2);
-              // 	esigma=fSB->GetParError(2);
-              // 	if(esigma<0.00001) esigma=0.0001;
-              // 	pos=fSB->GetParameter(1);
-              // 	epos=fSB->GetParError(1);
-              // 	if(epos<0.00001) epos=0.0001;
-              // 	ry=fSB->GetParameter(0)/hRebinned->GetBinWidth(1);
-              // 	ery=fSB->GetParError(0)/hRebinned->GetBinWidth(1);
-              //   }
-              // }
-              xnt[7]=chisq;
-              if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
-                xnt[8]=significance;
-                xnt[9]=pos;
-                xnt[10]=epos;
-                xnt[11]=sigma;
-                xnt[12]=esigma;
-                xnt[13]=ry;
-                xnt[14]=ery;
-                fHistoRawYieldDistAll->Fill(ry);
-                fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
-                fHistoRawYieldTrialAll->SetBinError(globBin,ery);
-                fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
-                fHistoSigmaTrialAll->SetBinError(globBin,esigma);
-                fHistoMeanTrialAll->SetBinContent(globBin,pos);
-                fHistoMeanTrialAll->SetBinError(globBin,epos);
-                fHistoChi2TrialAll->SetBinContent(globBin,chisq);
-                fHistoChi2TrialAll->SetBinError(globBin,0.00001);
-                fHistoSignifTrialAll->SetBinContent(globBin,significance);
-                fHistoSignifTrialAll->SetBinError(globBin,erSignif);
-                if(fSaveBkgVal) {
-                  fHistoBkgTrialAll->SetBinContent(globBin,bkg);
-                  fHistoBkgTrialAll->SetBinError(globBin,erbkg);
-                  fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,bkgBEdge);
-                  fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,erbkgBEdge);
-                }
-
-                if(ry<fMinYieldGlob) fMinYieldGlob=ry;
-                if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
-                fHistoRawYieldDist[theCase]->Fill(ry);
-                fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
-                fHistoRawYieldTrial[theCase]->SetBinError(itrial,ery);
-                fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
-                fHistoSigmaTrial[theCase]->SetBinError(itrial,esigma);
-                fHistoMeanTrial[theCase]->SetBinContent(itrial,pos);
-                fHistoMeanTrial[theCase]->SetBinError(itrial,epos);
-                fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
-                fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
-                fHistoSignifTrial[theCase]->SetBinContent(itrial,significance);
-                fHistoSignifTrial[theCase]->SetBinError(itrial,erSignif);
-                if(fSaveBkgVal) {
-                  fHistoBkgTrial[theCase]->SetBinContent(itrial,bkg);
-                  fHistoBkgTrial[theCase]->SetBinError(itrial,erbkg);
-                  fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,bkgBEdge);
-                  fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,erbkgBEdge);
-                }
-
-                for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
-                  Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
-                  Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
-                  if(minMassBC>minMassForFit &&
-                      maxMassBC<maxMassForFit &&
-                      minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
-                      maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
-                    Double_t cnts,ecnts;
-                    BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,cnts,ecnts);
-                    ++itrialBC;
-                    fHistoRawYieldDistBinCAll->Fill(cnts);
-                    fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
-                    fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,ecnts);
-                    fHistoRawYieldTrialBinC[theCase]->SetBinContent(itrial,iStepBC+1,cnts);
-                    fHistoRawYieldTrialBinC[theCase]->SetBinError(itrial,iStepBC+1,ecnts);
-                    fHistoRawYieldDistBinC[theCase]->Fill(cnts);
-                  }
-                }
-              }
-              if (mustDeleteFitter) delete fitter;
-              fNtupleMultiTrials->Fill(xnt);
+              TrialFit trial;
+              trial.fHisto=hRebinned;
+              trial.fRebin=rebin;
+              trial.fFirstBin=iFirstBin;
+              trial.fMinMassForFit=minMassForFit;
+              trial.fMaxMassForFit=maxMassForFit;
+              trial.fHmin=hmin;
+              trial.fHmax=hmax;
+              trial.fTypeb=typeb;
+              trial.fIgs=igs;
+              trial.fTrial=itrial;
+              trial.fCase=igs*kNBkgFuncCases+typeb;
+              trial.fGlobBin=itrial+trial.fCase*totTrials;
+              trial.fFitter=0x0;
+              trials.push_back(trial);
             }
           }
         }
       }
-      delete hRebinned;
     }
   }
+
+  FitTrials(trials,hInvMassHisto,fDrawIndividualFits && thePad);
+
+  // merge the results in the scan order, so that the output does not depend on the number of threads
+  for(auto& trial : trials){
+    Int_t theCase=trial.fCase;
+    Int_t globBin=trial.fGlobBin;
+    Int_t iTrial=trial.fTrial;
+    if(trial.fFitter){
+      thePad->Clear();
+      trial.fFitter->DrawHere(thePad, fnSigmaForBkgEval);
+      fMassFitters.push_back(trial.fFitter);
+      for (auto format : fInvMassFitSaveAsFormats) {
+        thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
+      }
+    }
+    if(trial.fAccepted){
+      Double_t ry=trial.fRy;
+      fHistoRawYieldDistAll->Fill(ry);
+      fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
+      fHistoRawYieldTrialAll->SetBinError(globBin,trial.fERy);
+      fHistoSigmaTrialAll->SetBinContent(globBin,trial.fSigma);
+      fHistoSigmaTrialAll->SetBinError(globBin,trial.fESigma);
+      fHistoMeanTrialAll->SetBinContent(globBin,trial.fPos);
+      fHistoMeanTrialAll->SetBinError(globBin,trial.fEPos);
+      fHistoChi2TrialAll->SetBinContent(globBin,trial.fChisq);
+      fHistoChi2TrialAll->SetBinError(globBin,0.00001);
+      fHistoSignifTrialAll->SetBinContent(globBin,trial.fSignif);
+      fHistoSignifTrialAll->SetBinError(globBin,trial.fESignif);
+      if(fSaveBkgVal) {
+        fHistoBkgTrialAll->SetBinContent(globBin,trial.fBkg);
+        fHistoBkgTrialAll->SetBinError(globBin,trial.fEBkg);
+        fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,trial.fBkgBEdge);
+        fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,trial.fEBkgBEdge);
+      }
+
+      if(ry<fMinYieldGlob) fMinYieldGlob=ry;
+      if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
+      fHistoRawYieldDist[theCase]->Fill(ry);
+      fHistoRawYieldTrial[theCase]->SetBinContent(iTrial,ry);
+      fHistoRawYieldTrial[theCase]->SetBinError(iTrial,trial.fERy);
+      fHistoSigmaTrial[theCase]->SetBinContent(iTrial,trial.fSigma);
+      fHistoSigmaTrial[theCase]->SetBinError(iTrial,trial.fESigma);
+      fHistoMeanTrial[theCase]->SetBinContent(iTrial,trial.fPos);
+      fHistoMeanTrial[theCase]->SetBinError(iTrial,trial.fEPos);
+      fHistoChi2Trial[theCase]->SetBinContent(iTrial,trial.fChisq);
+      fHistoChi2Trial[theCase]->SetBinError(iTrial,0.00001);
+      fHistoSignifTrial[theCase]->SetBinContent(iTrial,trial.fSignif);
+      fHistoSignifTrial[theCase]->SetBinError(iTrial,trial.fESignif);
+      if(fSaveBkgVal) {
+        fHistoBkgTrial[theCase]->SetBinContent(iTrial,trial.fBkg);
+        fHistoBkgTrial[theCase]->SetBinError(iTrial,trial.fEBkg);
+        fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(iTrial,trial.fBkgBEdge);
+        fHistoBkgInBinEdgesTrial[theCase]->SetBinError(iTrial,trial.fEBkgBEdge);
+      }
+
+      for(UInt_t jBC=0; jBC<trial.fBinCStep.size(); jBC++){
+        Int_t iStepBC=trial.fBinCStep[jBC];
+        Double_t cnts=trial.fCnts[jBC];
+        Double_t ecnts=trial.fECnts[jBC];
+        ++itrialBC;
+        fHistoRawYieldDistBinCAll->Fill(cnts);
+        fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
+        fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,ecnts);
+        fHistoRawYieldTrialBinC[theCase]->SetBinContent(iTrial,iStepBC+1,cnts);
+        fHistoRawYieldTrialBinC[theCase]->SetBinError(iTrial,iStepBC+1,ecnts);
+        fHistoRawYieldDistBinC[theCase]->Fill(cnts);
+      }
+    }
+    fNtupleMultiTrials->Fill(trial.fXnt);
+  }
+  for (auto hRebinned : rebinned) delete hRebinned;
   return kTRUE;
 }
 
+//________________________________________________________________________
+void AliHFMultiTrials::FitTrials(std::vector<TrialFit>& trials, TH1D* hInvMassHisto, Bool_t keepFitters) const{
+  // run the fits of all trials, serially or on fNThreads worker threads
+  // the concurrent mode needs ROOT6: TMinuit is a global object, hence
+  // the workers use Minuit2 and ROOT is switched to thread-safe mode
+
+  Int_t nTrials=trials.size();
+  Int_t nThreads=TMath::Min(fNThreads,nTrials);
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+  if(nThreads>1){
+    printf("Fitting %d trials on %d threads\n",nTrials,nThreads);
+    ROOT::EnableThreadSafety();
+    std::string prevMinimizer=ROOT::Math::MinimizerOptions::DefaultMinimizerType();
+    std::string prevAlgo=ROOT::Math::MinimizerOptions::DefaultMinimizerAlgo();
+    ROOT::Math::MinimizerOptions::SetDefaultMinimizer("Minuit2");
+    Bool_t addDir=TH1::AddDirectoryStatus();
+    TH1::AddDirectory(kFALSE);
+    std::atomic<Int_t> next(0);
+    std::vector<std::thread> workers;
+    for(Int_t ith=0; ith<nThreads; ith++){
+      workers.emplace_back([&](){
+        for(Int_t it=next++; it<nTrials; it=next++) FitTrial(trials[it],hInvMassHisto,keepFitters,kTRUE);
+      });
+    }
+    for(auto& worker : workers) worker.join();
+    TH1::AddDirectory(addDir);
+    ROOT::Math::MinimizerOptions::SetDefaultMinimizer(prevMinimizer.c_str(),prevAlgo.c_str());
+    return;
+  }
+#else
+  if(nThreads>1) printf("Concurrent fits need ROOT >= 6.06, fitting %d trials serially\n",nTrials);
+#endif
+  for(auto& trial : trials) FitTrial(trial,hInvMassHisto,keepFitters,kFALSE);
+}
+
+//________________________________________________________________________
+void AliHFMultiTrials::FitTrial(TrialFit& trial, TH1D* hInvMassHisto, Bool_t keepFitter, Bool_t concurrent) const{
+  // fit one configuration, filling the results of the trial
+  // only the trial and its own fitter are modified, so that this can run on a worker thread
+
+  const Int_t types=0;
+  TH1F* hRebinned=trial.fHisto;
+  Int_t typeb=trial.fTypeb;
+  Int_t igs=trial.fIgs;
+  Double_t hmin=trial.fHmin;
+  Double_t hmax=trial.fHmax;
+  Float_t* xnt=trial.fXnt;
+  for(Int_t j=0; j<15; j++) xnt[j]=0.;
+
+  AliHFMassFitterVAR*  fitter=0x0;
+  //if D0 Reflection
+  if(fhTemplRefl){
+    fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
+    fitter->SetTemplateReflections(fhTemplRefl);
+    fitter->SetFixReflOverS(fFixRefloS,kTRUE);
+  }
+  else {
+    if(typeb<=kPol2Bkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
+    }else if(typeb==kPowBkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);
+    }else if(typeb==kPowTimesExpoBkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
+    }else{
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
+      if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
+      if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
+      if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
+    }
+    fitter->SetReflectionSigmaFactor(0);
+  }
+  if(concurrent) fitter->SetUseDefaultMinimizer(kTRUE);
+  if(fFitOption==1) fitter->SetUseChi2Fit();
+  fitter->SetInitialGaussianMean(fMassD);
+  fitter->SetInitialGaussianSigma(fSigmaGausMC);
+  xnt[0]=trial.fRebin;
+  xnt[1]=trial.fFirstBin;
+  xnt[2]=trial.fMinMassForFit;
+  xnt[3]=trial.fMaxMassForFit;
+  xnt[4]=typeb;
+  xnt[6]=0;
+  if(igs==kFixSigFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+    xnt[5]=1;
+  }else if(igs==kFixSigUpFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
+    xnt[5]=2;
+  }else if(igs==kFixSigDownFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
+    xnt[5]=3;
+  }else if(igs==kFreeSigFreeMean){
+    xnt[5]=0;
+  }else if(igs==kFixSigFixMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+    fitter->SetFixGaussianMean(fMassD,kTRUE);
+    xnt[5]=1;
+    xnt[6]=1;
+  }else if(igs==kFreeSigFixMean){
+    fitter->SetFixGaussianMean(fMassD,kTRUE);
+    xnt[5]=0;
+    xnt[6]=1;
+  }
+  Bool_t out=kFALSE;
+  Double_t chisq=-1.;
+  Double_t sigma=0.;
+  Double_t esigma=0.;
+  Double_t pos=.0;
+  Double_t epos=.0;
+  Double_t ry=.0;
+  Double_t ery=.0;
+  Double_t significance=0.;
+  Double_t erSignif=0.;
+  Double_t bkg=0.;
+  Double_t erbkg=0.;
+  Double_t bkgBEdge=0;
+  Double_t erbkgBEdge=0;
+  TF1* fB1=0x0;
+  if(typeb<kNBkgFuncCases){
+    printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),trial.fRebin,trial.fFirstBin,trial.fMinMassForFit,trial.fMaxMassForFit,typeb,igs);
+    out=fitter->MassFitter(0);
+    chisq=fitter->GetReducedChiSquare();
+    fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
+    sigma=fitter->GetSigma();
+    pos=fitter->GetMean();
+    esigma=fitter->GetSigmaUncertainty();
+    if(esigma<0.00001) esigma=0.0001;
+    epos=fitter->GetMeanUncertainty();
+    if(epos<0.00001) epos=0.0001;
+    ry=fitter->GetRawYield();
+    ery=fitter->GetRawYieldError();
+    fB1=fitter->GetBackgroundFullRangeFunc();
+    fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
+    Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
+    Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
+    fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
+  }
+  xnt[7]=chisq;
+  trial.fAccepted=(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC);
+  trial.fChisq=chisq;
+  trial.fSigma=sigma;
+  trial.fESigma=esigma;
+  trial.fPos=pos;
+  trial.fEPos=epos;
+  trial.fRy=ry;
+  trial.fERy=ery;
+  trial.fSignif=significance;
+  trial.fESignif=erSignif;
+  trial.fBkg=bkg;
+  trial.fEBkg=erbkg;
+  trial.fBkgBEdge=bkgBEdge;
+  trial.fEBkgBEdge=erbkgBEdge;
+  if(trial.fAccepted){
+    xnt[8]=significance;
+    xnt[9]=pos;
+    xnt[10]=epos;
+    xnt[11]=sigma;
+    xnt[12]=esigma;
+    xnt[13]=ry;
+    xnt[14]=ery;
+    for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+      Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
+      Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
+      if(minMassBC>trial.fMinMassForFit &&
+          maxMassBC<trial.fMaxMassForFit &&
+          minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
+          maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
+        Double_t cnts,ecnts;
+        BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,cnts,ecnts);
+        trial.fBinCStep.push_back(iStepBC);
+        trial.fCnts.push_back(cnts);
+        trial.fECnts.push_back(ecnts);
+      }
+    }
+  }
+  if(out && keepFitter) trial.fFitter=fitter;
+  else delete fitter;
+}
+
 //________________________________________________________________________
 void AliHFMultiTrials::SaveToRoot(TString fileName, TString option) const{
   // save histos in a root file for further analysis
@@ -85,6 +85,7 @@ class AliHFMultiTrials : public TNamed {
   void SetSaveBkgValue(Bool_t opt=kTRUE, Double_t nsigma=3) {fSaveBkgVal=opt; fnSigmaForBkgEval=nsigma;}
 
   void SetDrawIndividualFits(Bool_t opt=kTRUE){fDrawIndividualFits=opt;}
+  void SetNumberOfThreads(Int_t nthr){fNThreads=nthr;}
 
   Bool_t DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad=0x0);
   void SaveToRoot(TString fileName, TString option="recreate") const;
@@ -107,6 +108,11 @@ class AliHFMultiTrials : public TNamed {
   void BinCount(TH1F* h, TF1* fB, Int_t rebin, Double_t minMass, Double_t maxMass, Double_t& count, Double_t& ecount) const;
   Bool_t DoFitWithPol3Bkg(TH1F* histoToFit, Double_t  hmin, Double_t  hmax,
 			  Int_t theCase);
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+  struct TrialFit;
+  void FitTrials(std::vector<TrialFit>& trials, TH1D* hInvMassHisto, Bool_t keepFitters) const;
+  void FitTrial(TrialFit& trial, TH1D* hInvMassHisto, Bool_t keepFitter, Bool_t concurrent) const;
+#endif
 
   AliHFMultiTrials(const AliHFMultiTrials &source);
   AliHFMultiTrials& operator=(const AliHFMultiTrials& source);
@@ -178,9 +184,10 @@ class AliHFMultiTrials : public TNamed {
   Double_t fMaxYieldGlob;   /// maximum yield
 
   std::vector<AliHFMassFitterVAR*> fMassFitters; //!<! Mass fitters
+  Int_t fNThreads;       /// number of threads for the fits (1 = serial, >1 needs ROOT6 and uses Minuit2)
 
   /// \cond CLASSIMP
-  ClassDef(AliHFMultiTrials,5); /// class for multiple trials of invariant mass fit
+  ClassDef(AliHFMultiTrials,6); /// class for multiple trials of invariant mass fit
   /// \endcond
 };
 
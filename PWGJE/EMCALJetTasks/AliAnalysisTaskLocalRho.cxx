@@ -441,7 +441,7 @@ Bool_t AliAnalysisTaskLocalRho::Run()
   } break;
   }
   // if all went well, add local rho
-  fLocalRho->SetLocalRho(fFitModulation);
+  fLocalRho->SetLocalRhoFromModulationFit(fFitModulation, fFitModulationType);
   PostData(1, fOutputList);
   return kTRUE;
 }
@@ -79,7 +79,8 @@ Bool_t AliAnalysisTaskRho::Run()
     }
   }
 
-  static Double_t rhovec[999];
+  if (fRhoValues.size() < static_cast<UInt_t>(Njets))
+    fRhoValues.resize(Njets);
   Int_t NjetAcc = 0;
 
   // push all jets within selected acceptance into stack
@@ -98,14 +99,14 @@ Bool_t AliAnalysisTaskRho::Run()
     if (!AcceptJet(jet))
       continue;
 
-    rhovec[NjetAcc] = jet->Pt() / jet->Area();
+    fRhoValues[NjetAcc] = jet->Pt() / jet->Area();
     ++NjetAcc;
   }
 
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = Median(fRhoValues, NjetAcc);
     fOutRho->SetVal(rho);
 
     if (fOutRhoScaled) {
@@ -5,6 +5,8 @@
 //
 // Author: S.Aiola
 
+#include <algorithm>
+
 #include <TFile.h>
 #include <TF1.h>
 #include <TH1F.h>
@@ -56,7 +58,8 @@ AliAnalysisTaskRhoBase::AliAnalysisTaskRhoBase() :
   fHistDeltaRhovsNtrack(0),
   fHistDeltaRhoScalevsNtrack(0),
   fHistRhovsNcluster(0),
-  fHistRhoScaledvsNcluster(0)
+  fHistRhoScaledvsNcluster(0),
+  fRhoValues()
 {
   // Constructor.
 
@@ -101,7 +104,8 @@ AliAnalysisTaskRhoBase::AliAnalysisTaskRhoBase(const char *name, Bool_t histo) :
   fHistDeltaRhovsNtrack(0),
   fHistDeltaRhoScalevsNtrack(0),
   fHistRhovsNcluster(0),
-  fHistRhoScaledvsNcluster(0)
+  fHistRhoScaledvsNcluster(0),
+  fRhoValues()
 {
   // Constructor.
 
@@ -467,6 +471,26 @@ Double_t AliAnalysisTaskRhoBase::GetScaleFactor(Double_t cent)
   return scale;
 }
 
+//________________________________________________________________________
+Double_t AliAnalysisTaskRhoBase::Median(std::vector<Double_t> &values, Int_t n)
+{
+  // Median of the first n values, same as TMath::Median(n, values) (mean of
+  // the two central values for even n), but with a linear-time selection
+  // and without allocating an index array. The values are reordered.
+
+  if (n <= 0)
+    return 0;
+
+  std::vector<Double_t>::iterator first = values.begin();
+  std::vector<Double_t>::iterator mid = first + n / 2;
+  std::nth_element(first, mid, first + n);
+
+  Double_t median = *mid;
+  if (n % 2 == 0)
+    median = 0.5 * (*std::max_element(first, mid) + median);
+  return median;
+}
+
 //________________________________________________________________________
 TF1* AliAnalysisTaskRhoBase::LoadRhoFunction(const char* path, const char* name)
 {
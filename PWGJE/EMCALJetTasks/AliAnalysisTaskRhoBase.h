@@ -10,6 +10,8 @@ class TH2F;
 class TH3F;
 class AliRhoParameter;
 
+#include <vector>
+
 #include "AliAnalysisTaskEmcalJet.h"
 
 class AliAnalysisTaskRhoBase : public AliAnalysisTaskEmcalJet {
@@ -34,6 +36,8 @@ class AliAnalysisTaskRhoBase : public AliAnalysisTaskEmcalJet {
   const char*            GetOutRhoName() const                                 { return fOutRhoName.Data()       ;                   }
   const char*            GetOutRhoScaledName() const                           { return fOutRhoScaledName.Data() ;                   }
 
+  static Double_t        Median(std::vector<Double_t> &values, Int_t n);
+
  protected:
   void                   ExecOnce();
   Bool_t                 Run();
@@ -80,9 +84,11 @@ class AliAnalysisTaskRhoBase : public AliAnalysisTaskEmcalJet {
   TH2F                  *fHistRhovsNcluster;             //!rho vs. no. of clusters
   TH2F                  *fHistRhoScaledvsNcluster;       //!rhoscaled vs. no. of clusters
 
+  std::vector<Double_t>  fRhoValues;                     //!per-jet (or per-particle) rho values, reused across events
+
   AliAnalysisTaskRhoBase(const AliAnalysisTaskRhoBase&);             // not implemented
   AliAnalysisTaskRhoBase& operator=(const AliAnalysisTaskRhoBase&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoBase, 11); // Rho base task
+  ClassDef(AliAnalysisTaskRhoBase, 12); // Rho base task
 };
 #endif
@@ -45,7 +45,8 @@ AliAnalysisTaskRhoMassBase::AliAnalysisTaskRhoMassBase() :
   fHistDeltaRhoMassScalevsNtrack(0),
   fHistRhoMassvsNcluster(0),
   fHistRhoMassScaledvsNcluster(0),
-  fHistGammaVsNtrack(0)
+  fHistGammaVsNtrack(0),
+  fRhoMassValues()
 {
   // Constructor.
 }
@@ -75,7 +76,8 @@ AliAnalysisTaskRhoMassBase::AliAnalysisTaskRhoMassBase(const char *name, Bool_t
   fHistDeltaRhoMassScalevsNtrack(0),
   fHistRhoMassvsNcluster(0),
   fHistRhoMassScaledvsNcluster(0),
-  fHistGammaVsNtrack(0)
+  fHistGammaVsNtrack(0),
+  fRhoMassValues()
 {
   // Constructor.
 
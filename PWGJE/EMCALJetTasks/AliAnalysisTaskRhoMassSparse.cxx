@@ -12,6 +12,7 @@
 #include <TMath.h>
 
 #include "AliAnalysisManager.h"
+#include "AliAnalysisTaskRhoBase.h"
 #include "AliEmcalJet.h"
 #include "AliLog.h"
 #include "AliRhoParameter.h"
@@ -137,9 +138,10 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     }
   }
 
-  static Double_t rhomvec[999];
-  static Double_t Evec[999];
-  static Double_t Mvec[999];
+  if (fRhoMassValues.size() < static_cast<UInt_t>(Njets))
+    fRhoMassValues.resize(Njets);
+  Double_t sumE = 0;
+  Double_t sumM = 0;
   Int_t NjetAcc = 0;
   Double_t TotaljetArea=0;
   Double_t TotaljetAreaPhys=0;
@@ -194,10 +196,10 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     if(jet->Area()>0.) {// && (jet->M()*jet->M() + jet->Pt()*jet->Pt())>0.) {
        //rhomvec[NjetAcc] = (TMath::Sqrt(sumM*sumM + sumPt*sumPt) - sumPt ) / jet->Area();
       // rhomvec[NjetAcc] = (TMath::Sqrt(jet->M()*jet->M() + jet->Pt()*jet->Pt()) - jet->Pt() ) / jet->Area();
-      rhomvec[NjetAcc] = GetMd(jet) / jet->Area();
-      fHistMdAreavsCent->Fill(fCent,rhomvec[NjetAcc]);
-      Evec[NjetAcc] = jet->E();
-      Mvec[NjetAcc] = jet->M();
+      fRhoMassValues[NjetAcc] = GetMd(jet) / jet->Area();
+      fHistMdAreavsCent->Fill(fCent,fRhoMassValues[NjetAcc]);
+      sumE += jet->E();
+      sumM += jet->M();
       ++NjetAcc;
     }
   }
@@ -211,7 +213,7 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rhom = TMath::Median(NjetAcc, rhomvec);
+    Double_t rhom = AliAnalysisTaskRhoBase::Median(fRhoMassValues, NjetAcc);
     if(fRhoCMS){
       rhom = rhom * OccCorr;
     }
@@ -219,8 +221,8 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     fOutRhoMass->SetVal(rhom);
 
     Int_t Ntracks = fTracks->GetEntries();
-    Double_t meanM = TMath::Mean(NjetAcc, Mvec);
-    Double_t meanE = TMath::Mean(NjetAcc, Evec);
+    Double_t meanM = sumM / NjetAcc;
+    Double_t meanE = sumE / NjetAcc;
     Double_t gamma = 0.;
     if(meanM>0.) gamma = meanE/meanM;
     fHistGammaVsNtrack->Fill(Ntracks,gamma);
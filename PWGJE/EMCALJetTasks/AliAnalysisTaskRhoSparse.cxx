@@ -126,7 +126,8 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
     }
   }
 
-  static Double_t rhovec[999];
+  if (fRhoValues.size() < static_cast<UInt_t>(Njets))
+    fRhoValues.resize(Njets);
   Int_t NjetAcc = 0;
   Double_t TotaljetArea=0;
   Double_t TotaljetAreaPhys=0;
@@ -176,7 +177,7 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
       continue;
 
     if(jet->Pt()>0.1){
-      rhovec[NjetAcc] = jet->Pt() / jet->Area();
+      fRhoValues[NjetAcc] = jet->Pt() / jet->Area();
       ++NjetAcc;
     }
   }
@@ -189,7 +190,7 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = Median(fRhoValues, NjetAcc);
 
     if(fRhoCMS){
       rho = rho * OccCorr;
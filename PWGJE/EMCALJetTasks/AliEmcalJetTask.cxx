@@ -70,6 +70,7 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fUtilities(0),
   fLocked(0),
+  fFillConstituentCache(kFALSE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -105,6 +106,7 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fUtilities(0),
   fLocked(0),
+  fFillConstituentCache(kFALSE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -439,6 +441,7 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
 
   Int_t uid   = -1;
 
+  jet->ResetConstituentCache();
   jet->SetNumberOfTracks(constituents.size());
   jet->SetNumberOfClusters(constituents.size());
 
@@ -522,6 +525,7 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
 
       if (flag == 0 || particlesSubName == "") {
         jet->AddTrackAt(fParticleContainerIndexMap.GlobalIndexFromLocalIndex(partCont, tid), nt);
+        if (fFillConstituentCache) jet->SetTrackConstituentKinematics(nt, t->Pt(), t->Eta(), t->Phi(), t->M(), t->Charge());
       }
       else {
         // Get the particle container and array corresponding to the subtracted particles
@@ -532,6 +536,7 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
         AliEmcalParticle* part_sub = new ((*particles_sub)[part_sub_id]) AliEmcalParticle(dynamic_cast<AliVTrack*>(t));   // SA: probably need to be fixed!!
         part_sub->SetPtEtaPhiM(constituents[ic].perp(),constituents[ic].eta(),constituents[ic].phi(),constituents[ic].m());
         jet->AddTrackAt(fParticleContainerIndexMap.GlobalIndexFromLocalIndex(partCont, part_sub_id), nt);
+        if (fFillConstituentCache) jet->SetTrackConstituentKinematics(nt, part_sub->Pt(), part_sub->Eta(), part_sub->Phi(), part_sub->M(), t->Charge());
       }
 
       ++nt;
@@ -606,6 +611,7 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
   jet->SetMCPt(mcpt);
   jet->SetPtEmc(emcpt);
   jet->SortConstituents();
+  if (fFillConstituentCache) jet->BuildConstituentCache();
 }
 
 /**
@@ -78,6 +78,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetTrackEfficiencyOnlyForEmbedding(Bool_t b) { if (IsLocked()) return; fTrackEfficiencyOnlyForEmbedding = b     ; }
   void                   SetLegacyMode(Bool_t mode)                 { if (IsLocked()) return; fLegacyMode       = mode  ; }
   void                   SetFillGhost(Bool_t b=kTRUE)               { if (IsLocked()) return; fFillGhost        = b     ; }
+  void                   SetFillConstituentCache(Bool_t b=kTRUE)    { if (IsLocked()) return; fFillConstituentCache = b ; }
   void                   SetRadius(Double_t r)                      { if (IsLocked()) return; fRadius           = r     ; }
 
   void                   SetEtaRange(Double_t emi, Double_t ema);
@@ -173,6 +174,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   TObjArray             *fUtilities;              // jet utilities (gen subtractor, constituent subtractor etc.)
   Bool_t                 fTrackEfficiencyOnlyForEmbedding; // Apply aritificial tracking inefficiency only for embedded tracks
   Bool_t                 fLocked;                 // true if lock is set
+  Bool_t                 fFillConstituentCache;   // fill the constituent kinematics cache of the AliEmcalJet objects
 
   TString                fJetsName;               //!name of jet collection
   Bool_t                 fIsInit;                 //!=true if already initialized
@@ -197,7 +199,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 24);
+  ClassDef(AliEmcalJetTask, 25);
   /// \endcond
 };
 #endif
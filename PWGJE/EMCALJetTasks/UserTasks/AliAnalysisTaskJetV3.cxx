@@ -982,7 +982,7 @@ Bool_t AliAnalysisTaskJetV3::Run()
         } break;
     }
     // if all went well, update the local rho parameter
-    fLocalRho->SetLocalRho(fFitModulation);
+    fLocalRho->SetLocalRhoFromModulationFit(fFitModulation, fFitModulationType);
     // and only at this point can the leading jet after rho subtraction be evaluated
     if(fFillQAHistograms) fLeadingJetAfterSub = GetLeadingJet(fLocalRho);
     // fill a number of histograms. event qa needs to be filled first as it also determines the runnumber for the track qa 
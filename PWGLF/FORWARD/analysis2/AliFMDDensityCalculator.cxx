@@ -60,7 +60,20 @@ AliFMDDensityCalculator::AliFMDDensityCalculator()
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fUseRingBatch(true),
+    fRingTableELossFit(0),
+    fStripX(),
+    fStripY(),
+    fSectorZ(),
+    fStripAcc(),
+    fRingCuts(),
+    fRingFitAxis(),
+    fRingFitBins(0),
+    fRingFits(),
+    fRingMaxN(),
+    fBatchValues(),
+    fBatchStrips()
 {
   // 
   // Constructor 
@@ -98,7 +111,20 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const char* title)
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fUseRingBatch(true),
+    fRingTableELossFit(0),
+    fStripX(),
+    fStripY(),
+    fSectorZ(),
+    fStripAcc(),
+    fRingCuts(),
+    fRingFitAxis(),
+    fRingFitBins(0),
+    fRingFits(),
+    fRingMaxN(),
+    fBatchValues(),
+    fBatchStrips()
 {
   // 
   // Constructor 
@@ -167,7 +193,20 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const
     fDoTiming(o.fDoTiming),
     fHTiming(o.fHTiming), 
   fMaxOutliers(o.fMaxOutliers),
-  fOutlierCut(o.fOutlierCut)
+  fOutlierCut(o.fOutlierCut),
+  fUseRingBatch(o.fUseRingBatch),
+  fRingTableELossFit(0),
+  fStripX(),
+  fStripY(),
+  fSectorZ(),
+  fStripAcc(),
+  fRingCuts(),
+  fRingFitAxis(),
+  fRingFitBins(0),
+  fRingFits(),
+  fRingMaxN(),
+  fBatchValues(),
+  fBatchStrips()
 {
   // 
   // Copy constructor 
@@ -232,6 +271,8 @@ AliFMDDensityCalculator::operator=(const AliFMDDensityCalculator& o)
   fHTiming            = o.fHTiming;
   fMaxOutliers        = o.fMaxOutliers;
   fOutlierCut         = o.fOutlierCut;
+  fUseRingBatch       = o.fUseRingBatch;
+  fRingTableELossFit  = 0; // Tables are rebuilt on first use
 
   fRingHistos.Delete();
   TIter    next(&o.fRingHistos);
@@ -251,6 +292,7 @@ AliFMDDensityCalculator::SetupForData(const TAxis& axis)
   //   etaAxis   Eta axis
   DGUARD(fDebug, 1, "Initialize FMD density calculator");
   CacheMaxWeights(axis);
+  fRingTableELossFit = 0; // Remake ring tables on next event
  
   fCache.Init(axis);
 
@@ -401,6 +443,17 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
   // We do not use TArrayD because we do not wont a bounds check 
   // TArrayD etaCache(20*512); // Same number of strips per ring
   // TArrayD phiCache(20*512); // whether it is inner our outer. 
+
+  // --- Check if we can do the rings in one batch -------------------
+  // The detailed debug output is only available strip-by-strip
+  Bool_t useBatch = false;
+  if (fUseRingBatch && fDebug < 3 && fLowCuts) {
+    const AliFMDCorrELossFit* cor = 
+      AliForwardCorrectionManager::Instance().GetELossFit();
+    if (cor && cor != fRingTableELossFit) CacheRingTables(cor);
+    useBatch = (cor && (fUsePhiAcceptance == kPhiNoCorrect || 
+			fStripAcc.GetSize() > 0));
+  }
   
   // --- Loop over detectors -----------------------------------------
   for (UShort_t d=1; d<=3; d++) { 
@@ -430,8 +483,13 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
       // etaCache.Reset(AliESDFMD::kInvalidEta);
       // phiCache.Reset(AliESDFMD::kInvalidEta);
 
+      // --- Process all strips in one batch -------------------------
+      if (useBatch) 
+	CalculateRing(fmd, d, r, h, rh, lowFlux, ip, etaCache, phiCache,
+		      rePhiTime, nPartTime);
+
       // --- Loop over sectors and strips ----------------------------
-      for (UShort_t s=0; s<ns; s++) { 
+      for (UShort_t s=0; s<ns && !useBatch; s++) { 
 	for (UShort_t t=0; t<nt; t++) {
 	  
 	  Float_t  mult   = fmd.Multiplicity(d,r,s,t);
@@ -650,6 +708,299 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
   return kTRUE;
 }
 
+//_____________________________________________________________________
+void
+AliFMDDensityCalculator::CacheRingTables(const AliFMDCorrELossFit* cor)
+{
+  // 
+  // Fill the per-ring tables used by CalculateRing: the strip
+  // positions, the acceptance corrections, the low cuts per eta bin,
+  // and the usable energy loss fits and maximum weights per eta bin
+  // of the fits.  Lookups that fail are left empty, so that
+  // CalculateRing falls back to the full calculation (and warnings)
+  // for those strips.
+  // 
+  // Parameters:
+  //    cor   Energy loss fits 
+  //
+  DGUARD(fDebug, 2, "Cache ring tables in FMD density calculator");
+  const Int_t nMax = 20*512; // Same number of strips per ring
+
+  fStripX.Set(5*nMax);
+  fStripY.Set(5*nMax);
+  fSectorZ.Set(5*40);
+  fStripAcc.Set(0);
+  if (fAccI && fAccO) { 
+    fStripAcc.Set(2*512);
+    for (UShort_t t = 0; t < 512; t++) fStripAcc[t]     = AcceptanceCorrection('I',t);
+    for (UShort_t t = 0; t < 256; t++) fStripAcc[512+t] = AcceptanceCorrection('O',t);
+  }
+
+  Int_t nCut = fLowCuts->GetXaxis()->GetNbins()+2;
+  fRingCuts.Set(5*nCut);
+
+  // Mirror AliFMDCorrELossFit::FindEtaBin, which gives bins 0 to N
+  const TAxis& fitAxis = cor->GetEtaAxis();
+  fRingFitAxis = fitAxis;
+  fRingFitBins = 1;
+  if (TMath::Abs(fitAxis.GetXmin() - fitAxis.GetXmax()) >= 1e-6 &&
+      fitAxis.GetNbins() > 0) 
+    fRingFitBins = fitAxis.GetNbins()+1;
+  fRingFits.Clear();
+  fRingFits.Expand(5*fRingFitBins);
+  fRingMaxN.Set(5*fRingFitBins);
+  fRingMaxN.Reset(0);
+
+  for (UShort_t d=1; d<=3; d++) { 
+    UShort_t nr = (d == 1 ? 1 : 2);
+    for (UShort_t q=0; q<nr; q++) { 
+      Char_t         r    = (q == 0 ? 'I' : 'O');
+      UShort_t       ns   = (q == 0 ?  20 :  40);
+      UShort_t       nt   = (q == 0 ? 512 : 256);
+      Int_t          ring = (d == 1 ? 0 : 2*d - 3 + q);
+      const TArrayI* max  = 0;
+      switch (ring) { 
+      case 0: max = &fFMD1iMax; break;
+      case 1: max = &fFMD2iMax; break;
+      case 2: max = &fFMD2oMax; break;
+      case 3: max = &fFMD3iMax; break;
+      case 4: max = &fFMD3oMax; break;
+      }
+
+      // --- Strip positions as in AliForwardUtil::GetXYZ ------------
+      for (UShort_t s=0; s<ns; s++) { 
+	Double_t phiD = AliForwardUtil::GetSectorPhi(d, r, s);
+	Double_t zD   = AliForwardUtil::GetSectorZ(d, r, s);
+	if (phiD == AliForwardUtil::kInvalidValue) 
+	  zD = AliForwardUtil::kInvalidValue;
+	fSectorZ[ring*40+s] = zD;
+	for (UShort_t t=0; t<nt; t++) {
+	  Double_t rD = AliForwardUtil::GetStripR(r, t);
+	  fStripX[ring*nMax+s*nt+t] = rD*TMath::Cos(phiD);
+	  fStripY[ring*nMax+s*nt+t] = rD*TMath::Sin(phiD);
+	}
+      }
+
+      // --- Low cuts as in GetMultCut -------------------------------
+      for (Int_t ieta = 0; ieta < nCut; ieta++) 
+	fRingCuts[ring*nCut+ieta] = Rng2Cut(d, r, ieta, fLowCuts);
+
+      // --- Fits and weights as in NParticles -----------------------
+      for (Int_t bin = 1; bin < fRingFitBins; bin++) { 
+	AliFMDCorrELossFit::ELossFit* fit = cor->FindFit(d,r,bin,-1);
+	Int_t iEta = bin - 1;
+	Int_t m    = (iEta < max->fN ? max->At(iEta) : -1);
+	if (!fit || m < 1) continue;
+	fRingFits.AddAt(fit, ring*fRingFitBins+bin);
+	fRingMaxN[ring*fRingFitBins+bin] = TMath::Min(fMaxParticles, 
+						       UShort_t(m));
+      }
+    }
+  }
+  fRingTableELossFit = cor;
+}
+
+//_____________________________________________________________________
+void
+AliFMDDensityCalculator::CalculateRing(const AliESDFMD& fmd, 
+				       UShort_t         d, 
+				       Char_t           r, 
+				       TH2D*            h, 
+				       RingHistos*      rh,
+				       Bool_t           lowFlux,
+				       const TVector3&  ip, 
+				       Double_t*        etaCache, 
+				       Double_t*        phiCache,
+				       Double_t&        rePhiTime, 
+				       Double_t&        nPartTime)
+{
+  // 
+  // Calculate the density of all strips in a ring in one batch. 
+  // 
+  // This does the same as the strip-by-strip loop in Calculate, but
+  // the per-strip lookups are replaced by the tables made by
+  // CacheRingTables, and the histograms are filled once per ring
+  // from flat arrays, in the same strip order.
+  // 
+  // Parameters:
+  //    fmd       AliESDFMD object (possibly) corrected for sharing
+  //    d         Detector
+  //    r         Ring 
+  //    h         Output histogram
+  //    rh        Ring histograms 
+  //    lowFlux   Low flux flag. 
+  //    ip        Coordinates of interaction point
+  //    etaCache  On return, eta of each strip
+  //    phiCache  On return, phi of each strip
+  //    rePhiTime Time spent on the re-calculation
+  //    nPartTime Time spent on the rest
+  //
+  TStopwatch timer;
+  const Int_t nMax = 20*512;
+  UShort_t    q    = (r == 'I' || r == 'i') ? 0 : 1;
+  UShort_t    ns   = (q == 0 ?  20 :  40);
+  UShort_t    nt   = (q == 0 ? 512 : 256);
+  Int_t       ring = (d == 1 ? 0 : 2*d - 3 + q);
+  Int_t       nStr = ns*nt;
+
+  const Double_t* stripX = fStripX.GetArray()  + ring*nMax;
+  const Double_t* stripY = fStripY.GetArray()  + ring*nMax;
+  const Double_t* sectZ  = fSectorZ.GetArray() + ring*40;
+  const Float_t*  acc    = (fStripAcc.GetSize() > 0 ? 
+			    fStripAcc.GetArray() + q*512 : 0);
+  TAxis*          cutAx  = fLowCuts->GetXaxis();
+  const Double_t* cuts   = fRingCuts.GetArray() + ring*(cutAx->GetNbins()+2);
+
+  // Flat per-strip arrays.  The first 3 are indexed by strip, the
+  // rest by the strips with a valid signal.
+  if (fBatchValues.GetSize() < 8*nMax) fBatchValues.Set(8*nMax);
+  if (fBatchStrips.GetSize() < nMax)   fBatchStrips.Set(nMax);
+  Double_t* eloss  = fBatchValues.GetArray();
+  Double_t* oldEta = eloss  + nMax;
+  Double_t* oldPhi = oldEta + nMax;
+  Double_t* vEta   = oldPhi + nMax;
+  Double_t* vPhi   = vEta   + nMax;
+  Double_t* vMult  = vPhi   + nMax;
+  Double_t* vN     = vMult  + nMax;
+  Double_t* vC     = vN     + nMax;
+  Int_t*    strips = fBatchStrips.GetArray();
+  Int_t     nValid = 0;
+
+  // --- Eta and phi of all strips -----------------------------------
+  START_TIMER(timer);
+  Double_t iX = ip.X(); if (iX > 100) iX = 0; // No X
+  Double_t iY = ip.Y(); if (iY > 100) iY = 0; // No Y
+  for (UShort_t s=0; s<ns; s++) { 
+    for (UShort_t t=0; t<nt; t++) {
+      Int_t    i   = s*nt+t;
+      Double_t phi = fmd.Phi(d,r,s,t) * TMath::DegToRad();
+      Double_t eta = fmd.Eta(d,r,s,t);
+      oldPhi[i]    = phi;
+      oldEta[i]    = eta;
+      if (fRecalculatePhi) {
+	// Same as AliForwardUtil::GetEtaPhi with the cached strip
+	// position.  In case of problems, the full calculation is done
+	// to get the same warnings.
+	Bool_t   ok = false;
+	Double_t zD = sectZ[s];
+	if (zD != AliForwardUtil::kInvalidValue) { 
+	  Double_t dX    = stripX[i]-iX;
+	  Double_t dY    = stripY[i]-iY;
+	  Double_t dZ    = zD-ip.Z();
+	  Double_t rr    = TMath::Sqrt(TMath::Power(dX,2)+TMath::Power(dY,2));
+	  Double_t theta = TMath::ATan2(rr, dZ);
+	  if (TMath::Abs(theta) >= 1e-9) { 
+	    eta = -TMath::Log(TMath::Tan(theta/2));
+	    phi = TMath::ATan2(dY, dX);
+	    if (phi < 0)              phi += TMath::TwoPi();
+	    if (phi > TMath::TwoPi()) phi -= TMath::TwoPi();
+	    ok  = true;
+	  }
+	}
+	if (!ok) ok = AliForwardUtil::GetEtaPhi(d,r,s,t,ip,eta,phi);
+	if (!ok || TMath::Abs(eta) < 1) {
+	  AliWarningF("FMD%d%c[%2d,%3d] (%f,%f,%f) eta=%f phi=%f (%f)",
+		      d, r, s, t, ip.X(), ip.Y(), ip.Z(), eta,
+		      phi, oldEta[i]);
+	  eta = oldEta[i];
+	  phi = oldPhi[i];
+	}
+      }
+      etaCache[i] = eta;
+      phiCache[i] = phi;
+    }
+  }
+  ADD_TIMER(timer,rePhiTime);
+
+  // --- Number of particles in all strips ---------------------------
+  START_TIMER(timer);
+  for (Int_t i = 0; i < nStr; i++) { 
+    UShort_t s    = i / nt;
+    UShort_t t    = i % nt;
+    Float_t  mult = fmd.Multiplicity(d,r,s,t);
+    Double_t eta  = etaCache[i];
+    if (mult == AliESDFMD::kInvalidMult) { 
+      // Do not count invalid stuff 
+      eloss[i] = -1;
+      continue;
+    }
+    if (mult > 20) 
+      AliWarningF("Raw multiplicity of FMD%d%c[%02d,%03d] = %f > 20",
+		  d, r, s, t, mult);
+
+    if (fUsePhiAcceptance == kPhiCorrectELoss) mult *= acc[t];
+
+    Double_t cut  = 1024;
+    if (eta != AliESDFMD::kInvalidEta) cut = cuts[cutAx->FindBin(eta)];
+    else AliWarningF("Eta for FMD%d%c[%02d,%03d] is invalid: %f", 
+		     d, r, s, t, eta);
+
+    Double_t n   = 0;
+    if (cut > 0 && mult > cut) { 
+      if (lowFlux) n = 1;
+      else { 
+	// Same as NParticles with the cached fit and weight 
+	Float_t feta = eta;
+	Int_t   bin  = 0;
+	if (fRingFitBins > 1) { 
+	  bin = fRingFitAxis.FindBin(feta);
+	  if (bin <= 0 || bin >= fRingFitBins) bin = 0;
+	}
+	Int_t idx = ring*fRingFitBins+bin;
+	const AliFMDCorrELossFit::ELossFit* fit = 
+	  static_cast<const AliFMDCorrELossFit::ELossFit*>(fRingFits.UncheckedAt(idx));
+	if (fit) { 
+	  Double_t ret = fit->EvaluateWeighted(mult, UShort_t(fRingMaxN[idx]));
+	  fWeightedSum->Fill(ret);
+	  fSumOfWeights->Fill(ret);
+	  n = Float_t(ret);
+	}
+	else n = NParticles(mult,d,r,feta,lowFlux);
+      }
+    }
+    eloss[i] = mult;
+
+    Double_t c = 1;
+    if (fUsePhiAcceptance == kPhiCorrectNch) c = acc[t];
+    if (c > 0) n /= c;
+
+    strips[nValid] = i;
+    vEta[nValid]   = eta;
+    vPhi[nValid]   = phiCache[i];
+    vMult[nValid]  = mult;
+    vN[nValid]     = n;
+    vC[nValid]     = c;
+    nValid++;
+  }
+
+  // --- Fill histograms ---------------------------------------------
+  rh->fTotal->FillN(nStr, etaCache, 0);
+  rh->fELoss->FillN(nStr, eloss, 0);
+  rh->fGood->FillN(nValid, vEta, 0);
+  fCorrections->FillN(nValid, vC, 0);
+  for (Int_t j = 0; j < nValid; j++) { 
+    Int_t    i   = strips[j];
+    rh->fCorr->Fill(vEta[j], vC[j]);
+
+    // --- Accumulate Poisson statistics -----------------------------
+    Bool_t hit = (vN[j] > fHitThreshold && vC[j] > 0);
+    if (hit) {
+      rh->fELossUsed->Fill(vMult[j]);
+      if (fRecalculatePhi) {
+	rh->fPhiBefore->Fill(oldPhi[i]);
+	rh->fPhiAfter->Fill(vPhi[j]);
+	rh->fEtaBefore->Fill(oldEta[i]);
+	rh->fEtaAfter->Fill(oldEta[i]);	      
+      }
+      rh->fSignal->Fill(vEta[j], vMult[j]);
+    }
+    rh->fPoisson.Fill(i % nt, i / nt, hit, 1./vC[j]);
+  }
+  h->FillN(nValid, vEta, vPhi, vN);
+  if (!fUsePoisson) rh->fDensity->FillN(nValid, vEta, vPhi, vN);
+  ADD_TIMER(timer,nPartTime);
+}
+
 //_____________________________________________________________________
 Bool_t 
 AliFMDDensityCalculator::CheckOutlier(Double_t eloss, 
@@ -1201,6 +1552,7 @@ AliFMDDensityCalculator::Print(Option_t* option) const
   PFV("Threshold(hit)",         fHitThreshold);
   PFV("Max(outliers)",          fMaxOutliers);
   PFV("Cut(outlier)",           fOutlierCut);
+  PFB("Ring batch",             fUseRingBatch);
   PFV("Lower cut", "");
   fCuts.Print();
 
@@ -16,6 +16,10 @@
 #include <TNamed.h>
 #include <TList.h>
 #include <TArrayI.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
+#include <TObjArray.h>
+#include <TAxis.h>
 #include <TVector3.h>
 #include "AliForwardUtil.h"
 #include "AliFMDMultCuts.h"
@@ -211,6 +215,17 @@ public:
    * @param cut Cut value 
    */
   void SetHitThreshold(Double_t cut=0.9) { fHitThreshold = cut; }
+  /** 
+   * Set whether to process all strips of a ring in one batch.  The
+   * batch uses per-ring tables of the strip positions, acceptance
+   * corrections, low cuts, and energy loss fits, and fills the
+   * histograms once per ring.  The result is the same as for the
+   * strip-by-strip loop, which is still used for debug levels of 3
+   * and above.
+   * 
+   * @param use Whether to use the batch (default is true)
+   */
+  void SetUseRingBatch(Bool_t use=true) { fUseRingBatch = use; }
   /** 
    * Get the multiplicity cut.  If the user has set fMultCut (via
    * SetMultCut) then that value is used.  If not, then the lower
@@ -476,6 +491,41 @@ protected:
    * @return Ring histogram container 
    */
   RingHistos* GetRingHistos(UShort_t d, Char_t r) const;
+  /** 
+   * Fill the per-ring tables used by CalculateRing 
+   * 
+   * @param cor Energy loss fits 
+   */
+  void CacheRingTables(const AliFMDCorrELossFit* cor);
+  /** 
+   * Calculate the density of all strips in a ring in one batch.
+   * First the per-strip values are evaluated into flat arrays using
+   * the tables from CacheRingTables, then the histograms are filled
+   * in one go.
+   * 
+   * @param fmd       AliESDFMD object (possibly) corrected for sharing
+   * @param d         Detector
+   * @param r         Ring 
+   * @param h         Output histogram
+   * @param rh        Ring histograms 
+   * @param lowFlux   Low flux flag. 
+   * @param ip        Coordinates of interaction point
+   * @param etaCache  On return, @f$\eta@f$ of each strip
+   * @param phiCache  On return, @f$\varphi@f$ of each strip
+   * @param rePhiTime Time spent on the re-calculation
+   * @param nPartTime Time spent on the rest
+   */
+  void CalculateRing(const AliESDFMD& fmd, 
+		     UShort_t         d, 
+		     Char_t           r, 
+		     TH2D*            h, 
+		     RingHistos*      rh,
+		     Bool_t           lowFlux,
+		     const TVector3&  ip, 
+		     Double_t*        etaCache, 
+		     Double_t*        phiCache,
+		     Double_t&        rePhiTime, 
+		     Double_t&        nPartTime);
   TList    fRingHistos;    //  List of histogram containers
   TH1D*    fSumOfWeights;  //  Histogram
   TH1D*    fWeightedSum;   //  Histogram
@@ -504,8 +554,21 @@ protected:
   TProfile*              fHTiming;
   Double_t               fMaxOutliers; // Maximum ratio of outlier bins 
   Double_t               fOutlierCut;  // Maximum relative diviation 
+  Bool_t                 fUseRingBatch; // Process the strips of a ring in one batch
+  const AliFMDCorrELossFit* fRingTableELossFit; //! Fits the ring tables are made for
+  TArrayD                fStripX;      //! Strip x per ring, sector, strip
+  TArrayD                fStripY;      //! Strip y per ring, sector, strip
+  TArrayD                fSectorZ;     //! Sector z per ring and sector 
+  TArrayF                fStripAcc;    //! Acceptance correction per ring type and strip
+  TArrayD                fRingCuts;    //! Low cut per ring and eta bin of the cuts
+  TAxis                  fRingFitAxis; //! Eta axis of the energy loss fits 
+  Int_t                  fRingFitBins; //! Number of fit table entries per ring
+  TObjArray              fRingFits;    //! Usable fit per ring and eta bin of the fits
+  TArrayI                fRingMaxN;    //! Maximum weight per ring and eta bin of the fits
+  TArrayD                fBatchValues; //! Per-strip values of the ring batch
+  TArrayI                fBatchStrips; //! Strips with a valid signal in the ring batch
 
-  ClassDef(AliFMDDensityCalculator,16); // Calculate Nch density 
+  ClassDef(AliFMDDensityCalculator,17); // Calculate Nch density 
 };
 
 #endif
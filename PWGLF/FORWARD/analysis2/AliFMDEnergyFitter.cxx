@@ -16,8 +16,15 @@
 #include <TFitResult.h>
 #include <THStack.h>
 #include <TROOT.h>
+#include <RVersion.h>
 #include <iostream>
 #include <iomanip>
+#include <vector>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+#include <Math/MinimizerOptions.h>
+#include <atomic>
+#include <thread>
+#endif
 
 ClassImp(AliFMDEnergyFitter)
 #if 0
@@ -49,7 +56,8 @@ AliFMDEnergyFitter::AliFMDEnergyFitter()
     fDebug(0),
     fResidualMethod(kNoResiduals),
     fSkips(0),
-    fRegularizationCut(3e6)
+    fRegularizationCut(3e6),
+    fNThreads(1)
 {
   // 
   // Default Constructor - do not use 
@@ -79,7 +87,8 @@ AliFMDEnergyFitter::AliFMDEnergyFitter(const char* title)
     fDebug(0),
     fResidualMethod(kNoResiduals),
     fSkips(0),
-    fRegularizationCut(3e6)
+    fRegularizationCut(3e6),
+    fNThreads(1)
 {
   // 
   // Constructor 
@@ -415,6 +424,7 @@ AliFMDEnergyFitter::Fit(const TList* dir)
       continue;
     }
     
+    o->fNThreads = fNThreads;
     TObjArray* l = o->Fit(d, fLowCut, fNParticles,
 			  fMinEntries, fFitRangeBinWidth,
 			  fMaxRelParError, fMaxChi2PerNDF,
@@ -582,6 +592,7 @@ AliFMDEnergyFitter::Print(Option_t*) const
   PFV("max(chi^2/nu)",	        fMaxChi2PerNDF);
   PFV("min(a_i)",	        fMinWeight);
   PFV("Regularization cut",     fRegularizationCut);
+  PFV("Fit threads",            fNThreads);
   TString r = "";
   switch (fResidualMethod) { 
   case kNoResiduals:              r = "None";       break;
@@ -603,7 +614,8 @@ AliFMDEnergyFitter::RingHistos::RingHistos()
     fList(0),
     fBest(0),
     fFits("AliFMDCorrELossFit::ELossFit", 200),
-    fDebug(0)
+    fDebug(0),
+    fNThreads(1)
 {
   // 
   // Default CTOR
@@ -622,7 +634,8 @@ AliFMDEnergyFitter::RingHistos::RingHistos(UShort_t d, Char_t r)
     fList(0),
     fBest(0),
     fFits("AliFMDCorrELossFit::ELossFit", 200),
-    fDebug(0)
+    fDebug(0),
+    fNThreads(1)
 {
   // 
   // Constructor
@@ -1056,36 +1069,40 @@ AliFMDEnergyFitter::RingHistos::FitSlices(TList*           dir,
     best->Clear();
     best->SetOwner(false);
   }
+  // Get all distributions first, so that the fits can be done
+  // concurrently.  The results are then stored in eta-bin order.
+  TObjArray toFit(nDists);
   for (Int_t i = 0; i < nDists; i++) { 
-    // Ignore empty histograms altoghether 
     Int_t b    = i+1;
     TH1D* dist = (h ? h->ProjectionY(Form(fgkEDistFormat,GetName(),b),b,b,"e") 
 		  : static_cast<TH1D*>(dists->At(i)));
-    if (!dist) { 
-      // If we got the null pointer, return 0
-      nEmpty++;
-      continue;
-    }
+    if (!dist) continue;
     // Then releasing the histogram from the it's directory
     dist->SetDirectory(0);
     // Set a meaningful title
     dist->SetTitle(Form("#Delta/#Delta_{mip} for %s in %6.2f<#eta<%6.2f",
 			GetName(), eta.GetBinLowEdge(b),
 			eta.GetBinUpEdge(b)));
+    toFit.AddAt(dist, i);
+  }
 
-    // Now fit 
-    UShort_t    status1 = 0;
-    ELossFit_t* res     = FitHist(dist,
-				  lowCut, 
-				  nParticles,
-				  minEntries,
-				  minusBins,   
-				  relErrorCut,
-				  chi2nuCut,
-				  minWeight,
-				  regCut,
-				  scaleToPeak,
-				  status1);
+  // Now fit 
+  TObjArray results(nDists);
+  TArrayI   statuses(nDists);
+  FitHists(toFit, results, statuses, lowCut, nParticles, minEntries, 
+	   minusBins, relErrorCut, chi2nuCut, minWeight, regCut, scaleToPeak);
+
+  for (Int_t i = 0; i < nDists; i++) { 
+    // Ignore empty histograms altoghether 
+    Int_t b    = i+1;
+    TH1D* dist = static_cast<TH1D*>(toFit.At(i));
+    if (!dist) { 
+      // If we got the null pointer, return 0
+      nEmpty++;
+      continue;
+    }
+    UShort_t    status1 = statuses[i];
+    ELossFit_t* res     = static_cast<ELossFit_t*>(results.At(i));
     if (!res) {
       switch (status1) { 
       case 1: nEmpty++; break;
@@ -1205,6 +1222,93 @@ AliFMDEnergyFitter::RingHistos::FitSlices(TList*           dir,
   return pars;
 }
 
+//____________________________________________________________________
+void
+AliFMDEnergyFitter::RingHistos::FitHists(const TObjArray& dists,
+					 TObjArray&       results,
+					 TArrayI&         status,
+					 Double_t         lowCut, 
+					 UShort_t         nParticles,
+					 UShort_t         minEntries,
+					 UShort_t         minusBins, 
+					 Double_t         relErrorCut, 
+					 Double_t         chi2nuCut,
+					 Double_t         minWeight,
+					 Double_t         regCut,
+					 Bool_t           scaleToPeak) const
+{
+  // 
+  // Fit all distributions, serially or on fNThreads worker threads.
+  // TMinuit is a global object, so the workers use Minuit2 and ROOT
+  // is switched to thread-safe mode.  Each fit has its own fitter
+  // and its own array of candidate fits, and the results are stored
+  // by index, so that the output is the same for any number of
+  // threads larger than one.  Since the serial fits use the default
+  // minimizer (normally Minuit), the threaded results may differ
+  // slightly from the serial ones.
+  // 
+  // Parameters:
+  //    dists       Distributions to fit (null entries are skipped)
+  //    results     On return, the best fit of each distribution 
+  //    status      On return, the status of each fit 
+  //    Others      See FitHist 
+  //
+  Int_t                    n = dists.GetSize();
+  std::vector<ELossFit_t*> res(n, static_cast<ELossFit_t*>(0));
+  std::vector<UShort_t>    sta(n, 0);
+  Int_t                    nThreads = TMath::Min(fNThreads, n);
+  Bool_t                   done     = false;
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+  if (nThreads > 1) { 
+    DMSG(fDebug,1,"Fitting %d distributions of %s on %d threads", 
+	 n, GetName(), nThreads);
+    ROOT::EnableThreadSafety();
+    std::string prevMinimizer = 
+      ROOT::Math::MinimizerOptions::DefaultMinimizerType();
+    std::string prevAlgo      = 
+      ROOT::Math::MinimizerOptions::DefaultMinimizerAlgo();
+    ROOT::Math::MinimizerOptions::SetDefaultMinimizer("Minuit2");
+    std::atomic<Int_t>       next(0);
+    std::vector<std::thread> workers;
+    for (Int_t j = 0; j < nThreads; j++) { 
+      workers.emplace_back([&]() { 
+	  TClonesArray fits("AliFMDCorrELossFit::ELossFit", 200);
+	  for (Int_t i = next++; i < n; i = next++) { 
+	    TH1* dist = static_cast<TH1*>(dists.At(i));
+	    if (!dist) continue;
+	    res[i] = FitHist(dist, lowCut, nParticles, minEntries, minusBins,
+			     relErrorCut, chi2nuCut, minWeight, regCut,
+			     scaleToPeak, sta[i], &fits);
+	  }
+	});
+    }
+    for (auto& worker : workers) worker.join();
+    ROOT::Math::MinimizerOptions::SetDefaultMinimizer(prevMinimizer.c_str(),
+						      prevAlgo.c_str());
+    done = true;
+  }
+#else
+  if (nThreads > 1) 
+    AliWarningF("Concurrent fits need ROOT >= 6.06, fitting %s serially",
+		GetName());
+#endif
+  for (Int_t i = 0; i < n && !done; i++) { 
+    TH1* dist = static_cast<TH1*>(dists.At(i));
+    if (!dist) continue;
+    res[i] = FitHist(dist, lowCut, nParticles, minEntries, minusBins,
+		     relErrorCut, chi2nuCut, minWeight, regCut,
+		     scaleToPeak, sta[i]);
+  }
+
+  // Store the results in order 
+  results.Expand(n);
+  status.Set(n);
+  for (Int_t i = 0; i < n; i++) { 
+    results.AddAt(res[i], i);
+    status[i] = sta[i];
+  }
+}
+
 
 //____________________________________________________________________
 void
@@ -1227,7 +1331,8 @@ AliFMDEnergyFitter::RingHistos::FitHist(TH1*      dist,
 					Double_t  minWeight,
 					Double_t  regCut,
 					Bool_t    scaleToPeak,
-					UShort_t& status) const
+					UShort_t& status,
+					TClonesArray* fits) const
 {
   // 
   // Fit a signal histogram.  First, the bin @f$ b_{min}@f$ with
@@ -1250,6 +1355,8 @@ AliFMDEnergyFitter::RingHistos::FitHist(TH1*      dist,
   //                    is loosend by a factor of 2 
   //    chi2nuCut   Cut on @f$ \chi^2/\nu@f$ - 
   //                    the reduced @f$\chi^2@f$ 
+  //    fits        If not null, array for candidate fits to use
+  //                    instead of fFits
   // 
   // Return:
   //    The best fit function 
@@ -1338,7 +1445,9 @@ AliFMDEnergyFitter::RingHistos::FitHist(TH1*      dist,
 
   // Here, we use the real quality assesor instead of the old
   // `CheckResult' to ensure consitency in all output.
-  ELossFit_t* ret = FindBestFit(dist, relErrorCut, chi2nuCut, minWeight);
+  ELossFit_t* ret = (fits ? 
+		     FindBestFit(dist, relErrorCut, chi2nuCut, minWeight, *fits) :
+		     FindBestFit(dist, relErrorCut, chi2nuCut, minWeight));
   if (!ret) status = 3;
   return ret;
 }
@@ -1365,11 +1474,35 @@ AliFMDEnergyFitter::RingHistos::FindBestFit(const TH1* dist,
   // Return:
   //    Best fit or null
   //
+  return FindBestFit(dist, relErrorCut, chi2nuCut, minWeightCut, fFits);
+}
+
+//__________________________________________________________________
+AliFMDEnergyFitter::RingHistos::ELossFit_t* 
+AliFMDEnergyFitter::RingHistos::FindBestFit(const TH1*    dist,
+					    Double_t      relErrorCut, 
+					    Double_t      chi2nuCut,
+					    Double_t      minWeightCut,
+					    TClonesArray& fits)  const
+{
+  // 
+  // Find the best fit, using the array fits for the candidates 
+  // 
+  // Parameters:
+  //    dist           Histogram 
+  //    relErrorCut    Cut applied to relative error of parameter. 
+  //    chi2nuCut      Cut on @f$ \chi^2/\nu@f$ 
+  //    minWeightCut   Least valid @f$ a_i@f$ 
+  //    fits           Array of candidate fits 
+  // 
+  // Return:
+  //    Best fit or null
+  //
   TList* funcs = dist->GetListOfFunctions();
   TF1*   func  = 0;
   Int_t  i     = 0;
   TIter  next(funcs);
-  fFits.Clear(); // This is only ever used here
+  fits.Clear(); // This is only ever used here
 
   if (fDebug) printf("Find best fit for %s ... ", dist->GetName());
   if (fDebug > 2) printf("\n");
@@ -1377,7 +1510,7 @@ AliFMDEnergyFitter::RingHistos::FindBestFit(const TH1* dist,
   // Loop over all functions stored in distribution, 
   // and calculate the quality 
   while ((func = static_cast<TF1*>(next()))) { 
-    ELossFit_t* fit = new(fFits[i++]) ELossFit_t(0,*func);
+    ELossFit_t* fit = new(fits[i++]) ELossFit_t(0,*func);
     fit->fDet  = fDet;
     fit->fRing = fRing;
     // fit->fBin  = b;
@@ -1389,11 +1522,11 @@ AliFMDEnergyFitter::RingHistos::FindBestFit(const TH1* dist,
   }
 
   // Sort all the found fit objects in increasing quality 
-  fFits.Sort();
-  if (fDebug > 2) fFits.Print("s");
+  fits.Sort();
+  if (fDebug > 2) fits.Print("s");
 
   // Get the top-most fit
-  ELossFit_t* ret = static_cast<ELossFit_t*>(fFits.At(i-1));
+  ELossFit_t* ret = static_cast<ELossFit_t*>(fits.At(i-1));
   if (!ret) {
     AliWarningF("No fit found for %s", GetName());
     return 0;
@@ -19,6 +19,7 @@
 #include <TList.h>
 #include <TObjArray.h>
 #include <TClonesArray.h>
+#include <TArrayI.h>
 #include "AliFMDCorrELossFit.h"
 #include "AliForwardUtil.h"
 #include "AliLandauGaus.h"
@@ -287,6 +288,18 @@ public:
     fRegularizationCut = cut;
   }
   void SetSkips(UShort_t skip) { fSkips = skip; }
+  /** 
+   * Set the number of threads used for the fits of the eta bins of
+   * each ring.  The fits of the eta bins are independent, and the
+   * results are stored in eta-bin order.  More than one thread needs
+   * ROOT 6.06 or later, and then the fits are done with Minuit2
+   * instead of the default minimizer.  The output is then the same
+   * for any number of threads, but may differ slightly from the
+   * serial (1 thread) output.
+   * 
+   * @param n Number of threads (1 means serial)
+   */
+  void SetNThreads(Int_t n=1) { fNThreads = n; }
   /** 
    * Set the debug level.  The higher the value the more output 
    * 
@@ -593,7 +606,39 @@ public:
 				Double_t  minWeight,
 				Double_t  regCut,
 				Bool_t    scaleToPeak,
-				UShort_t& status) const;
+				UShort_t& status,
+				TClonesArray* fits=0) const;
+    /** 
+     * Fit all distributions, serially or on fNThreads worker
+     * threads.  Each fit has its own fitter and array of candidate
+     * fits, so that the fits can be done concurrently.
+     * 
+     * @param dists       Distributions to fit (null entries are skipped)
+     * @param results     On return, the best fit of each distribution 
+     * @param status      On return, the status of each fit (see FitHist)
+     * @param lowCut      Lower cut @f$ E_{min}@f$ on signal 
+     * @param nParticles  Max number @f$ N@f$ of convolved landaus to fit
+     * @param minEntries  Least number of entries required
+     * @param minusBins   Number of bins @f$ \Delta b@f$ from peak to 
+     *                    subtract to get the fit range 
+     * @param relErrorCut Cut applied to relative error of parameter. 
+     * @param chi2nuCut   Cut on @f$ \chi^2/\nu@f$ 
+     * @param minWeight   Least weight ot consider
+     * @param regCut      Regularization cut-off
+     * @param scaleToPeak If true, scale distribution to peak value
+     */
+    void FitHists(const TObjArray& dists,
+		  TObjArray&       results,
+		  TArrayI&         status,
+		  Double_t         lowCut, 
+		  UShort_t         nParticles,
+		  UShort_t         minEntries,
+		  UShort_t         minusBins,
+		  Double_t         relErrorCut, 
+		  Double_t         chi2nuCut,
+		  Double_t         minWeight,
+		  Double_t         regCut,
+		  Bool_t           scaleToPeak) const;
     /** 
      * Find the best fit 
      * 
@@ -611,6 +656,23 @@ public:
 				    Double_t   relErrorCut, 
 				    Double_t   chi2nuCut,
 				    Double_t   minWeightCut) const;
+    /** 
+     * Find the best fit using the array @a fits for the candidate
+     * fits.
+     * 
+     * @param dist           Histogram 
+     * @param relErrorCut    Cut applied to relative error of parameter. 
+     * @param chi2nuCut      Cut on @f$ \chi^2/\nu@f$ 
+     * @param minWeightCut   Least valid @f$ a_i@f$ 
+     * @param fits           Array to store candidate fits in 
+     * 
+     * @return Best fit 
+     */
+    ELossFit_t* FindBestFit(const TH1*    dist,
+			    Double_t      relErrorCut, 
+			    Double_t      chi2nuCut,
+			    Double_t      minWeightCut,
+			    TClonesArray& fits) const;
     /** 
      * Calculate residuals of the fit 
      * 
@@ -679,7 +741,8 @@ public:
     mutable TObjArray    fBest;
     mutable TClonesArray fFits;
     Int_t                fDebug;
-    ClassDef(RingHistos,4);
+    Int_t                fNThreads; // Number of threads for the fits
+    ClassDef(RingHistos,5);
   };
 protected:
   /** 
@@ -750,8 +813,9 @@ protected:
   EResidualMethod fResidualMethod;    // Whether to store residuals (debugging)
   UShort_t        fSkips;             // Rings to skip when fitting 
   Double_t        fRegularizationCut; // When to regularize the chi^2
+  Int_t           fNThreads;          // Number of threads for the fits
 
-  ClassDef(AliFMDEnergyFitter,8); //
+  ClassDef(AliFMDEnergyFitter,9); //
 };
 
 #endif
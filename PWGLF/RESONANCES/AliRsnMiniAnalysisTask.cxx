@@ -13,6 +13,9 @@
 // Developers: F. Bellini (fbellini@cern.ch)
 //
 
+#include <algorithm>
+#include <map>
+
 #include <Riostream.h>
 
 #include <TH1.h>
@@ -88,6 +91,12 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
    fTriggerAna(0x0),
    fESDtrackCuts(0x0),
    fMiniEvent(0x0),
+   fMixBufferMemory(1000.0),
+   fEvStore(0),
+   fEvStoreSize(0),
+   fEvVz(),
+   fEvMult(),
+   fEvAngle(),
    fBigOutput(kFALSE),
    fMixPrintRefresh(-1),
    fCheckDecay(kTRUE),
@@ -144,6 +153,12 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const char *name, Bool_t useMC) :
    fTriggerAna(0x0),
    fESDtrackCuts(0x0),
    fMiniEvent(0x0),
+   fMixBufferMemory(1000.0),
+   fEvStore(0),
+   fEvStoreSize(0),
+   fEvVz(),
+   fEvMult(),
+   fEvAngle(),
    fBigOutput(kFALSE),
    fMixPrintRefresh(-1),
    fCheckDecay(kTRUE),
@@ -205,6 +220,12 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const AliRsnMiniAnalysisTask &cop
    fTriggerAna(copy.fTriggerAna),
    fESDtrackCuts(copy.fESDtrackCuts),
    fMiniEvent(0x0),
+   fMixBufferMemory(copy.fMixBufferMemory),
+   fEvStore(0),
+   fEvStoreSize(0),
+   fEvVz(),
+   fEvMult(),
+   fEvAngle(),
    fBigOutput(copy.fBigOutput),
    fMixPrintRefresh(copy.fMixPrintRefresh),
    fCheckDecay(copy.fCheckDecay),
@@ -270,6 +291,7 @@ AliRsnMiniAnalysisTask &AliRsnMiniAnalysisTask::operator=(const AliRsnMiniAnalys
    fESDtrackCuts = copy.fESDtrackCuts;
    fBigOutput = copy.fBigOutput;
    fMixPrintRefresh = copy.fMixPrintRefresh;
+   fMixBufferMemory = copy.fMixBufferMemory;
    fCheckDecay = copy.fCheckDecay;
    fMaxNDaughters = copy.fMaxNDaughters;
    fCheckP = copy.fCheckP;
@@ -298,6 +320,7 @@ AliRsnMiniAnalysisTask::~AliRsnMiniAnalysisTask()
       delete fOutput;
       delete fEvBuffer;
    }
+   fEvStore.Delete();
 }
 
 //__________________________________________________________________________________________________
@@ -398,7 +421,15 @@ void AliRsnMiniAnalysisTask::UserCreateOutputObjects()
       cs->Init(fOutput);
    }
 
-   // create temporary tree for filtered events
+   // create in-memory store and temporary tree for filtered events:
+   // events are kept in memory up to the configured budget, the tree
+   // only receives those which do not fit anymore
+   fEvStore.SetOwner();
+   fEvStore.Delete();
+   fEvStoreSize = 0;
+   fEvVz.clear();
+   fEvMult.clear();
+   fEvAngle.clear();
    if (fMiniEvent) delete fMiniEvent;
    fEvBuffer = new TTree("EventBuffer", "Temporary buffer for mini events");
    fEvBuffer->Branch("events", "AliRsnMiniEvent", &fMiniEvent);
@@ -458,10 +489,25 @@ void AliRsnMiniAnalysisTask::UserExec(Option_t *)
    if (fMiniEvent->IsEmpty()) {
       AliDebugClass(2, Form("Rejecting empty event #%d", fEvNum));
    } else {
-      Int_t id = fEvBuffer->GetEntries();
+      Int_t id = fEvStore.GetEntriesFast() + (Int_t)fEvBuffer->GetEntries();
       AliDebugClass(2, Form("Adding event #%d with ID = %d", fEvNum, id));
       fMiniEvent->ID() = id;
-      fEvBuffer->Fill();
+      fEvVz.push_back(fMiniEvent->Vz());
+      fEvMult.push_back(fMiniEvent->Mult());
+      fEvAngle.push_back(fMiniEvent->Angle());
+      Long64_t size = sizeof(AliRsnMiniEvent) + fMiniEvent->Particles().GetEntriesFast() * sizeof(AliRsnMiniParticle);
+      if (fEvBuffer->GetEntries() == 0 && fEvStoreSize + size <= (Long64_t)(fMixBufferMemory * 1048576.0)) {
+         // the store takes ownership, a new cursor is created with the next event;
+         // references to the input event are dropped as they would be in the tree
+         fMiniEvent->SetRef(0x0);
+         fMiniEvent->SetRefMC(0x0);
+         fMiniEvent->SetQnVector(0x0);
+         fEvStore.AddLast(fMiniEvent);
+         fEvStoreSize += size;
+         fMiniEvent = 0x0;
+      } else {
+         fEvBuffer->Fill();
+      }
    }
 
    // post data for computed stuff
@@ -482,9 +528,10 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    fEvBuffer->SetBranchAddress("events", &fMiniEvent);
    TStopwatch timer;
    // prepare variables
-   Int_t ievt, nEvents = (Int_t)fEvBuffer->GetEntries();
+   Int_t ievt, nEvents = fEvStore.GetEntriesFast() + (Int_t)fEvBuffer->GetEntries();
    Int_t idef, nDefs   = fHistograms.GetEntries();
-   Int_t imix, iloop, ifill;
+   Int_t imix, ifill;
+   AliRsnMiniEvent *event = 0x0;
    AliRsnMiniOutput *def = 0x0;
    AliRsnMiniOutput::EComputation compType;
 
@@ -502,7 +549,7 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    timer.Start();
    for (ievt = 0; ievt < nEvents; ievt++) {
       // get next entry
-      fEvBuffer->GetEntry(ievt);
+      event = GetStoredEvent(ievt);
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] Std.Event %d/%d",GetName(), ievt,nEvents));
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
@@ -517,23 +564,23 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
             case AliRsnMiniOutput::kEventOnly:
                //AliDebugClass(1, Form("Event %d, def '%s': event-value histogram filling", ievt, def->GetName()));
                ifill = 1;
-               def->FillEvent(fMiniEvent, &fValues);
+               def->FillEvent(event, &fValues);
                break;
             case AliRsnMiniOutput::kTruePair:
                //AliDebugClass(1, Form("Event %d, def '%s': true-pair histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+               ifill = def->FillPair(event, event, &fValues);
                break;
             case AliRsnMiniOutput::kTrackPair:
                //AliDebugClass(1, Form("Event %d, def '%s': pair-value histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+               ifill = def->FillPair(event, event, &fValues);
                break;
             case AliRsnMiniOutput::kTrackPairRotated1:
                //AliDebugClass(1, Form("Event %d, def '%s': rotated (1) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+               ifill = def->FillPair(event, event, &fValues);
                break;
             case AliRsnMiniOutput::kTrackPairRotated2:
                //AliDebugClass(1, Form("Event %d, def '%s': rotated (2) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+               ifill = def->FillPair(event, event, &fValues);
                break;
             default:
                // other kinds are processed elsewhere
@@ -552,83 +599,54 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       return;
    }
 
-   // initialize mixing counter
-   Int_t    nmatched[nEvents];
-   TString *smatched = new TString[nEvents];
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      smatched[ievt] = "|";
-      nmatched[ievt] = 0;
-   }
-
-
    AliInfo(Form("[%s] Std.Event %d/%d",GetName(), nEvents,nEvents));
    timer.Stop(); timer.Print(); timer.Start(); fflush(stdout);
 
    // search for good matchings
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      if (printNum&&(ievt%printNum==0)) {
-         AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),ievt,nEvents));
-         timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
-      }
-      if (nmatched[ievt] >= fNMix) continue;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      for (iloop = 1; iloop < nEvents; iloop++) {
-         imix = ievt + iloop;
-         if (imix >= nEvents) imix -= nEvents;
-         if (imix == ievt) continue;
-         // text next entry
-         fEvBuffer->GetEntry(imix);
-         // skip if events are not matched
-         if (!EventsMatch(&evMain, fMiniEvent)) continue;
-         // check that the array of good matches for mixed does not already contain main event
-         if (smatched[imix].Contains(Form("|%d|", ievt))) continue;
-         // check that the found good events has not enough matches already
-         if (nmatched[imix] >= fNMix) continue;
-         // add new mixing candidate
-         smatched[ievt].Append(Form("%d|", imix));
-         nmatched[ievt]++;
-         nmatched[imix]++;
-         if (nmatched[ievt] >= fNMix) break;
-      }
-      AliDebugClass(1, Form("Matches for event %5d = %d [%s] (missing are declared above)", evMain.ID(), nmatched[ievt], smatched[ievt].Data()));
-   }
+   std::vector< std::vector<Int_t> > partners;
+   FindMixPartners(partners, printNum);
 
    AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout); timer.Start();
 
    // perform mixing
-   TObjArray *list = 0x0;
-   TObjString *os = 0x0;
+   // events from the in-memory store are used in place, while an event
+   // read back from the buffer must be copied before reading its partners
+   AliRsnMiniEvent *evMain = 0x0, *evMainCopy = 0x0;
+   Int_t ipart, npart;
    for (ievt = 0; ievt < nEvents; ievt++) {
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] EventMixing %d/%d",GetName(),ievt,nEvents));
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
       ifill = 0;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      list = smatched[ievt].Tokenize("|");
-      TObjArrayIter next(list);
-      while ( (os = (TObjString *)next()) ) {
-         imix = os->GetString().Atoi();
-         fEvBuffer->GetEntry(imix);
+      npart = (Int_t)partners[ievt].size();
+      if (!npart) continue;
+      evMain = GetStoredEvent(ievt);
+      if (evMain == fMiniEvent) {
+         evMainCopy = new AliRsnMiniEvent(*fMiniEvent);
+         evMain = evMainCopy;
+      }
+      for (ipart = 0; ipart < npart; ipart++) {
+         imix = partners[ievt][ipart];
+         event = GetStoredEvent(imix);
          for (idef = 0; idef < nDefs; idef++) {
             def = (AliRsnMiniOutput *)fHistograms[idef];
             if (!def) continue;
             if (!def->IsTrackPairMix()) continue;
-            ifill += def->FillPair(&evMain, fMiniEvent, &fValues, kTRUE);
+            ifill += def->FillPair(evMain, event, &fValues, kTRUE);
             if (!def->IsSymmetric()) {
                AliDebugClass(2, "Reflecting non symmetric pair");
-               ifill += def->FillPair(fMiniEvent, &evMain, &fValues, kFALSE);
+               ifill += def->FillPair(event, evMain, &fValues, kFALSE);
             }
          }
       }
-      delete list;
+      if (evMainCopy) {
+         delete evMainCopy;
+         evMainCopy = 0x0;
+      }
    }
 
-   delete [] smatched;
-
    AliInfo(Form("[%s] EventMixing %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout);
 
@@ -1422,40 +1440,150 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
 //
 
    if (!event1 || !event2) return kFALSE;
-   Int_t ivz1, ivz2, imult1, imult2, iangle1, iangle2;
-   Double_t dv, dm, da;
+   return EventsMatch(event1->Vz(), event1->Mult(), event1->Angle(), event2->Vz(), event2->Mult(), event2->Angle());
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniAnalysisTask::EventsMatch(Double_t vz1, Double_t mult1, Double_t angle1, Double_t vz2, Double_t mult2, Double_t angle2) const
+{
+//
+// Same as above, from the event-level values only,
+// so that the partner search does not need to access the mini-events.
+//
 
    if (fContinuousMix) {
-      dv = TMath::Abs(event1->Vz()    - event2->Vz()   );
-      dm = TMath::Abs(event1->Mult()  - event2->Mult() );
-      da = TMath::Abs(event1->Angle() - event2->Angle());
-      if (dv > fMaxDiffVz) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Vz = %f", event1->ID(), event2->ID(), dv));
-         return kFALSE;
-      }
-      if (dm > fMaxDiffMult ) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Mult = %f", event1->ID(), event2->ID(), dm));
-         return kFALSE;
-      }
-      if (da > fMaxDiffAngle) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Angle = %f", event1->ID(), event2->ID(), da));
-         return kFALSE;
-      }
+      if (TMath::Abs(vz1    - vz2   ) > fMaxDiffVz   ) return kFALSE;
+      if (TMath::Abs(mult1  - mult2 ) > fMaxDiffMult ) return kFALSE;
+      if (TMath::Abs(angle1 - angle2) > fMaxDiffAngle) return kFALSE;
       return kTRUE;
    } else {
-      ivz1 = (Int_t)(event1->Vz() / fMaxDiffVz);
-      ivz2 = (Int_t)(event2->Vz() / fMaxDiffVz);
-      imult1 = (Int_t)(event1->Mult() / fMaxDiffMult);
-      imult2 = (Int_t)(event2->Mult() / fMaxDiffMult);
-      iangle1 = (Int_t)(event1->Angle() / fMaxDiffAngle);
-      iangle2 = (Int_t)(event2->Angle() / fMaxDiffAngle);
-      if (ivz1 != ivz2) return kFALSE;
-      if (imult1 != imult2) return kFALSE;
-      if (iangle1 != iangle2) return kFALSE;
+      if (MixCell(vz1, fMaxDiffVz) != MixCell(vz2, fMaxDiffVz)) return kFALSE;
+      if (MixCell(mult1, fMaxDiffMult) != MixCell(mult2, fMaxDiffMult)) return kFALSE;
+      if (MixCell(angle1, fMaxDiffAngle) != MixCell(angle2, fMaxDiffAngle)) return kFALSE;
       return kTRUE;
    }
 }
 
+//__________________________________________________________________________________________________
+Int_t AliRsnMiniAnalysisTask::MixCell(Double_t value, Double_t width) const
+{
+//
+// Cell of the mixing index along one axis.
+// For binned mixing this is the bin used to match events (truncation, as done historically),
+// for continuous mixing cells have the size of the allowed difference, so that
+// all compatible events are found in the same or in the adjacent cells.
+// A non-positive width collapses the axis into a single cell.
+//
+
+   if (width <= 0.0) return 0;
+   Double_t x = value / width;
+   if (fContinuousMix) x = TMath::Floor(x);
+   if (x > 1E9) return 1000000000;
+   if (x < -1E9) return -1000000000;
+   return (Int_t)x;
+}
+
+//__________________________________________________________________________________________________
+AliRsnMiniEvent *AliRsnMiniAnalysisTask::GetStoredEvent(Int_t id)
+{
+//
+// Return the stored mini-event with the given ID.
+// Events beyond the in-memory store are read from the buffer
+// into the cursor, which is overwritten by the next call.
+//
+
+   Int_t nmem = fEvStore.GetEntriesFast();
+   if (id < nmem) return (AliRsnMiniEvent *)fEvStore.UncheckedAt(id);
+   fEvBuffer->GetEntry(id - nmem);
+   return fMiniEvent;
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::FindMixPartners(std::vector< std::vector<Int_t> > &partners, Int_t printNum)
+{
+//
+// Search mixing partners for all stored events.
+// Events are indexed by their (vz, mult, angle) cell, and for each event only
+// the events in the same cell (binned mixing) or in the adjacent ones (continuous mixing)
+// are tested, in the same order as a scan over all events starting after the current one.
+// Each event gets at most fNMix matches in total, and a pair is never listed twice.
+// The partners found for each event are stored in the corresponding list.
+//
+
+   Int_t ievt, imix, nEvents = (Int_t)fEvVz.size();
+   partners.assign(nEvents, std::vector<Int_t>());
+   std::vector<Int_t> nmatched(nEvents, 0);
+
+   // build the index
+   std::vector<Int_t> cellVz(nEvents), cellMult(nEvents), cellAngle(nEvents);
+   std::map<std::pair<Int_t, std::pair<Int_t, Int_t> >, std::vector<Int_t> > cells;
+   for (ievt = 0; ievt < nEvents; ievt++) {
+      cellVz[ievt]    = MixCell(fEvVz[ievt], fMaxDiffVz);
+      cellMult[ievt]  = MixCell(fEvMult[ievt], fMaxDiffMult);
+      cellAngle[ievt] = MixCell(fEvAngle[ievt], fMaxDiffAngle);
+      cells[std::make_pair(cellVz[ievt], std::make_pair(cellMult[ievt], cellAngle[ievt]))].push_back(ievt);
+   }
+
+   // search
+   Int_t range = (fContinuousMix ? 1 : 0);
+   Int_t iv, im, ia, il, nlists, best, stop, pass;
+   std::vector<const std::vector<Int_t> *> lists;
+   std::vector<Int_t> cursor;
+   std::map<std::pair<Int_t, std::pair<Int_t, Int_t> >, std::vector<Int_t> >::const_iterator it;
+   for (ievt = 0; ievt < nEvents; ievt++) {
+      if (printNum&&(ievt%printNum==0)) {
+         AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),ievt,nEvents));
+         fflush(stdout);
+      }
+      if (nmatched[ievt] >= fNMix) continue;
+      lists.clear();
+      for (iv = -range; iv <= range; iv++) {
+         for (im = -range; im <= range; im++) {
+            for (ia = -range; ia <= range; ia++) {
+               it = cells.find(std::make_pair(cellVz[ievt] + iv, std::make_pair(cellMult[ievt] + im, cellAngle[ievt] + ia)));
+               if (it != cells.end()) lists.push_back(&it->second);
+            }
+         }
+      }
+      nlists = (Int_t)lists.size();
+      cursor.resize(nlists);
+      // first the events after the current one, then those before it
+      for (pass = 0; pass < 2 && nmatched[ievt] < fNMix; pass++) {
+         stop = (pass == 0 ? nEvents : ievt);
+         for (il = 0; il < nlists; il++) {
+            if (pass == 0)
+               cursor[il] = std::upper_bound(lists[il]->begin(), lists[il]->end(), ievt) - lists[il]->begin();
+            else
+               cursor[il] = 0;
+         }
+         while (nmatched[ievt] < fNMix) {
+            // next candidate is the smallest pending ID among the cells
+            best = -1;
+            imix = stop;
+            for (il = 0; il < nlists; il++) {
+               if (cursor[il] < (Int_t)lists[il]->size() && (*lists[il])[cursor[il]] < imix) {
+                  imix = (*lists[il])[cursor[il]];
+                  best = il;
+               }
+            }
+            if (best < 0) break;
+            cursor[best]++;
+            // skip if events are not matched
+            if (fContinuousMix && !EventsMatch(fEvVz[ievt], fEvMult[ievt], fEvAngle[ievt], fEvVz[imix], fEvMult[imix], fEvAngle[imix])) continue;
+            // check that the found good events has not enough matches already
+            if (nmatched[imix] >= fNMix) continue;
+            // check that the list of good matches for mixed does not already contain main event
+            if (std::find(partners[imix].begin(), partners[imix].end(), ievt) != partners[imix].end()) continue;
+            // add new mixing candidate
+            partners[ievt].push_back(imix);
+            nmatched[ievt]++;
+            nmatched[imix]++;
+         }
+      }
+      AliDebugClass(1, Form("Matches for event %5d = %d (missing are declared above)", ievt, nmatched[ievt]));
+   }
+}
+
 //---------------------------------------------------------------------
 Double_t AliRsnMiniAnalysisTask::ApplyCentralityPatchPbPb2011(){
   //This part rejects randomly events such that the centrality gets flat for LHC11h Pb-Pb data
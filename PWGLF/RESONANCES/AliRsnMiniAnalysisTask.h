@@ -12,6 +12,8 @@
 // Developers: F. Bellini (fbellini@cern.ch)
 //
 
+#include <vector>
+
 #include <TString.h>
 #include <TClonesArray.h>
 
@@ -59,6 +61,7 @@ public:
    void                SetMaxDiffAngle(Double_t val)      {fMaxDiffAngle = val;}
    void                SetEventCuts(AliRsnCutSet *cuts)   {fEventCuts    = cuts;}
    void                SetMixPrintRefresh(Int_t n)        {fMixPrintRefresh = n;}
+   void                SetMixBufferMemory(Double_t mb)    {fMixBufferMemory = mb;}
    void                SetCheckDecay(Bool_t checkDecay = kTRUE) {fCheckDecay = checkDecay;}
    void                SetMaxNDaughters(Short_t n)        {fMaxNDaughters = n;}
    void                SetCheckMomentumConservation(Bool_t checkP) {fCheckP = checkP;}
@@ -100,6 +103,12 @@ private:
    void     FillTrueMotherAOD(AliRsnMiniEvent *event);
    void     StoreTrueMother(AliRsnMiniPair *pair, AliRsnMiniEvent *event);
    Bool_t   EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2);
+   Bool_t   EventsMatch(Double_t vz1, Double_t mult1, Double_t angle1, Double_t vz2, Double_t mult2, Double_t angle2) const;
+   Int_t    MixCell(Double_t value, Double_t width) const;
+   AliRsnMiniEvent *GetStoredEvent(Int_t id);
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+   void     FindMixPartners(std::vector< std::vector<Int_t> > &partners, Int_t printNum);
+#endif
    AliQnCorrectionsQnVector * GetQnVectorFromList(const TList *list,
                                                         const char *subdetector,
                                                         const char *expectedstep) const;
@@ -141,6 +150,12 @@ private:
    AliTriggerAnalysis  *fTriggerAna;      //! trigger analysis
    AliESDtrackCuts     *fESDtrackCuts;    //! quality cut for ESD tracks
    AliRsnMiniEvent     *fMiniEvent;       //! mini-event cursor
+   Double_t             fMixBufferMemory; // memory budget (MB) of the in-memory mini-event store, further events go to fEvBuffer
+   TObjArray            fEvStore;         //! in-memory mini-event store (events with ID below its size)
+   Long64_t             fEvStoreSize;     //! estimated memory used by fEvStore (bytes)
+   std::vector<Float_t> fEvVz;            //! vertex z of all stored mini-events, indexed by ID
+   std::vector<Float_t> fEvMult;          //! multiplicity of all stored mini-events, indexed by ID
+   std::vector<Float_t> fEvAngle;         //! event plane angle of all stored mini-events, indexed by ID
    Bool_t               fBigOutput;       // flag if open file for output list
    Int_t                fMixPrintRefresh; // how often info in mixing part is printed
    Bool_t               fCheckDecay;      // check if the mother decayed via the requested channel
@@ -156,7 +171,7 @@ private:
    Float_t              fMotherAcceptanceCutMaxEta;             // cut value to apply when selecting the mothers inside a defined acceptance
    Bool_t               fKeepMotherInAcceptance;                // flag to keep also mothers in acceptance
 
-   ClassDef(AliRsnMiniAnalysisTask, 13);   // AliRsnMiniAnalysisTask
+   ClassDef(AliRsnMiniAnalysisTask, 14);   // AliRsnMiniAnalysisTask
 };
 
 
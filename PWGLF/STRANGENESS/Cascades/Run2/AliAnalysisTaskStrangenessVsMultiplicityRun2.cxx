@@ -1389,117 +1389,8 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         // Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
-        //Step 1: Sweep members of the output object TList and fill all of them as appropriate
-        Int_t lNumberOfConfigurations = fListV0->GetEntries();
-        //AliWarning(Form("[V0 Analyses] Processing different configurations (%i detected)",lNumberOfConfigurations));
-        TH3F *histoout         = 0x0;
-        AliV0Result *lV0Result = 0x0;
-        for(Int_t lcfg=0; lcfg<lNumberOfConfigurations; lcfg++){
-            lV0Result = (AliV0Result*) fListV0->At(lcfg);
-            histoout  = lV0Result->GetHistogram();
-
-            Float_t lMass = 0;
-            Float_t lRap  = 0;
-            Float_t lPDGMass = -1;
-            Float_t lNegdEdx = 100;
-            Float_t lPosdEdx = 100;
-            Float_t lBaryonMomentum = -0.5;
-
-            //========================================================================
-            //Setting up: Variable V0 CosPA
-            Float_t lV0CosPACut = lV0Result -> GetCutV0CosPA();
-            Float_t lVarV0CosPApar[5];
-            lVarV0CosPApar[0] = lV0Result->GetCutVarV0CosPAExp0Const();
-            lVarV0CosPApar[1] = lV0Result->GetCutVarV0CosPAExp0Slope();
-            lVarV0CosPApar[2] = lV0Result->GetCutVarV0CosPAExp1Const();
-            lVarV0CosPApar[3] = lV0Result->GetCutVarV0CosPAExp1Slope();
-            lVarV0CosPApar[4] = lV0Result->GetCutVarV0CosPAConst();
-            Float_t lVarV0CosPA = TMath::Cos(
-                                             lVarV0CosPApar[0]*TMath::Exp(lVarV0CosPApar[1]*fTreeVariablePt) +
-                                             lVarV0CosPApar[2]*TMath::Exp(lVarV0CosPApar[3]*fTreeVariablePt) +
-                                             lVarV0CosPApar[4]);
-            if( lV0Result->GetCutUseVarV0CosPA() ){
-                //Only use if tighter than the non-variable cut
-                if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
-            }
-            //========================================================================
-
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kK0Short     ){
-                lMass    = fTreeVariableInvMassK0s;
-                lRap     = fTreeVariableRapK0Short;
-                lPDGMass = 0.497;
-                lNegdEdx = fTreeVariableNSigmasNegPion;
-                lPosdEdx = fTreeVariableNSigmasPosPion;
-            }
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kLambda      ){
-                lMass = fTreeVariableInvMassLambda;
-                lRap = fTreeVariableRapLambda;
-                lPDGMass = 1.115683;
-                lNegdEdx = fTreeVariableNSigmasNegPion;
-                lPosdEdx = fTreeVariableNSigmasPosProton;
-                lBaryonMomentum = fTreeVariablePosInnerP;
-            }
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kAntiLambda  ){
-                lMass = fTreeVariableInvMassAntiLambda;
-                lRap = fTreeVariableRapLambda;
-                lPDGMass = 1.115683;
-                lNegdEdx = fTreeVariableNSigmasNegProton;
-                lPosdEdx = fTreeVariableNSigmasPosPion;
-                lBaryonMomentum = fTreeVariableNegInnerP;
-            }
-
-            if (
-                //Check 1: Offline Vertexer
-                lOnFlyStatus == lV0Result->GetUseOnTheFly() &&
-
-                //Check 2: Basic Acceptance cuts
-                lV0Result->GetCutMinEtaTracks() < fTreeVariableNegEta && fTreeVariableNegEta < lV0Result->GetCutMaxEtaTracks() &&
-                lV0Result->GetCutMinEtaTracks() < fTreeVariablePosEta && fTreeVariablePosEta < lV0Result->GetCutMaxEtaTracks() &&
-                lRap > lV0Result->GetCutMinRapidity() &&
-                lRap < lV0Result->GetCutMaxRapidity() &&
-                
-                //Check 3: Topological Variables
-                fTreeVariableV0Radius > lV0Result->GetCutV0Radius() &&
-                fTreeVariableDcaNegToPrimVertex > lV0Result->GetCutDCANegToPV() &&
-                fTreeVariableDcaPosToPrimVertex > lV0Result->GetCutDCAPosToPV() &&
-                fTreeVariableDcaV0Daughters < lV0Result->GetCutDCAV0Daughters() &&
-                fTreeVariableV0CosineOfPointingAngle > lV0CosPACut &&
-                fTreeVariableDistOverTotMom*lPDGMass < lV0Result->GetCutProperLifetime() &&
-                fTreeVariableLeastNbrCrossedRows > lV0Result->GetCutLeastNumberOfCrossedRows() &&
-                fTreeVariableLeastRatioCrossedRowsOverFindable > lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable() &&
-
-                //Check 4: Minimum momentum of baryon daughter
-                ( lV0Result->GetMassHypothesis() == AliV0Result::kK0Short || lBaryonMomentum > lV0Result->GetCutMinBaryonMomentum() ) &&
-
-                //Check 5: TPC dEdx selections
-                TMath::Abs(lNegdEdx)<lV0Result->GetCutTPCdEdx() &&
-                TMath::Abs(lPosdEdx)<lV0Result->GetCutTPCdEdx() &&
-
-                //Check 6: Armenteros-Podolanski space cut (for K0Short analysis)
-                ( ( lV0Result->GetCutArmenteros() == kFALSE || lV0Result->GetMassHypothesis() != AliV0Result::kK0Short ) || ( fTreeVariablePtArmV0>lV0Result->GetCutArmenterosParameter()*TMath::Abs(fTreeVariableAlphaV0) ) ) &&
-
-                //Check 7: kITSrefit track selection if requested
-                (
-                 ( (fTreeVariableNegTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeVariablePosTrackStatus & AliESDtrack::kITSrefit) )
-                 ||
-                 !lV0Result->GetCutUseITSRefitTracks()
-                 )&&
-
-                //Check 8: Max Chi2/Clusters if not absurd
-                ( lV0Result->GetCutMaxChi2PerCluster()>1e+3 ||
-                 fTreeVariableMaxChi2PerCluster < lV0Result->GetCutMaxChi2PerCluster()
-                 ) &&
-                //Check 9: Min Track Length if positive
-                ( lV0Result->GetCutMinTrackLength()<0 || //this is a bit paranoid...
-                 fTreeVariableMinTrackLength > lV0Result->GetCutMinTrackLength()
-                 )
-                )
-            {
-                //This satisfies all my conditionals! Fill histogram
-                histoout -> Fill ( fCentrality, fTreeVariablePt, lMass );
-            }
-        }
+        //Step 1: Check the candidate against all configurations (compiled into cut tables) and fill
+        ProcessV0Configurations(lOnFlyStatus);
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         // End Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -2126,254 +2017,8 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         // Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
-        //Step 1: Sweep members of the output object TList and fill all of them as appropriate
-        Int_t lNumberOfConfigurationsCascade = fListCascade->GetEntries();
-        //AliWarning(Form("[Cascade Analyses] Processing different configurations (%i detected)",lNumberOfConfigurationsCascade));
-        TH3F *histoout         = 0x0;
-        AliCascadeResult *lCascadeResult = 0x0;
-        for(Int_t lcfg=0; lcfg<lNumberOfConfigurationsCascade; lcfg++){
-            lCascadeResult = (AliCascadeResult*) fListCascade->At(lcfg);
-            histoout  = lCascadeResult->GetHistogram();
-
-            Float_t lMass = 0;
-            Float_t lV0Mass = 0; 
-            Float_t lRap  = 0;
-            Float_t lPDGMass = -1;
-            Float_t lNegdEdx = 100;
-            Float_t lPosdEdx = 100;
-            Float_t lBachdEdx = 100;
-            Short_t  lCharge = -2;
-            Int_t lChargePos =  1;
-            Int_t lChargeNeg = -1;
-            Float_t lprpx, lprpy, lprpz, lpipx, lpipy, lpipz;
-            lpipx = fTreeCascVarBachPx;
-            lpipy = fTreeCascVarBachPy;
-            lpipz = fTreeCascVarBachPz;
-
-            //For parametric V0 Mass selection
-            Float_t lExpV0Mass =
-            fLambdaMassMean[0]+
-            fLambdaMassMean[1]*TMath::Exp(fLambdaMassMean[2]*lV0Pt)+
-            fLambdaMassMean[3]*TMath::Exp(fLambdaMassMean[4]*lV0Pt);
-
-            Float_t lExpV0Sigma =
-            fLambdaMassSigma[0]+fLambdaMassSigma[1]*lV0Pt+
-            fLambdaMassSigma[2]*TMath::Exp(fLambdaMassSigma[3]*lV0Pt);
-            
-            //========================================================================
-            //For 2.76TeV-like parametric V0 CosPA
-            Float_t l276TeVV0CosPA = 0.998;
-            Float_t pThr=1.5;
-            if (lV0TotMomentum<pThr) {
-                //Below the threshold "pThr", try a momentum dependent cos(PA) cut
-                const Double_t bend=0.03; // approximate Xi bending angle
-                const Double_t qt=0.211;  // max Lambda pT in Omega decay
-                const Double_t cpaThr=TMath::Cos(TMath::ATan(qt/pThr) + bend);
-                Double_t
-                cpaCut=(0.998/cpaThr)*TMath::Cos(TMath::ATan(qt/lV0TotMomentum) + bend);
-                l276TeVV0CosPA = cpaCut;
-            }
-            //========================================================================
-            
-            //========================================================================
-            //Setting up: Variable Cascade CosPA
-            Float_t lCascCosPACut = lCascadeResult -> GetCutCascCosPA();
-            Float_t lVarCascCosPApar[5];
-            lVarCascCosPApar[0] = lCascadeResult->GetCutVarCascCosPAExp0Const();
-            lVarCascCosPApar[1] = lCascadeResult->GetCutVarCascCosPAExp0Slope();
-            lVarCascCosPApar[2] = lCascadeResult->GetCutVarCascCosPAExp1Const();
-            lVarCascCosPApar[3] = lCascadeResult->GetCutVarCascCosPAExp1Slope();
-            lVarCascCosPApar[4] = lCascadeResult->GetCutVarCascCosPAConst();
-            Float_t lVarCascCosPA = TMath::Cos(
-                lVarCascCosPApar[0]*TMath::Exp(lVarCascCosPApar[1]*fTreeCascVarPt) +
-                lVarCascCosPApar[2]*TMath::Exp(lVarCascCosPApar[3]*fTreeCascVarPt) +
-                lVarCascCosPApar[4]);
-            if( lCascadeResult->GetCutUseVarCascCosPA() ){
-                //Only use if tighter than the non-variable cut
-                if( lVarCascCosPA > lCascCosPACut ) lCascCosPACut = lVarCascCosPA;
-            }
-            //========================================================================
-
-            //========================================================================
-            //Setting up: Variable V0 CosPA
-            Float_t lV0CosPACut = lCascadeResult -> GetCutV0CosPA();
-            Float_t lVarV0CosPApar[5];
-            lVarV0CosPApar[0] = lCascadeResult->GetCutVarV0CosPAExp0Const();
-            lVarV0CosPApar[1] = lCascadeResult->GetCutVarV0CosPAExp0Slope();
-            lVarV0CosPApar[2] = lCascadeResult->GetCutVarV0CosPAExp1Const();
-            lVarV0CosPApar[3] = lCascadeResult->GetCutVarV0CosPAExp1Slope();
-            lVarV0CosPApar[4] = lCascadeResult->GetCutVarV0CosPAConst();
-            Float_t lVarV0CosPA = TMath::Cos(
-                                               lVarV0CosPApar[0]*TMath::Exp(lVarV0CosPApar[1]*fTreeCascVarPt) +
-                                               lVarV0CosPApar[2]*TMath::Exp(lVarV0CosPApar[3]*fTreeCascVarPt) +
-                                               lVarV0CosPApar[4]);
-            if( lCascadeResult->GetCutUseVarV0CosPA() ){
-                //Only use if tighter than the non-variable cut
-                if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
-            }
-            //========================================================================
-
-            //========================================================================
-            //Setting up: Variable BB CosPA
-            Float_t lBBCosPACut = lCascadeResult -> GetCutBachBaryonCosPA();
-            Float_t lVarBBCosPApar[5];
-            lVarBBCosPApar[0] = lCascadeResult->GetCutVarBBCosPAExp0Const();
-            lVarBBCosPApar[1] = lCascadeResult->GetCutVarBBCosPAExp0Slope();
-            lVarBBCosPApar[2] = lCascadeResult->GetCutVarBBCosPAExp1Const();
-            lVarBBCosPApar[3] = lCascadeResult->GetCutVarBBCosPAExp1Slope();
-            lVarBBCosPApar[4] = lCascadeResult->GetCutVarBBCosPAConst();
-            Float_t lVarBBCosPA = TMath::Cos(
-                                             lVarBBCosPApar[0]*TMath::Exp(lVarBBCosPApar[1]*fTreeCascVarPt) +
-                                             lVarBBCosPApar[2]*TMath::Exp(lVarBBCosPApar[3]*fTreeCascVarPt) +
-                                             lVarBBCosPApar[4]);
-            if( lCascadeResult->GetCutUseVarBBCosPA() ){
-                //Only use if looser than the non-variable cut (WARNING: BEWARE INVERSE LOGIC)
-                if( lVarBBCosPA > lBBCosPACut ) lBBCosPACut = lVarBBCosPA;
-            }
-            //========================================================================
-
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kXiMinus     ){
-                lCharge  = -1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsXi;
-                lV0Mass  = fTreeCascVarV0MassLambda;
-                lRap     = fTreeCascVarRapXi;
-                lPDGMass = 1.32171;
-                lNegdEdx = fTreeCascVarNegNSigmaPion;
-                lPosdEdx = fTreeCascVarPosNSigmaProton;
-                lBachdEdx= fTreeCascVarBachNSigmaPion;
-                lprpx = fTreeCascVarPosPx;
-                lprpy = fTreeCascVarPosPy;
-                lprpz = fTreeCascVarPosPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kXiPlus      ){
-                lCharge  = +1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsXi;
-                lV0Mass  = fTreeCascVarV0MassAntiLambda;
-                lRap     = fTreeCascVarRapXi;
-                lPDGMass = 1.32171;
-                lNegdEdx = fTreeCascVarNegNSigmaProton;
-                lPosdEdx = fTreeCascVarPosNSigmaPion;
-                lBachdEdx= fTreeCascVarBachNSigmaPion;
-                lprpx = fTreeCascVarNegPx;
-                lprpy = fTreeCascVarNegPy;
-                lprpz = fTreeCascVarNegPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kOmegaMinus     ){
-                lCharge  = -1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsOmega;
-                lV0Mass  = fTreeCascVarV0MassLambda;
-                lRap     = fTreeCascVarRapOmega;
-                lPDGMass = 1.67245;
-                lNegdEdx = fTreeCascVarNegNSigmaPion;
-                lPosdEdx = fTreeCascVarPosNSigmaProton;
-                lBachdEdx= fTreeCascVarBachNSigmaKaon;
-                lprpx = fTreeCascVarPosPx;
-                lprpy = fTreeCascVarPosPy;
-                lprpz = fTreeCascVarPosPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kOmegaPlus      ){
-                lCharge  = +1;
-                if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
-                lMass    = fTreeCascVarMassAsOmega;
-                lV0Mass  = fTreeCascVarV0MassAntiLambda;
-                lRap     = fTreeCascVarRapOmega;
-                lPDGMass = 1.67245;
-                lNegdEdx = fTreeCascVarNegNSigmaProton;
-                lPosdEdx = fTreeCascVarPosNSigmaPion;
-                lBachdEdx= fTreeCascVarBachNSigmaKaon;
-                lprpx = fTreeCascVarNegPx;
-                lprpy = fTreeCascVarNegPy;
-                lprpz = fTreeCascVarNegPz;
-            }
-            
-            if (
-                //Check 1: Charge consistent with expectations
-                fTreeCascVarCharge == lCharge &&
-                
-                //Check 2: Basic Acceptance cuts
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarPosEta && fTreeCascVarPosEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarNegEta && fTreeCascVarNegEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarBachEta && fTreeCascVarBachEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lRap > lCascadeResult->GetCutMinRapidity() &&
-                lRap < lCascadeResult->GetCutMaxRapidity() &&
-                
-                //Check 3: Topological Variables
-                // - V0 Selections
-                fTreeCascVarDCANegToPrimVtx > lCascadeResult->GetCutDCANegToPV() &&
-                fTreeCascVarDCAPosToPrimVtx > lCascadeResult->GetCutDCAPosToPV() &&
-                fTreeCascVarDCAV0Daughters < lCascadeResult->GetCutDCAV0Daughters() &&
-                fTreeCascVarV0CosPointingAngle > lV0CosPACut &&
-                fTreeCascVarV0Radius > lCascadeResult->GetCutV0Radius() &&
-                // - Cascade Selections
-                fTreeCascVarDCAV0ToPrimVtx > lCascadeResult->GetCutDCAV0ToPV() &&
-                TMath::Abs(lV0Mass-1.116) < lCascadeResult->GetCutV0Mass() &&
-                fTreeCascVarDCABachToPrimVtx > lCascadeResult->GetCutDCABachToPV() &&
-                fTreeCascVarDCACascDaughters < lCascadeResult->GetCutDCACascDaughters() &&
-                fTreeCascVarCascCosPointingAngle > lCascCosPACut &&
-                fTreeCascVarCascRadius > lCascadeResult->GetCutCascRadius() &&
-                
-                // - Implementation of a parametric V0 Mass cut if requested
-                (
-                 ( lCascadeResult->GetCutV0MassSigma() > 50 ) || //anything goes
-                 (TMath::Abs( (lV0Mass-lExpV0Mass) / lExpV0Sigma ) < lCascadeResult->GetCutV0MassSigma() )
-                 ) &&
-                
-                // - Miscellaneous
-                fTreeCascVarDistOverTotMom*lPDGMass < lCascadeResult->GetCutProperLifetime() &&
-                fTreeCascVarLeastNbrClusters > lCascadeResult->GetCutLeastNumberOfClusters() &&
-                
-                //Check 4: TPC dEdx selections
-                TMath::Abs(lNegdEdx )<lCascadeResult->GetCutTPCdEdx() &&
-                TMath::Abs(lPosdEdx )<lCascadeResult->GetCutTPCdEdx() &&
-                TMath::Abs(lBachdEdx)<lCascadeResult->GetCutTPCdEdx() &&
-                
-                //Check 5: Xi rejection for Omega analysis
-                ( ( lCascadeResult->GetMassHypothesis() != AliCascadeResult::kOmegaMinus && lCascadeResult->GetMassHypothesis() != AliCascadeResult::kOmegaPlus  ) || ( TMath::Abs( fTreeCascVarMassAsXi - 1.32171 ) > lCascadeResult->GetCutXiRejection() ) ) &&
-                
-                //Check 6: Experimental DCA Bachelor to Baryon cut
-                ( fTreeCascVarDCABachToBaryon > lCascadeResult->GetCutDCABachToBaryon() ) &&
-                
-                //Check 7: Experimental Bach Baryon CosPA
-                ( fTreeCascVarWrongCosPA < lBBCosPACut  ) &&
-                
-                //Check 8: Min/Max V0 Lifetime cut
-                ( ( fTreeCascVarV0Lifetime > lCascadeResult->GetCutMinV0Lifetime() ) &&
-                 ( fTreeCascVarV0Lifetime < lCascadeResult->GetCutMaxV0Lifetime() ||
-                  lCascadeResult->GetCutMaxV0Lifetime() > 1e+3 ) ) &&
-                
-                //Check 9: kITSrefit track selection if requested
-                (
-                 ( (fTreeCascVarPosTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeCascVarNegTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeCascVarBachTrackStatus & AliESDtrack::kITSrefit)
-                  )
-                 ||
-                 !lCascadeResult->GetCutUseITSRefitTracks()
-                 ) &&
-                
-                //Check 10: Max Chi2/Clusters if not absurd
-                ( lCascadeResult->GetCutMaxChi2PerCluster()>1e+3 ||
-                 fTreeCascVarMaxChi2PerCluster < lCascadeResult->GetCutMaxChi2PerCluster()
-                 )&&
-                
-                //Check 11: Min Track Length if positive
-                ( lCascadeResult->GetCutMinTrackLength()<0 || //this is a bit paranoid...
-                 fTreeCascVarMinTrackLength > lCascadeResult->GetCutMinTrackLength()
-                 )&&
-                
-                //Check 12: Check if special V0 CosPA cut used
-                //either don't use the cut at all, or make sure it's above threshold
-                ( lCascadeResult->GetCutUse276TeVV0CosPA()==kFALSE ||
-                 fTreeCascVarV0CosPointingAngle>l276TeVV0CosPA
-                 )
-                ){
-                //This satisfies all my conditionals! Fill histogram
-                histoout -> Fill ( fCentrality, fTreeCascVarPt, lMass );
-            }
-        }
+        //Step 1: Check the candidate against all configurations (compiled into cut tables) and fill
+        ProcessCascadeConfigurations(lV0Pt, lV0TotMomentum);
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         // End Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -3950,3 +3595,404 @@ AliAnalysisTaskStrangenessVsMultiplicityRun2::FMDhits AliAnalysisTaskStrangeness
     }
     return ret_vector;
 }
+
+//______________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::CompileV0Configurations()
+{
+    //Translate the AliV0Result objects in fListV0 into the V0 cut table (one lane per configuration)
+    //Flags are resolved here, so that the per-candidate check is a sequence of plain comparisons
+    const Int_t lN = fListV0->GetEntries();
+    fV0CutTable.assign(kV0NCutColumns*lN, 0.);
+    fV0CutHypothesis.assign(lN, 3);
+    fV0CutHisto.assign(lN, (TH3F*)0x0);
+    fV0CutPass.assign(lN, 0);
+    fV0CutCosPA.assign(lN, 0.);
+    fV0CutVarSlots.clear();
+    fV0CutVarPars.clear();
+
+    Double_t *lCut = fV0CutTable.empty() ? 0x0 : &fV0CutTable[0];
+    TIter lNext(fListV0);
+    AliV0Result *lV0Result = 0x0;
+    for(Int_t lcfg=0; lcfg<lN; lcfg++){
+        lV0Result = (AliV0Result*) lNext();
+        fV0CutHisto[lcfg] = lV0Result->GetHistogram();
+        AliV0Result::EMassHypo lHypo = lV0Result->GetMassHypothesis();
+        if( lHypo == AliV0Result::kK0Short || lHypo == AliV0Result::kLambda || lHypo == AliV0Result::kAntiLambda )
+            fV0CutHypothesis[lcfg] = lHypo;
+
+        lCut[kV0CutOnTheFly*lN+lcfg]                = lV0Result->GetUseOnTheFly();
+        lCut[kV0CutMinEta*lN+lcfg]                  = lV0Result->GetCutMinEtaTracks();
+        lCut[kV0CutMaxEta*lN+lcfg]                  = lV0Result->GetCutMaxEtaTracks();
+        lCut[kV0CutMinRap*lN+lcfg]                  = lV0Result->GetCutMinRapidity();
+        lCut[kV0CutMaxRap*lN+lcfg]                  = lV0Result->GetCutMaxRapidity();
+        lCut[kV0CutRadius*lN+lcfg]                  = lV0Result->GetCutV0Radius();
+        lCut[kV0CutDCANeg*lN+lcfg]                  = lV0Result->GetCutDCANegToPV();
+        lCut[kV0CutDCAPos*lN+lcfg]                  = lV0Result->GetCutDCAPosToPV();
+        lCut[kV0CutDCADaughters*lN+lcfg]            = lV0Result->GetCutDCAV0Daughters();
+        lCut[kV0CutCosPA*lN+lcfg]                   = (Float_t) lV0Result->GetCutV0CosPA();
+        lCut[kV0CutProperLifetime*lN+lcfg]          = lV0Result->GetCutProperLifetime();
+        lCut[kV0CutCrossedRows*lN+lcfg]             = lV0Result->GetCutLeastNumberOfCrossedRows();
+        lCut[kV0CutCrossedRowsOverFindable*lN+lcfg] = lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable();
+        lCut[kV0CutCheckBaryonMomentum*lN+lcfg]     = ( lHypo != AliV0Result::kK0Short );
+        lCut[kV0CutMinBaryonMomentum*lN+lcfg]       = lV0Result->GetCutMinBaryonMomentum();
+        lCut[kV0CutTPCdEdx*lN+lcfg]                 = lV0Result->GetCutTPCdEdx();
+        lCut[kV0CutUseArmenteros*lN+lcfg]           = ( lV0Result->GetCutArmenteros() && lHypo == AliV0Result::kK0Short );
+        lCut[kV0CutArmenterosParameter*lN+lcfg]     = lV0Result->GetCutArmenterosParameter();
+        lCut[kV0CutUseITSRefit*lN+lcfg]             = lV0Result->GetCutUseITSRefitTracks();
+        lCut[kV0CutSkipMaxChi2*lN+lcfg]             = ( lV0Result->GetCutMaxChi2PerCluster()>1e+3 );
+        lCut[kV0CutMaxChi2*lN+lcfg]                 = lV0Result->GetCutMaxChi2PerCluster();
+        lCut[kV0CutSkipMinTrackLength*lN+lcfg]      = ( lV0Result->GetCutMinTrackLength()<0 );
+        lCut[kV0CutMinTrackLength*lN+lcfg]          = lV0Result->GetCutMinTrackLength();
+
+        //Variable V0 CosPA: only tightens the fixed cut, evaluated per candidate
+        if( lV0Result->GetCutUseVarV0CosPA() ){
+            fV0CutVarSlots.push_back(lcfg);
+            fV0CutVarPars.push_back(lV0Result->GetCutVarV0CosPAExp0Const());
+            fV0CutVarPars.push_back(lV0Result->GetCutVarV0CosPAExp0Slope());
+            fV0CutVarPars.push_back(lV0Result->GetCutVarV0CosPAExp1Const());
+            fV0CutVarPars.push_back(lV0Result->GetCutVarV0CosPAExp1Slope());
+            fV0CutVarPars.push_back(lV0Result->GetCutVarV0CosPAConst());
+        }
+    }
+}
+
+//______________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::CompileCascadeConfigurations()
+{
+    //Translate the AliCascadeResult objects in fListCascade into the cascade cut table (one lane per configuration)
+    //Flags are resolved here, so that the per-candidate check is a sequence of plain comparisons
+    const Int_t lN = fListCascade->GetEntries();
+    fCascadeCutTable.assign(kCascadeNCutColumns*lN, 0.);
+    fCascadeCutHypothesis.assign(lN, 4);
+    fCascadeCutHisto.assign(lN, (TH3F*)0x0);
+    fCascadeCutPass.assign(lN, 0);
+    fCascadeCutCosPA.assign(3*lN, 0.);
+    fCascadeCutVarSlots.clear();
+    fCascadeCutVarPars.clear();
+
+    Double_t *lCut = fCascadeCutTable.empty() ? 0x0 : &fCascadeCutTable[0];
+    TIter lNext(fListCascade);
+    AliCascadeResult *lCascadeResult = 0x0;
+    for(Int_t lcfg=0; lcfg<lN; lcfg++){
+        lCascadeResult = (AliCascadeResult*) lNext();
+        fCascadeCutHisto[lcfg] = lCascadeResult->GetHistogram();
+        AliCascadeResult::EMassHypo lHypo = lCascadeResult->GetMassHypothesis();
+        Short_t lCharge = -2;
+        if( lHypo == AliCascadeResult::kXiMinus || lHypo == AliCascadeResult::kOmegaMinus ) lCharge = -1;
+        if( lHypo == AliCascadeResult::kXiPlus  || lHypo == AliCascadeResult::kOmegaPlus  ) lCharge = +1;
+        if( lCharge != -2 ){
+            fCascadeCutHypothesis[lcfg] = lHypo;
+            if ( lCascadeResult->GetSwapBachelorCharge() ) lCharge *= -1;
+        }
+
+        lCut[kCascCutCharge*lN+lcfg]             = lCharge;
+        lCut[kCascCutMinEta*lN+lcfg]             = lCascadeResult->GetCutMinEtaTracks();
+        lCut[kCascCutMaxEta*lN+lcfg]             = lCascadeResult->GetCutMaxEtaTracks();
+        lCut[kCascCutMinRap*lN+lcfg]             = lCascadeResult->GetCutMinRapidity();
+        lCut[kCascCutMaxRap*lN+lcfg]             = lCascadeResult->GetCutMaxRapidity();
+        lCut[kCascCutDCANeg*lN+lcfg]             = lCascadeResult->GetCutDCANegToPV();
+        lCut[kCascCutDCAPos*lN+lcfg]             = lCascadeResult->GetCutDCAPosToPV();
+        lCut[kCascCutDCAV0Daughters*lN+lcfg]     = lCascadeResult->GetCutDCAV0Daughters();
+        lCut[kCascCutV0CosPA*lN+lcfg]            = (Float_t) lCascadeResult->GetCutV0CosPA();
+        lCut[kCascCutV0Radius*lN+lcfg]           = lCascadeResult->GetCutV0Radius();
+        lCut[kCascCutDCAV0ToPV*lN+lcfg]          = lCascadeResult->GetCutDCAV0ToPV();
+        lCut[kCascCutV0Mass*lN+lcfg]             = lCascadeResult->GetCutV0Mass();
+        lCut[kCascCutDCABachToPV*lN+lcfg]        = lCascadeResult->GetCutDCABachToPV();
+        lCut[kCascCutDCACascDaughters*lN+lcfg]   = lCascadeResult->GetCutDCACascDaughters();
+        lCut[kCascCutCascCosPA*lN+lcfg]          = (Float_t) lCascadeResult->GetCutCascCosPA();
+        lCut[kCascCutCascRadius*lN+lcfg]         = lCascadeResult->GetCutCascRadius();
+        lCut[kCascCutSkipV0MassSigma*lN+lcfg]    = ( lCascadeResult->GetCutV0MassSigma() > 50 );
+        lCut[kCascCutV0MassSigma*lN+lcfg]        = lCascadeResult->GetCutV0MassSigma();
+        lCut[kCascCutProperLifetime*lN+lcfg]     = lCascadeResult->GetCutProperLifetime();
+        lCut[kCascCutLeastNbrClusters*lN+lcfg]   = lCascadeResult->GetCutLeastNumberOfClusters();
+        lCut[kCascCutTPCdEdx*lN+lcfg]            = lCascadeResult->GetCutTPCdEdx();
+        lCut[kCascCutCheckXiRejection*lN+lcfg]   = ( lHypo == AliCascadeResult::kOmegaMinus || lHypo == AliCascadeResult::kOmegaPlus );
+        lCut[kCascCutXiRejection*lN+lcfg]        = lCascadeResult->GetCutXiRejection();
+        lCut[kCascCutDCABachToBaryon*lN+lcfg]    = lCascadeResult->GetCutDCABachToBaryon();
+        lCut[kCascCutBBCosPA*lN+lcfg]            = (Float_t) lCascadeResult->GetCutBachBaryonCosPA();
+        lCut[kCascCutMinV0Lifetime*lN+lcfg]      = lCascadeResult->GetCutMinV0Lifetime();
+        lCut[kCascCutSkipMaxV0Lifetime*lN+lcfg]  = ( lCascadeResult->GetCutMaxV0Lifetime() > 1e+3 );
+        lCut[kCascCutMaxV0Lifetime*lN+lcfg]      = lCascadeResult->GetCutMaxV0Lifetime();
+        lCut[kCascCutUseITSRefit*lN+lcfg]        = lCascadeResult->GetCutUseITSRefitTracks();
+        lCut[kCascCutSkipMaxChi2*lN+lcfg]        = ( lCascadeResult->GetCutMaxChi2PerCluster()>1e+3 );
+        lCut[kCascCutMaxChi2*lN+lcfg]            = lCascadeResult->GetCutMaxChi2PerCluster();
+        lCut[kCascCutSkipMinTrackLength*lN+lcfg] = ( lCascadeResult->GetCutMinTrackLength()<0 );
+        lCut[kCascCutMinTrackLength*lN+lcfg]     = lCascadeResult->GetCutMinTrackLength();
+        lCut[kCascCutUse276TeVV0CosPA*lN+lcfg]   = lCascadeResult->GetCutUse276TeVV0CosPA();
+
+        //Variable CosPA cuts, evaluated per candidate. fCascadeCutCosPA holds
+        //the V0 (block 0), cascade (block 1) and bachelor-baryon (block 2) cuts
+        if( lCascadeResult->GetCutUseVarV0CosPA() ){
+            fCascadeCutVarSlots.push_back(lcfg);
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarV0CosPAExp0Const());
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarV0CosPAExp0Slope());
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarV0CosPAExp1Const());
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarV0CosPAExp1Slope());
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarV0CosPAConst());
+        }
+        if( lCascadeResult->GetCutUseVarCascCosPA() ){
+            fCascadeCutVarSlots.push_back(lN+lcfg);
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarCascCosPAExp0Const());
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarCascCosPAExp0Slope());
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarCascCosPAExp1Const());
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarCascCosPAExp1Slope());
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarCascCosPAConst());
+        }
+        if( lCascadeResult->GetCutUseVarBBCosPA() ){
+            fCascadeCutVarSlots.push_back(2*lN+lcfg);
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarBBCosPAExp0Const());
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarBBCosPAExp0Slope());
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarBBCosPAExp1Const());
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarBBCosPAExp1Slope());
+            fCascadeCutVarPars.push_back(lCascadeResult->GetCutVarBBCosPAConst());
+        }
+    }
+}
+
+//______________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::ApplyVariableCosPA(const std::vector<Int_t> &lSlots, const std::vector<Float_t> &lPars, Float_t lPt, std::vector<Float_t> &lCosPA) const
+{
+    //Tighten the CosPA cuts in the given slots with their pt-dependent parametrization
+    //(same single-precision parameters as the original per-configuration evaluation)
+    const Int_t lNSlots = lSlots.size();
+    for(Int_t islot=0; islot<lNSlots; islot++){
+        const Float_t *lPar = &lPars[5*islot];
+        Float_t lVarCosPA = TMath::Cos(
+                                       lPar[0]*TMath::Exp(lPar[1]*lPt) +
+                                       lPar[2]*TMath::Exp(lPar[3]*lPt) +
+                                       lPar[4]);
+        if( lVarCosPA > lCosPA[lSlots[islot]] ) lCosPA[lSlots[islot]] = lVarCosPA;
+    }
+}
+
+//______________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::ProcessV0Configurations(Int_t lOnFlyStatus)
+{
+    //Check the current V0 candidate against all configurations and fill the histograms of those it passes
+    //Candidate variables are computed once per mass hypothesis; each configuration is a lane
+    //of the cut table and the comparisons are combined without branches, so the loop vectorizes
+    if( (Int_t)fV0CutHisto.size() != fListV0->GetEntries() ) CompileV0Configurations();
+    const Int_t lN = fV0CutHisto.size();
+    if( lN == 0 ) return;
+
+    //Hypothesis-dependent variables (K0Short, Lambda, AntiLambda, undefined)
+    const Float_t lPDGMass[4] = { 0.497, 1.115683, 1.115683, -1 };
+    const Float_t lMass[4] = { fTreeVariableInvMassK0s, fTreeVariableInvMassLambda, fTreeVariableInvMassAntiLambda, 0 };
+    const Float_t lRap [4] = { fTreeVariableRapK0Short, fTreeVariableRapLambda, fTreeVariableRapLambda, 0 };
+    const Float_t lNegdEdx[4] = { TMath::Abs(fTreeVariableNSigmasNegPion), TMath::Abs(fTreeVariableNSigmasNegPion), TMath::Abs(fTreeVariableNSigmasNegProton), 100 };
+    const Float_t lPosdEdx[4] = { TMath::Abs(fTreeVariableNSigmasPosPion), TMath::Abs(fTreeVariableNSigmasPosProton), TMath::Abs(fTreeVariableNSigmasPosPion), 100 };
+    const Float_t lBaryonMomentum[4] = { -0.5, fTreeVariablePosInnerP, fTreeVariableNegInnerP, -0.5 };
+    Float_t lDecayLength[4];
+    for(Int_t ih=0; ih<4; ih++) lDecayLength[ih] = fTreeVariableDistOverTotMom*lPDGMass[ih];
+
+    //Hypothesis-independent variables
+    const Double_t lOnFly      = lOnFlyStatus;
+    const Float_t lNegEta      = fTreeVariableNegEta;
+    const Float_t lPosEta      = fTreeVariablePosEta;
+    const Float_t lV0Radius    = fTreeVariableV0Radius;
+    const Float_t lDcaNeg      = fTreeVariableDcaNegToPrimVertex;
+    const Float_t lDcaPos      = fTreeVariableDcaPosToPrimVertex;
+    const Float_t lDcaV0Dau    = fTreeVariableDcaV0Daughters;
+    const Float_t lV0CosPA     = fTreeVariableV0CosineOfPointingAngle;
+    const Int_t   lCrossedRows = fTreeVariableLeastNbrCrossedRows;
+    const Float_t lCrossedRowsOverFindable = fTreeVariableLeastRatioCrossedRowsOverFindable;
+    const Float_t lPtArm       = fTreeVariablePtArmV0;
+    const Float_t lAbsAlpha    = TMath::Abs(fTreeVariableAlphaV0);
+    const Bool_t  lITSRefit    = ( (fTreeVariableNegTrackStatus & AliESDtrack::kITSrefit) && (fTreeVariablePosTrackStatus & AliESDtrack::kITSrefit) );
+    const Float_t lMaxChi2     = fTreeVariableMaxChi2PerCluster;
+    const Float_t lMinLength   = fTreeVariableMinTrackLength;
+
+    //CosPA cut of each configuration at this pt
+    const Double_t *lCut = &fV0CutTable[0];
+    for(Int_t i=0; i<lN; i++) fV0CutCosPA[i] = lCut[kV0CutCosPA*lN+i];
+    ApplyVariableCosPA(fV0CutVarSlots, fV0CutVarPars, fTreeVariablePt, fV0CutCosPA);
+
+    const Int_t   *lHypo  = &fV0CutHypothesis[0];
+    const Float_t *lCosPA = &fV0CutCosPA[0];
+    UChar_t *lPass = &fV0CutPass[0];
+    for(Int_t i=0; i<lN; i++){
+        const Int_t h = lHypo[i];
+        lPass[i] =
+            //Check 1: Offline Vertexer
+            ( lOnFly == lCut[kV0CutOnTheFly*lN+i] ) &
+            //Check 2: Basic Acceptance cuts
+            ( lCut[kV0CutMinEta*lN+i] < lNegEta ) & ( lNegEta < lCut[kV0CutMaxEta*lN+i] ) &
+            ( lCut[kV0CutMinEta*lN+i] < lPosEta ) & ( lPosEta < lCut[kV0CutMaxEta*lN+i] ) &
+            ( lRap[h] > lCut[kV0CutMinRap*lN+i] ) & ( lRap[h] < lCut[kV0CutMaxRap*lN+i] ) &
+            //Check 3: Topological Variables
+            ( lV0Radius > lCut[kV0CutRadius*lN+i] ) &
+            ( lDcaNeg > lCut[kV0CutDCANeg*lN+i] ) &
+            ( lDcaPos > lCut[kV0CutDCAPos*lN+i] ) &
+            ( lDcaV0Dau < lCut[kV0CutDCADaughters*lN+i] ) &
+            ( lV0CosPA > lCosPA[i] ) &
+            ( lDecayLength[h] < lCut[kV0CutProperLifetime*lN+i] ) &
+            ( lCrossedRows > lCut[kV0CutCrossedRows*lN+i] ) &
+            ( lCrossedRowsOverFindable > lCut[kV0CutCrossedRowsOverFindable*lN+i] ) &
+            //Check 4: Minimum momentum of baryon daughter
+            ( ( lCut[kV0CutCheckBaryonMomentum*lN+i] == 0 ) | ( lBaryonMomentum[h] > lCut[kV0CutMinBaryonMomentum*lN+i] ) ) &
+            //Check 5: TPC dEdx selections
+            ( lNegdEdx[h] < lCut[kV0CutTPCdEdx*lN+i] ) & ( lPosdEdx[h] < lCut[kV0CutTPCdEdx*lN+i] ) &
+            //Check 6: Armenteros-Podolanski space cut (for K0Short analysis)
+            ( ( lCut[kV0CutUseArmenteros*lN+i] == 0 ) | ( lPtArm > lCut[kV0CutArmenterosParameter*lN+i]*lAbsAlpha ) ) &
+            //Check 7: kITSrefit track selection if requested
+            ( lITSRefit | ( lCut[kV0CutUseITSRefit*lN+i] == 0 ) ) &
+            //Check 8: Max Chi2/Clusters if not absurd
+            ( ( lCut[kV0CutSkipMaxChi2*lN+i] != 0 ) | ( lMaxChi2 < lCut[kV0CutMaxChi2*lN+i] ) ) &
+            //Check 9: Min Track Length if positive
+            ( ( lCut[kV0CutSkipMinTrackLength*lN+i] != 0 ) | ( lMinLength > lCut[kV0CutMinTrackLength*lN+i] ) );
+    }
+
+    //Fill the histograms of the configurations satisfying all conditionals
+    for(Int_t i=0; i<lN; i++){
+        if( lPass[i] ) fV0CutHisto[i] -> Fill ( fCentrality, fTreeVariablePt, lMass[lHypo[i]] );
+    }
+}
+
+//______________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::ProcessCascadeConfigurations(Float_t lV0Pt, Float_t lV0TotMomentum)
+{
+    //Check the current cascade candidate against all configurations and fill the histograms of those it passes
+    //Candidate variables are computed once per mass hypothesis; each configuration is a lane
+    //of the cut table and the comparisons are combined without branches, so the loop vectorizes
+    if( (Int_t)fCascadeCutHisto.size() != fListCascade->GetEntries() ) CompileCascadeConfigurations();
+    const Int_t lN = fCascadeCutHisto.size();
+    if( lN == 0 ) return;
+
+    //For parametric V0 Mass selection
+    Float_t lExpV0Mass =
+    fLambdaMassMean[0]+
+    fLambdaMassMean[1]*TMath::Exp(fLambdaMassMean[2]*lV0Pt)+
+    fLambdaMassMean[3]*TMath::Exp(fLambdaMassMean[4]*lV0Pt);
+
+    Float_t lExpV0Sigma =
+    fLambdaMassSigma[0]+fLambdaMassSigma[1]*lV0Pt+
+    fLambdaMassSigma[2]*TMath::Exp(fLambdaMassSigma[3]*lV0Pt);
+
+    //For 2.76TeV-like parametric V0 CosPA
+    Float_t l276TeVV0CosPA = 0.998;
+    Float_t pThr=1.5;
+    if (lV0TotMomentum<pThr) {
+        //Below the threshold "pThr", try a momentum dependent cos(PA) cut
+        const Double_t bend=0.03; // approximate Xi bending angle
+        const Double_t qt=0.211;  // max Lambda pT in Omega decay
+        const Double_t cpaThr=TMath::Cos(TMath::ATan(qt/pThr) + bend);
+        Double_t
+        cpaCut=(0.998/cpaThr)*TMath::Cos(TMath::ATan(qt/lV0TotMomentum) + bend);
+        l276TeVV0CosPA = cpaCut;
+    }
+
+    //Hypothesis-dependent variables (XiMinus, XiPlus, OmegaMinus, OmegaPlus, undefined)
+    const Float_t lPDGMass[5] = { 1.32171, 1.32171, 1.67245, 1.67245, -1 };
+    const Float_t lMass[5]   = { fTreeCascVarMassAsXi, fTreeCascVarMassAsXi, fTreeCascVarMassAsOmega, fTreeCascVarMassAsOmega, 0 };
+    const Float_t lV0Mass[5] = { fTreeCascVarV0MassLambda, fTreeCascVarV0MassAntiLambda, fTreeCascVarV0MassLambda, fTreeCascVarV0MassAntiLambda, 0 };
+    const Float_t lRap[5]    = { fTreeCascVarRapXi, fTreeCascVarRapXi, fTreeCascVarRapOmega, fTreeCascVarRapOmega, 0 };
+    const Float_t lNegdEdx[5]  = { TMath::Abs(fTreeCascVarNegNSigmaPion), TMath::Abs(fTreeCascVarNegNSigmaProton), TMath::Abs(fTreeCascVarNegNSigmaPion), TMath::Abs(fTreeCascVarNegNSigmaProton), 100 };
+    const Float_t lPosdEdx[5]  = { TMath::Abs(fTreeCascVarPosNSigmaProton), TMath::Abs(fTreeCascVarPosNSigmaPion), TMath::Abs(fTreeCascVarPosNSigmaProton), TMath::Abs(fTreeCascVarPosNSigmaPion), 100 };
+    const Float_t lBachdEdx[5] = { TMath::Abs(fTreeCascVarBachNSigmaPion), TMath::Abs(fTreeCascVarBachNSigmaPion), TMath::Abs(fTreeCascVarBachNSigmaKaon), TMath::Abs(fTreeCascVarBachNSigmaKaon), 100 };
+    Float_t lDecayLength[5];
+    Double_t lV0MassWindow[5];
+    Float_t lV0MassSigmas[5];
+    for(Int_t ih=0; ih<5; ih++){
+        lDecayLength[ih]  = fTreeCascVarDistOverTotMom*lPDGMass[ih];
+        lV0MassWindow[ih] = TMath::Abs(lV0Mass[ih]-1.116);
+        lV0MassSigmas[ih] = TMath::Abs( (lV0Mass[ih]-lExpV0Mass) / lExpV0Sigma );
+    }
+
+    //Hypothesis-independent variables
+    const Double_t lCharge      = fTreeCascVarCharge;
+    const Float_t lPosEta       = fTreeCascVarPosEta;
+    const Float_t lNegEta       = fTreeCascVarNegEta;
+    const Float_t lBachEta      = fTreeCascVarBachEta;
+    const Float_t lDcaNeg       = fTreeCascVarDCANegToPrimVtx;
+    const Float_t lDcaPos       = fTreeCascVarDCAPosToPrimVtx;
+    const Float_t lDcaV0Dau     = fTreeCascVarDCAV0Daughters;
+    const Float_t lV0CosPA      = fTreeCascVarV0CosPointingAngle;
+    const Float_t lV0Radius     = fTreeCascVarV0Radius;
+    const Float_t lDcaV0ToPV    = fTreeCascVarDCAV0ToPrimVtx;
+    const Float_t lDcaBach      = fTreeCascVarDCABachToPrimVtx;
+    const Float_t lDcaCascDau   = fTreeCascVarDCACascDaughters;
+    const Float_t lCascCosPA    = fTreeCascVarCascCosPointingAngle;
+    const Float_t lCascRadius   = fTreeCascVarCascRadius;
+    const Int_t   lNbrClusters  = fTreeCascVarLeastNbrClusters;
+    const Double_t lXiMassWindow = TMath::Abs( fTreeCascVarMassAsXi - 1.32171 );
+    const Float_t lDcaBachBar   = fTreeCascVarDCABachToBaryon;
+    const Float_t lWrongCosPA   = fTreeCascVarWrongCosPA;
+    const Float_t lV0Lifetime   = fTreeCascVarV0Lifetime;
+    const Bool_t  lITSRefit     = ( (fTreeCascVarPosTrackStatus & AliESDtrack::kITSrefit) &&
+                                    (fTreeCascVarNegTrackStatus & AliESDtrack::kITSrefit) &&
+                                    (fTreeCascVarBachTrackStatus & AliESDtrack::kITSrefit) );
+    const Float_t lMaxChi2      = fTreeCascVarMaxChi2PerCluster;
+    const Float_t lMinLength    = fTreeCascVarMinTrackLength;
+    const Bool_t  l276TeVPass   = ( lV0CosPA > l276TeVV0CosPA );
+
+    //CosPA cuts of each configuration at this pt
+    const Double_t *lCut = &fCascadeCutTable[0];
+    for(Int_t i=0; i<lN; i++){
+        fCascadeCutCosPA[i]      = lCut[kCascCutV0CosPA*lN+i];
+        fCascadeCutCosPA[lN+i]   = lCut[kCascCutCascCosPA*lN+i];
+        fCascadeCutCosPA[2*lN+i] = lCut[kCascCutBBCosPA*lN+i];
+    }
+    ApplyVariableCosPA(fCascadeCutVarSlots, fCascadeCutVarPars, fTreeCascVarPt, fCascadeCutCosPA);
+
+    const Int_t   *lHypo        = &fCascadeCutHypothesis[0];
+    const Float_t *lV0CosPACut   = &fCascadeCutCosPA[0];
+    const Float_t *lCascCosPACut = &fCascadeCutCosPA[lN];
+    const Float_t *lBBCosPACut   = &fCascadeCutCosPA[2*lN];
+    UChar_t *lPass = &fCascadeCutPass[0];
+    for(Int_t i=0; i<lN; i++){
+        const Int_t h = lHypo[i];
+        lPass[i] =
+            //Check 1: Charge consistent with expectations
+            ( lCharge == lCut[kCascCutCharge*lN+i] ) &
+            //Check 2: Basic Acceptance cuts
+            ( lCut[kCascCutMinEta*lN+i] < lPosEta ) & ( lPosEta < lCut[kCascCutMaxEta*lN+i] ) &
+            ( lCut[kCascCutMinEta*lN+i] < lNegEta ) & ( lNegEta < lCut[kCascCutMaxEta*lN+i] ) &
+            ( lCut[kCascCutMinEta*lN+i] < lBachEta ) & ( lBachEta < lCut[kCascCutMaxEta*lN+i] ) &
+            ( lRap[h] > lCut[kCascCutMinRap*lN+i] ) & ( lRap[h] < lCut[kCascCutMaxRap*lN+i] ) &
+            //Check 3: Topological Variables
+            // - V0 Selections
+            ( lDcaNeg > lCut[kCascCutDCANeg*lN+i] ) &
+            ( lDcaPos > lCut[kCascCutDCAPos*lN+i] ) &
+            ( lDcaV0Dau < lCut[kCascCutDCAV0Daughters*lN+i] ) &
+            ( lV0CosPA > lV0CosPACut[i] ) &
+            ( lV0Radius > lCut[kCascCutV0Radius*lN+i] ) &
+            // - Cascade Selections
+            ( lDcaV0ToPV > lCut[kCascCutDCAV0ToPV*lN+i] ) &
+            ( lV0MassWindow[h] < lCut[kCascCutV0Mass*lN+i] ) &
+            ( lDcaBach > lCut[kCascCutDCABachToPV*lN+i] ) &
+            ( lDcaCascDau < lCut[kCascCutDCACascDaughters*lN+i] ) &
+            ( lCascCosPA > lCascCosPACut[i] ) &
+            ( lCascRadius > lCut[kCascCutCascRadius*lN+i] ) &
+            // - Implementation of a parametric V0 Mass cut if requested
+            ( ( lCut[kCascCutSkipV0MassSigma*lN+i] != 0 ) | ( lV0MassSigmas[h] < lCut[kCascCutV0MassSigma*lN+i] ) ) &
+            // - Miscellaneous
+            ( lDecayLength[h] < lCut[kCascCutProperLifetime*lN+i] ) &
+            ( lNbrClusters > lCut[kCascCutLeastNbrClusters*lN+i] ) &
+            //Check 4: TPC dEdx selections
+            ( lNegdEdx[h] < lCut[kCascCutTPCdEdx*lN+i] ) &
+            ( lPosdEdx[h] < lCut[kCascCutTPCdEdx*lN+i] ) &
+            ( lBachdEdx[h] < lCut[kCascCutTPCdEdx*lN+i] ) &
+            //Check 5: Xi rejection for Omega analysis
+            ( ( lCut[kCascCutCheckXiRejection*lN+i] == 0 ) | ( lXiMassWindow > lCut[kCascCutXiRejection*lN+i] ) ) &
+            //Check 6: Experimental DCA Bachelor to Baryon cut
+            ( lDcaBachBar > lCut[kCascCutDCABachToBaryon*lN+i] ) &
+            //Check 7: Experimental Bach Baryon CosPA
+            ( lWrongCosPA < lBBCosPACut[i] ) &
+            //Check 8: Min/Max V0 Lifetime cut
+            ( lV0Lifetime > lCut[kCascCutMinV0Lifetime*lN+i] ) &
+            ( ( lV0Lifetime < lCut[kCascCutMaxV0Lifetime*lN+i] ) | ( lCut[kCascCutSkipMaxV0Lifetime*lN+i] != 0 ) ) &
+            //Check 9: kITSrefit track selection if requested
+            ( lITSRefit | ( lCut[kCascCutUseITSRefit*lN+i] == 0 ) ) &
+            //Check 10: Max Chi2/Clusters if not absurd
+            ( ( lCut[kCascCutSkipMaxChi2*lN+i] != 0 ) | ( lMaxChi2 < lCut[kCascCutMaxChi2*lN+i] ) ) &
+            //Check 11: Min Track Length if positive
+            ( ( lCut[kCascCutSkipMinTrackLength*lN+i] != 0 ) | ( lMinLength > lCut[kCascCutMinTrackLength*lN+i] ) ) &
+            //Check 12: Check if special V0 CosPA cut used
+            ( ( lCut[kCascCutUse276TeVV0CosPA*lN+i] == 0 ) | l276TeVPass );
+    }
+
+    //Fill the histograms of the configurations satisfying all conditionals
+    for(Int_t i=0; i<lN; i++){
+        if( lPass[i] ) fCascadeCutHisto[i] -> Fill ( fCentrality, fTreeCascVarPt, lMass[lHypo[i]] );
+    }
+}
@@ -47,6 +47,7 @@ class AliCascadeResult;
 //#include "TString.h"
 //#include "AliESDtrackCuts.h"
 //#include "AliAnalysisTaskSE.h"
+#include <vector>
 #include "AliEventCuts.h"
 
 class AliAnalysisTaskStrangenessVsMultiplicityRun2 : public AliAnalysisTaskSE {
@@ -220,6 +221,35 @@ public:
 
 
 private:
+    //Superlight mode: configurations compiled into cut tables, one lane per configuration
+    //Tables are column-major: column c of configuration i is at c*(number of configurations)+i
+    enum EV0CutColumn {
+        kV0CutOnTheFly, kV0CutMinEta, kV0CutMaxEta, kV0CutMinRap, kV0CutMaxRap,
+        kV0CutRadius, kV0CutDCANeg, kV0CutDCAPos, kV0CutDCADaughters, kV0CutCosPA,
+        kV0CutProperLifetime, kV0CutCrossedRows, kV0CutCrossedRowsOverFindable,
+        kV0CutCheckBaryonMomentum, kV0CutMinBaryonMomentum, kV0CutTPCdEdx,
+        kV0CutUseArmenteros, kV0CutArmenterosParameter, kV0CutUseITSRefit,
+        kV0CutSkipMaxChi2, kV0CutMaxChi2, kV0CutSkipMinTrackLength, kV0CutMinTrackLength,
+        kV0NCutColumns
+    };
+    enum ECascadeCutColumn {
+        kCascCutCharge, kCascCutMinEta, kCascCutMaxEta, kCascCutMinRap, kCascCutMaxRap,
+        kCascCutDCANeg, kCascCutDCAPos, kCascCutDCAV0Daughters, kCascCutV0CosPA, kCascCutV0Radius,
+        kCascCutDCAV0ToPV, kCascCutV0Mass, kCascCutDCABachToPV, kCascCutDCACascDaughters,
+        kCascCutCascCosPA, kCascCutCascRadius, kCascCutSkipV0MassSigma, kCascCutV0MassSigma,
+        kCascCutProperLifetime, kCascCutLeastNbrClusters, kCascCutTPCdEdx,
+        kCascCutCheckXiRejection, kCascCutXiRejection, kCascCutDCABachToBaryon, kCascCutBBCosPA,
+        kCascCutMinV0Lifetime, kCascCutSkipMaxV0Lifetime, kCascCutMaxV0Lifetime, kCascCutUseITSRefit,
+        kCascCutSkipMaxChi2, kCascCutMaxChi2, kCascCutSkipMinTrackLength, kCascCutMinTrackLength,
+        kCascCutUse276TeVV0CosPA,
+        kCascadeNCutColumns
+    };
+    void CompileV0Configurations();
+    void CompileCascadeConfigurations();
+    void ProcessV0Configurations(Int_t lOnFlyStatus);
+    void ProcessCascadeConfigurations(Float_t lV0Pt, Float_t lV0TotMomentum);
+    void ApplyVariableCosPA(const std::vector<Int_t> &lSlots, const std::vector<Float_t> &lPars, Float_t lPt, std::vector<Float_t> &lCosPA) const;
+
     // Note : In ROOT, "//!" means "do not stream the data from Master node to Worker node" ...
     // your data member object is created on the worker nodes and streaming is not needed.
     // http://root.cern.ch/download/doc/11InputOutput.pdf, page 14
@@ -470,10 +500,29 @@ private:
     TH1D *fHistEventCounter; //!
     TH1D *fHistCentrality; //!
 
+//===========================================================================================
+//   Compiled configurations (superlight mode)
+//===========================================================================================
+    std::vector<Double_t> fV0CutTable;       //! V0 cut values (see EV0CutColumn)
+    std::vector<Int_t>    fV0CutHypothesis;  //! mass hypothesis of each V0 configuration
+    std::vector<TH3F*>    fV0CutHisto;       //! output histogram of each V0 configuration
+    std::vector<UChar_t>  fV0CutPass;        //! pass flag of each V0 configuration for the current candidate
+    std::vector<Float_t>  fV0CutCosPA;       //! V0 CosPA cut of each configuration for the current candidate
+    std::vector<Int_t>    fV0CutVarSlots;    //! slots in fV0CutCosPA with a pt-dependent cut
+    std::vector<Float_t>  fV0CutVarPars;     //! parameters of the pt-dependent cuts (5 per slot)
+
+    std::vector<Double_t> fCascadeCutTable;      //! cascade cut values (see ECascadeCutColumn)
+    std::vector<Int_t>    fCascadeCutHypothesis; //! mass hypothesis of each cascade configuration
+    std::vector<TH3F*>    fCascadeCutHisto;      //! output histogram of each cascade configuration
+    std::vector<UChar_t>  fCascadeCutPass;       //! pass flag of each cascade configuration for the current candidate
+    std::vector<Float_t>  fCascadeCutCosPA;      //! V0, cascade and bachelor-baryon CosPA cuts (3 blocks) for the current candidate
+    std::vector<Int_t>    fCascadeCutVarSlots;   //! slots in fCascadeCutCosPA with a pt-dependent cut
+    std::vector<Float_t>  fCascadeCutVarPars;    //! parameters of the pt-dependent cuts (5 per slot)
+
     AliAnalysisTaskStrangenessVsMultiplicityRun2(const AliAnalysisTaskStrangenessVsMultiplicityRun2&);            // not implemented
     AliAnalysisTaskStrangenessVsMultiplicityRun2& operator=(const AliAnalysisTaskStrangenessVsMultiplicityRun2&); // not implemented
 
-    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 2);
+    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 3);
     //1: first implementation
 };
 